@@ -38,67 +38,22 @@ bool BitVector::resetFind()
 
 SInt32 BitVector::find()
 {
-
-   int windex = (m_last_pos == -1) ? 0 : m_last_pos >> 6; //divide by 64
-   int word_count = (m_capacity + 64 -1)  >> 6;
+   UInt32 windex = (m_last_pos == -1) ? 0 : (m_last_pos + 1) >> 6; //divide by 64
+   UInt32 shift = (m_last_pos == -1) ? 0 : (m_last_pos + 1) & 63;
 
    //walk through bitVector one word at a time
    //return when we find a set bit (whose pos is > last_pos)
-   while (windex < word_count)
+   while (windex < VECTOR_SIZE)
    {
-
-      UInt64 word64 = m_words[windex];
+      //mask off the bits at or below last_pos in the first word
+      UInt64 word64 = m_words[windex] & (~((UInt64) 0) << shift);
 
       if (word64 != 0)
       {
-
-         UInt32 words32[2];
-         words32[1] = (word64 >> 32) ;
-         words32[0] = word64 & 0xFFFFFFFF;
-
-         for (int i = 0; i < 2; i++)
-         {
-            if (words32[i] != 0)
-            {
-
-               UInt16 words16[2];
-               words16[1] = (words32[i] >> 16);
-               words16[0] = words32[i] & 0xFFFF;
-
-               for (int j = 0; j < 2; j++)
-               {
-                  if (words16[j] != 0)
-                  {
-
-                     UInt8 words8[2];
-                     words8[1] = (words16[j] >> 8);
-                     words8[0] = words16[j] & 0xFF;
-
-                     for (int k = 0; k < 2; k++)
-                     {
-                        if (words8[k] != 0)
-                        {
-
-                           for (int l = 0; l < 8; l++)
-                           {
-                              //loop through byte and look for set bit
-                              if (bTestBit(words8[k], l))
-                              {
-                                 int return_pos = 64*windex + 32*i + 16*j + 8*k + l;
-                                 if (return_pos > m_last_pos)
-                                 {
-                                    m_last_pos = return_pos;
-                                    return return_pos;
-                                 }
-                              }
-                           }
-                        }
-                     }
-                  }
-               }
-            }
-         }
+         m_last_pos = (windex << 6) + __builtin_ctzll(word64);
+         return m_last_pos;
       }
+      shift = 0;
       ++windex;
    }
 
@@ -119,7 +74,7 @@ bool BitVector::bTestBit(UInt8 byte_word, UInt32 bit)
    return (byte_word & mask) ? true : false;
 }
 
-bool BitVector::at(UInt32 bit)
+bool BitVector::at(UInt32 bit) const
 {
    assert(bit < m_capacity);
 
@@ -160,25 +115,31 @@ void BitVector::clear(UInt32 bit)
    }
 }
 
-#if BITVECT_DEBUG
-
 void BitVector::set(const BitVector& vec2)
 {
    assert(m_capacity == vec2.m_capacity);
 
+   m_size = 0;
    for (UInt32 i = 0; i < VECTOR_SIZE; i++)
-      words[i] |= vec2.m_words[i];
+   {
+      m_words[i] |= vec2.m_words[i];
+      m_size += __builtin_popcountll(m_words[i]);
+   }
 }
 
 void BitVector::clear(const BitVector& vec2)
 {
    assert(m_capacity == vec2.m_capacity);
 
+   m_size = 0;
    for (UInt32 i = 0; i < VECTOR_SIZE; i++)
-      words[i] &= ~vec2.m_words[i];
+   {
+      m_words[i] &= ~vec2.m_words[i];
+      m_size += __builtin_popcountll(m_words[i]);
+   }
 }
 
-bool BitVector::test(const BitVector& vec2)
+bool BitVector::test(const BitVector& vec2) const
 {
    assert(vec2.m_capacity == m_capacity);
 
@@ -191,6 +152,7 @@ bool BitVector::test(const BitVector& vec2)
    return false;
 }
 
+#if BITVECT_DEBUG
 
 void BitVector::debug()
 {
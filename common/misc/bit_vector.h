@@ -55,19 +55,22 @@ class BitVector
       //this is a helper function to the "find" function
       bool bTestBit(UInt8 word, UInt32 bit);
 
-      UInt32 capacity() { return m_capacity; }
-      UInt32 size() { return m_size; }
+      UInt32 capacity() const { return m_capacity; }
+      UInt32 size() const { return m_size; }
 
       void reset();
-      bool at(UInt32 bit);
+      bool at(UInt32 bit) const;
       void set(UInt32 bit);
       void clear(UInt32 bit);
 
-#ifdef BITVECT_DEBUG
       void set(const BitVector& vec2);
       void clear(const BitVector& vec2);
-      bool test(const BitVector& vec2);
-#endif
+      bool test(const BitVector& vec2) const;
+
+      //word-at-a-time access for callers that iterate the set bits
+      //directly (pop the lowest set bit with word &= word - 1)
+      UInt32 getNumWords() const { return VECTOR_SIZE; }
+      UInt64 getWord(UInt32 index) const { return m_words[index]; }
 
 };
 
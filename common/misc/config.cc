@@ -7,6 +7,8 @@
 #include "utils.h"
 
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 #include "log.h"
 
 #define DEBUG
@@ -54,6 +56,11 @@ Config::Config()
       // Simulation Mode
       m_simulation_mode = parseSimulationMode(Sim()->getCfg()->getString("general/mode"));
     
+      // Multi-application placement and partitioning
+      m_multi_app_tile_placement = Sim()->getCfg()->getString("multi_app/tile_placement", "interleaved");
+      m_partition_dram_by_target = parseResourceSharing(Sim()->getCfg()->getString("multi_app/dram_controllers", "shared"));
+      m_partition_l2_home_by_target = parseResourceSharing(Sim()->getCfg()->getString("multi_app/l2_home_slices", "shared"));
+
       // Target and Process Index, moved from socktransport.cc 
       m_knob_proc_index_str = getenv("CARBON_PROCESS_INDEX");
       m_knob_target_index_str = getenv("CARBON_TARGET_INDEX");
@@ -72,6 +79,12 @@ Config::Config()
    m_max_threads_per_core = m_knob_max_threads_per_core;
    m_num_cores_per_tile = 1;
 
+   if ((m_multi_app_tile_placement != "interleaved") && (m_multi_app_tile_placement != "contiguous"))
+   {
+      fprintf(stderr, "ERROR: Unrecognized multi-application tile placement(%s)\n", m_multi_app_tile_placement.c_str());
+      exit(EXIT_FAILURE);
+   }
+
    if(m_num_processes > 1 && m_knob_proc_index_str == NULL)
    {
       fprintf(stderr, "ERROR: Process index undefined with multiple processes.\n");
@@ -290,6 +303,9 @@ Config::computeProcessToTileMapping()
          {
          case NETWORK_EMESH_HOP_BY_HOP:
          case NETWORK_ATAC:
+         case NETWORK_ETORUS:
+         case NETWORK_ECMESH:
+         case NETWORK_EFLATTENED_BUTTERFLY:
             return process_to_tile_mapping_struct.second;
 
          default:
@@ -300,6 +316,10 @@ Config::computeProcessToTileMapping()
    }
    
    
+   // Give each target (process) its own region of the mesh
+   if (m_multi_app_tile_placement == "contiguous")
+      return computeContiguousProcessToTileMapping();
+
    //this may need to be changed sqc_multi
    vector<TileList> process_to_tile_mapping(m_num_processes);
    UInt32 current_proc = 0;
@@ -311,6 +331,64 @@ Config::computeProcessToTileMapping()
    return process_to_tile_mapping;
 }
 
+vector<Config::TileList>
+Config::computeContiguousProcessToTileMapping()
+{
+   TileList tile_list;
+   for (UInt32 i = 0; i < m_application_tiles; i++)
+      tile_list.push_back(i);
+
+   vector<TileList> process_to_tile_mapping(m_num_processes);
+   bisectTileList(tile_list, 0, m_num_processes, process_to_tile_mapping);
+   return process_to_tile_mapping;
+}
+
+// Recursively cut the region along its longer side, giving each half a share
+// of the tiles proportional to the number of processes placed in it
+void Config::bisectTileList(const TileList& tile_list, UInt32 first_proc, UInt32 num_procs,
+                            vector<TileList>& process_to_tile_mapping)
+{
+   if (num_procs == 1)
+   {
+      process_to_tile_mapping[first_proc] = tile_list;
+      return;
+   }
+
+   // Tiles are laid out row by row on a mesh of width floor(sqrt(application tiles))
+   SInt32 mesh_width = (SInt32) floor(sqrt(1.0 * m_application_tiles));
+   SInt32 min_x = mesh_width, max_x = -1, min_y = m_application_tiles, max_y = -1;
+   for (TLCI it = tile_list.begin(); it != tile_list.end(); it++)
+   {
+      min_x = std::min(min_x, (*it) % mesh_width);
+      max_x = std::max(max_x, (*it) % mesh_width);
+      min_y = std::min(min_y, (*it) / mesh_width);
+      max_y = std::max(max_y, (*it) / mesh_width);
+   }
+   bool cut_along_x = ((max_x - min_x) > (max_y - min_y));
+
+   vector<pair<SInt32, tile_id_t> > sorted_tile_list;
+   for (TLCI it = tile_list.begin(); it != tile_list.end(); it++)
+   {
+      SInt32 key = cut_along_x ? (((*it) % mesh_width) * (SInt32) m_application_tiles + (*it) / mesh_width) : (*it);
+      sorted_tile_list.push_back(make_pair(key, *it));
+   }
+   sort(sorted_tile_list.begin(), sorted_tile_list.end());
+
+   UInt32 num_first_procs = num_procs / 2;
+   UInt32 num_first_tiles = (tile_list.size() * num_first_procs) / num_procs;
+   TileList first_tile_list, second_tile_list;
+   for (UInt32 i = 0; i < sorted_tile_list.size(); i++)
+   {
+      if (i < num_first_tiles)
+         first_tile_list.push_back(sorted_tile_list[i].second);
+      else
+         second_tile_list.push_back(sorted_tile_list[i].second);
+   }
+
+   bisectTileList(first_tile_list, first_proc, num_first_procs, process_to_tile_mapping);
+   bisectTileList(second_tile_list, first_proc + num_first_procs, num_procs - num_first_procs, process_to_tile_mapping);
+}
+
 void Config::logTileMap()
 {
    // Log the map we just created
@@ -414,6 +492,19 @@ UInt32 Config::getTileFromCommId(UInt32 comm_id)
    return it == m_comm_to_tile_map.end() ? INVALID_TILE_ID : it->second;
 }
 
+bool Config::parseResourceSharing(string sharing)
+{
+   if (sharing == "shared")
+      return false;
+   else if (sharing == "partitioned")
+      return true;
+   else
+   {
+      fprintf(stderr, "Unrecognized Resource Sharing Policy(%s)\n", sharing.c_str());
+      exit(EXIT_FAILURE);
+   }
+}
+
 Config::SimulationMode Config::parseSimulationMode(string mode)
 {
    if (mode == "full")
@@ -118,6 +118,18 @@ public:
    UInt32 getMasterProcessID(UInt32 target_id)
    { return target_id; }
 
+   // Targets of a multi-application run (each target runs in its own host process)
+   // The target number is carried in the upper bits of every simulated address
+   static const UInt32 TARGET_NUM_ADDRESS_BIT = 48;
+   UInt32 getTargetNumFromAddress(IntPtr address) const
+   { return (m_num_targets == 1) ? 0 : (UInt32) (address >> TARGET_NUM_ADDRESS_BIT); }
+   UInt32 getTargetNumForTile(tile_id_t tile_id) const
+   { return (m_num_targets == 1) ? 0 : getProcessNumForTile(tile_id); }
+
+   // Sharing of the DRAM controllers and the L2 home slices among the targets
+   bool getPartitionDramByTarget() const        { return m_partition_dram_by_target; }
+   bool getPartitionL2HomeByTarget() const      { return m_partition_l2_home_by_target; }
+
    // Get MCP tile/core ID
    tile_id_t getMasterMCPTileID () const  { return (getTotalTiles() - m_num_targets); }
    core_id_t getMasterMCPCoreID() const   { return (core_id_t) {(tile_id_t) (getTotalTiles() - m_num_targets), MAIN_CORE_TYPE}; }
@@ -209,6 +221,8 @@ public:
 
 private:
    std::vector<TileList> computeProcessToTileMapping();
+   std::vector<TileList> computeContiguousProcessToTileMapping();
+   void bisectTileList(const TileList& tile_list, UInt32 first_proc, UInt32 num_procs, std::vector<TileList>& process_to_tile_mapping);
    
    UInt32  m_num_processes;         // Total number of processes (incl myself)
    UInt32  m_num_targets;           // Total number of targets (incl myself)  //sqc_multi
@@ -245,6 +259,11 @@ private:
 
    ProcessList m_process_list_current_target;  // The process indexes of current target
 
+   // Multi-application placement and partitioning
+   std::string m_multi_app_tile_placement;
+   bool m_partition_dram_by_target;
+   bool m_partition_l2_home_by_target;
+
    static Config *m_singleton;
 
    static UInt32 m_knob_total_tiles;
@@ -264,6 +283,7 @@ private:
    void parseNetworkParameters();
 
    static SimulationMode parseSimulationMode(std::string mode);
+   static bool parseResourceSharing(std::string sharing);
    static UInt32 computeTileIDLength(UInt32 tile_count);
    static bool isTileCountPermissible(UInt32 tile_count);
    
@@ -38,6 +38,18 @@ void Semaphore::wait()
    _lock.release();
 }
 
+bool Semaphore::tryWait()
+{
+   _lock.acquire();
+
+   bool acquired = (_count > 0);
+   if (acquired)
+      _count --;
+
+   _lock.release();
+   return acquired;
+}
+
 void Semaphore::signal()
 {
    _lock.acquire();
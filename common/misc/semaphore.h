@@ -10,6 +10,10 @@ public:
    ~Semaphore();
 
    void wait();
+   // Decrement the count if it is positive, without blocking
+   bool tryWait();
+   // Lock-free peek at the count (may be stale)
+   int getCount() const { return *((volatile const int*) &_count); }
    void signal();
    void broadcast();
 
@@ -0,0 +1,95 @@
+#include <algorithm>
+
+#include "varint_stream.h"
+
+using std::string;
+
+// -- VarintOutputStream -- //
+
+VarintOutputStream::VarintOutputStream(UInt32 buffer_size)
+   : _buffer(std::max<UInt32>(buffer_size, 64))
+   , _buffer_pos(0)
+{}
+
+VarintOutputStream::~VarintOutputStream()
+{
+   close();
+}
+
+bool
+VarintOutputStream::open(const string& filename)
+{
+   _file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+   return _file.good();
+}
+
+void
+VarintOutputStream::close()
+{
+   if (!_file.is_open())
+      return;
+   flush();
+   _file.close();
+}
+
+void
+VarintOutputStream::writeHeader(const UInt8* magic, UInt64 version, tile_id_t tile_id)
+{
+   for (UInt32 i = 0; i < MAGIC_SIZE; i++)
+      putByte(magic[i]);
+   putVarint(version);
+   putVarint(tile_id);
+}
+
+void
+VarintOutputStream::flush()
+{
+   _file.write((const char*) &_buffer[0], _buffer_pos);
+   _buffer_pos = 0;
+}
+
+// -- VarintInputStream -- //
+
+VarintInputStream::VarintInputStream(UInt32 buffer_size)
+   : _buffer(std::max<UInt32>(buffer_size, 64))
+   , _buffer_pos(0)
+   , _buffer_end(0)
+{}
+
+VarintInputStream::~VarintInputStream()
+{
+   _file.close();
+}
+
+bool
+VarintInputStream::open(const string& filename)
+{
+   _file.open(filename.c_str(), std::ios::in | std::ios::binary);
+   return _file.good();
+}
+
+VarintInputStream::HeaderStatus
+VarintInputStream::readHeader(const UInt8* magic, UInt64 version, tile_id_t& tile_id)
+{
+   for (UInt32 i = 0; i < VarintOutputStream::MAGIC_SIZE; i++)
+   {
+      UInt8 byte;
+      if (!getByte(byte) || (byte != magic[i]))
+         return INVALID_MAGIC;
+   }
+
+   UInt64 file_version, file_tile_id;
+   if (!getVarint(file_version) || (file_version != version) || !getVarint(file_tile_id))
+      return INVALID_VERSION;
+   tile_id = (tile_id_t) file_tile_id;
+   return VALID_HEADER;
+}
+
+bool
+VarintInputStream::fill()
+{
+   _file.read((char*) &_buffer[0], _buffer.size());
+   _buffer_pos = 0;
+   _buffer_end = _file.gcount();
+   return (_buffer_end > 0);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "fixed_types.h"
+
+// Buffered binary file streams of bytes and LEB128 varints (signed values are zigzag encoded,
+// so that small negative deltas stay short), used by the memory and packet traces.
+// A trace starts with a header: a 4 byte magic, a varint version and a varint tile ID.
+// The buffer is written out (read in) whenever it is full (empty).
+
+class VarintOutputStream
+{
+public:
+   VarintOutputStream(UInt32 buffer_size);
+   ~VarintOutputStream();
+
+   // Returns false if the file could not be created
+   bool open(const std::string& filename);
+   // Writes out what is left in the buffer
+   void close();
+
+   void writeHeader(const UInt8* magic, UInt64 version, tile_id_t tile_id);
+
+   void putByte(UInt8 byte)
+   {
+      if (_buffer_pos == _buffer.size())
+         flush();
+      _buffer[_buffer_pos ++] = byte;
+   }
+
+   void putVarint(UInt64 value)
+   {
+      while (value >= 0x80)
+      {
+         putByte((UInt8) (value | 0x80));
+         value >>= 7;
+      }
+      putByte((UInt8) value);
+   }
+
+   void putSignedVarint(SInt64 value)
+   { putVarint((((UInt64) value) << 1) ^ ((UInt64) (value >> 63))); }
+
+   static const UInt32 MAGIC_SIZE = 4;
+
+private:
+   std::ofstream _file;
+   std::vector<UInt8> _buffer;
+   UInt32 _buffer_pos;
+
+   void flush();
+};
+
+class VarintInputStream
+{
+public:
+   enum HeaderStatus
+   {
+      VALID_HEADER = 0,
+      INVALID_MAGIC,
+      INVALID_VERSION
+   };
+
+   VarintInputStream(UInt32 buffer_size);
+   ~VarintInputStream();
+
+   // Returns false if the file could not be opened
+   bool open(const std::string& filename);
+
+   HeaderStatus readHeader(const UInt8* magic, UInt64 version, tile_id_t& tile_id);
+
+   // Return false at the end of the file
+   bool getByte(UInt8& byte)
+   {
+      if ((_buffer_pos == _buffer_end) && !fill())
+         return false;
+      byte = _buffer[_buffer_pos ++];
+      return true;
+   }
+
+   bool getVarint(UInt64& value)
+   {
+      value = 0;
+      for (UInt32 shift = 0; shift < 64; shift += 7)
+      {
+         UInt8 byte;
+         if (!getByte(byte))
+            return false;
+         value |= ((UInt64) (byte & 0x7f)) << shift;
+         if (!(byte & 0x80))
+            return true;
+      }
+      return false;
+   }
+
+   bool getSignedVarint(SInt64& value)
+   {
+      UInt64 encoded_value;
+      if (!getVarint(encoded_value))
+         return false;
+      value = (SInt64) ((encoded_value >> 1) ^ (~(encoded_value & 1) + 1));
+      return true;
+   }
+
+private:
+   std::ifstream _file;
+   std::vector<UInt8> _buffer;
+   UInt32 _buffer_pos;
+   UInt32 _buffer_end;
+
+   bool fill();
+};
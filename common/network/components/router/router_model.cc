@@ -1,3 +1,6 @@
+#include <algorithm>
+using std::min_element;
+
 #include "router_model.h"
 #include "network_model.h"
 #include "network.h"
@@ -10,7 +13,8 @@
 RouterModel::RouterModel(NetworkModel* model, double frequency, double voltage,
                          SInt32 num_input_ports, SInt32 num_output_ports,
                          SInt32 num_flits_per_port_buffer, UInt64 delay, SInt32 flit_width,
-                         bool contention_model_enabled, string& contention_model_type)
+                         bool contention_model_enabled, string& contention_model_type,
+                         SInt32 num_vc_classes, SInt32 num_vcs_per_class, UInt64 credit_round_trip_delay)
    : _model(model)
    , _frequency(frequency)
    , _num_input_ports(num_input_ports)
@@ -18,8 +22,26 @@ RouterModel::RouterModel(NetworkModel* model, double frequency, double voltage,
    , _delay(delay)
    , _contention_model_enabled(contention_model_enabled)
    , _power_model(NULL)
+   , _credit_flow_control_enabled(contention_model_enabled && (num_vcs_per_class > 0))
+   , _num_vc_classes(num_vc_classes)
+   , _num_vcs_per_class(num_vcs_per_class)
+   , _num_flits_per_vc_buffer(num_flits_per_port_buffer)
+   , _credit_round_trip_delay(credit_round_trip_delay)
+   , _total_vc_stalls(0)
+   , _total_vc_stall_cycles(0)
+   , _total_credit_stalls(0)
+   , _total_credit_stall_cycles(0)
 {
-   if (_contention_model_enabled)
+   LOG_ASSERT_ERROR((_num_vc_classes >= 1) && (_num_vcs_per_class >= 0) && (_num_flits_per_vc_buffer >= 1),
+                    "Num VC Classes(%i), Num VCs per Class(%i), Num Flits per Buffer(%i)",
+                    _num_vc_classes, _num_vcs_per_class, _num_flits_per_vc_buffer);
+
+   if (_credit_flow_control_enabled)
+   {
+      _vc_free_time.resize(_num_output_ports * _num_vc_classes * _num_vcs_per_class, 0);
+      _total_flits.resize(_num_output_ports, 0);
+   }
+   else if (_contention_model_enabled)
    {
       _contention_model_list.resize(_num_output_ports);
       for (SInt32 i = 0; i < _num_output_ports; i++)
@@ -32,7 +54,8 @@ RouterModel::RouterModel(NetworkModel* model, double frequency, double voltage,
    if (Config::getSingleton()->getEnablePowerModeling())
    {
       _power_model = new RouterPowerModel(_frequency, voltage, _num_input_ports, _num_output_ports,
-                                          num_flits_per_port_buffer, flit_width);
+                                          num_flits_per_port_buffer, flit_width,
+                                          _num_vc_classes, max<SInt32>(_num_vcs_per_class, 1));
    }
 }
 
@@ -41,7 +64,7 @@ RouterModel::~RouterModel()
    if (Config::getSingleton()->getEnablePowerModeling())
       delete _power_model;
 
-   if (_contention_model_enabled)
+   if (_contention_model_enabled && !_credit_flow_control_enabled)
    {
       for (SInt32 i = 0; i < _num_output_ports; i++)
          delete _contention_model_list[i];
@@ -50,7 +73,7 @@ RouterModel::~RouterModel()
 
 void
 RouterModel::processPacket(const NetPacket& pkt, SInt32 output_port,
-                           UInt64& zero_load_delay, UInt64& contention_delay)
+                           UInt64& zero_load_delay, UInt64& contention_delay, SInt32 vc_class)
 {
    vector<SInt32> output_port_list;
    
@@ -64,12 +87,12 @@ RouterModel::processPacket(const NetPacket& pkt, SInt32 output_port,
       output_port_list.push_back(output_port);
    }
 
-   processPacket(pkt, output_port_list, zero_load_delay, contention_delay);
+   processPacket(pkt, output_port_list, zero_load_delay, contention_delay, vc_class);
 }
 
 void
 RouterModel::processPacket(const NetPacket& pkt, vector<SInt32>& output_port_list,
-                                  UInt64& zero_load_delay, UInt64& contention_delay)
+                                  UInt64& zero_load_delay, UInt64& contention_delay, SInt32 vc_class)
 {
    if (!_model->isModelEnabled(pkt))
       return;
@@ -88,7 +111,9 @@ RouterModel::processPacket(const NetPacket& pkt, vector<SInt32>& output_port_lis
       UInt64 max_queue_delay = 0;
       for (vector<SInt32>::iterator it = output_port_list.begin(); it != output_port_list.end(); it++)
       {
-         UInt64 queue_delay = _contention_model_list[*it]->computeQueueDelay(pkt.time.toCycles(_frequency), num_flits);
+         UInt64 queue_delay = _credit_flow_control_enabled ?
+                              computeCreditFlowControlDelay(pkt.time.toCycles(_frequency), num_flits, *it, vc_class) :
+                              _contention_model_list[*it]->computeQueueDelay(pkt.time.toCycles(_frequency), num_flits);
          max_queue_delay = max<UInt64>(max_queue_delay, queue_delay);
       }
 
@@ -101,6 +126,9 @@ RouterModel::processPacket(const NetPacket& pkt, vector<SInt32>& output_port_lis
 
    // Update Event Counters
    updateEventCounters(num_flits, output_port_list);
+   // Update Output Port Backlog (done by the flow control model when enabled)
+   if (!_credit_flow_control_enabled)
+      updateOutputPortBacklog(pkt.time.toCycles(_frequency), num_flits, output_port_list);
 
    // Update Dynamic Energy Counters
    if (Config::getSingleton()->getEnablePowerModeling())
@@ -131,6 +159,7 @@ RouterModel::initializeContentionCounters()
 {
    _total_contention_delay.resize(_num_output_ports, 0);
    _total_packets.resize(_num_output_ports, 0);
+   _output_port_busy_until.resize(_num_output_ports, 0);
 }
 
 void
@@ -143,6 +172,56 @@ RouterModel::updateContentionCounters(UInt64 contention_delay, vector<SInt32>& o
    }
 }
 
+void
+RouterModel::updateOutputPortBacklog(UInt64 time, SInt32 num_flits, vector<SInt32>& output_port_list)
+{
+   for (vector<SInt32>::iterator it = output_port_list.begin(); it != output_port_list.end(); it++)
+      _output_port_busy_until[*it] = max<UInt64>(_output_port_busy_until[*it], time) + num_flits;
+}
+
+UInt64
+RouterModel::computeCreditFlowControlDelay(UInt64 pkt_time, SInt32 num_flits, SInt32 output_port, SInt32 vc_class)
+{
+   LOG_ASSERT_ERROR((vc_class >= 0) && (vc_class < _num_vc_classes), "VC Class(%i), Num VC Classes(%i)",
+                    vc_class, _num_vc_classes);
+
+   // VC allocation: the VC of the class whose credits are all back first
+   vector<UInt64>::iterator vc_begin = _vc_free_time.begin() + ((output_port * _num_vc_classes) + vc_class) * _num_vcs_per_class;
+   vector<UInt64>::iterator vc = min_element(vc_begin, vc_begin + _num_vcs_per_class);
+   UInt64 vc_stall = (*vc > pkt_time) ? (*vc - pkt_time) : 0;
+   if (vc_stall > 0)
+   {
+      _total_vc_stalls ++;
+      _total_vc_stall_cycles += vc_stall;
+   }
+
+   // Switch allocation: the link is shared by all the VCs of the port
+   UInt64 start_time = max<UInt64>(pkt_time + vc_stall, _output_port_busy_until[output_port]);
+
+   // Credits: after each buffer-full of flits, the next flit waits for the first credit to return
+   UInt64 credit_stall = 0;
+   if ((num_flits > _num_flits_per_vc_buffer) && (_credit_round_trip_delay > (UInt64) _num_flits_per_vc_buffer))
+   {
+      credit_stall = ((num_flits - 1) / _num_flits_per_vc_buffer) * (_credit_round_trip_delay - _num_flits_per_vc_buffer);
+      _total_credit_stalls ++;
+      _total_credit_stall_cycles += credit_stall;
+   }
+
+   UInt64 tail_departure_time = start_time + credit_stall + num_flits;
+   _output_port_busy_until[output_port] = start_time + num_flits;
+   *vc = tail_departure_time + _credit_round_trip_delay;
+   _total_flits[output_port] += num_flits;
+
+   return (start_time - pkt_time) + credit_stall;
+}
+
+UInt64
+RouterModel::getOutputPortBacklog(SInt32 output_port, UInt64 time) const
+{
+   assert(output_port >= 0 && output_port < _num_output_ports);
+   return (_output_port_busy_until[output_port] > time) ? (_output_port_busy_until[output_port] - time) : 0;
+}
+
 float
 RouterModel::getAverageContentionDelay(SInt32 output_port_start, SInt32 output_port_end)
 {
@@ -176,7 +255,10 @@ RouterModel::getAverageLinkUtilization(SInt32 output_port_start, SInt32 output_p
    float link_utilization = 0.0;
    for (SInt32 i = output_port_start; i <= output_port_end; i++)
    {
-      link_utilization += _contention_model_list[i]->getQueueUtilization();
+      if (_credit_flow_control_enabled)
+         link_utilization += (_output_port_busy_until[i] > 0) ? (((float) _total_flits[i]) / _output_port_busy_until[i]) : 0.0;
+      else
+         link_utilization += _contention_model_list[i]->getQueueUtilization();
    }
    link_utilization = link_utilization / (output_port_end - output_port_start + 1);
    return link_utilization;
@@ -190,6 +272,10 @@ RouterModel::getPercentAnalyticalModelsUsed(SInt32 output_port_start, SInt32 out
 
    LOG_ASSERT_ERROR(output_port_end >= output_port_start, "output_port_end(%i) < output_port_start(%i)",
                     output_port_end, output_port_start);
+
+   // No queue models with credit-based flow control
+   if (_credit_flow_control_enabled)
+      return 0.0;
    
    UInt64 total_analytical_model_requests = 0;
    UInt64 total_requests = 0;
@@ -12,19 +12,33 @@ using std::vector;
 class NetworkModel;
 class NetPacket;
 
+// Contention is modeled either with a queue model per output port, or (num_vcs_per_class > 0)
+// with virtual channels and credit-based flow control to the downstream router:
+//  - Every output port has num_vc_classes x num_vcs_per_class VCs, each with a downstream
+//    buffer of num_flits_per_port_buffer flits. A packet only gets a VC of its class.
+//  - VC allocation picks the VC whose downstream buffer frees up first, then switch
+//    allocation waits for the link (shared by the VCs of the port).
+//  - A packet longer than the VC buffer waits for the credits of its first flits, which come
+//    back credit_round_trip_delay cycles after the flits leave. The VC is held until the
+//    credits of the tail flit are back.
+//  - Credits always return after that constant delay: the time the flits then wait in the
+//    downstream router (for its own VCs, credits or links) does not hold them. So congestion
+//    does not propagate upstream (no backpressure); each router only sees its own VC, credit
+//    and link stalls.
 class RouterModel
 {
 public:
    RouterModel(NetworkModel* model, double frequency, double voltage,
                SInt32 num_input_ports, SInt32 num_output_ports,
                SInt32 num_flits_per_port_buffer, UInt64 delay, SInt32 flit_width,
-               bool contention_model_enabled, string& contention_model_type);
+               bool contention_model_enabled, string& contention_model_type,
+               SInt32 num_vc_classes = 1, SInt32 num_vcs_per_class = 0, UInt64 credit_round_trip_delay = 0);
    ~RouterModel();
 
    void processPacket(const NetPacket& pkt, SInt32 output_port,
-                      UInt64& zero_load_delay, UInt64& contention_delay);
+                      UInt64& zero_load_delay, UInt64& contention_delay, SInt32 vc_class = 0);
    void processPacket(const NetPacket& pkt, vector<SInt32>& output_port_list,
-                      UInt64& zero_load_delay, UInt64& contention_delay);
+                      UInt64& zero_load_delay, UInt64& contention_delay, SInt32 vc_class = 0);
    
    // Event Counters
    UInt64 getTotalBufferWrites()                            { return _total_buffer_writes; }
@@ -43,6 +57,17 @@ public:
    // Percent Analytical Model Used
    float getPercentAnalyticalModelsUsed(SInt32 output_port_start, SInt32 output_port_end = INVALID_PORT);
 
+   // Cycles of traffic already sent through the output port that are still pending at 'time'
+   // (in cycles), whether or not the contention model is enabled. Used by adaptive routing.
+   UInt64 getOutputPortBacklog(SInt32 output_port, UInt64 time) const;
+
+   // Flow Control Counters
+   bool isCreditFlowControlEnabled()      { return _credit_flow_control_enabled; }
+   UInt64 getTotalVCStalls()              { return _total_vc_stalls; }
+   UInt64 getTotalVCStallCycles()         { return _total_vc_stall_cycles; }
+   UInt64 getTotalCreditStalls()          { return _total_credit_stalls; }
+   UInt64 getTotalCreditStallCycles()     { return _total_credit_stall_cycles; }
+
    static const SInt32 OUTPUT_PORT_ALL = 0xbabecafe;
    static const SInt32 INVALID_PORT = 0xdeadbeef;
 
@@ -67,6 +92,28 @@ private:
    // Contention Counters
    vector<UInt64> _total_contention_delay;
    vector<UInt64> _total_packets;
+   // Cycle at which each output port is done with the flits sent through it
+   vector<UInt64> _output_port_busy_until;
+
+   // Credit-based flow control
+   bool _credit_flow_control_enabled;
+   SInt32 _num_vc_classes;
+   SInt32 _num_vcs_per_class;
+   SInt32 _num_flits_per_vc_buffer;
+   UInt64 _credit_round_trip_delay;
+   // Cycle at which all the credits of each VC are back, by output port, then VC class, then VC
+   vector<UInt64> _vc_free_time;
+   // Flits sent through each output port
+   vector<UInt64> _total_flits;
+
+   // Flow Control Counters
+   UInt64 _total_vc_stalls;
+   UInt64 _total_vc_stall_cycles;
+   UInt64 _total_credit_stalls;
+   UInt64 _total_credit_stall_cycles;
+
+   // Returns the VC, switch and credit stall cycles of the packet on the output port
+   UInt64 computeCreditFlowControlDelay(UInt64 pkt_time, SInt32 num_flits, SInt32 output_port, SInt32 vc_class);
 
    // Initialize Event Counters
    void initializeEventCounters();
@@ -76,4 +123,6 @@ private:
    void initializeContentionCounters();
    // Update Contention Counters
    void updateContentionCounters(UInt64 contention_delay, vector<SInt32>& output_port_list);
+   // Update Output Port Backlog
+   void updateOutputPortBacklog(UInt64 time, SInt32 num_flits, vector<SInt32>& output_port_list);
 };
@@ -6,7 +6,8 @@
 using namespace dsent_contrib;
 
 RouterPowerModel::RouterPowerModel(double frequency, double voltage, UInt32 num_input_ports, UInt32 num_output_ports,
-                                   UInt32 num_flits_per_port_buffer, UInt32 flit_width)
+                                   UInt32 num_flits_per_port_buffer, UInt32 flit_width,
+                                   UInt32 num_vc_classes, UInt32 num_vcs_per_class)
    : _num_input_ports(num_input_ports)
    , _num_output_ports(num_output_ports)
 {
@@ -22,7 +23,7 @@ RouterPowerModel::RouterPowerModel(double frequency, double voltage, UInt32 num_
       // DSENT expects frequency in hertz (Hz)
       _dsent_router_map[current_voltage] =  new DSENTRouter(current_frequency * 1e9, current_voltage,
                                                             num_input_ports, num_output_ports,
-                                                            1, 1,
+                                                            num_vc_classes, num_vcs_per_class,
                                                             num_flits_per_port_buffer, flit_width,
                                                             DSENTInterface::getSingleton());
    }
@@ -10,8 +10,10 @@ using std::map;
 class RouterPowerModel
 {
 public:
+   // 'num_flits_per_port_buffer' is the buffer depth of each of the num_vc_classes x num_vcs_per_class VCs
    RouterPowerModel(double frequency, double voltage, UInt32 num_input_ports, UInt32 num_output_ports,
-                    UInt32 num_flits_per_port_buffer, UInt32 flit_width);
+                    UInt32 num_flits_per_port_buffer, UInt32 flit_width,
+                    UInt32 num_vc_classes = 1, UInt32 num_vcs_per_class = 1);
    ~RouterPowerModel();
 
    // Change voltage, frequency dynamically
@@ -0,0 +1,257 @@
+#include <sstream>
+#include <algorithm>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "deterministic_delivery.h"
+#include "network.h"
+#include "simulator.h"
+#include "config.h"
+#include "log.h"
+
+using std::string;
+using std::vector;
+using std::list;
+using std::endl;
+
+static UInt64 getHostTime()
+{
+   timeval t;
+   gettimeofday(&t, NULL);
+   return (((UInt64) t.tv_sec) * 1000000 + t.tv_usec);
+}
+
+// Delivery order: simulated time, then sender (stable, so that packets from a sender stay in order)
+static bool isDeliveredBefore(const Byte* buffer1, const Byte* buffer2)
+{
+   const NetPacket* packet1 = (const NetPacket*) buffer1;
+   const NetPacket* packet2 = (const NetPacket*) buffer2;
+   if (!(packet1->time == packet2->time))
+      return (packet1->time < packet2->time);
+   return (TILE_ID(packet1->sender) < TILE_ID(packet2->sender));
+}
+
+DeterministicDelivery::DeterministicDelivery(tile_id_t tile_id, Transport::Node* transport)
+   : _tile_id(tile_id)
+   , _transport(transport)
+   , _replay_stall_timeout(0)
+   , _total_packets_delivered(0)
+   , _total_packets_reordered(0)
+   , _total_replay_stalls(0)
+   , _total_host_time(0)
+{
+   string log_mode;
+   string replay_directory;
+   try
+   {
+      log_mode = Sim()->getCfg()->getString("deterministic/log", "none");
+      replay_directory = Sim()->getCfg()->getString("deterministic/replay_directory", "");
+      _replay_stall_timeout = Sim()->getCfg()->getInt("deterministic/replay_stall_timeout", 10000);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [deterministic] parameters from the cfg file");
+   }
+   _log_mode = parseLogMode(log_mode);
+   _next_replay_entry.sender = INVALID_TILE_ID;
+
+   if (_log_mode == RECORD_LOG)
+   {
+      string filename = Config::getSingleton()->formatOutputFileName(getFilename(_tile_id));
+      _record_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      LOG_ASSERT_ERROR(_record_file.good(), "Could not open delivery log(%s)", filename.c_str());
+   }
+   else if (_log_mode == REPLAY_LOG)
+   {
+      string filename = (replay_directory == "") ?
+                        Config::getSingleton()->formatOutputFileName(getFilename(_tile_id)) :
+                        (replay_directory + "/" + getFilename(_tile_id));
+      _replay_file.open(filename.c_str(), std::ios::in | std::ios::binary);
+      LOG_ASSERT_ERROR(_replay_file.good(), "Could not open delivery log(%s)", filename.c_str());
+      readNextReplayEntry();
+   }
+}
+
+DeterministicDelivery::~DeterministicDelivery()
+{
+   for (list<Byte*>::iterator it = _pending_buffer_list.begin(); it != _pending_buffer_list.end(); it++)
+      delete [] *it;
+
+   if (_record_file.is_open())
+      _record_file.close();
+   if (_replay_file.is_open())
+      _replay_file.close();
+}
+
+bool
+DeterministicDelivery::isEnabled()
+{
+   return Sim()->getCfg()->getBool("deterministic/enabled", false);
+}
+
+string
+DeterministicDelivery::getFilename(tile_id_t tile_id)
+{
+   std::ostringstream filename;
+   filename << "delivery_log_" << tile_id << ".bin";
+   return filename.str();
+}
+
+DeterministicDelivery::LogMode
+DeterministicDelivery::parseLogMode(string log_mode)
+{
+   if (log_mode == "none")
+      return NO_LOG;
+   else if (log_mode == "record")
+      return RECORD_LOG;
+   else if (log_mode == "replay")
+      return REPLAY_LOG;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Deterministic Delivery Log Mode(%s)", log_mode.c_str());
+      return NO_LOG;
+   }
+}
+
+void
+DeterministicDelivery::pull(vector<Byte*>& buffer_list)
+{
+   // Waiting for the first packet is not part of the cost of the deterministic mode
+   if (_pending_buffer_list.empty())
+      _pending_buffer_list.push_back(_transport->recv());
+
+   UInt64 start_time = getHostTime();
+
+   receivePendingPackets();
+   if ( (_log_mode != REPLAY_LOG) || !replayNextPacket(buffer_list) )
+      orderPendingPackets(buffer_list);
+
+   if (_log_mode == RECORD_LOG)
+   {
+      for (vector<Byte*>::iterator it = buffer_list.begin(); it != buffer_list.end(); it++)
+      {
+         const NetPacket* packet = (const NetPacket*) *it;
+         LogEntry entry;
+         entry.sender = TILE_ID(packet->sender);
+         entry.type = (SInt32) packet->type;
+         entry.time = packet->time.toPicosec();
+         _record_file.write((const char*) &entry.sender, sizeof(entry.sender));
+         _record_file.write((const char*) &entry.type, sizeof(entry.type));
+         _record_file.write((const char*) &entry.time, sizeof(entry.time));
+      }
+   }
+
+   _total_packets_delivered += buffer_list.size();
+   _total_host_time += (getHostTime() - start_time);
+}
+
+void
+DeterministicDelivery::receivePendingPackets()
+{
+   while (_transport->query())
+      _pending_buffer_list.push_back(_transport->recv());
+}
+
+void
+DeterministicDelivery::orderPendingPackets(vector<Byte*>& buffer_list)
+{
+   buffer_list.assign(_pending_buffer_list.begin(), _pending_buffer_list.end());
+   _pending_buffer_list.clear();
+
+   vector<Byte*> arrival_order = buffer_list;
+   std::stable_sort(buffer_list.begin(), buffer_list.end(), isDeliveredBefore);
+   for (UInt32 i = 0; i < buffer_list.size(); i++)
+   {
+      if (buffer_list[i] != arrival_order[i])
+         _total_packets_reordered ++;
+   }
+}
+
+bool
+DeterministicDelivery::replayNextPacket(vector<Byte*>& buffer_list)
+{
+   if (_next_replay_entry.sender == INVALID_TILE_ID)
+      return false;
+
+   // Packets from a sender arrive in the order they were sent, so the
+   // first pending packet from the logged sender is the one to deliver
+   while (true)
+   {
+      for (list<Byte*>::iterator it = _pending_buffer_list.begin(); it != _pending_buffer_list.end(); it++)
+      {
+         const NetPacket* packet = (const NetPacket*) *it;
+         if (TILE_ID(packet->sender) != _next_replay_entry.sender)
+            continue;
+
+         if ((packet->type != (PacketType) _next_replay_entry.type) || !(packet->time == _next_replay_entry.time))
+         {
+            LOG_PRINT_ERROR("Tile(%i): Packet(%llu) differs from the delivery log: "
+                            "logged sender(%i), type(%i), time(%llu ps), got type(%i), time(%llu ps)",
+                            _tile_id, (long long unsigned int) _total_packets_delivered,
+                            _next_replay_entry.sender, _next_replay_entry.type,
+                            (long long unsigned int) _next_replay_entry.time,
+                            (SInt32) packet->type, (long long unsigned int) packet->time.toPicosec());
+         }
+
+         if (it != _pending_buffer_list.begin())
+            _total_packets_reordered ++;
+         buffer_list.push_back(*it);
+         _pending_buffer_list.erase(it);
+         readNextReplayEntry();
+         return true;
+      }
+
+      _total_replay_stalls ++;
+      waitForPacket();
+   }
+}
+
+// Receives the next packet, giving up if none arrives within the stall timeout
+void
+DeterministicDelivery::waitForPacket()
+{
+   const UInt32 poll_interval = 100;   // In microseconds
+
+   UInt64 stall_start_time = getHostTime();
+   while (!_transport->query())
+   {
+      if ((getHostTime() - stall_start_time) >= ((UInt64) _replay_stall_timeout) * 1000)
+      {
+         LOG_PRINT_ERROR("Tile(%i): Packet(%llu) of the delivery log (sender(%i), type(%i), time(%llu ps)) "
+                         "did not arrive within %u ms, %u other packets pending",
+                         _tile_id, (long long unsigned int) _total_packets_delivered,
+                         _next_replay_entry.sender, _next_replay_entry.type,
+                         (long long unsigned int) _next_replay_entry.time,
+                         _replay_stall_timeout, (UInt32) _pending_buffer_list.size());
+      }
+      usleep(poll_interval);
+   }
+   _pending_buffer_list.push_back(_transport->recv());
+}
+
+void
+DeterministicDelivery::readNextReplayEntry()
+{
+   LogEntry entry;
+   if (_replay_file.read((char*) &entry.sender, sizeof(entry.sender)) &&
+       _replay_file.read((char*) &entry.type, sizeof(entry.type)) &&
+       _replay_file.read((char*) &entry.time, sizeof(entry.time)))
+   {
+      _next_replay_entry = entry;
+   }
+   else
+   {
+      LOG_PRINT("Tile(%i): End of the delivery log", _tile_id);
+      _next_replay_entry.sender = INVALID_TILE_ID;
+   }
+}
+
+void
+DeterministicDelivery::outputSummary(std::ostream& out)
+{
+   out << "  Deterministic Delivery: " << endl;
+   out << "    Packets Delivered: " << _total_packets_delivered << endl;
+   out << "    Packets Reordered: " << _total_packets_reordered << endl;
+   out << "    Replay Stalls: " << _total_replay_stalls << endl;
+   out << "    Host Time (in microseconds): " << _total_host_time << endl;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <fstream>
+#include <iostream>
+
+#include "fixed_types.h"
+#include "common_types.h"
+#include "transport.h"
+
+// Orders the packets a tile pulls from the transport when [deterministic] enabled = true,
+// instead of delivering them in the order the host threads happened to send them.
+//  - The packets waiting in the transport queue are delivered together, sorted by
+//    (simulated time, sender). Packets from one sender keep the order they were sent in.
+//  - log = record writes the sender, type and simulated time of every delivered packet to
+//    delivery_log_<tile>.bin in the output directory. log = replay delivers the packets in the
+//    order recorded by an earlier run (the log in replay_directory), holding back the packets
+//    that arrive early. The run stops with an error at the first packet that does not match
+//    the log, or if the logged packet does not arrive within replay_stall_timeout.
+//    Past the end of the log, packets are ordered as above.
+//  - Only the order in which packets reach the network queue of the tile is recorded. The packet
+//    netRecv() picks from that queue (the earliest matching one) depends on what has reached
+//    the queue when it is called, which is not recorded.
+class DeterministicDelivery
+{
+public:
+   enum LogMode
+   {
+      NO_LOG = 0,
+      RECORD_LOG,
+      REPLAY_LOG
+   };
+
+   DeterministicDelivery(tile_id_t tile_id, Transport::Node* transport);
+   ~DeterministicDelivery();
+
+   static bool isEnabled();
+
+   // Blocks until at least one packet can be delivered, and returns the buffers
+   // of the packets to deliver now, in order
+   void pull(std::vector<Byte*>& buffer_list);
+
+   void outputSummary(std::ostream& out);
+
+   static std::string getFilename(tile_id_t tile_id);
+
+private:
+   tile_id_t _tile_id;
+   Transport::Node* _transport;
+   LogMode _log_mode;
+
+   // Packets received from the transport but not delivered yet
+   std::list<Byte*> _pending_buffer_list;
+
+   // Delivered packet, as written to the log
+   struct LogEntry
+   {
+      tile_id_t sender;
+      SInt32 type;
+      UInt64 time;   // In picoseconds
+   };
+
+   std::ofstream _record_file;
+   std::ifstream _replay_file;
+   // Next packet to deliver when replaying (sender is INVALID_TILE_ID past the end of the log)
+   LogEntry _next_replay_entry;
+   // Time to wait for the next logged packet before giving up (in milliseconds)
+   UInt32 _replay_stall_timeout;
+
+   // Event Counters
+   UInt64 _total_packets_delivered;
+   UInt64 _total_packets_reordered;
+   UInt64 _total_replay_stalls;
+   // Host time spent ordering and replaying (not waiting for the first packet), in microseconds
+   UInt64 _total_host_time;
+
+   void receivePendingPackets();
+   void orderPendingPackets(std::vector<Byte*>& buffer_list);
+   bool replayNextPacket(std::vector<Byte*>& buffer_list);
+   void readNextReplayEntry();
+   void waitForPacket();
+
+   static LogMode parseLogMode(std::string log_mode);
+};
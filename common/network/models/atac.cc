@@ -525,8 +525,11 @@ NetworkModelAtac::routePacketOnONet(const NetPacket& pkt, tile_id_t pkt_sender,
 
       if (pkt_receiver == NetPacket::BROADCAST)
       {
+         // Multicast packets are only delivered to the receivers in this cluster
          for (vector<tile_id_t>::iterator it = tile_id_list.begin(); it != tile_id_list.end(); it++)
          {
+            if (pkt.isMulticast() && !pkt.isMulticastReceiver(*it))
+               continue;
             Hop hop(pkt, *it, RECEIVE_TILE, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
             next_hops.push(hop);
          }
@@ -0,0 +1,652 @@
+#include <math.h>
+using namespace std;
+
+#include "ecmesh.h"
+#include "tile.h"
+#include "simulator.h"
+#include "config.h"
+#include "utils.h"
+#include "packet_type.h"
+
+bool NetworkModelECMesh::_initialized = false;
+SInt32 NetworkModelECMesh::_mesh_width;
+SInt32 NetworkModelECMesh::_mesh_height;
+SInt32 NetworkModelECMesh::_concentration;
+SInt32 NetworkModelECMesh::_cluster_width;
+SInt32 NetworkModelECMesh::_cluster_height;
+SInt32 NetworkModelECMesh::_router_mesh_width;
+SInt32 NetworkModelECMesh::_router_mesh_height;
+bool NetworkModelECMesh::_contention_model_enabled;
+
+NetworkModelECMesh::NetworkModelECMesh(Network* net, SInt32 network_id)
+   : NetworkModel(net, network_id)
+   , _injection_router(NULL)
+   , _concentration_link(NULL)
+   , _cmesh_router(NULL)
+{
+   try
+   {
+      // Flit Width is specified in bits
+      _flit_width = Sim()->getCfg()->getInt("network/ecmesh/flit_width");
+
+      // Is broadcast tree enabled?
+      _has_broadcast_capability = Sim()->getCfg()->getBool("network/ecmesh/broadcast_tree_enabled");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Could not read ecmesh parameters from the configuration file");
+   }
+
+   // Initialize Topology Params
+   initializeECMeshTopologyParams();
+
+   // Create Router & Link Models
+   _num_cmesh_router_ports = NUM_MESH_DIRECTIONS + _concentration;
+   createRouterAndLinkModels();
+}
+
+NetworkModelECMesh::~NetworkModelECMesh()
+{
+   // Destroy the Router & Link Models
+   destroyRouterAndLinkModels();
+}
+
+// The cluster is as square as possible, wider than high
+bool
+NetworkModelECMesh::computeClusterDimensions(SInt32 concentration, SInt32& cluster_width, SInt32& cluster_height)
+{
+   if (concentration <= 0)
+      return false;
+   cluster_height = (SInt32) floor(sqrt(concentration));
+   cluster_width = concentration / cluster_height;
+   return (concentration == (cluster_width * cluster_height));
+}
+
+void
+NetworkModelECMesh::initializeECMeshTopologyParams()
+{
+   if (_initialized)
+      return;
+   _initialized = true;
+
+   try
+   {
+      _concentration = Sim()->getCfg()->getInt("network/ecmesh/concentration");
+      // Is contention model enabled?
+      _contention_model_enabled = Sim()->getCfg()->getBool("network/ecmesh/queue_model/enabled");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read parameters from the ecmesh section of the cfg file");
+   }
+
+   SInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
+
+   _mesh_width = (SInt32) floor (sqrt(num_application_tiles));
+   _mesh_height = (SInt32) ceil (1.0 * num_application_tiles / _mesh_width);
+   LOG_ASSERT_ERROR(num_application_tiles == (_mesh_width * _mesh_height),
+         "Num Application Tiles(%i), Mesh Width(%i), Mesh Height(%i)",
+         num_application_tiles, _mesh_width, _mesh_height);
+
+   __attribute__((unused)) bool valid = computeClusterDimensions(_concentration, _cluster_width, _cluster_height);
+   LOG_ASSERT_ERROR(valid && ((_mesh_width % _cluster_width) == 0) && ((_mesh_height % _cluster_height) == 0),
+         "Concentration(%i) does not tile a Mesh of Width(%i), Height(%i)",
+         _concentration, _mesh_width, _mesh_height);
+
+   _router_mesh_width = _mesh_width / _cluster_width;
+   _router_mesh_height = _mesh_height / _cluster_height;
+}
+
+void
+NetworkModelECMesh::createRouterAndLinkModels()
+{
+   if (isSystemTile(_tile_id))
+      return;
+
+   // Create Router & Link Models
+   // Router & Link are clocked at the same frequency
+
+   // Router
+   UInt64 router_delay = 0;
+   UInt32 num_flits_per_output_buffer = 0;
+   // Link
+   string link_type;
+   // Contention Model
+   string contention_model_type;
+   try
+   {
+      // Router Delay (pipeline delay) is specified in cycles
+      router_delay = (UInt64) Sim()->getCfg()->getInt("network/ecmesh/router/delay");
+      // Number of flits per port - used only for power modeling purposes now
+      num_flits_per_output_buffer = Sim()->getCfg()->getInt("network/ecmesh/router/num_flits_per_port_buffer");
+
+      // Link Parameters
+      link_type = Sim()->getCfg()->getString("network/ecmesh/link/type");
+
+      contention_model_type = Sim()->getCfg()->getString("network/ecmesh/queue_model/type");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read ecmesh router & link parameters from the cfg file");
+   }
+
+   // Create the injection port contention model first
+   _injection_router = new RouterModel(this, _frequency, _voltage,
+                                       1, 1,
+                                       4, 0, _flit_width,
+                                       _contention_model_enabled, contention_model_type);
+   // Concentration Link
+   _concentration_link = new ElectricalLinkModel(this, link_type,
+                                                 _frequency, _voltage,
+                                                 _tile_width, _flit_width);
+
+   if (!isRouterTile(_tile_id))
+      return;
+
+   // CMesh Router: the local ports take the packets of the concentration links
+   _cmesh_router = new RouterModel(this, _frequency, _voltage,
+                                   _num_cmesh_router_ports, _num_cmesh_router_ports,
+                                   num_flits_per_output_buffer, router_delay, _flit_width,
+                                   _contention_model_enabled, contention_model_type);
+   // CMesh Link List
+   // A mesh link spans a cluster
+   _cmesh_link_list.resize(_num_cmesh_router_ports);
+   for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+   {
+      double link_length = _tile_width;
+      if ((i == LEFT) || (i == RIGHT))
+         link_length = _cluster_width * _tile_width;
+      else if ((i == DOWN) || (i == UP))
+         link_length = _cluster_height * _tile_width;
+      _cmesh_link_list[i] = new ElectricalLinkModel(this, link_type,
+                                                    _frequency, _voltage,
+                                                    link_length, _flit_width);
+   }
+}
+
+void
+NetworkModelECMesh::destroyRouterAndLinkModels()
+{
+   if (isSystemTile(_tile_id))
+      return;
+
+   // Injection Port Router
+   delete _injection_router;
+   // Concentration Link
+   delete _concentration_link;
+
+   if (!isRouterTile(_tile_id))
+      return;
+
+   // CMesh Router
+   delete _cmesh_router;
+   // CMesh Link List
+   for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+      delete _cmesh_link_list[i];
+}
+
+void
+NetworkModelECMesh::routePacket(const NetPacket &pkt, queue<Hop> &next_hops)
+{
+   tile_id_t pkt_sender = TILE_ID(pkt.sender);
+   tile_id_t pkt_receiver = TILE_ID(pkt.receiver);
+
+   if (pkt.node_type == SEND_TILE)
+   {
+      UInt64 zero_load_delay = 0;
+      UInt64 contention_delay = 0;
+      _injection_router->processPacket(pkt, 0, zero_load_delay, contention_delay);
+      // Go to the router of the cluster
+      _concentration_link->processPacket(pkt, zero_load_delay);
+
+      SInt32 rx, ry;
+      computeRouterPosition(_tile_id, rx, ry);
+      Hop hop(pkt, computeRouterTileID(rx,ry), ECMESH, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+      next_hops.push(hop);
+   }
+
+   else if (pkt.node_type == ECMESH)
+   {
+      LOG_ASSERT_ERROR(isRouterTile(_tile_id), "Tile(%i) has no ecmesh router", _tile_id);
+
+      SInt32 cx, cy;
+      computeRouterPosition(_tile_id, cx, cy);
+
+      if (pkt_receiver == NetPacket::BROADCAST)
+      {
+         SInt32 sx, sy;
+         computeRouterPosition(pkt_sender, sx, sy);
+
+         list<NextDest> next_dest_list;
+
+         // A multicast packet only follows the branches of the broadcast tree
+         // that lead to at least one tile in its receiver set
+         bool multicast = pkt.isMulticast();
+
+         if ( (cy >= sy) && (!multicast || hasMulticastReceiver(pkt, cx, cx, cy+1, _router_mesh_height-1)) )
+            next_dest_list.push_back(NextDest(computeRouterTileID(cx,cy+1), UP, ECMESH));
+         if ( (cy <= sy) && (!multicast || hasMulticastReceiver(pkt, cx, cx, 0, cy-1)) )
+            next_dest_list.push_back(NextDest(computeRouterTileID(cx,cy-1), DOWN, ECMESH));
+         if (cy == sy)
+         {
+            if ( (cx >= sx) && (!multicast || hasMulticastReceiver(pkt, cx+1, _router_mesh_width-1, 0, _router_mesh_height-1)) )
+               next_dest_list.push_back(NextDest(computeRouterTileID(cx+1,cy), RIGHT, ECMESH));
+            if ( (cx <= sx) && (!multicast || hasMulticastReceiver(pkt, 0, cx-1, 0, _router_mesh_height-1)) )
+               next_dest_list.push_back(NextDest(computeRouterTileID(cx-1,cy), LEFT, ECMESH));
+         }
+         for (SInt32 i = 0; i < _concentration; i++)
+         {
+            tile_id_t local_tile_id = computeLocalTileID(cx, cy, i);
+            if (!multicast || pkt.isMulticastReceiver(local_tile_id))
+               next_dest_list.push_back(NextDest(local_tile_id, NUM_MESH_DIRECTIONS + i, RECEIVE_TILE));
+         }
+
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+
+         // Get the link delay as well as a vector of directions
+         // Remove the tile_ids' that are invalid
+         UInt64 max_link_delay = 0;
+         vector<SInt32> output_port_list;
+         for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); )
+         {
+            if ((*it)._tile_id != INVALID_TILE_ID)
+            {
+               SInt32 output_port = (*it)._output_port;
+               output_port_list.push_back(output_port);
+
+               UInt64 link_delay = 0;
+               _cmesh_link_list[output_port]->processPacket(pkt, link_delay);
+               max_link_delay = max<UInt64>(max_link_delay, link_delay);
+
+               it ++;
+            }
+            else
+            {
+               it = next_dest_list.erase(it);
+            }
+         }
+         // Nothing left to deliver (multicast to system tiles only)
+         if (next_dest_list.empty())
+            return;
+
+         // Update the zero_load_delay
+         zero_load_delay += max_link_delay;
+
+         // Get the router to process the packet
+         _cmesh_router->processPacket(pkt, output_port_list, zero_load_delay, contention_delay);
+
+         // Populate the next_hops queue
+         for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); it++)
+         {
+            Hop hop(pkt, (*it)._tile_id, (*it)._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+            next_hops.push(hop);
+         }
+      }
+
+      else // (pkt_receiver != NetPacket::BROADCAST)
+      {
+         SInt32 dx, dy;
+         computeRouterPosition(pkt_receiver, dx, dy);
+
+         NextDest next_dest;
+
+         if (cx > dx)
+            next_dest = NextDest(computeRouterTileID(cx-1,cy), LEFT, ECMESH);
+         else if (cx < dx)
+            next_dest = NextDest(computeRouterTileID(cx+1,cy), RIGHT, ECMESH);
+         else if (cy > dy)
+            next_dest = NextDest(computeRouterTileID(cx,cy-1), DOWN, ECMESH);
+         else if (cy < dy)
+            next_dest = NextDest(computeRouterTileID(cx,cy+1), UP, ECMESH);
+         else
+            next_dest = NextDest(pkt_receiver, NUM_MESH_DIRECTIONS + computeLocalIndex(pkt_receiver), RECEIVE_TILE);
+
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+
+         assert(next_dest._output_port >= 0 && next_dest._output_port < (SInt32) _cmesh_link_list.size());
+
+         // Go through router
+         _cmesh_router->processPacket(pkt, next_dest._output_port, zero_load_delay, contention_delay);
+         // Go through link
+         _cmesh_link_list[next_dest._output_port]->processPacket(pkt, zero_load_delay);
+
+         assert(next_dest._tile_id != INVALID_TILE_ID);
+         Hop hop(pkt, next_dest._tile_id, next_dest._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+         next_hops.push(hop);
+
+      } // (pkt_receiver == NetPacket::BROADCAST)
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Node Type(%i)", pkt.node_type);
+   }
+}
+
+void
+NetworkModelECMesh::computeRouterPosition(tile_id_t tile_id, SInt32 &x, SInt32 &y)
+{
+   x = (tile_id % _mesh_width) / _cluster_width;
+   y = (tile_id / _mesh_width) / _cluster_height;
+}
+
+tile_id_t
+NetworkModelECMesh::computeRouterTileID(SInt32 x, SInt32 y)
+{
+   if ( (x < 0) || (y < 0) || (x >= _router_mesh_width) || (y >= _router_mesh_height) )
+      return INVALID_TILE_ID;
+   else
+      return computeLocalTileID(x, y, 0);
+}
+
+tile_id_t
+NetworkModelECMesh::computeLocalTileID(SInt32 x, SInt32 y, SInt32 local_index)
+{
+   SInt32 tile_x = (x * _cluster_width) + (local_index % _cluster_width);
+   SInt32 tile_y = (y * _cluster_height) + (local_index / _cluster_width);
+   return (tile_y * _mesh_width + tile_x);
+}
+
+SInt32
+NetworkModelECMesh::computeLocalIndex(tile_id_t tile_id)
+{
+   SInt32 tile_x = tile_id % _mesh_width;
+   SInt32 tile_y = tile_id / _mesh_width;
+   return ((tile_y % _cluster_height) * _cluster_width) + (tile_x % _cluster_width);
+}
+
+bool
+NetworkModelECMesh::isRouterTile(tile_id_t tile_id)
+{
+   return (isApplicationTile(tile_id) && (computeLocalIndex(tile_id) == 0));
+}
+
+bool
+NetworkModelECMesh::hasMulticastReceiver(const NetPacket& pkt, SInt32 min_x, SInt32 max_x, SInt32 min_y, SInt32 max_y)
+{
+   for (SInt32 y = min_y; y <= max_y; y++)
+   {
+      for (SInt32 x = min_x; x <= max_x; x++)
+      {
+         for (SInt32 i = 0; i < _concentration; i++)
+         {
+            if (pkt.isMulticastReceiver(computeLocalTileID(x, y, i)))
+               return true;
+         }
+      }
+   }
+   return false;
+}
+
+// Router hops: the tiles of a cluster are at distance 0 from each other
+SInt32
+NetworkModelECMesh::computeDistance(tile_id_t sender, tile_id_t receiver)
+{
+   SInt32 sx, sy, dx, dy;
+   computeRouterPosition(sender, sx, sy);
+   computeRouterPosition(receiver, dx, dy);
+
+   return abs(sx-dx) + abs(sy-dy);
+}
+
+void
+NetworkModelECMesh::outputSummary(ostream &out, const Time& target_completion_time)
+{
+   NetworkModel::outputSummary(out, target_completion_time);
+   outputPowerSummary(out, target_completion_time);
+   outputEventCountSummary(out);
+   if (_contention_model_enabled)
+      outputContentionModelsSummary(out);
+}
+
+bool
+NetworkModelECMesh::isTileCountPermissible(SInt32 tile_count)
+{
+   SInt32 mesh_width = (SInt32) floor (sqrt(tile_count));
+   SInt32 mesh_height = (SInt32) ceil (1.0 * tile_count / mesh_width);
+
+   if (tile_count != (mesh_width * mesh_height))
+   {
+      fprintf(stderr, "ERROR: Tile Count(%i) != Mesh Width(%i) * Mesh Height(%i)\n", tile_count, mesh_width, mesh_height);
+      return false;
+   }
+
+   SInt32 concentration = 0;
+   try
+   {
+      concentration = Sim()->getCfg()->getInt("network/ecmesh/concentration");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read network/ecmesh/concentration from the cfg file");
+   }
+
+   SInt32 cluster_width, cluster_height;
+   if ( !computeClusterDimensions(concentration, cluster_width, cluster_height) ||
+        ((mesh_width % cluster_width) != 0) || ((mesh_height % cluster_height) != 0) )
+   {
+      fprintf(stderr, "ERROR: Concentration(%i) does not tile a Mesh of Width(%i), Height(%i)\n",
+              concentration, mesh_width, mesh_height);
+      return false;
+   }
+   return true;
+}
+
+pair<bool, vector<tile_id_t> >
+NetworkModelECMesh::computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count)
+{
+   // Initialize mesh, cluster and router mesh dimensions
+   initializeECMeshTopologyParams();
+
+   // Spread the clusters with memory controllers over a grid of equal blocks of the router mesh
+   // (one at the center of each block), with as few controllers as possible per cluster
+   SInt32 num_routers = _router_mesh_width * _router_mesh_height;
+   SInt32 memory_controllers_per_cluster = (num_memory_controllers + num_routers - 1) / num_routers;
+   SInt32 num_clusters_with_memory_controllers = (num_memory_controllers + memory_controllers_per_cluster - 1) / memory_controllers_per_cluster;
+
+   vector<tile_id_t> tile_id_list_with_memory_controllers;
+   SInt32 memory_controller_mesh_width = (SInt32) floor(sqrt(num_clusters_with_memory_controllers));
+   SInt32 memory_controller_mesh_height = (SInt32) ceil(1.0 * num_clusters_with_memory_controllers / memory_controller_mesh_width);
+
+   SInt32 num_computed_memory_controllers = 0;
+   for (SInt32 j = 0; j < (memory_controller_mesh_height) && (num_computed_memory_controllers < num_memory_controllers); j++)
+   {
+      for (SInt32 i = 0; (i < memory_controller_mesh_width) && (num_computed_memory_controllers < num_memory_controllers); i++)
+      {
+         SInt32 size_x = _router_mesh_width / memory_controller_mesh_width;
+         SInt32 size_y = _router_mesh_height / memory_controller_mesh_height;
+         SInt32 base_x = i * size_x;
+         SInt32 base_y = j * size_y;
+
+         if (i == (memory_controller_mesh_width-1))
+            size_x = _router_mesh_width - ((memory_controller_mesh_width-1) * size_x);
+         if (j == (memory_controller_mesh_height-1))
+            size_y = _router_mesh_height - ((memory_controller_mesh_height-1) * size_y);
+
+         for (SInt32 k = 0; (k < memory_controllers_per_cluster) && (num_computed_memory_controllers < num_memory_controllers); k++)
+         {
+            tile_id_list_with_memory_controllers.push_back(computeLocalTileID(base_x + size_x/2, base_y + size_y/2, k));
+            num_computed_memory_controllers ++;
+         }
+      }
+   }
+
+   return (make_pair(true, tile_id_list_with_memory_controllers));
+}
+
+pair<bool, vector<Config::TileList> >
+NetworkModelECMesh::computeProcessToTileMapping()
+{
+   // Initialize mesh, cluster and router mesh dimensions
+   initializeECMeshTopologyParams();
+
+   // Clusters are filled before moving to the next router
+   return (make_pair(true, computeDistanceAwareProcessToTileMapping(_mesh_width * _mesh_height, computeDistance)));
+}
+
+void
+NetworkModelECMesh::outputEventCountSummary(ostream& out)
+{
+   out << "    Event Counters:" << endl;
+
+   if (isApplicationTile(_tile_id) && isRouterTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << _cmesh_router->getTotalBufferWrites() << endl;
+      out << "      Buffer Reads: " << _cmesh_router->getTotalBufferReads() << endl;
+      out << "      Switch Allocator Requests: " << _cmesh_router->getTotalSwitchAllocatorRequests() << endl;
+      for (SInt32 i = 1; i <= _num_cmesh_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << _cmesh_router->getTotalCrossbarTraversals(i) << endl;
+
+      UInt64 total_link_traversals = 0;
+      for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+         total_link_traversals += _cmesh_link_list[i]->getTotalTraversals();
+      out << "      Link Traversals: " << total_link_traversals << endl;
+      out << "      Concentration Link Traversals: " << _concentration_link->getTotalTraversals() << endl;
+   }
+
+   else if (isApplicationTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << endl;
+      out << "      Buffer Reads: " << endl;
+      out << "      Switch Allocator Requests: " << endl;
+      for (SInt32 i = 1; i <= _num_cmesh_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << endl;
+      out << "      Link Traversals: " << endl;
+      out << "      Concentration Link Traversals: " << _concentration_link->getTotalTraversals() << endl;
+   }
+
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << endl;
+      out << "      Buffer Reads: " << endl;
+      out << "      Switch Allocator Requests: " << endl;
+      for (SInt32 i = 1; i <= _num_cmesh_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << endl;
+      out << "      Link Traversals: " << endl;
+      out << "      Concentration Link Traversals: " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelECMesh::outputContentionModelsSummary(ostream& out)
+{
+   out << "    Contention Counters:" << endl;
+
+   if (isApplicationTile(_tile_id) && isRouterTile(_tile_id))
+   {
+      out << "      Average ECMesh Router Contention Delay: " << _cmesh_router->getAverageContentionDelay(0, _num_cmesh_router_ports-1) << endl;
+      out << "      Average ECMesh Router Link Utilization: " << _cmesh_router->getAverageLinkUtilization(0, _num_cmesh_router_ports-1) << endl;
+      out << "      Analytical Models Used (%): " << _cmesh_router->getPercentAnalyticalModelsUsed(0, _num_cmesh_router_ports-1) << endl;
+   }
+
+   else if (isApplicationTile(_tile_id) || isSystemTile(_tile_id))
+   {
+      out << "      Average ECMesh Router Contention Delay: " << endl;
+      out << "      Average ECMesh Router Link Utilization: " << endl;
+      out << "      Analytical Models Used (%): " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelECMesh::outputPowerSummary(ostream& out, const Time& target_completion_time)
+{
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
+   // Output to sim.out
+   out << "    Power Model Statistics: " << endl;
+   if (isApplicationTile(_tile_id))
+   {
+      // Convert time into seconds
+      double target_completion_sec = target_completion_time.toSec();
+
+      // Compute the final leakage/dynamic energy
+      computeEnergy(target_completion_time);
+
+      double static_energy = getStaticEnergy();
+      double dynamic_energy = getDynamicEnergy();
+      out << "      Average Static Power (in W): " << static_energy / target_completion_sec << endl;
+      out << "      Average Dynamic Power (in W): " << dynamic_energy / target_completion_sec << endl;
+      out << "      Total Static Energy (in J): " << static_energy << endl;
+      out << "      Total Dynamic Energy (in J): " << dynamic_energy << endl;
+   }
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Average Static Power (in W): " << endl;
+      out << "      Average Dynamic Power (in W): " << endl;
+      out << "      Total Static Energy (in J): " << endl;
+      out << "      Total Dynamic Energy (in J): " << endl;
+   }
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelECMesh::setDVFS(double frequency, double voltage, const Time& curr_time)
+{
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
+   _concentration_link->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+   if (!isRouterTile(_tile_id))
+      return;
+
+   _cmesh_router->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+   for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+      _cmesh_link_list[i]->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+}
+
+void
+NetworkModelECMesh::computeEnergy(const Time& curr_time)
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   _concentration_link->getPowerModel()->computeEnergy(curr_time);
+   if (!isRouterTile(_tile_id))
+      return;
+
+   _cmesh_router->getPowerModel()->computeEnergy(curr_time);
+   for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+      _cmesh_link_list[i]->getPowerModel()->computeEnergy(curr_time);
+}
+
+double
+NetworkModelECMesh::getDynamicEnergy()
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   double dynamic_energy = _concentration_link->getPowerModel()->getDynamicEnergy();
+   if (!isRouterTile(_tile_id))
+      return dynamic_energy;
+
+   dynamic_energy += _cmesh_router->getPowerModel()->getDynamicEnergy();
+   for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+      dynamic_energy += _cmesh_link_list[i]->getPowerModel()->getDynamicEnergy();
+   return dynamic_energy;
+}
+
+double
+NetworkModelECMesh::getStaticEnergy()
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   double static_energy = _concentration_link->getPowerModel()->getStaticEnergy();
+   if (!isRouterTile(_tile_id))
+      return static_energy;
+
+   static_energy += _cmesh_router->getPowerModel()->getStaticEnergy();
+   for (SInt32 i = 0; i < _num_cmesh_router_ports; i++)
+      static_energy += _cmesh_link_list[i]->getPowerModel()->getStaticEnergy();
+   return static_energy;
+}
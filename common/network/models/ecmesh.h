@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <iostream>
+using std::vector;
+using std::pair;
+using std::ostream;
+
+#include "network.h"
+#include "network_model.h"
+#include "fixed_types.h"
+#include "queue_model.h"
+#include "router_model.h"
+#include "electrical_link_model.h"
+
+// Electrical Concentrated Mesh
+//  - The tiles are grouped into rectangular clusters of 'concentration' tiles that share a
+//    router. The routers form a mesh and use dimension-order routing (X, then Y).
+//  - The router of a cluster is modeled on the lowest tile of the cluster (the router tile).
+//    Every tile has a concentration link to the router, and the router has a local port
+//    (and ejection link) for every tile of the cluster.
+class NetworkModelECMesh : public NetworkModel
+{
+public:
+   NetworkModelECMesh(Network* net, SInt32 network_id);
+   ~NetworkModelECMesh();
+
+   void outputSummary(std::ostream &out, const Time& target_completion_time);
+
+   // Energy computation
+   void computeEnergy(const Time& curr_time);
+   double getDynamicEnergy();
+   double getStaticEnergy();
+
+   static bool isTileCountPermissible(SInt32 tile_count);
+   static pair<bool,vector<tile_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count);
+   static pair<bool,vector<Config::TileList> > computeProcessToTileMapping();
+
+private:
+   enum NodeType
+   {
+      ECMESH = 2 // Always Start at 2
+   };
+
+   // The local ports (one per tile of the cluster) follow the mesh ports
+   enum OutputDirection
+   {
+      LEFT = 0,
+      RIGHT,
+      DOWN,
+      UP,
+      NUM_MESH_DIRECTIONS
+   };
+
+   // Fields
+   static bool _initialized;
+   // Tiles are laid out row by row on a mesh of _mesh_width x _mesh_height tiles
+   static SInt32 _mesh_width;
+   static SInt32 _mesh_height;
+   // Each cluster is _cluster_width x _cluster_height tiles
+   static SInt32 _concentration;
+   static SInt32 _cluster_width;
+   static SInt32 _cluster_height;
+   // Routers are laid out on a mesh of _router_mesh_width x _router_mesh_height
+   static SInt32 _router_mesh_width;
+   static SInt32 _router_mesh_height;
+
+   // Is contention model enabled?
+   static bool _contention_model_enabled;
+
+   // Injection Router & link from the tile to the router of its cluster
+   RouterModel* _injection_router;
+   ElectricalLinkModel* _concentration_link;
+
+   // Router & Link Parameters (only on the router tile of a cluster)
+   SInt32 _num_cmesh_router_ports;
+   RouterModel* _cmesh_router;
+   // Mesh links, then the ejection links to the tiles of the cluster
+   vector<ElectricalLinkModel*> _cmesh_link_list;
+
+   // Routing Function
+   void routePacket(const NetPacket &pkt, queue<Hop> &next_hops);
+
+   // DVFS
+   void setDVFS(double frequency, double voltage, const Time& curr_time);
+
+   // Toplogy Params
+   static void initializeECMeshTopologyParams();
+   static bool computeClusterDimensions(SInt32 concentration, SInt32& cluster_width, SInt32& cluster_height);
+
+   // Router & Link Models
+   void createRouterAndLinkModels();
+   void destroyRouterAndLinkModels();
+
+   // Utilities
+   static SInt32 computeDistance(tile_id_t sender, tile_id_t receiver);
+   static void computeRouterPosition(tile_id_t tile, SInt32 &x, SInt32 &y);
+   static tile_id_t computeRouterTileID(SInt32 x, SInt32 y);
+   static tile_id_t computeLocalTileID(SInt32 x, SInt32 y, SInt32 local_index);
+   static SInt32 computeLocalIndex(tile_id_t tile);
+   bool isRouterTile(tile_id_t tile);
+   // Is any tile attached to a router in the (inclusive) region a receiver of the multicast packet?
+   static bool hasMulticastReceiver(const NetPacket& pkt, SInt32 min_x, SInt32 max_x, SInt32 min_y, SInt32 max_y);
+
+   void outputPowerSummary(ostream& out, const Time& target_completion_time);
+   void outputEventCountSummary(ostream& out);
+   void outputContentionModelsSummary(ostream& out);
+};
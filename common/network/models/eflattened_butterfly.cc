@@ -0,0 +1,514 @@
+#include <math.h>
+using namespace std;
+
+#include "eflattened_butterfly.h"
+#include "tile.h"
+#include "simulator.h"
+#include "config.h"
+#include "utils.h"
+#include "packet_type.h"
+
+bool NetworkModelEFlattenedButterfly::_initialized = false;
+SInt32 NetworkModelEFlattenedButterfly::_mesh_width;
+SInt32 NetworkModelEFlattenedButterfly::_mesh_height;
+bool NetworkModelEFlattenedButterfly::_contention_model_enabled;
+
+NetworkModelEFlattenedButterfly::NetworkModelEFlattenedButterfly(Network* net, SInt32 network_id)
+   : NetworkModel(net, network_id)
+{
+   try
+   {
+      // Flit Width is specified in bits
+      _flit_width = Sim()->getCfg()->getInt("network/eflattened_butterfly/flit_width");
+
+      // Is broadcast tree enabled?
+      _has_broadcast_capability = Sim()->getCfg()->getBool("network/eflattened_butterfly/broadcast_tree_enabled");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Could not read eflattened_butterfly parameters from the configuration file");
+   }
+
+   // Initialize Topology Params
+   initializeEFlattenedButterflyTopologyParams();
+
+   // Create Router & Link Models
+   _num_router_ports = 1 + (_mesh_width-1) + (_mesh_height-1);
+   createRouterAndLinkModels();
+}
+
+NetworkModelEFlattenedButterfly::~NetworkModelEFlattenedButterfly()
+{
+   // Destroy the Router & Link Models
+   destroyRouterAndLinkModels();
+}
+
+void
+NetworkModelEFlattenedButterfly::initializeEFlattenedButterflyTopologyParams()
+{
+   if (_initialized)
+      return;
+   _initialized = true;
+
+   SInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
+
+   _mesh_width = (SInt32) floor (sqrt(num_application_tiles));
+   _mesh_height = (SInt32) ceil (1.0 * num_application_tiles / _mesh_width);
+   LOG_ASSERT_ERROR(num_application_tiles == (_mesh_width * _mesh_height),
+         "Num Application Tiles(%i), Mesh Width(%i), Mesh Height(%i)",
+         num_application_tiles, _mesh_width, _mesh_height);
+
+   try
+   {
+      // Is contention model enabled?
+      _contention_model_enabled = Sim()->getCfg()->getBool("network/eflattened_butterfly/queue_model/enabled");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read parameters from the eflattened_butterfly section of the cfg file");
+   }
+}
+
+void
+NetworkModelEFlattenedButterfly::createRouterAndLinkModels()
+{
+   if (isSystemTile(_tile_id))
+      return;
+
+   // Create Router & Link Models
+   // Router & Link are clocked at the same frequency
+
+   // Router
+   UInt64 router_delay = 0;
+   UInt32 num_flits_per_output_buffer = 0;
+   // Link
+   string link_type;
+   // Contention Model
+   string contention_model_type;
+   try
+   {
+      // Router Delay (pipeline delay) is specified in cycles
+      router_delay = (UInt64) Sim()->getCfg()->getInt("network/eflattened_butterfly/router/delay");
+      // Number of flits per port - used only for power modeling purposes now
+      num_flits_per_output_buffer = Sim()->getCfg()->getInt("network/eflattened_butterfly/router/num_flits_per_port_buffer");
+
+      // Link Parameters
+      link_type = Sim()->getCfg()->getString("network/eflattened_butterfly/link/type");
+
+      contention_model_type = Sim()->getCfg()->getString("network/eflattened_butterfly/queue_model/type");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read eflattened_butterfly router & link parameters from the cfg file");
+   }
+
+   // Create the injection port contention model first
+   _injection_router = new RouterModel(this, _frequency, _voltage,
+                                       1, 1,
+                                       4, 0, _flit_width,
+                                       _contention_model_enabled, contention_model_type);
+   // Router
+   _router = new RouterModel(this, _frequency, _voltage,
+                             _num_router_ports, _num_router_ports,
+                             num_flits_per_output_buffer, router_delay, _flit_width,
+                             _contention_model_enabled, contention_model_type);
+   // Link List
+   SInt32 cx, cy;
+   computePosition(_tile_id, cx, cy);
+   _link_list.resize(_num_router_ports);
+   _link_list[SELF] = new ElectricalLinkModel(this, link_type,
+                                              _frequency, _voltage,
+                                              _tile_width, _flit_width);
+   for (SInt32 x = 0; x < _mesh_width; x++)
+   {
+      if (x == cx)
+         continue;
+      _link_list[computeRowPort(cx, x)] = new ElectricalLinkModel(this, link_type,
+                                                                  _frequency, _voltage,
+                                                                  abs(x - cx) * _tile_width, _flit_width);
+   }
+   for (SInt32 y = 0; y < _mesh_height; y++)
+   {
+      if (y == cy)
+         continue;
+      _link_list[computeColumnPort(cy, y)] = new ElectricalLinkModel(this, link_type,
+                                                                     _frequency, _voltage,
+                                                                     abs(y - cy) * _tile_width, _flit_width);
+   }
+}
+
+void
+NetworkModelEFlattenedButterfly::destroyRouterAndLinkModels()
+{
+   if (isSystemTile(_tile_id))
+      return;
+
+   // Injection Port Router
+   delete _injection_router;
+   // Router
+   delete _router;
+   // Link List
+   for (SInt32 i = 0; i < _num_router_ports; i++)
+      delete _link_list[i];
+}
+
+void
+NetworkModelEFlattenedButterfly::routePacket(const NetPacket &pkt, queue<Hop> &next_hops)
+{
+   tile_id_t pkt_sender = TILE_ID(pkt.sender);
+   tile_id_t pkt_receiver = TILE_ID(pkt.receiver);
+
+   if (pkt.node_type == SEND_TILE)
+   {
+      UInt64 zero_load_delay = 0;
+      UInt64 contention_delay = 0;
+      _injection_router->processPacket(pkt, 0, zero_load_delay, contention_delay);
+
+      Hop hop(pkt, _tile_id, EFLATTENED_BUTTERFLY, Latency(0,_frequency), Latency(contention_delay,_frequency));
+      next_hops.push(hop);
+   }
+
+   else if (pkt.node_type == EFLATTENED_BUTTERFLY)
+   {
+      SInt32 cx, cy;
+      computePosition(_tile_id, cx, cy);
+
+      if (pkt_receiver == NetPacket::BROADCAST)
+      {
+         SInt32 sx, sy;
+         computePosition(pkt_sender, sx, sy);
+
+         list<NextDest> next_dest_list;
+
+         // A multicast packet only follows the branches of the broadcast tree
+         // that lead to at least one tile in its receiver set
+         bool multicast = pkt.isMulticast();
+
+         // The sender sends to every tile of its row, which sends to every tile of its column
+         if ((cy == sy) && (cx == sx))
+         {
+            for (SInt32 x = 0; x < _mesh_width; x++)
+            {
+               if ( (x != cx) && (!multicast || hasMulticastReceiverInColumn(pkt, x)) )
+                  next_dest_list.push_back(NextDest(computeTileID(x,cy), computeRowPort(cx,x), EFLATTENED_BUTTERFLY));
+            }
+         }
+         if (cy == sy)
+         {
+            for (SInt32 y = 0; y < _mesh_height; y++)
+            {
+               if ( (y != cy) && (!multicast || pkt.isMulticastReceiver(computeTileID(cx,y))) )
+                  next_dest_list.push_back(NextDest(computeTileID(cx,y), computeColumnPort(cy,y), EFLATTENED_BUTTERFLY));
+            }
+         }
+         if (!multicast || pkt.isMulticastReceiver(_tile_id))
+            next_dest_list.push_back(NextDest(_tile_id, SELF, RECEIVE_TILE));
+
+         // Nothing left to deliver (multicast to system tiles only)
+         if (next_dest_list.empty())
+            return;
+
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+
+         // Get the link delay as well as a vector of directions
+         UInt64 max_link_delay = 0;
+         vector<SInt32> output_port_list;
+         for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); it++)
+         {
+            SInt32 output_port = (*it)._output_port;
+            output_port_list.push_back(output_port);
+
+            UInt64 link_delay = 0;
+            _link_list[output_port]->processPacket(pkt, link_delay);
+            max_link_delay = max<UInt64>(max_link_delay, link_delay);
+         }
+
+         // Update the zero_load_delay
+         zero_load_delay += max_link_delay;
+
+         // Get the router to process the packet
+         _router->processPacket(pkt, output_port_list, zero_load_delay, contention_delay);
+
+         // Populate the next_hops queue
+         for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); it++)
+         {
+            Hop hop(pkt, (*it)._tile_id, (*it)._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+            next_hops.push(hop);
+         }
+      }
+
+      else // (pkt_receiver != NetPacket::BROADCAST)
+      {
+         SInt32 dx, dy;
+         computePosition(pkt_receiver, dx, dy);
+
+         NextDest next_dest;
+
+         if (cx != dx)
+            next_dest = NextDest(computeTileID(dx,cy), computeRowPort(cx,dx), EFLATTENED_BUTTERFLY);
+         else if (cy != dy)
+            next_dest = NextDest(computeTileID(cx,dy), computeColumnPort(cy,dy), EFLATTENED_BUTTERFLY);
+         else
+            next_dest = NextDest(_tile_id, SELF, RECEIVE_TILE);
+
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+
+         assert(next_dest._output_port >= 0 && next_dest._output_port < (SInt32) _link_list.size());
+
+         // Go through router
+         _router->processPacket(pkt, next_dest._output_port, zero_load_delay, contention_delay);
+         // Go through link
+         _link_list[next_dest._output_port]->processPacket(pkt, zero_load_delay);
+
+         Hop hop(pkt, next_dest._tile_id, next_dest._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+         next_hops.push(hop);
+
+      } // (pkt_receiver == NetPacket::BROADCAST)
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Node Type(%i)", pkt.node_type);
+   }
+}
+
+void
+NetworkModelEFlattenedButterfly::computePosition(tile_id_t tile_id, SInt32 &x, SInt32 &y)
+{
+   x = tile_id % _mesh_width;
+   y = tile_id / _mesh_width;
+}
+
+tile_id_t
+NetworkModelEFlattenedButterfly::computeTileID(SInt32 x, SInt32 y)
+{
+   return (y * _mesh_width + x);
+}
+
+SInt32
+NetworkModelEFlattenedButterfly::computeRowPort(SInt32 cx, SInt32 x)
+{
+   assert(x != cx);
+   return 1 + ((x < cx) ? x : (x-1));
+}
+
+SInt32
+NetworkModelEFlattenedButterfly::computeColumnPort(SInt32 cy, SInt32 y)
+{
+   assert(y != cy);
+   return _mesh_width + ((y < cy) ? y : (y-1));
+}
+
+bool
+NetworkModelEFlattenedButterfly::hasMulticastReceiverInColumn(const NetPacket& pkt, SInt32 x)
+{
+   for (SInt32 y = 0; y < _mesh_height; y++)
+   {
+      if (pkt.isMulticastReceiver(computeTileID(x,y)))
+         return true;
+   }
+   return false;
+}
+
+// Router-to-router hops
+SInt32
+NetworkModelEFlattenedButterfly::computeDistance(tile_id_t sender, tile_id_t receiver)
+{
+   SInt32 sx, sy, dx, dy;
+   computePosition(sender, sx, sy);
+   computePosition(receiver, dx, dy);
+
+   return ((sx != dx) ? 1 : 0) + ((sy != dy) ? 1 : 0);
+}
+
+void
+NetworkModelEFlattenedButterfly::outputSummary(ostream &out, const Time& target_completion_time)
+{
+   NetworkModel::outputSummary(out, target_completion_time);
+   outputPowerSummary(out, target_completion_time);
+   outputEventCountSummary(out);
+   if (_contention_model_enabled)
+      outputContentionModelsSummary(out);
+}
+
+bool
+NetworkModelEFlattenedButterfly::isTileCountPermissible(SInt32 tile_count)
+{
+   SInt32 mesh_width = (SInt32) floor (sqrt(tile_count));
+   SInt32 mesh_height = (SInt32) ceil (1.0 * tile_count / mesh_width);
+
+   if (tile_count != (mesh_width * mesh_height))
+   {
+      fprintf(stderr, "ERROR: Tile Count(%i) != Mesh Width(%i) * Mesh Height(%i)\n", tile_count, mesh_width, mesh_height);
+      return false;
+   }
+   return true;
+}
+
+pair<bool, vector<tile_id_t> >
+NetworkModelEFlattenedButterfly::computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count)
+{
+   // Initialize mesh_width, mesh_height
+   initializeEFlattenedButterflyTopologyParams();
+
+   // Every tile is at most one hop away from the rows and columns of the memory controllers,
+   // so spread them along the diagonals to have as many distinct rows and columns as possible
+   vector<tile_id_t> tile_id_list_with_memory_controllers;
+   SInt32 num_tiles = _mesh_width * _mesh_height;
+   for (SInt32 i = 0; i < num_memory_controllers; i++)
+   {
+      SInt32 position = (SInt32) ((1.0 * i * num_tiles) / num_memory_controllers);
+      SInt32 y = position / _mesh_width;
+      SInt32 x = (position + y) % _mesh_width;
+      tile_id_list_with_memory_controllers.push_back(computeTileID(x,y));
+   }
+
+   return (make_pair(true, tile_id_list_with_memory_controllers));
+}
+
+pair<bool, vector<Config::TileList> >
+NetworkModelEFlattenedButterfly::computeProcessToTileMapping()
+{
+   // Initialize mesh_width, mesh_height
+   initializeEFlattenedButterflyTopologyParams();
+
+   return (make_pair(true, computeDistanceAwareProcessToTileMapping(_mesh_width * _mesh_height, computeDistance)));
+}
+
+void
+NetworkModelEFlattenedButterfly::outputEventCountSummary(ostream& out)
+{
+   out << "    Event Counters:" << endl;
+
+   if (isApplicationTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << _router->getTotalBufferWrites() << endl;
+      out << "      Buffer Reads: " << _router->getTotalBufferReads() << endl;
+      out << "      Switch Allocator Requests: " << _router->getTotalSwitchAllocatorRequests() << endl;
+      for (SInt32 i = 1; i <= _num_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << _router->getTotalCrossbarTraversals(i) << endl;
+
+      UInt64 total_link_traversals = 0;
+      for (SInt32 i = 0; i < _num_router_ports; i++)
+         total_link_traversals += _link_list[i]->getTotalTraversals();
+      out << "      Link Traversals: " << total_link_traversals << endl;
+   }
+
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << endl;
+      out << "      Buffer Reads: " << endl;
+      out << "      Switch Allocator Requests: " << endl;
+      for (SInt32 i = 1; i <= _num_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << endl;
+      out << "      Link Traversals: " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelEFlattenedButterfly::outputContentionModelsSummary(ostream& out)
+{
+   out << "    Contention Counters:" << endl;
+
+   if (isApplicationTile(_tile_id))
+   {
+      out << "      Average EFlattenedButterfly Router Contention Delay: " << _router->getAverageContentionDelay(0, _num_router_ports-1) << endl;
+      out << "      Average EFlattenedButterfly Router Link Utilization: " << _router->getAverageLinkUtilization(0, _num_router_ports-1) << endl;
+      out << "      Analytical Models Used (%): " << _router->getPercentAnalyticalModelsUsed(0, _num_router_ports-1) << endl;
+   }
+
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Average EFlattenedButterfly Router Contention Delay: " << endl;
+      out << "      Average EFlattenedButterfly Router Link Utilization: " << endl;
+      out << "      Analytical Models Used (%): " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelEFlattenedButterfly::outputPowerSummary(ostream& out, const Time& target_completion_time)
+{
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
+   // Output to sim.out
+   out << "    Power Model Statistics: " << endl;
+   if (isApplicationTile(_tile_id))
+   {
+      // Convert time into seconds
+      double target_completion_sec = target_completion_time.toSec();
+
+      // Compute the final leakage/dynamic energy
+      computeEnergy(target_completion_time);
+
+      double static_energy = getStaticEnergy();
+      double dynamic_energy = getDynamicEnergy();
+      out << "      Average Static Power (in W): " << static_energy / target_completion_sec << endl;
+      out << "      Average Dynamic Power (in W): " << dynamic_energy / target_completion_sec << endl;
+      out << "      Total Static Energy (in J): " << static_energy << endl;
+      out << "      Total Dynamic Energy (in J): " << dynamic_energy << endl;
+   }
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Average Static Power (in W): " << endl;
+      out << "      Average Dynamic Power (in W): " << endl;
+      out << "      Total Static Energy (in J): " << endl;
+      out << "      Total Dynamic Energy (in J): " << endl;
+   }
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelEFlattenedButterfly::setDVFS(double frequency, double voltage, const Time& curr_time)
+{
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
+   _router->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+   for (SInt32 i = 0; i < _num_router_ports; i++)
+      _link_list[i]->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+}
+
+void
+NetworkModelEFlattenedButterfly::computeEnergy(const Time& curr_time)
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   _router->getPowerModel()->computeEnergy(curr_time);
+   for (SInt32 i = 0; i < _num_router_ports; i++)
+      _link_list[i]->getPowerModel()->computeEnergy(curr_time);
+}
+
+double
+NetworkModelEFlattenedButterfly::getDynamicEnergy()
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   double dynamic_energy = _router->getPowerModel()->getDynamicEnergy();
+   for (SInt32 i = 0; i < _num_router_ports; i++)
+      dynamic_energy += _link_list[i]->getPowerModel()->getDynamicEnergy();
+   return dynamic_energy;
+}
+
+double
+NetworkModelEFlattenedButterfly::getStaticEnergy()
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   double static_energy = _router->getPowerModel()->getStaticEnergy();
+   for (SInt32 i = 0; i < _num_router_ports; i++)
+      static_energy += _link_list[i]->getPowerModel()->getStaticEnergy();
+   return static_energy;
+}
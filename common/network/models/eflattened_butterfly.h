@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <iostream>
+using std::vector;
+using std::pair;
+using std::ostream;
+
+#include "network.h"
+#include "network_model.h"
+#include "fixed_types.h"
+#include "queue_model.h"
+#include "router_model.h"
+#include "electrical_link_model.h"
+
+// Electrical 2D Flattened Butterfly
+//  - The router of a tile has a direct link to every other tile of its row and of its column,
+//    so that a packet reaches any tile in at most two hops (first along the row, then along
+//    the column). A link is as long as the distance it spans.
+class NetworkModelEFlattenedButterfly : public NetworkModel
+{
+public:
+   NetworkModelEFlattenedButterfly(Network* net, SInt32 network_id);
+   ~NetworkModelEFlattenedButterfly();
+
+   void outputSummary(std::ostream &out, const Time& target_completion_time);
+
+   // Energy computation
+   void computeEnergy(const Time& curr_time);
+   double getDynamicEnergy();
+   double getStaticEnergy();
+
+   static bool isTileCountPermissible(SInt32 tile_count);
+   static pair<bool,vector<tile_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count);
+   static pair<bool,vector<Config::TileList> > computeProcessToTileMapping();
+
+private:
+   enum NodeType
+   {
+      EFLATTENED_BUTTERFLY = 2 // Always Start at 2
+   };
+
+   // Port 0 is SELF, followed by the row ports (one per other tile of the row)
+   // and the column ports (one per other tile of the column)
+   static const SInt32 SELF = 0;
+
+   // Fields
+   static bool _initialized;
+   static SInt32 _mesh_width;
+   static SInt32 _mesh_height;
+
+   // Is contention model enabled?
+   static bool _contention_model_enabled;
+
+   // Injection Router
+   RouterModel* _injection_router;
+
+   // Router & Link Parameters
+   SInt32 _num_router_ports;
+   RouterModel* _router;
+   vector<ElectricalLinkModel*> _link_list;
+
+   // Routing Function
+   void routePacket(const NetPacket &pkt, queue<Hop> &next_hops);
+
+   // DVFS
+   void setDVFS(double frequency, double voltage, const Time& curr_time);
+
+   // Toplogy Params
+   static void initializeEFlattenedButterflyTopologyParams();
+
+   // Router & Link Models
+   void createRouterAndLinkModels();
+   void destroyRouterAndLinkModels();
+
+   // Utilities
+   static SInt32 computeDistance(tile_id_t sender, tile_id_t receiver);
+   static void computePosition(tile_id_t tile, SInt32 &x, SInt32 &y);
+   static tile_id_t computeTileID(SInt32 x, SInt32 y);
+   // Output port from column 'cx' to column 'x' (on the row) and from row 'cy' to row 'y' (on the column)
+   static SInt32 computeRowPort(SInt32 cx, SInt32 x);
+   static SInt32 computeColumnPort(SInt32 cy, SInt32 y);
+   // Is any tile in column 'x' a receiver of the multicast packet?
+   static bool hasMulticastReceiverInColumn(const NetPacket& pkt, SInt32 x);
+
+   void outputPowerSummary(ostream& out, const Time& target_completion_time);
+   void outputEventCountSummary(ostream& out);
+   void outputContentionModelsSummary(ostream& out);
+};
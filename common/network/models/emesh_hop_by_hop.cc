@@ -12,9 +12,11 @@ bool NetworkModelEMeshHopByHop::_initialized = false;
 SInt32 NetworkModelEMeshHopByHop::_mesh_width;
 SInt32 NetworkModelEMeshHopByHop::_mesh_height;
 bool NetworkModelEMeshHopByHop::_contention_model_enabled;
+NetworkModelEMeshHopByHop::RoutingAlgorithm NetworkModelEMeshHopByHop::_routing_algorithm;
 
 NetworkModelEMeshHopByHop::NetworkModelEMeshHopByHop(Network* net, SInt32 network_id)
    : NetworkModel(net, network_id)
+   , _total_adaptive_routing_decisions(0)
 {
    try
    {
@@ -58,15 +60,35 @@ NetworkModelEMeshHopByHop::initializeEMeshTopologyParams()
          "Num Application Tiles(%i), Mesh Width(%i), Mesh Height(%i)",
          num_application_tiles, _mesh_width, _mesh_height);
       
+   string routing_algorithm;
    try
    {
       // Is contention model enabled?
       _contention_model_enabled = Sim()->getCfg()->getBool("network/emesh_hop_by_hop/queue_model/enabled");
+      // Routing algorithm of the unicast packets
+      routing_algorithm = Sim()->getCfg()->getString("network/emesh_hop_by_hop/routing", "xy");
    }
    catch (...)
    {
       LOG_PRINT_ERROR("Could not read parameters from the emesh_hop_by_hop section of the cfg file");
    }
+   _routing_algorithm = parseRoutingAlgorithm(routing_algorithm);
+}
+
+NetworkModelEMeshHopByHop::RoutingAlgorithm
+NetworkModelEMeshHopByHop::parseRoutingAlgorithm(string routing_algorithm)
+{
+   if (routing_algorithm == "xy")
+      return XY_ROUTING;
+   else if (routing_algorithm == "west_first")
+      return WEST_FIRST_ROUTING;
+   else if (routing_algorithm == "odd_even")
+      return ODD_EVEN_ROUTING;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized emesh_hop_by_hop routing algorithm(%s)", routing_algorithm.c_str());
+      return XY_ROUTING;
+   }
 }
 
 void
@@ -81,17 +103,20 @@ NetworkModelEMeshHopByHop::createRouterAndLinkModels()
    // Router
    UInt64 router_delay = 0;
    UInt32 num_flits_per_output_buffer = 0;
+   SInt32 num_virtual_channels = 0;
    // Link
    string link_type;
-   __attribute__((unused)) UInt64 link_delay = 0;
+   UInt64 link_delay = 0;
    // Contention Model
    string contention_model_type;
    try
    {
       // Router Delay (pipeline delay) is specified in cycles
       router_delay = (UInt64) Sim()->getCfg()->getInt("network/emesh_hop_by_hop/router/delay");
-      // Number of flits per port - used only for power modeling purposes now
+      // Number of flits per port - used for power modeling, and as the depth of each VC buffer with virtual channels
       num_flits_per_output_buffer = Sim()->getCfg()->getInt("network/emesh_hop_by_hop/router/num_flits_per_port_buffer");
+      // Virtual channels per port (0 models contention with the queue model instead)
+      num_virtual_channels = Sim()->getCfg()->getInt("network/emesh_hop_by_hop/router/num_virtual_channels", 0);
      
       // Link Parameters
       link_delay = Sim()->getCfg()->getInt("network/emesh_hop_by_hop/link/delay");
@@ -111,10 +136,13 @@ NetworkModelEMeshHopByHop::createRouterAndLinkModels()
                                        4, 0, _flit_width,
                                        _contention_model_enabled, contention_model_type);
    // Mesh Router
+   // A credit returns across the link and through the router pipeline of the downstream router
+   UInt64 credit_round_trip_delay = 2 * link_delay + router_delay;
    _mesh_router = new RouterModel(this, _frequency, _voltage,
                                   _num_mesh_router_ports, _num_mesh_router_ports,
                                   num_flits_per_output_buffer, router_delay, _flit_width,
-                                  _contention_model_enabled, contention_model_type);
+                                  _contention_model_enabled, contention_model_type,
+                                  1, num_virtual_channels, credit_round_trip_delay);
    // Mesh Link List
    double link_length = _tile_width;
    _mesh_link_list.resize(_num_mesh_router_ports);
@@ -125,6 +153,112 @@ NetworkModelEMeshHopByHop::createRouterAndLinkModels()
                                                    link_length, _flit_width);
       assert(_mesh_link_list[i]->getDelay() == link_delay);
    }
+
+   // Routing Table
+   createRoutingTable();
+}
+
+void
+NetworkModelEMeshHopByHop::createRoutingTable()
+{
+   SInt32 cx, cy;
+   computePosition(_tile_id, cx, cy);
+
+   _neighbor_tile_list[SELF] = _tile_id;
+   _neighbor_tile_list[LEFT] = computeTileID(cx-1,cy);
+   _neighbor_tile_list[RIGHT] = computeTileID(cx+1,cy);
+   _neighbor_tile_list[DOWN] = computeTileID(cx,cy-1);
+   _neighbor_tile_list[UP] = computeTileID(cx,cy+1);
+
+   _routing_table.resize(_mesh_width * _mesh_height);
+   for (tile_id_t tile_id = 0; tile_id < (tile_id_t) _routing_table.size(); tile_id++)
+   {
+      SInt32 dx, dy;
+      computePosition(tile_id, dx, dy);
+      computeOutputPorts(cx, cy, dx, dy, false, _routing_table[tile_id]._output_port);
+      computeOutputPorts(cx, cy, dx, dy, true, _routing_table[tile_id]._source_column_output_port);
+   }
+}
+
+// The X port comes first, so that adaptive routing falls back to XY routing on a tie
+void
+NetworkModelEMeshHopByHop::computeOutputPorts(SInt32 cx, SInt32 cy, SInt32 dx, SInt32 dy, bool in_source_column,
+                                              SInt8 output_port[2])
+{
+   SInt8 x_port = (dx > cx) ? RIGHT : ((dx < cx) ? LEFT : INVALID_OUTPUT_PORT);
+   SInt8 y_port = (dy > cy) ? UP : ((dy < cy) ? DOWN : INVALID_OUTPUT_PORT);
+
+   output_port[0] = output_port[1] = INVALID_OUTPUT_PORT;
+   if ((x_port == INVALID_OUTPUT_PORT) && (y_port == INVALID_OUTPUT_PORT))
+   {
+      output_port[0] = SELF;
+      return;
+   }
+   if ((x_port == INVALID_OUTPUT_PORT) || (y_port == INVALID_OUTPUT_PORT))
+   {
+      output_port[0] = (x_port != INVALID_OUTPUT_PORT) ? x_port : y_port;
+      return;
+   }
+
+   switch (_routing_algorithm)
+   {
+   case XY_ROUTING:
+      output_port[0] = x_port;
+      break;
+
+   case WEST_FIRST_ROUTING:
+      // All the west hops are taken first
+      output_port[0] = x_port;
+      if (x_port == RIGHT)
+         output_port[1] = y_port;
+      break;
+
+   case ODD_EVEN_ROUTING:
+      // No east->north/south turn in an even column, no north/south->west turn in an odd column
+      if (x_port == RIGHT)
+      {
+         SInt32 num_output_ports = 0;
+         if (((dx % 2) == 1) || ((dx - cx) != 1))
+            output_port[num_output_ports++] = x_port;
+         if (((cx % 2) == 1) || in_source_column)
+            output_port[num_output_ports++] = y_port;
+         LOG_ASSERT_ERROR(num_output_ports > 0, "No odd-even route from (%i,%i) to (%i,%i)", cx, cy, dx, dy);
+      }
+      else
+      {
+         output_port[0] = x_port;
+         if ((cx % 2) == 0)
+            output_port[1] = y_port;
+      }
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized routing algorithm(%u)", _routing_algorithm);
+      break;
+   }
+}
+
+SInt32
+NetworkModelEMeshHopByHop::computeOutputPort(const NetPacket& pkt, tile_id_t pkt_receiver)
+{
+   const RoutingTableEntry& entry = _routing_table[pkt_receiver];
+   const SInt8* output_port = entry._output_port;
+   if ( (_routing_algorithm == ODD_EVEN_ROUTING) &&
+        ((TILE_ID(pkt.sender) % _mesh_width) == (_tile_id % _mesh_width)) )
+      output_port = entry._source_column_output_port;
+
+   if (output_port[1] == INVALID_OUTPUT_PORT)
+      return output_port[0];
+
+   // Adaptive routing: the output port with the smallest backlog
+   UInt64 pkt_time = pkt.time.toCycles(_frequency);
+   if (_mesh_router->getOutputPortBacklog(output_port[1], pkt_time) < _mesh_router->getOutputPortBacklog(output_port[0], pkt_time))
+   {
+      if (isModelEnabled(pkt))
+         _total_adaptive_routing_decisions ++;
+      return output_port[1];
+   }
+   return output_port[0];
 }
 
 void
@@ -168,18 +302,23 @@ NetworkModelEMeshHopByHop::routePacket(const NetPacket &pkt, queue<Hop> &next_ho
 
          list<NextDest> next_dest_list;
 
-         if (cy >= sy)
+         // A multicast packet only follows the branches of the broadcast tree
+         // that lead to at least one tile in its receiver set
+         bool multicast = pkt.isMulticast();
+
+         if ( (cy >= sy) && (!multicast || hasMulticastReceiver(pkt, cx, cx, cy+1, _mesh_height-1)) )
             next_dest_list.push_back(NextDest(computeTileID(cx,cy+1), UP, EMESH));
-         if (cy <= sy)
+         if ( (cy <= sy) && (!multicast || hasMulticastReceiver(pkt, cx, cx, 0, cy-1)) )
             next_dest_list.push_back(NextDest(computeTileID(cx,cy-1), DOWN, EMESH));
          if (cy == sy)
          {
-            if (cx >= sx)
+            if ( (cx >= sx) && (!multicast || hasMulticastReceiver(pkt, cx+1, _mesh_width-1, 0, _mesh_height-1)) )
                next_dest_list.push_back(NextDest(computeTileID(cx+1,cy), RIGHT, EMESH));
-            if (cx <= sx)
+            if ( (cx <= sx) && (!multicast || hasMulticastReceiver(pkt, 0, cx-1, 0, _mesh_height-1)) )
                next_dest_list.push_back(NextDest(computeTileID(cx-1,cy), LEFT, EMESH));
          }
-         next_dest_list.push_back(NextDest(_tile_id, SELF, RECEIVE_TILE));
+         if (!multicast || pkt.isMulticastReceiver(_tile_id))
+            next_dest_list.push_back(NextDest(_tile_id, SELF, RECEIVE_TILE));
 
          UInt64 zero_load_delay = 0;
          UInt64 contention_delay = 0;
@@ -206,6 +345,10 @@ NetworkModelEMeshHopByHop::routePacket(const NetPacket &pkt, queue<Hop> &next_ho
                it = next_dest_list.erase(it);
             }
          }
+         // Nothing left to deliver on the mesh (multicast to system tiles only)
+         if (next_dest_list.empty())
+            return;
+
          // Update the zero_load_delay
          zero_load_delay += max_link_delay;
 
@@ -222,22 +365,9 @@ NetworkModelEMeshHopByHop::routePacket(const NetPacket &pkt, queue<Hop> &next_ho
 
       else // (pkt_receiver != NetPacket::BROADCAST)
       {
-         SInt32 cx, cy, dx, dy;
-         computePosition(_tile_id, cx, cy);
-         computePosition(pkt_receiver, dx, dy);
-
-         NextDest next_dest;
-
-         if (cx > dx)
-            next_dest = NextDest(computeTileID(cx-1,cy), LEFT, EMESH);
-         else if (cx < dx)
-            next_dest = NextDest(computeTileID(cx+1,cy), RIGHT, EMESH);
-         else if (cy > dy)
-            next_dest = NextDest(computeTileID(cx,cy-1), DOWN, EMESH);
-         else if (cy < dy)
-            next_dest = NextDest(computeTileID(cx,cy+1), UP, EMESH);
-         else
-            next_dest = NextDest(_tile_id, SELF, RECEIVE_TILE);
+         // Routing table lookup
+         SInt32 output_port = computeOutputPort(pkt, pkt_receiver);
+         NextDest next_dest(_neighbor_tile_list[output_port], output_port, (output_port == SELF) ? RECEIVE_TILE : EMESH);
 
          UInt64 zero_load_delay = 0;
          UInt64 contention_delay = 0;
@@ -279,6 +409,20 @@ NetworkModelEMeshHopByHop::computeTileID(SInt32 x, SInt32 y)
       return (y * _mesh_width + x);
 }
 
+bool
+NetworkModelEMeshHopByHop::hasMulticastReceiver(const NetPacket& pkt, SInt32 min_x, SInt32 max_x, SInt32 min_y, SInt32 max_y)
+{
+   for (SInt32 y = min_y; y <= max_y; y++)
+   {
+      for (SInt32 x = min_x; x <= max_x; x++)
+      {
+         if (pkt.isMulticastReceiver(computeTileID(x,y)))
+            return true;
+      }
+   }
+   return false;
+}
+
 SInt32
 NetworkModelEMeshHopByHop::computeDistance(tile_id_t sender, tile_id_t receiver)
 {
@@ -301,6 +445,7 @@ NetworkModelEMeshHopByHop::outputSummary(ostream &out, const Time& target_comple
    NetworkModel::outputSummary(out, target_completion_time);
    outputPowerSummary(out, target_completion_time);
    outputEventCountSummary(out);
+   outputLinkUtilizationSummary(out, target_completion_time);
    if (_contention_model_enabled)
       outputContentionModelsSummary(out);
 }
@@ -449,6 +594,7 @@ NetworkModelEMeshHopByHop::outputEventCountSummary(ostream& out)
       for (SInt32 i = 0; i < _num_mesh_router_ports; i++)
          total_link_traversals += _mesh_link_list[i]->getTotalTraversals();
       out << "      Link Traversals: " << total_link_traversals << endl;
+      out << "      Adaptive Routing Decisions: " << _total_adaptive_routing_decisions << endl;
    }
 
    else if (isSystemTile(_tile_id))
@@ -459,6 +605,37 @@ NetworkModelEMeshHopByHop::outputEventCountSummary(ostream& out)
       for (SInt32 i = 1; i <= _num_mesh_router_ports; i++)
          out << "      Crossbar[" << i << "] Traversals: " << endl;
       out << "      Link Traversals: " << endl;
+      out << "      Adaptive Routing Decisions: " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+// One row per direction: laid out by tile position, each row is a heat map of the links in that direction
+void
+NetworkModelEMeshHopByHop::outputLinkUtilizationSummary(ostream& out, const Time& target_completion_time)
+{
+   static const char* direction_names[] = { "Self", "Left", "Right", "Down", "Up" };
+
+   out << "    Link Utilization Heat Map (%):" << endl;
+
+   if (isApplicationTile(_tile_id))
+   {
+      UInt64 total_cycles = target_completion_time.toCycles(_frequency);
+      for (SInt32 i = LEFT; i <= UP; i++)
+      {
+         double utilization = (total_cycles > 0) ? (100.0 * _mesh_link_list[i]->getTotalTraversals() / total_cycles) : 0.0;
+         out << "      " << direction_names[i] << " Link: " << utilization << endl;
+      }
+   }
+
+   else if (isSystemTile(_tile_id))
+   {
+      for (SInt32 i = LEFT; i <= UP; i++)
+         out << "      " << direction_names[i] << " Link: " << endl;
    }
 
    else
@@ -477,6 +654,10 @@ NetworkModelEMeshHopByHop::outputContentionModelsSummary(ostream& out)
       out << "      Average EMesh Router Contention Delay: " << _mesh_router->getAverageContentionDelay(0, _num_mesh_router_ports-1) << endl;
       out << "      Average EMesh Router Link Utilization: " << _mesh_router->getAverageLinkUtilization(0, _num_mesh_router_ports-1) << endl;
       out << "      Analytical Models Used (%): " << _mesh_router->getPercentAnalyticalModelsUsed(0, _num_mesh_router_ports-1) << endl;
+      out << "      VC Stalls: " << _mesh_router->getTotalVCStalls() << endl;
+      out << "      VC Stall Cycles: " << _mesh_router->getTotalVCStallCycles() << endl;
+      out << "      Credit Stalls: " << _mesh_router->getTotalCreditStalls() << endl;
+      out << "      Credit Stall Cycles: " << _mesh_router->getTotalCreditStallCycles() << endl;
    }
 
    else if (isSystemTile(_tile_id))
@@ -484,6 +665,10 @@ NetworkModelEMeshHopByHop::outputContentionModelsSummary(ostream& out)
       out << "      Average EMesh Router Contention Delay: " << endl;
       out << "      Average EMesh Router Link Utilization: " << endl;
       out << "      Analytical Models Used (%): " << endl;
+      out << "      VC Stalls: " << endl;
+      out << "      VC Stall Cycles: " << endl;
+      out << "      Credit Stalls: " << endl;
+      out << "      Credit Stall Cycles: " << endl;
    }
 
    else
@@ -45,6 +45,33 @@ private:
       UP
    };
 
+   enum RoutingAlgorithm
+   {
+      XY_ROUTING = 0,
+      // Minimal adaptive routing: the turn model restricts the output ports and the
+      // router picks the one with the smallest backlog
+      WEST_FIRST_ROUTING,
+      ODD_EVEN_ROUTING
+   };
+
+   // Minimal output ports towards a destination (the second one only with adaptive routing).
+   // With odd-even routing, a packet that has not left the column of its sender may also turn
+   // north/south in an even column, so those entries are kept separately.
+   class RoutingTableEntry
+   {
+   public:
+      RoutingTableEntry()
+      {
+         _output_port[0] = _output_port[1] = INVALID_OUTPUT_PORT;
+         _source_column_output_port[0] = _source_column_output_port[1] = INVALID_OUTPUT_PORT;
+      }
+
+      SInt8 _output_port[2];
+      SInt8 _source_column_output_port[2];
+   };
+
+   static const SInt8 INVALID_OUTPUT_PORT = -1;
+
    // Fields
    static bool _initialized;
    static SInt32 _mesh_width;
@@ -53,6 +80,15 @@ private:
    // Is contention model enabled?
    static bool _contention_model_enabled;
 
+   // Routing
+   static RoutingAlgorithm _routing_algorithm;
+   // Indexed by the destination tile
+   vector<RoutingTableEntry> _routing_table;
+   // Next tile on each output port
+   tile_id_t _neighbor_tile_list[5];
+   // Hops on which adaptive routing took the second output port
+   UInt64 _total_adaptive_routing_decisions;
+
    // Injection Router 
    RouterModel* _injection_router;
 
@@ -74,12 +110,21 @@ private:
    void createRouterAndLinkModels();
    void destroyRouterAndLinkModels();
 
+   // Routing Table
+   static RoutingAlgorithm parseRoutingAlgorithm(string routing_algorithm);
+   void createRoutingTable();
+   static void computeOutputPorts(SInt32 cx, SInt32 cy, SInt32 dx, SInt32 dy, bool in_source_column, SInt8 output_port[2]);
+   SInt32 computeOutputPort(const NetPacket& pkt, tile_id_t pkt_receiver);
+
    // Utilities
    static SInt32 computeDistance(tile_id_t sender, tile_id_t receiver);
    static void computePosition(tile_id_t tile, SInt32 &x, SInt32 &y);
    static tile_id_t computeTileID(SInt32 x, SInt32 y);
+   // Is any tile in the (inclusive) region a receiver of the multicast packet?
+   static bool hasMulticastReceiver(const NetPacket& pkt, SInt32 min_x, SInt32 max_x, SInt32 min_y, SInt32 max_y);
 
    void outputPowerSummary(ostream& out, const Time& target_completion_time);
    void outputEventCountSummary(ostream& out);
+   void outputLinkUtilizationSummary(ostream& out, const Time& target_completion_time);
    void outputContentionModelsSummary(ostream& out);
 };
@@ -0,0 +1,613 @@
+#include <math.h>
+using namespace std;
+
+#include "etorus.h"
+#include "tile.h"
+#include "simulator.h"
+#include "config.h"
+#include "utils.h"
+#include "packet_type.h"
+
+bool NetworkModelETorus::_initialized = false;
+SInt32 NetworkModelETorus::_torus_width;
+SInt32 NetworkModelETorus::_torus_height;
+bool NetworkModelETorus::_contention_model_enabled;
+
+NetworkModelETorus::NetworkModelETorus(Network* net, SInt32 network_id)
+   : NetworkModel(net, network_id)
+   , _total_dateline_crossings(0)
+{
+   try
+   {
+      // Flit Width is specified in bits
+      _flit_width = Sim()->getCfg()->getInt("network/etorus/flit_width");
+
+      // Is broadcast tree enabled?
+      _has_broadcast_capability = Sim()->getCfg()->getBool("network/etorus/broadcast_tree_enabled");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Could not read etorus parameters from the configuration file");
+   }
+
+   // Initialize Topology Params
+   initializeETorusTopologyParams();
+
+   // Create Router & Link Models
+   _num_torus_router_ports = 5;
+   createRouterAndLinkModels();
+}
+
+NetworkModelETorus::~NetworkModelETorus()
+{
+   // Destroy the Router & Link Models
+   destroyRouterAndLinkModels();
+}
+
+void
+NetworkModelETorus::initializeETorusTopologyParams()
+{
+   if (_initialized)
+      return;
+   _initialized = true;
+
+   SInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
+
+   _torus_width = (SInt32) floor (sqrt(num_application_tiles));
+   _torus_height = (SInt32) ceil (1.0 * num_application_tiles / _torus_width);
+   LOG_ASSERT_ERROR(num_application_tiles == (_torus_width * _torus_height),
+         "Num Application Tiles(%i), Torus Width(%i), Torus Height(%i)",
+         num_application_tiles, _torus_width, _torus_height);
+
+   try
+   {
+      // Is contention model enabled?
+      _contention_model_enabled = Sim()->getCfg()->getBool("network/etorus/queue_model/enabled");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read parameters from the etorus section of the cfg file");
+   }
+}
+
+void
+NetworkModelETorus::createRouterAndLinkModels()
+{
+   if (isSystemTile(_tile_id))
+      return;
+
+   // Create Router & Link Models
+   // Router & Link are clocked at the same frequency
+
+   // Router
+   UInt64 router_delay = 0;
+   UInt32 num_flits_per_output_buffer = 0;
+   SInt32 num_virtual_channels = 0;
+   // Link
+   string link_type;
+   // Contention Model
+   string contention_model_type;
+   try
+   {
+      // Router Delay (pipeline delay) is specified in cycles
+      router_delay = (UInt64) Sim()->getCfg()->getInt("network/etorus/router/delay");
+      // Number of flits per port per VC class - used for power modeling, and as the depth of each VC buffer with virtual channels
+      num_flits_per_output_buffer = Sim()->getCfg()->getInt("network/etorus/router/num_flits_per_port_buffer");
+      // Virtual channels per port per VC class (0 models contention with the queue model instead)
+      num_virtual_channels = Sim()->getCfg()->getInt("network/etorus/router/num_virtual_channels", 0);
+
+      // Link Parameters
+      link_type = Sim()->getCfg()->getString("network/etorus/link/type");
+
+      contention_model_type = Sim()->getCfg()->getString("network/etorus/queue_model/type");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read etorus router & link parameters from the cfg file");
+   }
+
+   // Create the injection port contention model first
+   _injection_router = new RouterModel(this, _frequency, _voltage,
+                                       1, 1,
+                                       4, 0, _flit_width,
+                                       _contention_model_enabled, contention_model_type);
+   // Torus Link List
+   // In a folded torus, every link spans two tiles
+   double link_length = 2 * _tile_width;
+   _torus_link_list.resize(_num_torus_router_ports);
+   for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+   {
+      _torus_link_list[i] = new ElectricalLinkModel(this, link_type,
+                                                    _frequency, _voltage,
+                                                    link_length, _flit_width);
+   }
+   // Torus Router: each port buffers both dateline VC classes
+   // A credit returns across the link and through the router pipeline of the downstream router
+   UInt64 credit_round_trip_delay = 2 * _torus_link_list[0]->getDelay() + router_delay;
+   _torus_router = new RouterModel(this, _frequency, _voltage,
+                                   _num_torus_router_ports, _num_torus_router_ports,
+                                   num_flits_per_output_buffer, router_delay, _flit_width,
+                                   _contention_model_enabled, contention_model_type,
+                                   NUM_DATELINE_VC_CLASSES, num_virtual_channels, credit_round_trip_delay);
+}
+
+void
+NetworkModelETorus::destroyRouterAndLinkModels()
+{
+   if (isSystemTile(_tile_id))
+      return;
+
+   // Injection Port Router
+   delete _injection_router;
+   // Torus Router
+   delete _torus_router;
+   // Torus Link List
+   for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+      delete _torus_link_list[i];
+}
+
+void
+NetworkModelETorus::routePacket(const NetPacket &pkt, queue<Hop> &next_hops)
+{
+   tile_id_t pkt_sender = TILE_ID(pkt.sender);
+   tile_id_t pkt_receiver = TILE_ID(pkt.receiver);
+
+   if (pkt.node_type == SEND_TILE)
+   {
+      UInt64 zero_load_delay = 0;
+      UInt64 contention_delay = 0;
+      _injection_router->processPacket(pkt, 0, zero_load_delay, contention_delay);
+
+      Hop hop(pkt, _tile_id, ETORUS, Latency(0,_frequency), Latency(contention_delay,_frequency));
+      next_hops.push(hop);
+   }
+
+   else if (pkt.node_type == ETORUS)
+   {
+      SInt32 cx, cy;
+      computePosition(_tile_id, cx, cy);
+
+      if (pkt_receiver == NetPacket::BROADCAST)
+      {
+         SInt32 sx, sy;
+         computePosition(pkt_sender, sx, sy);
+
+         // The broadcast tree first covers the row of the sender, each half of the ring in
+         // one direction, and then every column the same way from the row of the sender
+         SInt32 row_offset = computeForwardOffset(sx, cx, _torus_width);
+         SInt32 row_right_half = _torus_width / 2;
+         SInt32 row_left_half = _torus_width - 1 - row_right_half;
+         SInt32 col_offset = computeForwardOffset(sy, cy, _torus_height);
+         SInt32 col_up_half = _torus_height / 2;
+         SInt32 col_down_half = _torus_height - 1 - col_up_half;
+
+         // Positions left to cover in each direction from here
+         SInt32 num_right = 0, num_left = 0, num_up = 0, num_down = 0;
+         if (cy == sy)
+         {
+            num_right = (row_offset <= row_right_half) ? (row_right_half - row_offset) : 0;
+            num_left = (row_offset == 0) ? row_left_half :
+                       ((row_offset > row_right_half) ? (row_left_half - (_torus_width - row_offset)) : 0);
+         }
+         num_up = (col_offset <= col_up_half) ? (col_up_half - col_offset) : 0;
+         num_down = (col_offset == 0) ? col_down_half :
+                    ((col_offset > col_up_half) ? (col_down_half - (_torus_height - col_offset)) : 0);
+
+         list<NextDest> next_dest_list;
+
+         // A multicast packet only follows the branches of the broadcast tree
+         // that lead to at least one tile in its receiver set
+         bool multicast = pkt.isMulticast();
+
+         if ( (num_right > 0) && (!multicast || hasMulticastReceiver(pkt, cx+1, num_right, 1, 0, _torus_height, 1)) )
+            next_dest_list.push_back(NextDest(computeTileID(cx+1,cy), RIGHT, ETORUS));
+         if ( (num_left > 0) && (!multicast || hasMulticastReceiver(pkt, cx-1, num_left, -1, 0, _torus_height, 1)) )
+            next_dest_list.push_back(NextDest(computeTileID(cx-1,cy), LEFT, ETORUS));
+         if ( (num_up > 0) && (!multicast || hasMulticastReceiver(pkt, cx, 1, 1, cy+1, num_up, 1)) )
+            next_dest_list.push_back(NextDest(computeTileID(cx,cy+1), UP, ETORUS));
+         if ( (num_down > 0) && (!multicast || hasMulticastReceiver(pkt, cx, 1, 1, cy-1, num_down, -1)) )
+            next_dest_list.push_back(NextDest(computeTileID(cx,cy-1), DOWN, ETORUS));
+         if (!multicast || pkt.isMulticastReceiver(_tile_id))
+            next_dest_list.push_back(NextDest(_tile_id, SELF, RECEIVE_TILE));
+
+         // Nothing left to deliver (multicast to system tiles only)
+         if (next_dest_list.empty())
+            return;
+
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+
+         // Get the link delay as well as a vector of directions
+         // All the copies of the packet are allocated VCs of the highest class among them
+         UInt64 max_link_delay = 0;
+         vector<SInt32> output_port_list;
+         SInt32 vc_class = 0;
+         for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); it++)
+         {
+            SInt32 output_port = (*it)._output_port;
+            output_port_list.push_back(output_port);
+            vc_class = max<SInt32>(vc_class, computeVCClass(sx, sy, cx, cy, output_port));
+
+            UInt64 link_delay = 0;
+            _torus_link_list[output_port]->processPacket(pkt, link_delay);
+            max_link_delay = max<UInt64>(max_link_delay, link_delay);
+
+            if (isModelEnabled(pkt) && isDatelineLink(cx, cy, output_port))
+               _total_dateline_crossings ++;
+         }
+
+         // Update the zero_load_delay
+         zero_load_delay += max_link_delay;
+
+         // Get the router to process the packet
+         _torus_router->processPacket(pkt, output_port_list, zero_load_delay, contention_delay, vc_class);
+
+         // Populate the next_hops queue
+         for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); it++)
+         {
+            Hop hop(pkt, (*it)._tile_id, (*it)._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+            next_hops.push(hop);
+         }
+      }
+
+      else // (pkt_receiver != NetPacket::BROADCAST)
+      {
+         SInt32 dx, dy;
+         computePosition(pkt_receiver, dx, dy);
+
+         // Minimal routing on each ring: ties go up the ring
+         SInt32 x_offset = computeForwardOffset(cx, dx, _torus_width);
+         SInt32 y_offset = computeForwardOffset(cy, dy, _torus_height);
+
+         NextDest next_dest;
+
+         if (x_offset != 0)
+         {
+            if (2 * x_offset <= _torus_width)
+               next_dest = NextDest(computeTileID(cx+1,cy), RIGHT, ETORUS);
+            else
+               next_dest = NextDest(computeTileID(cx-1,cy), LEFT, ETORUS);
+         }
+         else if (y_offset != 0)
+         {
+            if (2 * y_offset <= _torus_height)
+               next_dest = NextDest(computeTileID(cx,cy+1), UP, ETORUS);
+            else
+               next_dest = NextDest(computeTileID(cx,cy-1), DOWN, ETORUS);
+         }
+         else
+         {
+            next_dest = NextDest(_tile_id, SELF, RECEIVE_TILE);
+         }
+
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+
+         assert(next_dest._output_port >= 0 && next_dest._output_port < (SInt32) _torus_link_list.size());
+
+         // The packet switches to the second VC class on the wraparound link
+         if (isModelEnabled(pkt) && isDatelineLink(cx, cy, next_dest._output_port))
+            _total_dateline_crossings ++;
+
+         // Go through router
+         SInt32 sx, sy;
+         computePosition(pkt_sender, sx, sy);
+         SInt32 vc_class = computeVCClass(sx, sy, cx, cy, next_dest._output_port);
+         _torus_router->processPacket(pkt, next_dest._output_port, zero_load_delay, contention_delay, vc_class);
+         // Go through link
+         _torus_link_list[next_dest._output_port]->processPacket(pkt, zero_load_delay);
+
+         Hop hop(pkt, next_dest._tile_id, next_dest._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+         next_hops.push(hop);
+
+      } // (pkt_receiver == NetPacket::BROADCAST)
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Node Type(%i)", pkt.node_type);
+   }
+}
+
+void
+NetworkModelETorus::computePosition(tile_id_t tile_id, SInt32 &x, SInt32 &y)
+{
+   x = tile_id % _torus_width;
+   y = tile_id / _torus_width;
+}
+
+tile_id_t
+NetworkModelETorus::computeTileID(SInt32 x, SInt32 y)
+{
+   x = ((x % _torus_width) + _torus_width) % _torus_width;
+   y = ((y % _torus_height) + _torus_height) % _torus_height;
+   return (y * _torus_width + x);
+}
+
+SInt32
+NetworkModelETorus::computeForwardOffset(SInt32 from, SInt32 to, SInt32 ring_size)
+{
+   return (((to - from) % ring_size) + ring_size) % ring_size;
+}
+
+bool
+NetworkModelETorus::isDatelineLink(SInt32 x, SInt32 y, SInt32 output_port)
+{
+   switch (output_port)
+   {
+   case RIGHT:
+      return (x == (_torus_width-1));
+   case LEFT:
+      return (x == 0);
+   case UP:
+      return (y == (_torus_height-1));
+   case DOWN:
+      return (y == 0);
+   default:
+      return false;
+   }
+}
+
+SInt32
+NetworkModelETorus::computeVCClass(SInt32 sx, SInt32 sy, SInt32 cx, SInt32 cy, SInt32 output_port)
+{
+   // Packets move along X from column 'sx' and along Y from row 'sy', and keep the
+   // second class from the dateline link to the end of the ring they are on
+   if (isDatelineLink(cx, cy, output_port))
+      return 1;
+
+   switch (output_port)
+   {
+   case RIGHT:
+      return (cx < sx) ? 1 : 0;
+   case LEFT:
+      return (cx > sx) ? 1 : 0;
+   case UP:
+      return (cy < sy) ? 1 : 0;
+   case DOWN:
+      return (cy > sy) ? 1 : 0;
+   default:
+      return 0;
+   }
+}
+
+bool
+NetworkModelETorus::hasMulticastReceiver(const NetPacket& pkt, SInt32 x, SInt32 num_x, SInt32 dx,
+                                         SInt32 y, SInt32 num_y, SInt32 dy)
+{
+   for (SInt32 j = 0; j < num_y; j++)
+   {
+      for (SInt32 i = 0; i < num_x; i++)
+      {
+         if (pkt.isMulticastReceiver(computeTileID(x + i*dx, y + j*dy)))
+            return true;
+      }
+   }
+   return false;
+}
+
+SInt32
+NetworkModelETorus::computeDistance(tile_id_t sender, tile_id_t receiver)
+{
+   SInt32 sx, sy, dx, dy;
+   computePosition(sender, sx, sy);
+   computePosition(receiver, dx, dy);
+
+   SInt32 x_offset = computeForwardOffset(sx, dx, _torus_width);
+   SInt32 y_offset = computeForwardOffset(sy, dy, _torus_height);
+   return min(x_offset, _torus_width - x_offset) + min(y_offset, _torus_height - y_offset);
+}
+
+void
+NetworkModelETorus::outputSummary(ostream &out, const Time& target_completion_time)
+{
+   NetworkModel::outputSummary(out, target_completion_time);
+   outputPowerSummary(out, target_completion_time);
+   outputEventCountSummary(out);
+   if (_contention_model_enabled)
+      outputContentionModelsSummary(out);
+}
+
+bool
+NetworkModelETorus::isTileCountPermissible(SInt32 tile_count)
+{
+   SInt32 torus_width = (SInt32) floor (sqrt(tile_count));
+   SInt32 torus_height = (SInt32) ceil (1.0 * tile_count / torus_width);
+
+   if (tile_count != (torus_width * torus_height))
+   {
+      fprintf(stderr, "ERROR: Tile Count(%i) != Torus Width(%i) * Torus Height(%i)\n", tile_count, torus_width, torus_height);
+      return false;
+   }
+   return true;
+}
+
+pair<bool, vector<tile_id_t> >
+NetworkModelETorus::computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count)
+{
+   // Initialize torus_width, torus_height
+   initializeETorusTopologyParams();
+
+   // The torus has no edges, so spread the controllers over a grid of equal blocks,
+   // one at the center of each block
+   vector<tile_id_t> tile_id_list_with_memory_controllers;
+   SInt32 memory_controller_mesh_width = (SInt32) floor(sqrt(num_memory_controllers));
+   SInt32 memory_controller_mesh_height = (SInt32) ceil(1.0 * num_memory_controllers / memory_controller_mesh_width);
+
+   SInt32 num_computed_memory_controllers = 0;
+   for (SInt32 j = 0; j < (memory_controller_mesh_height) && (num_computed_memory_controllers < num_memory_controllers); j++)
+   {
+      for (SInt32 i = 0; (i < memory_controller_mesh_width) && (num_computed_memory_controllers < num_memory_controllers); i++)
+      {
+         SInt32 size_x = _torus_width / memory_controller_mesh_width;
+         SInt32 size_y = _torus_height / memory_controller_mesh_height;
+         SInt32 base_x = i * size_x;
+         SInt32 base_y = j * size_y;
+
+         if (i == (memory_controller_mesh_width-1))
+            size_x = _torus_width - ((memory_controller_mesh_width-1) * size_x);
+         if (j == (memory_controller_mesh_height-1))
+            size_y = _torus_height - ((memory_controller_mesh_height-1) * size_y);
+
+         tile_id_list_with_memory_controllers.push_back(computeTileID(base_x + size_x/2, base_y + size_y/2));
+         num_computed_memory_controllers ++;
+      }
+   }
+
+   return (make_pair(true, tile_id_list_with_memory_controllers));
+}
+
+pair<bool, vector<Config::TileList> >
+NetworkModelETorus::computeProcessToTileMapping()
+{
+   // Initialize torus_width, torus_height
+   initializeETorusTopologyParams();
+
+   return (make_pair(true, computeDistanceAwareProcessToTileMapping(_torus_width * _torus_height, computeDistance)));
+}
+
+void
+NetworkModelETorus::outputEventCountSummary(ostream& out)
+{
+   out << "    Event Counters:" << endl;
+
+   if (isApplicationTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << _torus_router->getTotalBufferWrites() << endl;
+      out << "      Buffer Reads: " << _torus_router->getTotalBufferReads() << endl;
+      out << "      Switch Allocator Requests: " << _torus_router->getTotalSwitchAllocatorRequests() << endl;
+      for (SInt32 i = 1; i <= _num_torus_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << _torus_router->getTotalCrossbarTraversals(i) << endl;
+
+      UInt64 total_link_traversals = 0;
+      for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+         total_link_traversals += _torus_link_list[i]->getTotalTraversals();
+      out << "      Link Traversals: " << total_link_traversals << endl;
+      out << "      Dateline Crossings: " << _total_dateline_crossings << endl;
+   }
+
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Buffer Writes: " << endl;
+      out << "      Buffer Reads: " << endl;
+      out << "      Switch Allocator Requests: " << endl;
+      for (SInt32 i = 1; i <= _num_torus_router_ports; i++)
+         out << "      Crossbar[" << i << "] Traversals: " << endl;
+      out << "      Link Traversals: " << endl;
+      out << "      Dateline Crossings: " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelETorus::outputContentionModelsSummary(ostream& out)
+{
+   out << "    Contention Counters:" << endl;
+
+   if (isApplicationTile(_tile_id))
+   {
+      out << "      Average ETorus Router Contention Delay: " << _torus_router->getAverageContentionDelay(0, _num_torus_router_ports-1) << endl;
+      out << "      Average ETorus Router Link Utilization: " << _torus_router->getAverageLinkUtilization(0, _num_torus_router_ports-1) << endl;
+      out << "      Analytical Models Used (%): " << _torus_router->getPercentAnalyticalModelsUsed(0, _num_torus_router_ports-1) << endl;
+      out << "      VC Stalls: " << _torus_router->getTotalVCStalls() << endl;
+      out << "      VC Stall Cycles: " << _torus_router->getTotalVCStallCycles() << endl;
+      out << "      Credit Stalls: " << _torus_router->getTotalCreditStalls() << endl;
+      out << "      Credit Stall Cycles: " << _torus_router->getTotalCreditStallCycles() << endl;
+   }
+
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Average ETorus Router Contention Delay: " << endl;
+      out << "      Average ETorus Router Link Utilization: " << endl;
+      out << "      Analytical Models Used (%): " << endl;
+      out << "      VC Stalls: " << endl;
+      out << "      VC Stall Cycles: " << endl;
+      out << "      Credit Stalls: " << endl;
+      out << "      Credit Stall Cycles: " << endl;
+   }
+
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelETorus::outputPowerSummary(ostream& out, const Time& target_completion_time)
+{
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
+   // Output to sim.out
+   out << "    Power Model Statistics: " << endl;
+   if (isApplicationTile(_tile_id))
+   {
+      // Convert time into seconds
+      double target_completion_sec = target_completion_time.toSec();
+
+      // Compute the final leakage/dynamic energy
+      computeEnergy(target_completion_time);
+
+      double static_energy = getStaticEnergy();
+      double dynamic_energy = getDynamicEnergy();
+      out << "      Average Static Power (in W): " << static_energy / target_completion_sec << endl;
+      out << "      Average Dynamic Power (in W): " << dynamic_energy / target_completion_sec << endl;
+      out << "      Total Static Energy (in J): " << static_energy << endl;
+      out << "      Total Dynamic Energy (in J): " << dynamic_energy << endl;
+   }
+   else if (isSystemTile(_tile_id))
+   {
+      out << "      Average Static Power (in W): " << endl;
+      out << "      Average Dynamic Power (in W): " << endl;
+      out << "      Total Static Energy (in J): " << endl;
+      out << "      Total Dynamic Energy (in J): " << endl;
+   }
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Tile ID(%i)", _tile_id);
+   }
+}
+
+void
+NetworkModelETorus::setDVFS(double frequency, double voltage, const Time& curr_time)
+{
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
+   _torus_router->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+   for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+      _torus_link_list[i]->getPowerModel()->setDVFS(frequency, voltage, curr_time);
+}
+
+void
+NetworkModelETorus::computeEnergy(const Time& curr_time)
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   _torus_router->getPowerModel()->computeEnergy(curr_time);
+   for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+      _torus_link_list[i]->getPowerModel()->computeEnergy(curr_time);
+}
+
+double
+NetworkModelETorus::getDynamicEnergy()
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   double dynamic_energy = _torus_router->getPowerModel()->getDynamicEnergy();
+   for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+      dynamic_energy += _torus_link_list[i]->getPowerModel()->getDynamicEnergy();
+   return dynamic_energy;
+}
+
+double
+NetworkModelETorus::getStaticEnergy()
+{
+   assert(Config::getSingleton()->getEnablePowerModeling());
+   double static_energy = _torus_router->getPowerModel()->getStaticEnergy();
+   for (SInt32 i = 0; i < _num_torus_router_ports; i++)
+      static_energy += _torus_link_list[i]->getPowerModel()->getStaticEnergy();
+   return static_energy;
+}
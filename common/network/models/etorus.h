@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <iostream>
+using std::vector;
+using std::pair;
+using std::ostream;
+
+#include "network.h"
+#include "network_model.h"
+#include "fixed_types.h"
+#include "queue_model.h"
+#include "router_model.h"
+#include "electrical_link_model.h"
+
+// Electrical 2D torus (folded, so that the wraparound links have the same length as the others)
+//  - Minimal dimension-order routing (X, then Y), taking the wraparound link when it is shorter
+//  - Deadlock freedom with two dateline VC classes per port: a packet moves to the second class
+//    when it crosses the dateline (the wraparound link) of a dimension and back to the first
+//    class when it turns into the next dimension. The router buffers are sized for both classes.
+class NetworkModelETorus : public NetworkModel
+{
+public:
+   NetworkModelETorus(Network* net, SInt32 network_id);
+   ~NetworkModelETorus();
+
+   void outputSummary(std::ostream &out, const Time& target_completion_time);
+
+   // Energy computation
+   void computeEnergy(const Time& curr_time);
+   double getDynamicEnergy();
+   double getStaticEnergy();
+
+   static bool isTileCountPermissible(SInt32 tile_count);
+   static pair<bool,vector<tile_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count);
+   static pair<bool,vector<Config::TileList> > computeProcessToTileMapping();
+
+private:
+   enum NodeType
+   {
+      ETORUS = 2 // Always Start at 2
+   };
+
+   enum OutputDirection
+   {
+      SELF = 0,
+      LEFT,
+      RIGHT,
+      DOWN,
+      UP
+   };
+
+   static const SInt32 NUM_DATELINE_VC_CLASSES = 2;
+
+   // Fields
+   static bool _initialized;
+   static SInt32 _torus_width;
+   static SInt32 _torus_height;
+
+   // Is contention model enabled?
+   static bool _contention_model_enabled;
+
+   // Injection Router
+   RouterModel* _injection_router;
+
+   // Router & Link Parameters
+   SInt32 _num_torus_router_ports;
+   RouterModel* _torus_router;
+   vector<ElectricalLinkModel*> _torus_link_list;
+
+   // Event Counters
+   UInt64 _total_dateline_crossings;
+
+   // Routing Function
+   void routePacket(const NetPacket &pkt, queue<Hop> &next_hops);
+
+   // DVFS
+   void setDVFS(double frequency, double voltage, const Time& curr_time);
+
+   // Toplogy Params
+   static void initializeETorusTopologyParams();
+
+   // Router & Link Models
+   void createRouterAndLinkModels();
+   void destroyRouterAndLinkModels();
+
+   // Utilities
+   static SInt32 computeDistance(tile_id_t sender, tile_id_t receiver);
+   static void computePosition(tile_id_t tile, SInt32 &x, SInt32 &y);
+   static tile_id_t computeTileID(SInt32 x, SInt32 y);
+   // Hops from 'from' to 'to' going up the ring of the given size
+   static SInt32 computeForwardOffset(SInt32 from, SInt32 to, SInt32 ring_size);
+   // Is the link out of (x,y) on 'output_port' the wraparound link of its ring?
+   static bool isDatelineLink(SInt32 x, SInt32 y, SInt32 output_port);
+   // Dateline VC class on the link out of (cx,cy) on 'output_port' for a packet sent from (sx,sy)
+   static SInt32 computeVCClass(SInt32 sx, SInt32 sy, SInt32 cx, SInt32 cy, SInt32 output_port);
+   // Is any tile in the columns { x, x+dx, .. } (num_x of them) and the
+   // rows { y, y+dy, .. } (num_y of them) a receiver of the multicast packet?
+   static bool hasMulticastReceiver(const NetPacket& pkt, SInt32 x, SInt32 num_x, SInt32 dx,
+                                    SInt32 y, SInt32 num_y, SInt32 dy);
+
+   void outputPowerSummary(ostream& out, const Time& target_completion_time);
+   void outputEventCountSummary(ostream& out);
+   void outputContentionModelsSummary(ostream& out);
+};
@@ -6,7 +6,11 @@
 #include "memory_manager.h"
 #include "simulator.h"
 #include "tile_manager.h"
+#include "thread_scheduler.h"
 #include "network_model.h"
+#include "packet_trace.h"
+#include "parallel_network_engine.h"
+#include "deterministic_delivery.h"
 #include "core_model.h"
 #include "statistics_manager.h"
 #include "utils.h"
@@ -48,11 +52,35 @@ Network::Network(Tile *tile)
                        "Cannot Enable Shared Memory Shortcut for (%i) processes", Config::getSingleton()->getProcessCount());
    }
 
+   // Packet trace (only the application tiles send packets on the modeled networks)
+   _packet_trace_writer = NULL;
+   bool packet_trace_enabled = false;
+   UInt32 packet_trace_buffer_size = 0;
+   try
+   {
+      packet_trace_enabled = Sim()->getCfg()->getBool("network/packet_trace/enabled", false);
+      packet_trace_buffer_size = Sim()->getCfg()->getInt("network/packet_trace/buffer_size", 65536);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [network/packet_trace] parameters from the config file");
+   }
+   if (packet_trace_enabled && (_tile->getId() < (tile_id_t) Config::getSingleton()->getApplicationTiles()))
+      _packet_trace_writer = new PacketTraceWriter(_tile, packet_trace_buffer_size);
+
+   // Deterministic mode
+   _deterministic_delivery = NULL;
+   if (DeterministicDelivery::isEnabled())
+      _deterministic_delivery = new DeterministicDelivery(_tile->getId(), _transport);
+
    LOG_PRINT("Initialized Network.");
 }
 
 Network::~Network()
 {
+   delete _packet_trace_writer;
+   delete _deterministic_delivery;
+
    for (SInt32 i = 0; i < NUM_STATIC_NETWORKS; i++)
       delete _models[i];
 
@@ -86,6 +114,8 @@ void Network::outputSummary(std::ostream &out, const Time& target_completion_tim
       out << "  Network (" <<  _models[i]->getNetworkName() << "): " << endl;
       _models[i]->outputSummary(out, target_completion_time);
    }
+   if (_deterministic_delivery)
+      _deterministic_delivery->outputSummary(out);
 }
 
 // Polling function that performs background activities, such as
@@ -94,76 +124,104 @@ void Network::outputSummary(std::ostream &out, const Time& target_completion_tim
 
 void Network::netPullFromTransport()
 {
-   do
+   LOG_PRINT("Entering netPullFromTransport");
+
+   // Deterministic mode: deliver the packets in (simulated time, sender) or logged order
+   if (_deterministic_delivery)
    {
-      LOG_PRINT("Entering netPullFromTransport");
+      vector<Byte*> buffer_list;
+      _deterministic_delivery->pull(buffer_list);
+      for (vector<Byte*>::iterator it = buffer_list.begin(); it != buffer_list.end(); it++)
+      {
+         NetPacket packet(*it, _tile->getId());
+         receivePacket(packet);
+      }
+      return;
+   }
 
+   do
+   {
       NetPacket packet(_transport->recv(), _tile->getId());
+      receivePacket(packet);
+   }
+   while (_transport->query());
+}
 
-      LOG_PRINT("Pull packet : type %i, from (%i, %i), time %llu",
-                (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.time.toNanosec());
-      LOG_ASSERT_ERROR(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod,
-                       "Invalid Packet Sender(%i)", packet.sender);
-      LOG_ASSERT_ERROR(0 <= packet.type && packet.type < NUM_PACKET_TYPES,
-                       "Packet type: %d not between 0 and %d", packet.type, NUM_PACKET_TYPES);
-
-      NetworkModel* model = getNetworkModelFromPacketType(packet.type);
-   
-      if (model->isPacketReadyToBeReceived(packet))   // Receive Packet
-      {
-         // I have accepted the packet - process the received packet
-         model->__processReceivedPacket(packet);
-         
-         // asynchronous I/O support
-         NetworkCallback callback = _callbacks[packet.type];
+void Network::receivePacket(NetPacket& packet)
+{
+   LOG_PRINT("Pull packet : type %i, from (%i, %i), time %llu",
+             (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.time.toNanosec());
+   LOG_ASSERT_ERROR(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod,
+                    "Invalid Packet Sender(%i)", packet.sender);
+   LOG_ASSERT_ERROR(0 <= packet.type && packet.type < NUM_PACKET_TYPES,
+                    "Packet type: %d not between 0 and %d", packet.type, NUM_PACKET_TYPES);
 
-         if (callback != NULL)
-         {
-            LOG_PRINT("Executing callback on packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu", 
-                      (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
-                      packet.receiver.tile_id, packet.receiver.core_type,
-                      _tile->getId(), packet.time.toNanosec());
-            assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
-            assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
-
-            callback(_callbackObjs[packet.type], packet);
-
-            // De-allocate packet payload
-            if (packet.length > 0)
-               delete [] (Byte*) packet.data;
-         }
+   NetworkModel* model = getNetworkModelFromPacketType(packet.type);
+   bool ready_to_be_received = model->isPacketReadyToBeReceived(packet);
 
-         // synchronous I/O support
-         else
-         {
-            LOG_PRINT("Enqueuing packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu",
-                      (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type,
-                      packet.receiver.tile_id, packet.receiver.core_type,
-                      _tile->getId(), packet.time.toNanosec());
+   if (ready_to_be_received && packet.isMulticast() && !packet.isMulticastReceiver(_tile->getId()))
+   {
+      // Delivered by the broadcast tree but not in the receiver set - drop it
+      LOG_PRINT("Dropping multicast packet : type %i, from (%i, %i), tile_id %i, time %llu",
+                (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
+                _tile->getId(), packet.time.toNanosec());
 
-            _netQueueLock.acquire();
-            _netQueue.push_back(packet);
-            _netQueueLock.release();
+      delete [] (Byte*) packet.data;
+   }
 
-            _netQueueCond.broadcast();
-         }
-      }
+   else if (ready_to_be_received)   // Receive Packet
+   {
+      // I have accepted the packet - process the received packet
+      model->__processReceivedPacket(packet);
+      
+      // asynchronous I/O support
+      NetworkCallback callback = _callbacks[packet.type];
 
-      else // Forward Packet
-      { 
-         LOG_PRINT("Forwarding packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu.", 
+      if (callback != NULL)
+      {
+         LOG_PRINT("Executing callback on packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu", 
                    (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
                    packet.receiver.tile_id, packet.receiver.core_type,
                    _tile->getId(), packet.time.toNanosec());
+         assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
+         assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
+
+         callback(_callbackObjs[packet.type], packet);
 
-         forwardPacket(packet);
-         
          // De-allocate packet payload
          if (packet.length > 0)
             delete [] (Byte*) packet.data;
       }
+
+      // synchronous I/O support
+      else
+      {
+         LOG_PRINT("Enqueuing packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu",
+                   (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type,
+                   packet.receiver.tile_id, packet.receiver.core_type,
+                   _tile->getId(), packet.time.toNanosec());
+
+         _netQueueLock.acquire();
+         _netQueue.push_back(packet);
+         _netQueueLock.release();
+
+         _netQueueCond.broadcast();
+      }
+   }
+
+   else // Forward Packet
+   { 
+      LOG_PRINT("Forwarding packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu.", 
+                (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
+                packet.receiver.tile_id, packet.receiver.core_type,
+                _tile->getId(), packet.time.toNanosec());
+
+      forwardPacket(packet);
+      
+      // De-allocate packet payload
+      if (packet.length > 0)
+         delete [] (Byte*) packet.data;
    }
-   while (_transport->query());
 }
 
 NetworkModel* Network::getNetworkModelFromPacketType(PacketType packet_type)
@@ -177,11 +235,21 @@ SInt32 Network::netSend(NetPacket& packet)
 
    NetworkModel* model = getNetworkModelFromPacketType(packet.type);
 
+   // Application messages tell the thread scheduler which threads talk to each other
+   if ( ((packet.type == USER) || (packet.type == USER_COLLECTIVE)) && (TILE_ID(packet.receiver) != NetPacket::BROADCAST) )
+   {
+      ThreadScheduler* thread_scheduler = Sim()->getThreadScheduler();
+      if (thread_scheduler)
+         thread_scheduler->recordCommunication(TILE_ID(packet.sender), TILE_ID(packet.receiver), packet.length);
+   }
+
    LOG_PRINT("netSend: type %i, from (%i,%i) to (%i,%i), tile_id %i, time %llu",
              packet.type, packet.sender.tile_id, packet.sender.core_type,
              packet.receiver.tile_id, packet.receiver.core_type,
              _tile->getId(), packet.time.toNanosec());
    
+   if (_packet_trace_writer)
+      _packet_trace_writer->record(packet, model);
 
    // Send packet as multiple packets if model has not broadcast capability and receiver is ALL
    if ( (TILE_ID(packet.receiver) == NetPacket::BROADCAST) && (!model->hasBroadcastCapability()) )
@@ -210,9 +278,79 @@ SInt32 Network::netSend(module_t module, NetPacket& packet)
    return netSend(packet);
 }
 
+SInt32 Network::netMulticast(module_t module, NetPacket& packet, const BitVector& receivers)
+{
+   // Interface for sending a packet to a set of receivers (one bit per tile)
+
+   NetworkModel* model = getNetworkModelFromPacketType(packet.type);
+   tile_id_t sender = TILE_ID(packet.sender);
+
+   LOG_PRINT("netMulticast: type %i, from (%i,%i) to %u receivers, tile_id %i, time %llu",
+             packet.type, packet.sender.tile_id, packet.sender.core_type,
+             receivers.size(), _tile->getId(), packet.time.toNanosec());
+   LOG_ASSERT_ERROR(packet.length > 0, "Multicast packets must carry a payload");
+   LOG_ASSERT_ERROR(receivers.capacity() <= Config::getSingleton()->getTotalTiles(),
+                    "Receiver set capacity(%u) > Total Tiles(%u)",
+                    receivers.capacity(), Config::getSingleton()->getTotalTiles());
+
+   // The sender is never part of the multicast - it goes through the local corner case
+   UInt32 num_remote_receivers = receivers.size();
+   if (((UInt32) sender < receivers.capacity()) && receivers.at(sender))
+   {
+      NetPacket self_packet = packet;
+      self_packet.receiver = CORE_ID(sender);
+      netSend(self_packet);
+      num_remote_receivers --;
+   }
+
+   if (num_remote_receivers == 0)
+      return packet.length;
+
+   UInt32 num_words = receivers.getNumWords();
+   UInt64 multicast_mask[num_words];
+   for (UInt32 w = 0; w < num_words; w++)
+      multicast_mask[w] = receivers.getWord(w);
+   if ((UInt32) (sender >> 6) < num_words)
+      multicast_mask[sender >> 6] &= ~(((UInt64) 1) << (sender & 63));
+
+   if (model->hasBroadcastCapability() && (num_remote_receivers > 1))
+   {
+      // Send one packet down the broadcast tree of the model, the model prunes
+      // branches without receivers and the receiving tiles filter on the mask
+      NetPacket multicast_packet = packet;
+      multicast_packet.receiver = CORE_ID(NetPacket::BROADCAST);
+      multicast_packet.multicast_mask_length = num_words;
+      multicast_packet.multicast_mask = multicast_mask;
+      netSend(module, multicast_packet);
+   }
+   else
+   {
+      // Send as separate unicast packets, walking the mask a word at a time
+      for (UInt32 w = 0; w < num_words; w++)
+      {
+         UInt64 word = multicast_mask[w];
+         while (word != 0)
+         {
+            tile_id_t receiver = (tile_id_t) ((w << 6) + __builtin_ctzll(word));
+            NetPacket unicast_packet = packet;
+            unicast_packet.receiver = CORE_ID(receiver);
+            netSend(module, unicast_packet);
+            word &= (word - 1);
+         }
+      }
+   }
+
+   return packet.length;
+}
+
 
 SInt32 Network::forwardPacket(const NetPacket& packet)
 {
+   // The parallel network engine routes the hops on the threads that own the routers
+   ParallelNetworkEngine* parallel_network_engine = Sim()->getParallelNetworkEngine();
+   if (_sharedMemoryShortcutEnabled && parallel_network_engine && parallel_network_engine->injectPacket(packet))
+      return packet.length;
+
    ScopedLock sl(_hop_queue_lock);
 
    // Create a buffer suitable for forwarding
@@ -383,9 +521,10 @@ NetPacket Network::netRecv(const NetMatch &match)
    {
       itr = _netQueue.end();
 
-      // check every entry in the queue
+      // check every entry in the queue (in deterministic mode, the earliest matching
+      // packet is received, ties broken by sender, instead of the first one to arrive)
       for (NetQueue::iterator i = _netQueue.begin();
-            (i != _netQueue.end()) && !found;
+            (i != _netQueue.end()) && (!found || _deterministic_delivery);
             i++)
       {
          // make sure that this core is the proper destination core for this tile
@@ -396,20 +535,27 @@ NetPacket Network::netRecv(const NetMatch &match)
          }
 
          // only find packets that match
-         for (sender.reset(); !sender.done() && !found; sender.next())
+         bool packet_match = false;
+         for (sender.reset(); !sender.done() && !packet_match; sender.next())
          {
             if (i->sender.tile_id != sender.getId().tile_id || i->sender.core_type != sender.getId().core_type)
                continue;
 
-            for (type.reset(); !type.done() && !found; type.next())
+            for (type.reset(); !type.done() && !packet_match; type.next())
             {
                if (i->type != (PacketType)type.get())
                   continue;
 
-               found = true;
-               itr = i;
+               packet_match = true;
             }
          }
+
+         if (packet_match && (!found || (i->time < itr->time) ||
+                       ((i->time == itr->time) && (i->sender.tile_id < itr->sender.tile_id))))
+         {
+            found = true;
+            itr = i;
+         }
       }
 
       // go to sleep until a packet arrives if none have been found
@@ -454,6 +600,46 @@ NetPacket Network::netRecv(const NetMatch &match)
    return packet;
 }
 
+bool Network::netQuery(const NetMatch &match, const Time& time)
+{
+   core_id_t receiver = match.receiver.tile_id == INVALID_TILE_ID 
+                        ? _tile->getCore()->getId() 
+                        : match.receiver;
+
+   ScopedLock sl(_netQueueLock);
+
+   NetQueue::iterator itr = _netQueue.end();
+   for (NetQueue::iterator i = _netQueue.begin(); i != _netQueue.end(); i++)
+   {
+      if (i->receiver.tile_id != receiver.tile_id || i->receiver.core_type != receiver.core_type)
+      {
+         if (i->receiver.tile_id != NetPacket::BROADCAST)
+            continue;
+      }
+
+      bool sender_match = match.senders.empty();
+      for (vector<core_id_t>::const_iterator s = match.senders.begin(); (s != match.senders.end()) && !sender_match; s++)
+         sender_match = (i->sender.tile_id == s->tile_id) && (i->sender.core_type == s->core_type);
+      if (!sender_match)
+         continue;
+
+      bool type_match = match.types.empty();
+      for (vector<PacketType>::const_iterator t = match.types.begin(); (t != match.types.end()) && !type_match; t++)
+         type_match = (i->type == *t);
+      if (!type_match)
+         continue;
+
+      // Same choice as netRecv(): the first matching packet, or in deterministic mode
+      // the earliest one (ties broken by sender)
+      if ((itr == _netQueue.end()) || (i->time < itr->time) ||
+          ((i->time == itr->time) && (i->sender.tile_id < itr->sender.tile_id)))
+         itr = i;
+      if (!_deterministic_delivery)
+         break;
+   }
+   return (itr != _netQueue.end()) && (itr->time <= time);
+}
+
 // -- Wrappers
 
 SInt32 Network::netSend(core_id_t dest, PacketType type, const void *buf, UInt32 len)
@@ -645,6 +831,8 @@ NetPacket::NetPacket()
    , node_type(NetworkModel::SEND_TILE)
    , length(0)
    , data(0)
+   , multicast_mask_length(0)
+   , multicast_mask(NULL)
    , zero_load_delay(0)
    , contention_delay(0)
 {
@@ -657,6 +845,8 @@ NetPacket::NetPacket(Time t, PacketType ty, SInt32 s,
    , node_type(NetworkModel::SEND_TILE)
    , length(l)
    , data(d)
+   , multicast_mask_length(0)
+   , multicast_mask(NULL)
    , zero_load_delay(0)
    , contention_delay(0)
 {
@@ -673,6 +863,8 @@ NetPacket::NetPacket(Time t, PacketType ty, core_id_t s,
    , node_type(NetworkModel::SEND_TILE)
    , length(l)
    , data(d)
+   , multicast_mask_length(0)
+   , multicast_mask(NULL)
    , zero_load_delay(0)
    , contention_delay(0)
 {
@@ -684,9 +876,24 @@ NetPacket::NetPacket(Byte *buffer, heap_id_t heap_id)
 
    if (length > 0)
    {
-      Byte* data_buffer = new(heap_id) Byte[length];
+      // The multicast mask (if any) shares the allocation of the payload
+      // so that it is released along with it
+      UInt32 aligned_length = (length + sizeof(UInt64) - 1) & ~(sizeof(UInt64) - 1);
+      UInt32 multicast_mask_size = multicast_mask_length * sizeof(UInt64);
+
+      Byte* data_buffer = new(heap_id) Byte[aligned_length + multicast_mask_size];
       memcpy(data_buffer, buffer + sizeof(*this), length);
       data = data_buffer;
+
+      if (multicast_mask_length > 0)
+      {
+         memcpy(data_buffer + aligned_length, buffer + sizeof(*this) + length, multicast_mask_size);
+         multicast_mask = (const UInt64*) (data_buffer + aligned_length);
+      }
+   }
+   else
+   {
+      LOG_ASSERT_ERROR(multicast_mask_length == 0, "Multicast packet without a payload");
    }
 
    delete [] buffer;
@@ -697,7 +904,7 @@ NetPacket::NetPacket(Byte *buffer, heap_id_t heap_id)
 // but I don't see this as a major issue.
 UInt32 NetPacket::bufferSize() const
 {
-   return (sizeof(*this) + length);
+   return (sizeof(*this) + length + multicast_mask_length * sizeof(UInt64));
 }
 
 void NetPacket::makeBuffer(Byte* buffer) const
@@ -705,4 +912,6 @@ void NetPacket::makeBuffer(Byte* buffer) const
    memcpy(buffer, this, sizeof(*this));
    if (length > 0)
       memcpy(buffer + sizeof(*this), data, length);
+   if (multicast_mask_length > 0)
+      memcpy(buffer + sizeof(*this) + length, multicast_mask, multicast_mask_length * sizeof(UInt64));
 }
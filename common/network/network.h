@@ -20,8 +20,11 @@ using std::queue;
 #include "time_types.h"
 #include "dvfs.h"
 #include "network_model.h"
+#include "bit_vector.h"
 
 class Tile;
+class PacketTraceWriter;
+class DeterministicDelivery;
 
 // -- Network Packets -- //
 
@@ -39,6 +42,11 @@ public:
    UInt32 length;
    const void *data;
 
+   // Receiver set of a multicast packet (receiver is BROADCAST)
+   // One bit per tile, carried after the payload in the transport buffer
+   UInt32 multicast_mask_length;
+   const UInt64 *multicast_mask;
+
    Time zero_load_delay;
    Time contention_delay;
 
@@ -52,6 +60,13 @@ public:
    UInt32 bufferSize() const;
    void makeBuffer(Byte* buffer) const;
 
+   bool isMulticast() const { return (multicast_mask_length > 0); }
+   bool isMulticastReceiver(tile_id_t tile_id) const
+   {
+      return ( ((UInt32) (tile_id >> 6) < multicast_mask_length) &&
+               ((multicast_mask[tile_id >> 6] >> (tile_id & 63)) & 1) );
+   }
+
    static const SInt32 BROADCAST = 0xDEADBABE;
 };
 
@@ -99,7 +114,10 @@ public:
 
    SInt32 netSend(NetPacket& packet);
    SInt32 netSend(module_t module, NetPacket& packet);
+   SInt32 netMulticast(module_t module, NetPacket& packet, const BitVector& receivers);
    NetPacket netRecv(const NetMatch &match);
+   // Returns true if a packet matching 'match' has arrived by 'time' (does not block or dequeue)
+   bool netQuery(const NetMatch &match, const Time& time);
 
    // -- Wrappers -- //
 
@@ -147,7 +165,15 @@ private:
    // Is shortCut available through shared memory
    bool _sharedMemoryShortcutEnabled;
 
+   // Trace of the packets sent by the tile (NULL unless [network/packet_trace] is enabled)
+   PacketTraceWriter* _packet_trace_writer;
+
+   // Orders the packets pulled from the transport (NULL unless [deterministic] is enabled)
+   DeterministicDelivery* _deterministic_delivery;
+
    SInt32 forwardPacket(const NetPacket& packet);
+   // Receives or forwards a packet pulled from the transport
+   void receivePacket(NetPacket& packet);
    
    // -- Network Injection/Ejection Rate Trace -- //
    static void computeTraceEnabledNetworks();
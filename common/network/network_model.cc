@@ -1,4 +1,5 @@
 #include <cassert>
+#include <algorithm>
 using namespace std;
 
 #include "network.h"
@@ -8,6 +9,9 @@ using namespace std;
 #include "models/emesh_hop_counter.h"
 #include "models/emesh_hop_by_hop.h"
 #include "models/atac.h"
+#include "models/etorus.h"
+#include "models/ecmesh.h"
+#include "models/eflattened_butterfly.h"
 #include "memory_manager.h"
 #include "simulator.h"
 #include "config.h"
@@ -20,6 +24,7 @@ NetworkModel::NetworkModel(Network *network, SInt32 network_id)
    , _module(INVALID_MODULE)
    , _network(network)
    , _network_id(network_id)
+   , _target_interference_counters("Network")
    , _enabled(false)
 {
    assert(network_id >= 0 && network_id < NUM_STATIC_NETWORKS);
@@ -64,6 +69,15 @@ NetworkModel::createModel(Network *net, SInt32 network_id, UInt32 model_type)
    case NETWORK_ATAC:
       return new NetworkModelAtac(net, network_id);
 
+   case NETWORK_ETORUS:
+      return new NetworkModelETorus(net, network_id);
+
+   case NETWORK_ECMESH:
+      return new NetworkModelECMesh(net, network_id);
+
+   case NETWORK_EFLATTENED_BUTTERFLY:
+      return new NetworkModelEFlattenedButterfly(net, network_id);
+
    default:
       LOG_PRINT_ERROR("Unrecognized Network Model(%u)", model_type);
       return NULL;
@@ -166,13 +180,18 @@ NetworkModel::initializeEventCounters()
    
    _total_packet_latency = Time(0);
    _total_contention_delay = Time(0);
+   _target_interference_counters.reset();
 }
 
 bool
 NetworkModel::isModelEnabled(const NetPacket& pkt)
 {
    SInt32 network_id = getNetworkID();
-   if (network_id == STATIC_NETWORK_MEMORY)
+   if (pkt.type == NETWORK_REPLAY)
+   {
+      return _enabled;
+   }
+   else if (network_id == STATIC_NETWORK_MEMORY)
    {
       return ( _enabled && (getNetwork()->getTile()->getMemoryManager()->isModeled(pkt.data)) );
    }
@@ -185,7 +204,12 @@ NetworkModel::isModelEnabled(const NetPacket& pkt)
 UInt32
 NetworkModel::getModeledLength(const NetPacket& pkt) // In bits
 {   
-   if (pkt.type == SHARED_MEM)
+   if (pkt.type == NETWORK_REPLAY)
+   {
+      // Recorded modeled length
+      return pkt.length;
+   }
+   else if (pkt.type == SHARED_MEM)
    {
       // sender + receiver + size of shmem_msg
       // log2(core_id) for sender and receiver
@@ -269,6 +293,9 @@ NetworkModel::updateReceiveCounters(const NetPacket& packet)
    Time contention_delay = packet.contention_delay;
    _total_packet_latency += packet_latency;
    _total_contention_delay += contention_delay;
+
+   UInt32 target_num = Config::getSingleton()->getTargetNumForTile(TILE_ID(packet.sender));
+   _target_interference_counters.record(target_num, Latency(num_flits,_frequency), contention_delay);
 }
 
 void
@@ -309,6 +336,7 @@ NetworkModel::outputSummary(ostream& out, const Time& target_completion_time)
       out << "    Average Contention Delay (in clock cycles): 0" << endl;
       out << "    Average Contention Delay (in nanoseconds): 0" << endl;
    }
+   _target_interference_counters.outputSummary(out, "    ");
    
    // Asynchronous communication
    if (_module != INVALID_MODULE)
@@ -330,6 +358,12 @@ NetworkModel::parseNetworkType(string str)
       return NETWORK_ECLOS;
    else if (str == "atac")
       return NETWORK_ATAC;
+   else if (str == "etorus")
+      return NETWORK_ETORUS;
+   else if (str == "ecmesh")
+      return NETWORK_ECMESH;
+   else if (str == "eflattened_butterfly")
+      return NETWORK_EFLATTENED_BUTTERFLY;
    else
       return (UInt32)-1;
 }
@@ -348,6 +382,15 @@ NetworkModel::isTileCountPermissible(UInt32 network_type, SInt32 tile_count)
 
       case NETWORK_ATAC:
          return NetworkModelAtac::isTileCountPermissible(tile_count);
+
+      case NETWORK_ETORUS:
+         return NetworkModelETorus::isTileCountPermissible(tile_count);
+
+      case NETWORK_ECMESH:
+         return NetworkModelECMesh::isTileCountPermissible(tile_count);
+
+      case NETWORK_EFLATTENED_BUTTERFLY:
+         return NetworkModelEFlattenedButterfly::isTileCountPermissible(tile_count);
       
       default:
          fprintf(stderr, "*ERROR* Unrecognized network type(%u)\n", network_type);
@@ -381,6 +424,15 @@ NetworkModel::computeMemoryControllerPositions(UInt32 network_type, SInt32 num_m
       case NETWORK_ATAC:
          return NetworkModelAtac::computeMemoryControllerPositions(num_memory_controllers, tile_count);
 
+      case NETWORK_ETORUS:
+         return NetworkModelETorus::computeMemoryControllerPositions(num_memory_controllers, tile_count);
+
+      case NETWORK_ECMESH:
+         return NetworkModelECMesh::computeMemoryControllerPositions(num_memory_controllers, tile_count);
+
+      case NETWORK_EFLATTENED_BUTTERFLY:
+         return NetworkModelEFlattenedButterfly::computeMemoryControllerPositions(num_memory_controllers, tile_count);
+
       default:
          fprintf(stderr, "*ERROR* Unrecognized network type(%u)\n", network_type);
          abort();
@@ -403,6 +455,15 @@ NetworkModel::computeProcessToTileMapping(UInt32 network_type)
       case NETWORK_ATAC:
          return NetworkModelAtac::computeProcessToTileMapping();
 
+      case NETWORK_ETORUS:
+         return NetworkModelETorus::computeProcessToTileMapping();
+
+      case NETWORK_ECMESH:
+         return NetworkModelECMesh::computeProcessToTileMapping();
+
+      case NETWORK_EFLATTENED_BUTTERFLY:
+         return NetworkModelEFlattenedButterfly::computeProcessToTileMapping();
+
       default:
          fprintf(stderr, "*ERROR* Unrecognized network type(%u)\n", network_type);
          abort();
@@ -410,6 +471,48 @@ NetworkModel::computeProcessToTileMapping(UInt32 network_type)
    }
 }
 
+vector<Config::TileList>
+NetworkModel::computeDistanceAwareProcessToTileMapping(SInt32 tile_count,
+      SInt32 (*compute_distance)(tile_id_t sender, tile_id_t receiver))
+{
+   UInt32 process_count = Config::getSingleton()->getProcessCount();
+   vector<Config::TileList> process_to_tile_mapping(process_count);
+
+   vector<bool> assigned(tile_count, false);
+   // Total distance of each unassigned tile to the tiles of the current process
+   vector<SInt64> total_distance(tile_count);
+
+   tile_id_t seed = 0;
+   for (UInt32 i = 0; i < process_count; i++)
+   {
+      SInt32 num_tiles = (tile_count / process_count) + ((i < (tile_count % process_count)) ? 1 : 0);
+      while ((seed < tile_count) && assigned[seed])
+         seed ++;
+
+      fill(total_distance.begin(), total_distance.end(), 0);
+      tile_id_t tile_id = seed;
+      for (SInt32 j = 0; (j < num_tiles) && (tile_id != INVALID_TILE_ID); j++)
+      {
+         assigned[tile_id] = true;
+         process_to_tile_mapping[i].push_back(tile_id);
+
+         // Ties go to the lowest tile id
+         tile_id_t next_tile_id = INVALID_TILE_ID;
+         for (tile_id_t t = 0; t < tile_count; t++)
+         {
+            if (assigned[t])
+               continue;
+            total_distance[t] += compute_distance(tile_id, t);
+            if ((next_tile_id == INVALID_TILE_ID) || (total_distance[t] < total_distance[next_tile_id]))
+               next_tile_id = t;
+         }
+         tile_id = next_tile_id;
+      }
+   }
+
+   return process_to_tile_mapping;
+}
+
 bool
 NetworkModel::processCornerCases(const NetPacket& pkt, queue<Hop>& next_hops)
 {
@@ -429,7 +532,8 @@ NetworkModel::processCornerCases(const NetPacket& pkt, queue<Hop>& next_hops)
       {
          for (tile_id_t i = 0; i < (tile_id_t) Config::getSingleton()->getTotalTiles(); i++)
          {
-            next_hops.push(Hop(pkt, i, RECEIVE_TILE));
+            if (!pkt.isMulticast() || pkt.isMulticastReceiver(i))
+               next_hops.push(Hop(pkt, i, RECEIVE_TILE));
          }
       }
       else // (pkt_receiver != NetPacket::BROADCAST)
@@ -455,7 +559,8 @@ NetworkModel::processCornerCases(const NetPacket& pkt, queue<Hop>& next_hops)
                         i < (tile_id_t) Config::getSingleton()->getTotalTiles();
                         i++)
          {
-            next_hops.push(Hop(pkt, i, RECEIVE_TILE));
+            if (!pkt.isMulticast() || pkt.isMulticastReceiver(i))
+               next_hops.push(Hop(pkt, i, RECEIVE_TILE));
          }
       }
 
@@ -14,6 +14,7 @@ using std::pair;
 #include "packet_type.h"
 #include "common_types.h"
 #include "time_types.h"
+#include "target_interference_counters.h"
 #include "constants.h"
 #include "dvfs.h"
 #include "dvfs_manager.h"
@@ -153,6 +154,12 @@ protected:
    // Is System Tile - Thread Spawner or MCP
    bool isSystemTile(tile_id_t tile_id);
 
+   // Process mapping for the topologies whose hop distance is not the mesh distance:
+   // each process is grown from the lowest unassigned tile, one tile at a time, by adding the
+   // unassigned tile with the smallest total distance to the tiles already given to it
+   static vector<Config::TileList> computeDistanceAwareProcessToTileMapping(SInt32 tile_count,
+         SInt32 (*compute_distance)(tile_id_t sender, tile_id_t receiver));
+
 private:
    Network *_network;
    
@@ -177,6 +184,8 @@ private:
 
    Time _total_packet_latency;
    Time _total_contention_delay;
+   // Packets, link occupancy and contention delay of each target (by sender)
+   TargetInterferenceCounters _target_interference_counters;
 
    bool _enabled;
    
@@ -9,6 +9,9 @@ enum NetworkType
    NETWORK_EMESH_HOP_BY_HOP,
    NETWORK_ECLOS,
    NETWORK_ATAC,
+   NETWORK_ETORUS,
+   NETWORK_ECMESH,
+   NETWORK_EFLATTENED_BUTTERFLY,
    NUM_NETWORK_TYPES
 };
 
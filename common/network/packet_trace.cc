@@ -0,0 +1,202 @@
+#include <sstream>
+
+#include "packet_trace.h"
+#include "network.h"
+#include "network_model.h"
+#include "tile.h"
+#include "memory_manager.h"
+#include "config.h"
+#include "log.h"
+
+using std::string;
+
+static const UInt8 PACKET_TRACE_MAGIC[VarintOutputStream::MAGIC_SIZE] = { 'G', 'P', 'K', 'T' };
+static const UInt64 PACKET_TRACE_VERSION = 1;
+
+// Flags byte of a record
+enum
+{
+   RECORD_MEMORY_NETWORK = 0x1,
+   RECORD_BROADCAST = 0x2,
+   RECORD_MULTICAST = 0x4
+};
+
+// -- PacketTraceWriter -- //
+
+PacketTraceWriter::PacketTraceWriter(Tile* tile, UInt32 buffer_size)
+   : _tile(tile)
+   , _stream(buffer_size)
+   , _last_time(0)
+   , _last_address(0)
+   , _num_records(0)
+{
+   string filename = Config::getSingleton()->formatOutputFileName(getFilename(_tile->getId()));
+   LOG_ASSERT_ERROR(_stream.open(filename), "Could not open packet trace(%s)", filename.c_str());
+
+   _stream.writeHeader(PACKET_TRACE_MAGIC, PACKET_TRACE_VERSION, _tile->getId());
+}
+
+PacketTraceWriter::~PacketTraceWriter()
+{
+   _stream.close();
+   LOG_PRINT("Tile(%i): Recorded %llu packets", _tile->getId(), _num_records);
+}
+
+string
+PacketTraceWriter::getFilename(tile_id_t tile_id)
+{
+   std::ostringstream filename;
+   filename << "packet_trace_" << tile_id << ".bin";
+   return filename.str();
+}
+
+void
+PacketTraceWriter::record(const NetPacket& packet, NetworkModel* model)
+{
+   SInt32 network_id = g_type_to_static_network_map[packet.type];
+   if ((network_id != STATIC_NETWORK_USER) && (network_id != STATIC_NETWORK_MEMORY))
+      return;
+
+   // Packets to the tile itself and to the system tiles never reach the network models
+   tile_id_t receiver = TILE_ID(packet.receiver);
+   if ( (receiver == TILE_ID(packet.sender)) ||
+        ((receiver != NetPacket::BROADCAST) && (receiver >= (tile_id_t) Config::getSingleton()->getApplicationTiles())) )
+      return;
+   if (!model->isModelEnabled(packet))
+      return;
+
+   PacketTraceRecord record;
+   record._time = packet.time;
+   record._sender = TILE_ID(packet.sender);
+   record._receiver = receiver;
+   record._network_id = network_id;
+   record._modeled_length = model->getModeledLength(packet);
+   if (network_id == STATIC_NETWORK_MEMORY)
+      record._address = _tile->getMemoryManager()->getShmemAddress(packet.data);
+   if (packet.isMulticast())
+      record._multicast_mask.assign(packet.multicast_mask, packet.multicast_mask + packet.multicast_mask_length);
+
+   ScopedLock sl(_lock);
+   write(record);
+}
+
+void
+PacketTraceWriter::write(const PacketTraceRecord& record)
+{
+   // Packets are not sent in time order (the app and sim threads of a tile run apart)
+   UInt64 time = record._time.toPicosec();
+   _stream.putSignedVarint((SInt64) (time - _last_time));
+   _last_time = time;
+
+   UInt8 flags = 0;
+   if (record._network_id == STATIC_NETWORK_MEMORY)
+      flags |= RECORD_MEMORY_NETWORK;
+   if (record._receiver == NetPacket::BROADCAST)
+      flags |= RECORD_BROADCAST;
+   if (!record._multicast_mask.empty())
+      flags |= RECORD_MULTICAST;
+   _stream.putByte(flags);
+
+   if (flags & RECORD_MULTICAST)
+   {
+      _stream.putVarint(record._multicast_mask.size());
+      for (UInt32 i = 0; i < record._multicast_mask.size(); i++)
+         _stream.putVarint(record._multicast_mask[i]);
+   }
+   else if (!(flags & RECORD_BROADCAST))
+   {
+      _stream.putVarint(record._receiver);
+   }
+
+   _stream.putVarint(record._modeled_length);
+
+   if (flags & RECORD_MEMORY_NETWORK)
+   {
+      _stream.putSignedVarint((SInt64) (record._address - _last_address));
+      _last_address = record._address;
+   }
+
+   _num_records ++;
+}
+
+// -- PacketTraceReader -- //
+
+PacketTraceReader::PacketTraceReader(string filename, UInt32 buffer_size)
+   : _stream(buffer_size)
+   , _is_open(false)
+   , _tile_id(INVALID_TILE_ID)
+   , _last_time(0)
+   , _last_address(0)
+{
+   if (!_stream.open(filename))
+      return;
+
+   switch (_stream.readHeader(PACKET_TRACE_MAGIC, PACKET_TRACE_VERSION, _tile_id))
+   {
+   case VarintInputStream::INVALID_MAGIC:
+      LOG_PRINT_WARNING("%s is not a packet trace", filename.c_str());
+      return;
+   case VarintInputStream::INVALID_VERSION:
+      LOG_PRINT_WARNING("Unsupported packet trace version in %s", filename.c_str());
+      return;
+   default:
+      _is_open = true;
+      return;
+   }
+}
+
+PacketTraceReader::~PacketTraceReader()
+{}
+
+bool
+PacketTraceReader::next(PacketTraceRecord& record)
+{
+   if (!_is_open)
+      return false;
+
+   SInt64 time_delta;
+   if (!_stream.getSignedVarint(time_delta))
+      return false;
+   _last_time += time_delta;
+   record._time = Time(_last_time);
+   record._sender = _tile_id;
+
+   UInt8 flags = 0;
+   bool valid = _stream.getByte(flags);
+   record._network_id = (flags & RECORD_MEMORY_NETWORK) ? STATIC_NETWORK_MEMORY : STATIC_NETWORK_USER;
+   record._multicast_mask.clear();
+
+   UInt64 value = 0;
+   if (flags & RECORD_MULTICAST)
+   {
+      record._receiver = NetPacket::BROADCAST;
+      valid = valid && _stream.getVarint(value);
+      record._multicast_mask.resize(value);
+      for (UInt32 i = 0; valid && (i < record._multicast_mask.size()); i++)
+         valid = _stream.getVarint(record._multicast_mask[i]);
+   }
+   else if (flags & RECORD_BROADCAST)
+   {
+      record._receiver = NetPacket::BROADCAST;
+   }
+   else
+   {
+      valid = valid && _stream.getVarint(value);
+      record._receiver = (tile_id_t) value;
+   }
+
+   valid = valid && _stream.getVarint(value);
+   record._modeled_length = (UInt32) value;
+
+   record._address = INVALID_ADDRESS;
+   if (flags & RECORD_MEMORY_NETWORK)
+   {
+      SInt64 address_delta = 0;
+      valid = valid && _stream.getSignedVarint(address_delta);
+      _last_address += address_delta;
+      record._address = _last_address;
+   }
+
+   LOG_ASSERT_ERROR(valid, "Truncated packet trace of tile(%i)", _tile_id);
+   return true;
+}
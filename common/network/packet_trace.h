@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "fixed_types.h"
+#include "time_types.h"
+#include "lock.h"
+#include "varint_stream.h"
+
+class NetPacket;
+class NetworkModel;
+class Tile;
+
+// A packet sent on the user or memory network, as recorded in a packet trace
+class PacketTraceRecord
+{
+public:
+   PacketTraceRecord()
+      : _time(0), _sender(INVALID_TILE_ID), _receiver(INVALID_TILE_ID), _network_id(0)
+      , _modeled_length(0), _address(INVALID_ADDRESS) {}
+
+   Time _time;
+   tile_id_t _sender;
+   tile_id_t _receiver;                   // NetPacket::BROADCAST for broadcasts and multicasts
+   SInt32 _network_id;                    // STATIC_NETWORK_USER or STATIC_NETWORK_MEMORY
+   UInt32 _modeled_length;                // In bits
+   IntPtr _address;                       // Cache line address (memory network only)
+   std::vector<UInt64> _multicast_mask;   // Empty unless the packet is a multicast
+};
+
+// Per-tile packet trace (packet_trace_<tile>.bin in the output directory), recorded in
+// Network::netSend() when [network/packet_trace] enabled = true and replayed by the
+// network_model_driver benchmark.
+// Only the packets the network models see are recorded: modeled packets between two
+// different application tiles on the user and memory networks.
+// Each record is a handful of varints: the (zigzag) time delta from the previous record,
+// a flags byte, the receiver or multicast mask, the modeled length and, on the memory
+// network, the (zigzag) cache line address delta. Records go through the fixed-size buffer
+// of a VarintOutputStream, so the trace is streamed to disk as the simulation runs.
+class PacketTraceWriter
+{
+public:
+   PacketTraceWriter(Tile* tile, UInt32 buffer_size);
+   ~PacketTraceWriter();
+
+   // Called (possibly concurrently by the app and sim threads) for every packet sent by the tile
+   void record(const NetPacket& packet, NetworkModel* model);
+
+   UInt64 getNumRecords() const { return _num_records; }
+
+   static std::string getFilename(tile_id_t tile_id);
+
+private:
+   Tile* _tile;
+   VarintOutputStream _stream;
+
+   UInt64 _last_time;
+   IntPtr _last_address;
+   UInt64 _num_records;
+
+   Lock _lock;
+
+   void write(const PacketTraceRecord& record);
+};
+
+class PacketTraceReader
+{
+public:
+   PacketTraceReader(std::string filename, UInt32 buffer_size = 1 << 16);
+   ~PacketTraceReader();
+
+   bool isOpen() const { return _is_open; }
+   tile_id_t getTileId() const { return _tile_id; }
+
+   // Returns false at the end of the trace
+   bool next(PacketTraceRecord& record);
+
+private:
+   VarintInputStream _stream;
+   bool _is_open;
+   tile_id_t _tile_id;
+
+   UInt64 _last_time;
+   IntPtr _last_address;
+};
@@ -32,6 +32,11 @@ enum PacketType
    CLOCK_SKEW_MANAGEMENT,
    REMOTE_QUERY,
    REMOTE_QUERY_RESPONSE,
+   SYNC_SERVER_REQUEST,
+   USER_COLLECTIVE,
+   // Packets replayed from a packet trace (length is the modeled length in bits),
+   // routed directly on the network models and never sent through netSend()
+   NETWORK_REPLAY,
    NUM_PACKET_TYPES
 };
 
@@ -84,7 +89,10 @@ static EStaticNetwork g_type_to_static_network_map[] __attribute__((unused)) =
    STATIC_NETWORK_SYSTEM,        // SYSTEM_INITIALIZATION_FINI
    STATIC_NETWORK_SYSTEM,        // CLOCK_SKEW_MANAGEMENT
    STATIC_NETWORK_SYSTEM,        // REMOTE_QUERY
-   STATIC_NETWORK_SYSTEM         // REMOTE_QUERY_RESPONSE
+   STATIC_NETWORK_SYSTEM,        // REMOTE_QUERY_RESPONSE
+   STATIC_NETWORK_USER,          // SYNC_SERVER_REQUEST
+   STATIC_NETWORK_USER,          // USER_COLLECTIVE
+   STATIC_NETWORK_USER           // NETWORK_REPLAY
 };
 
 #endif
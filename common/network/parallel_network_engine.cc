@@ -0,0 +1,352 @@
+#include <cstring>
+#include "parallel_network_engine.h"
+#include "network.h"
+#include "network_model.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "host_placement.h"
+#include "config.h"
+#include "log.h"
+
+ParallelNetworkEngine::ParallelNetworkEngine()
+   : _num_tiles(Config::getSingleton()->getTotalTiles())
+   , _running(false)
+   , _total_injections(0)
+   , _total_collected_injections(0)
+   , _idle(false)
+   , _quit(false)
+   , _exit(false)
+   , _total_epochs(0)
+{
+   SInt32 num_workers = 0;
+   UInt64 lookahead = 0;
+   try
+   {
+      num_workers = Sim()->getCfg()->getInt("network/parallel_engine/num_threads", 2);
+      // Lookahead (smallest delay of a hop between two tiles) is specified in picoseconds
+      lookahead = (UInt64) Sim()->getCfg()->getInt("network/parallel_engine/lookahead", 1000);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [network/parallel_engine] parameters from the cfg file");
+   }
+
+   LOG_ASSERT_ERROR(Sim()->getCfg()->getBool("network/enable_shared_memory_shortcut", false),
+                    "The parallel network engine needs the shared memory shortcut");
+   LOG_ASSERT_ERROR(num_workers >= 1, "Num Threads(%i) must be >= 1", num_workers);
+   num_workers = std::min<SInt32>(num_workers, _num_tiles);
+   _lookahead = Time(lookahead);
+
+   for (SInt32 i = 0; i < num_workers; i++)
+      _worker_list.push_back(new Worker(this, i, num_workers));
+   _injection_sequence_num_list.resize(_num_tiles, 0);
+
+   pthread_barrier_init(&_barrier, NULL, num_workers);
+}
+
+ParallelNetworkEngine::~ParallelNetworkEngine()
+{
+   LOG_ASSERT_ERROR(!_running, "Parallel network engine destroyed while running");
+   pthread_barrier_destroy(&_barrier);
+   for (UInt32 i = 0; i < _worker_list.size(); i++)
+      delete _worker_list[i];
+}
+
+bool
+ParallelNetworkEngine::isEnabled()
+{
+   return Sim()->getCfg()->getBool("network/parallel_engine/enabled", false);
+}
+
+void
+ParallelNetworkEngine::spawnThreads()
+{
+   LOG_PRINT("Spawning %u parallel network engine threads", _worker_list.size());
+   _running = true;
+   for (UInt32 i = 0; i < _worker_list.size(); i++)
+      _worker_list[i]->_thread->spawn();
+}
+
+void
+ParallelNetworkEngine::quitThreads()
+{
+   // Stop accepting packets: an injection in progress holds the lock of its worker
+   _running = false;
+   for (UInt32 i = 0; i < _worker_list.size(); i++)
+   {
+      _worker_list[i]->_injection_lock.acquire();
+      _worker_list[i]->_injection_lock.release();
+   }
+
+   _idle_lock.acquire();
+   _quit = true;
+   _idle_cond.broadcast();
+   _idle_lock.release();
+
+   for (UInt32 i = 0; i < _worker_list.size(); i++)
+      _worker_list[i]->_thread->join();
+   LOG_PRINT("Parallel network engine threads exited");
+}
+
+bool
+ParallelNetworkEngine::injectPacket(const NetPacket& packet)
+{
+   tile_id_t sender = TILE_ID(packet.sender);
+   Worker* worker = _worker_list[getWorkerID(sender)];
+
+   worker->_injection_lock.acquire();
+   if (!_running)
+   {
+      worker->_injection_lock.release();
+      return false;
+   }
+   UInt64 sequence_num = __sync_fetch_and_add(&_injection_sequence_num_list[sender], 1);
+   worker->_injection_queue.push_back(Event(makeBuffer(packet, sender), sender, sequence_num, true));
+   worker->_injection_lock.release();
+
+   // Wake up the workers if they are waiting for packets (see waitForInjections())
+   __sync_fetch_and_add(&_total_injections, 1);
+   if (_idle)
+   {
+      _idle_lock.acquire();
+      _idle_cond.broadcast();
+      _idle_lock.release();
+   }
+
+   return true;
+}
+
+void
+ParallelNetworkEngine::workerThreadFunc(void* param)
+{
+   Worker* worker = (Worker*) param;
+   worker->_engine->runWorker(worker);
+}
+
+void
+ParallelNetworkEngine::runWorker(Worker* worker)
+{
+   LOG_PRINT("Parallel network engine thread (%i) starting", worker->_id);
+   // The workers are busy as long as packets are in flight, so they are kept off the system CPUs
+   Sim()->getHostPlacement()->unpinThread();
+
+   Time prev_window_end(0);
+   while (true)
+   {
+      collectEvents(worker);
+      pthread_barrier_wait(&_barrier);
+
+      // Every worker computes the same window from the earliest events of all the workers
+      bool has_pending_events = false;
+      Time window_start(0);
+      for (UInt32 i = 0; i < _worker_list.size(); i++)
+      {
+         if (_worker_list[i]->_has_pending_events &&
+             (!has_pending_events || (_worker_list[i]->_earliest_event_time < window_start)))
+         {
+            window_start = _worker_list[i]->_earliest_event_time;
+            has_pending_events = true;
+         }
+      }
+
+      if (!has_pending_events)
+      {
+         if (worker->_id == 0)
+            _exit = waitForInjections();
+         pthread_barrier_wait(&_barrier);
+         if (_exit)
+            break;
+         continue;
+      }
+
+      Time window_end = window_start + _lookahead;
+      processEvents(worker, prev_window_end, window_end);
+      prev_window_end = window_end;
+      if (worker->_id == 0)
+         _total_epochs ++;
+
+      pthread_barrier_wait(&_barrier);
+   }
+
+   LOG_PRINT("Parallel network engine thread (%i) exiting", worker->_id);
+}
+
+void
+ParallelNetworkEngine::collectEvents(Worker* worker)
+{
+   worker->_injection_lock.acquire();
+   vector<Event> injection_queue;
+   injection_queue.swap(worker->_injection_queue);
+   worker->_injection_lock.release();
+
+   for (vector<Event>::iterator it = injection_queue.begin(); it != injection_queue.end(); it++)
+      worker->_event_queue.push(*it);
+   if (!injection_queue.empty())
+      __sync_fetch_and_add(&_total_collected_injections, injection_queue.size());
+
+   // Hops the other workers produced in the previous epoch
+   for (UInt32 i = 0; i < _worker_list.size(); i++)
+   {
+      vector<Event>& outbox = _worker_list[i]->_outbox_list[worker->_id];
+      for (vector<Event>::iterator it = outbox.begin(); it != outbox.end(); it++)
+         worker->_event_queue.push(*it);
+      outbox.clear();
+   }
+
+   worker->_has_pending_events = !worker->_event_queue.empty();
+   if (worker->_has_pending_events)
+      worker->_earliest_event_time = worker->_event_queue.top()._time;
+}
+
+void
+ParallelNetworkEngine::processEvents(Worker* worker, const Time& prev_window_end, const Time& window_end)
+{
+   while (!worker->_event_queue.empty() && (worker->_event_queue.top()._time < window_end))
+   {
+      Event event = worker->_event_queue.top();
+      worker->_event_queue.pop();
+
+      worker->_total_events ++;
+      if (event._time < prev_window_end)
+      {
+         if (event._injected)
+            worker->_total_late_injections ++;
+         else
+            worker->_total_lookahead_violations ++;
+      }
+
+      routeEvent(worker, event);
+   }
+}
+
+void
+ParallelNetworkEngine::routeEvent(Worker* worker, const Event& event)
+{
+   NetPacket* pkt = (NetPacket*) event._buffer;
+   UInt32 buffer_size = pkt->bufferSize();
+
+   Network* network = Sim()->getTileManager()->getTileFromID(event._tile)->getNetwork();
+   NetworkModel* model = network->getNetworkModelFromPacketType(pkt->type);
+
+   queue<NetworkModel::Hop> hop_queue;
+   model->__routePacket(*pkt, hop_queue);
+
+   while (!hop_queue.empty())
+   {
+      NetworkModel::Hop hop = hop_queue.front();
+      hop_queue.pop();
+
+      Byte* buffer = makeBuffer(*pkt, event._tile);
+      NetPacket* hop_pkt = (NetPacket*) buffer;
+      hop_pkt->node_type = hop._next_node_type;
+      hop_pkt->time = hop._time;
+      hop_pkt->zero_load_delay = hop._zero_load_delay;
+      hop_pkt->contention_delay = hop._contention_delay;
+
+      if (hop._next_node_type == NetworkModel::RECEIVE_TILE)
+      {
+         LOG_PRINT("Send packet : type %i, from %i to %i, next_hop %i, tile_id %i, time %llu",
+                   (SInt32) hop_pkt->type, hop_pkt->sender.tile_id, hop_pkt->receiver.tile_id,
+                   hop._next_tile_id, event._tile, hop._time.toNanosec());
+         network->getTransport()->send(hop._next_tile_id, buffer, buffer_size);
+         delete [] buffer;
+      }
+      else
+      {
+         Event next_event(buffer, hop._next_tile_id, event._sequence_num, false);
+         SInt32 next_worker_id = getWorkerID(hop._next_tile_id);
+         if (next_worker_id == worker->_id)
+            worker->_event_queue.push(next_event);
+         else
+            worker->_outbox_list[next_worker_id].push_back(next_event);
+      }
+   }
+
+   delete [] event._buffer;
+}
+
+bool
+ParallelNetworkEngine::waitForInjections()
+{
+   ScopedLock sl(_idle_lock);
+
+   _idle = true;
+   __sync_synchronize();
+   while ((_total_injections == _total_collected_injections) && !_quit)
+      _idle_cond.wait(_idle_lock);
+   _idle = false;
+
+   // Packets can no longer be injected once _quit is set
+   return (_quit && (_total_injections == _total_collected_injections));
+}
+
+Byte*
+ParallelNetworkEngine::makeBuffer(const NetPacket& packet, tile_id_t tile)
+{
+   Byte* buffer = new(tile) Byte[packet.bufferSize()];
+   packet.makeBuffer(buffer);
+
+   // The payload and multicast mask of the copy live in the buffer
+   NetPacket* buf_pkt = (NetPacket*) buffer;
+   if (buf_pkt->length > 0)
+      buf_pkt->data = buffer + sizeof(NetPacket);
+   if (buf_pkt->multicast_mask_length > 0)
+      buf_pkt->multicast_mask = (const UInt64*) (buffer + sizeof(NetPacket) + buf_pkt->length);
+   return buffer;
+}
+
+void
+ParallelNetworkEngine::outputSummary(ostream& out)
+{
+   out << "Parallel Network Engine Summary: " << endl;
+   out << "  Num Threads: " << _worker_list.size() << endl;
+   out << "  Lookahead (in picoseconds): " << _lookahead.toPicosec() << endl;
+   out << "  Epochs: " << _total_epochs << endl;
+   for (UInt32 i = 0; i < _worker_list.size(); i++)
+   {
+      Worker* worker = _worker_list[i];
+      out << "  Thread " << i << ":" << endl;
+      out << "    Events: " << worker->_total_events << endl;
+      out << "    Late Injections: " << worker->_total_late_injections << endl;
+      out << "    Lookahead Violations: " << worker->_total_lookahead_violations << endl;
+   }
+}
+
+ParallelNetworkEngine::Event::Event(Byte* buffer, tile_id_t tile, UInt64 sequence_num, bool injected)
+   : _buffer(buffer)
+   , _time(((NetPacket*) buffer)->time)
+   , _sender(TILE_ID(((NetPacket*) buffer)->sender))
+   , _sequence_num(sequence_num)
+   , _tile(tile)
+   , _injected(injected)
+{}
+
+bool
+ParallelNetworkEngine::Event::operator>(const Event& event) const
+{
+   if (!(_time == event._time))
+      return (_time > event._time);
+   if (_sender != event._sender)
+      return (_sender > event._sender);
+   if (_sequence_num != event._sequence_num)
+      return (_sequence_num > event._sequence_num);
+   return (_tile > event._tile);
+}
+
+ParallelNetworkEngine::Worker::Worker(ParallelNetworkEngine* engine, SInt32 id, SInt32 num_workers)
+   : _engine(engine)
+   , _id(id)
+   , _has_pending_events(false)
+   , _outbox_list(num_workers)
+   , _total_events(0)
+   , _total_late_injections(0)
+   , _total_lookahead_violations(0)
+{
+   _thread = Thread::create(ParallelNetworkEngine::workerThreadFunc, this);
+}
+
+ParallelNetworkEngine::Worker::~Worker()
+{
+   delete _thread;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <iostream>
+#include <pthread.h>
+using std::vector;
+using std::priority_queue;
+using std::ostream;
+
+#include "fixed_types.h"
+#include "common_types.h"
+#include "time_types.h"
+#include "thread.h"
+#include "lock.h"
+#include "cond.h"
+
+class NetPacket;
+
+// Routes packets hop by hop on a pool of host threads when the shared memory shortcut is
+// enabled, instead of walking all the hops of a packet on the thread that sends it.
+//  - Every worker owns the network models of a contiguous block of tiles, so the routers
+//    of a tile are only ever touched by one host thread. The workers are not pinned, they
+//    run on any host CPU of the process (see HostPlacement::unpinThread()).
+//  - Workers run in epochs separated by barriers (conservative PDES). An epoch routes the
+//    events in the window [earliest pending event, earliest pending event + lookahead),
+//    in (time, sender, sequence number, tile) order.
+//  - Hops to the tiles of another worker go to a per worker pair outbox that is only read
+//    after the next barrier, so the routing path takes no locks.
+//  - Packets injected by the application & sim threads are collected at the start of an
+//    epoch. Within an epoch the order is fixed, but the epoch a packet is collected in
+//    depends on when its sender runs on the host, so the order in which the routers see
+//    packets (and the resulting contention delays) can change from run to run.
+//    Packets collected after the window that contains their time are counted as late injections.
+//  - The lookahead is the smallest delay of a hop between two tiles. Hops that arrive
+//    later than that are still routed in order, and are counted as lookahead violations.
+class ParallelNetworkEngine
+{
+public:
+   ParallelNetworkEngine();
+   ~ParallelNetworkEngine();
+
+   static bool isEnabled();
+
+   void spawnThreads();
+   // Routes the packets still in flight, then stops the workers
+   void quitThreads();
+
+   // Returns false if the engine is not running (the caller then routes the packet itself)
+   bool injectPacket(const NetPacket& packet);
+
+   void outputSummary(ostream& out);
+
+private:
+   class Event
+   {
+   public:
+      Event(Byte* buffer, tile_id_t tile, UInt64 sequence_num, bool injected);
+
+      bool operator>(const Event& event) const;
+
+      // NetPacket followed by its payload and multicast mask (see NetPacket::makeBuffer)
+      Byte* _buffer;
+      Time _time;
+      tile_id_t _sender;
+      UInt64 _sequence_num;
+      // Tile whose network model routes the packet
+      tile_id_t _tile;
+      bool _injected;
+   };
+
+   typedef priority_queue<Event, vector<Event>, std::greater<Event> > EventQueue;
+
+   class Worker
+   {
+   public:
+      Worker(ParallelNetworkEngine* engine, SInt32 id, SInt32 num_workers);
+      ~Worker();
+
+      ParallelNetworkEngine* _engine;
+      SInt32 _id;
+      Thread* _thread;
+
+      EventQueue _event_queue;
+      // Time of the earliest event in _event_queue (valid if _has_pending_events)
+      Time _earliest_event_time;
+      bool _has_pending_events;
+
+      // Packets injected by the application & sim threads of the tiles of the worker
+      vector<Event> _injection_queue;
+      Lock _injection_lock;
+
+      // Hops to the tiles of every worker, produced in the current epoch
+      vector<vector<Event> > _outbox_list;
+
+      // Event Counters
+      UInt64 _total_events;
+      UInt64 _total_late_injections;
+      UInt64 _total_lookahead_violations;
+   };
+
+   vector<Worker*> _worker_list;
+   SInt32 _num_tiles;
+   Time _lookahead;
+   // Packets injected by each sender tile so far
+   vector<UInt64> _injection_sequence_num_list;
+
+   bool _running;
+   pthread_barrier_t _barrier;
+
+   // Workers sleep when no packets are in flight
+   volatile UInt64 _total_injections;
+   volatile UInt64 _total_collected_injections;
+   volatile bool _idle;
+   volatile bool _quit;
+   bool _exit;
+   Lock _idle_lock;
+   ConditionVariable _idle_cond;
+
+   UInt64 _total_epochs;
+
+   static void workerThreadFunc(void* param);
+   void runWorker(Worker* worker);
+
+   SInt32 getWorkerID(tile_id_t tile)
+   { return (SInt32) ((((UInt64) tile) * _worker_list.size()) / _num_tiles); }
+
+   void collectEvents(Worker* worker);
+   void processEvents(Worker* worker, const Time& prev_window_end, const Time& window_end);
+   void routeEvent(Worker* worker, const Event& event);
+   // Returns true if the workers should exit
+   bool waitForInjections();
+
+   // Copy of the packet, allocated on the heap of 'tile'
+   static Byte* makeBuffer(const NetPacket& packet, tile_id_t tile);
+};
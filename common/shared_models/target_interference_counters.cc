@@ -0,0 +1,71 @@
+#include "target_interference_counters.h"
+#include "config.h"
+#include "log.h"
+
+using std::endl;
+
+TargetInterferenceCounters::TargetInterferenceCounters(string resource_name)
+   : _resource_name(resource_name)
+{
+   UInt32 num_targets = Config::getSingleton()->getTargetCount();
+   _total_requests.resize(num_targets);
+   _total_occupancy.resize(num_targets);
+   _total_queueing_delay.resize(num_targets);
+   reset();
+}
+
+TargetInterferenceCounters::~TargetInterferenceCounters()
+{}
+
+void
+TargetInterferenceCounters::record(UInt32 target_num, const Time& occupancy, const Time& queueing_delay)
+{
+   LOG_ASSERT_ERROR(target_num < _total_requests.size(), "%s: Target(%u), Num Targets(%u)",
+                    _resource_name.c_str(), target_num, _total_requests.size());
+
+   _total_requests[target_num] ++;
+   _total_occupancy[target_num] += occupancy;
+   _total_queueing_delay[target_num] += queueing_delay;
+}
+
+void
+TargetInterferenceCounters::reset()
+{
+   for (UInt32 i = 0; i < _total_requests.size(); i++)
+   {
+      _total_requests[i] = 0;
+      _total_occupancy[i] = Time(0);
+      _total_queueing_delay[i] = Time(0);
+   }
+}
+
+void
+TargetInterferenceCounters::outputSummary(ostream& out, string indent) const
+{
+   if (_total_requests.size() <= 1)
+      return;
+
+   for (UInt32 i = 0; i < _total_requests.size(); i++)
+   {
+      out << indent << "Target " << i << " " << _resource_name << " Requests: " << _total_requests[i] << endl;
+      out << indent << "Target " << i << " Total " << _resource_name << " Occupancy (in nanoseconds): "
+          << _total_occupancy[i].toNanosec() << endl;
+      out << indent << "Target " << i << " Total " << _resource_name << " Queueing Delay (in nanoseconds): "
+          << _total_queueing_delay[i].toNanosec() << endl;
+   }
+}
+
+void
+TargetInterferenceCounters::dummyOutputSummary(ostream& out, string resource_name, string indent)
+{
+   UInt32 num_targets = Config::getSingleton()->getTargetCount();
+   if (num_targets <= 1)
+      return;
+
+   for (UInt32 i = 0; i < num_targets; i++)
+   {
+      out << indent << "Target " << i << " " << resource_name << " Requests: " << endl;
+      out << indent << "Target " << i << " Total " << resource_name << " Occupancy (in nanoseconds): " << endl;
+      out << indent << "Target " << i << " Total " << resource_name << " Queueing Delay (in nanoseconds): " << endl;
+   }
+}
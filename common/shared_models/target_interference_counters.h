@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+using std::string;
+using std::vector;
+using std::ostream;
+
+#include "fixed_types.h"
+#include "time_types.h"
+
+// Per-target accounting for a resource that the targets of a multi-application run share
+// (a DRAM controller, the routers on the path of a packet, a directory).
+// For every target, counts the requests the resource served, the time they occupied it
+// and the queueing delay they saw behind requests of any target.
+// Nothing is printed when a single target is simulated.
+class TargetInterferenceCounters
+{
+public:
+   TargetInterferenceCounters(string resource_name);
+   ~TargetInterferenceCounters();
+
+   void record(UInt32 target_num, const Time& occupancy, const Time& queueing_delay);
+   void reset();
+
+   void outputSummary(ostream& out, string indent) const;
+   static void dummyOutputSummary(ostream& out, string resource_name, string indent);
+
+private:
+   string _resource_name;
+
+   vector<UInt64> _total_requests;
+   vector<Time> _total_occupancy;
+   vector<Time> _total_queueing_delay;
+};
@@ -0,0 +1,354 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <cstring>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_placement.h"
+#include "simulator.h"
+#include "config.h"
+#include "log.h"
+
+using std::string;
+using std::vector;
+using std::endl;
+
+HostPlacement::HostPlacement()
+{
+   try
+   {
+      _policy = parsePolicy(Sim()->getCfg()->getString("host/pinning", "none"));
+      _isolate_system_threads = Sim()->getCfg()->getBool("host/isolate_system_threads", true);
+      _numa_local_allocation = Sim()->getCfg()->getBool("host/numa_local_allocation", true);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [host] parameters from the config file");
+   }
+
+   CPU_ZERO(&_initial_affinity);
+   sched_getaffinity(0, sizeof(_initial_affinity), &_initial_affinity);
+
+   UInt32 num_local_tiles = Config::getSingleton()->getNumLocalTiles();
+   _app_thread_cpu.resize(num_local_tiles, -1);
+   _sim_thread_cpu.resize(num_local_tiles, -1);
+   _tile_socket.resize(num_local_tiles, -1);
+   _num_host_processes = 1;
+   _host_process_index = 0;
+
+   if (_policy == TILE_AFFINITY)
+   {
+      discoverHostCores();
+      findHostProcesses();
+      partitionHostCores();
+      lockHostCpus();
+      computePlacement();
+   }
+
+   std::ostringstream name;
+   name << "host_placement_" << Config::getSingleton()->getCurrentProcessNum() << ".out";
+   std::ofstream placement_file(Config::getSingleton()->formatOutputFileName(name.str()).c_str());
+   outputPlacement(placement_file);
+   placement_file.close();
+}
+
+HostPlacement::~HostPlacement()
+{
+   for (UInt32 i = 0; i < _host_cpu_locks.size(); i++)
+   {
+      unlink(_host_cpu_locks[i].second.c_str());
+      close(_host_cpu_locks[i].first);
+   }
+}
+
+HostPlacement::Policy
+HostPlacement::parsePolicy(string policy)
+{
+   if (policy == "none")
+      return NONE;
+   else if (policy == "tile_affinity")
+      return TILE_AFFINITY;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized host pinning policy(%s)", policy.c_str());
+      return NUM_POLICIES;
+   }
+}
+
+SInt32
+HostPlacement::readTopologyValue(SInt32 cpu, string name)
+{
+   std::ostringstream filename;
+   filename << "/sys/devices/system/cpu/cpu" << cpu << "/topology/" << name;
+   std::ifstream topology_file(filename.str().c_str());
+   SInt32 value = -1;
+   if (topology_file.good())
+      topology_file >> value;
+   return value;
+}
+
+// Group the host CPUs this process may run on into host cores (SMT siblings), ordered by socket
+void
+HostPlacement::discoverHostCores()
+{
+   std::map<std::pair<SInt32,SInt32>, HostCore> host_core_map;
+   for (SInt32 cpu = 0; cpu < CPU_SETSIZE; cpu++)
+   {
+      if (!CPU_ISSET(cpu, &_initial_affinity))
+         continue;
+
+      SInt32 socket = readTopologyValue(cpu, "physical_package_id");
+      SInt32 core = readTopologyValue(cpu, "core_id");
+      if ((socket < 0) || (core < 0))
+      {
+         // Topology not exported, every CPU is a core of its own
+         socket = 0;
+         core = cpu;
+      }
+
+      HostCore& host_core = host_core_map[std::make_pair(socket, core)];
+      host_core.socket = socket;
+      host_core.core = core;
+      host_core.cpus.push_back(cpu);
+   }
+
+   for (std::map<std::pair<SInt32,SInt32>, HostCore>::iterator it = host_core_map.begin(); it != host_core_map.end(); it++)
+      _host_cores.push_back(it->second);
+}
+
+// Processes mapped to the same address in [process_map] run on the same host
+void
+HostPlacement::findHostProcesses()
+{
+   Config* config = Config::getSingleton();
+   if (config->getProcessCount() == 1)
+      return;
+
+   vector<string> process_addresses(config->getProcessCount());
+   for (UInt32 i = 0; i < config->getProcessCount(); i++)
+   {
+      std::ostringstream key;
+      key << "process_map/process" << i;
+      try
+      {
+         process_addresses[i] = Sim()->getCfg()->getString(key.str());
+      }
+      catch (...)
+      {
+         LOG_PRINT_ERROR("Key: %s not found in config!", key.str().c_str());
+      }
+   }
+
+   UInt32 current_process_num = config->getCurrentProcessNum();
+   _num_host_processes = 0;
+   for (UInt32 i = 0; i < config->getProcessCount(); i++)
+   {
+      if (process_addresses[i] == process_addresses[current_process_num])
+      {
+         if (i == current_process_num)
+            _host_process_index = _num_host_processes;
+         _num_host_processes ++;
+      }
+   }
+}
+
+// Each process on the host keeps its own contiguous slice of the host cores
+void
+HostPlacement::partitionHostCores()
+{
+   UInt32 num_host_cores = _host_cores.size();
+   LOG_ASSERT_ERROR(num_host_cores >= _num_host_processes,
+                    "%u processes run on this host but only %u host cores are available: processes would share host cores",
+                    _num_host_processes, num_host_cores);
+
+   UInt32 first_host_core = (_host_process_index * num_host_cores) / _num_host_processes;
+   UInt32 last_host_core = ((_host_process_index + 1) * num_host_cores) / _num_host_processes;
+   _host_cores = vector<HostCore>(_host_cores.begin() + first_host_core, _host_cores.begin() + last_host_core);
+}
+
+// Take a lock on each host CPU of the process, so that two processes placed on the same
+// CPUs (e.g., with a wrong [process_map] or a different initial affinity) fail at start-up
+void
+HostPlacement::lockHostCpus()
+{
+   char host_name[256];
+   if (gethostname(host_name, sizeof(host_name)) != 0)
+      strncpy(host_name, "localhost", sizeof(host_name));
+   host_name[sizeof(host_name) - 1] = '\0';
+
+   for (UInt32 i = 0; i < _host_cores.size(); i++)
+   {
+      for (UInt32 j = 0; j < _host_cores[i].cpus.size(); j++)
+      {
+         std::ostringstream name;
+         name << "host_cpu_" << host_name << "_" << _host_cores[i].cpus[j] << ".lock";
+         string filename = Config::getSingleton()->formatOutputFileName(name.str());
+
+         int fd = open(filename.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+         LOG_ASSERT_ERROR(fd >= 0, "Could not open host CPU lock file(%s)", filename.c_str());
+         LOG_ASSERT_ERROR(flock(fd, LOCK_EX | LOCK_NB) == 0,
+                          "Host CPU %i is already used by another process of the simulation", _host_cores[i].cpus[j]);
+         _host_cpu_locks.push_back(std::make_pair(fd, filename));
+      }
+   }
+}
+
+void
+HostPlacement::computePlacement()
+{
+   if (_host_cores.empty())
+      return;
+
+   // The system threads get the last host core if there is more than one
+   UInt32 num_tile_host_cores = _host_cores.size();
+   if (_isolate_system_threads && (_host_cores.size() > 1))
+   {
+      num_tile_host_cores --;
+      _system_cpus = _host_cores.back().cpus;
+   }
+
+   Config* config = Config::getSingleton();
+   const Config::TileList& local_tiles = config->getTileListForCurrentProcess();
+
+   vector<std::pair<tile_id_t, UInt32> > application_tiles;
+   for (UInt32 i = 0; i < local_tiles.size(); i++)
+   {
+      if (local_tiles[i] < (tile_id_t) config->getApplicationTiles())
+         application_tiles.push_back(std::make_pair(local_tiles[i], i));
+   }
+   // Tile IDs are laid out row by row on the mesh, so consecutive IDs are neighbors
+   std::sort(application_tiles.begin(), application_tiles.end());
+
+   UInt32 num_application_tiles = application_tiles.size();
+   for (UInt32 k = 0; k < num_application_tiles; k++)
+   {
+      const HostCore& host_core = _host_cores[(k * num_tile_host_cores) / num_application_tiles];
+      UInt32 tile_index = application_tiles[k].second;
+      _app_thread_cpu[tile_index] = host_core.cpus[0];
+      _sim_thread_cpu[tile_index] = host_core.cpus[(host_core.cpus.size() > 1) ? 1 : 0];
+      _tile_socket[tile_index] = host_core.socket;
+   }
+}
+
+void
+HostPlacement::pinCurrentThread(const vector<SInt32>& cpus)
+{
+   if (cpus.empty())
+      return;
+
+   cpu_set_t cpu_set;
+   CPU_ZERO(&cpu_set);
+   for (UInt32 i = 0; i < cpus.size(); i++)
+      CPU_SET(cpus[i], &cpu_set);
+   if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+      LOG_PRINT_WARNING("Could not pin thread to host CPU %i", cpus[0]);
+}
+
+void
+HostPlacement::pinAppThread(UInt32 tile_index)
+{
+   if (_policy == NONE)
+      return;
+   LOG_ASSERT_ERROR(tile_index < _app_thread_cpu.size(), "Tile index(%u) out of range", tile_index);
+
+   if (_app_thread_cpu[tile_index] >= 0)
+      pinCurrentThread(vector<SInt32>(1, _app_thread_cpu[tile_index]));
+   else
+      pinCurrentThread(_system_cpus);
+}
+
+void
+HostPlacement::pinSimThread(UInt32 tile_index)
+{
+   if (_policy == NONE)
+      return;
+   LOG_ASSERT_ERROR(tile_index < _sim_thread_cpu.size(), "Tile index(%u) out of range", tile_index);
+
+   if (_sim_thread_cpu[tile_index] >= 0)
+      pinCurrentThread(vector<SInt32>(1, _sim_thread_cpu[tile_index]));
+   else
+      pinCurrentThread(_system_cpus);
+}
+
+void
+HostPlacement::pinSystemThread()
+{
+   if (_policy == NONE)
+      return;
+   pinCurrentThread(_system_cpus);
+}
+
+void
+HostPlacement::unpinThread()
+{
+   if (_policy == NONE)
+      return;
+
+   vector<SInt32> process_cpus;
+   for (UInt32 i = 0; i < _host_cores.size(); i++)
+      process_cpus.insert(process_cpus.end(), _host_cores[i].cpus.begin(), _host_cores[i].cpus.end());
+   pinCurrentThread(process_cpus);
+}
+
+// Run the construction of the tile on the CPUs of its socket, so that its model
+// state is first touched, and hence allocated, on the NUMA node of the socket
+void
+HostPlacement::beginTileConstruction(UInt32 tile_index)
+{
+   if ((_policy == NONE) || !_numa_local_allocation || (_tile_socket[tile_index] < 0))
+      return;
+
+   vector<SInt32> socket_cpus;
+   for (UInt32 i = 0; i < _host_cores.size(); i++)
+   {
+      if (_host_cores[i].socket == _tile_socket[tile_index])
+         socket_cpus.insert(socket_cpus.end(), _host_cores[i].cpus.begin(), _host_cores[i].cpus.end());
+   }
+   pinCurrentThread(socket_cpus);
+}
+
+void
+HostPlacement::endTileConstruction()
+{
+   if ((_policy == NONE) || !_numa_local_allocation)
+      return;
+   sched_setaffinity(0, sizeof(_initial_affinity), &_initial_affinity);
+}
+
+void
+HostPlacement::outputPlacement(std::ostream& os)
+{
+   Config* config = Config::getSingleton();
+   const Config::TileList& local_tiles = config->getTileListForCurrentProcess();
+
+   os << "Host Placement (Target " << config->getCurrentTargetNum() << ", Process " << config->getCurrentProcessNum() << "):" << endl;
+   os << "  Policy: " << ((_policy == TILE_AFFINITY) ? "tile_affinity" : "none") << endl;
+   if (_policy == NONE)
+      return;
+
+   os << "  Host Cores: " << _host_cores.size() << " (Process " << _host_process_index << " of " << _num_host_processes << " on this host)" << endl;
+   os << "  NUMA Local Allocation: " << (_numa_local_allocation ? "true" : "false") << endl;
+   os << "  System Threads (MCP, LCP, Statistics) CPUs:";
+   if (_system_cpus.empty())
+      os << " any";
+   for (UInt32 i = 0; i < _system_cpus.size(); i++)
+      os << " " << _system_cpus[i];
+   os << endl;
+
+   for (UInt32 i = 0; i < local_tiles.size(); i++)
+   {
+      os << "  Tile " << local_tiles[i] << ": ";
+      if (_app_thread_cpu[i] >= 0)
+      {
+         os << "Socket " << _tile_socket[i] << ", App Thread CPU " << _app_thread_cpu[i]
+            << ", Sim Thread CPU " << _sim_thread_cpu[i] << endl;
+      }
+      else
+      {
+         os << "System CPUs" << endl;
+      }
+   }
+}
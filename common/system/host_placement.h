@@ -0,0 +1,87 @@
+#ifndef HOST_PLACEMENT_H
+#define HOST_PLACEMENT_H
+
+#include <sched.h>
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "fixed_types.h"
+
+// Placement of the host threads of this process on the host CPUs ([host] section).
+// With the 'tile_affinity' policy:
+//  - The processes that run on the same host (see [process_map]) split its host cores,
+//    and each process checks at start-up that no other process holds its host CPUs.
+//  - The application tiles of the process are spread over its host cores in tile ID order,
+//    so bands of neighboring tiles on the mesh share a socket.
+//  - The app thread and the sim thread of a tile run on SMT siblings of the same host core.
+//  - The MCP, LCP and statistics threads (and the threads of the MCP and thread-spawner tiles)
+//    can be isolated on a host core of their own.
+//  - The model state of each tile can be allocated on the NUMA node of its host core, by
+//    constructing the tile on that node (first-touch allocation).
+// The placement is written to host_placement_<process>.out at start-up.
+class HostPlacement
+{
+public:
+   enum Policy
+   {
+      NONE = 0,
+      TILE_AFFINITY,
+      NUM_POLICIES
+   };
+
+   HostPlacement();
+   ~HostPlacement();
+
+   // Called by the thread being placed
+   void pinAppThread(UInt32 tile_index);
+   void pinSimThread(UInt32 tile_index);
+   void pinSystemThread();
+   // Lets the thread run on any host CPU of the process (threads inherit the CPUs of their creator)
+   void unpinThread();
+
+   // Called around the construction of the model state of a tile
+   void beginTileConstruction(UInt32 tile_index);
+   void endTileConstruction();
+
+   void outputPlacement(std::ostream& os);
+
+private:
+   struct HostCore
+   {
+      SInt32 socket;
+      SInt32 core;
+      std::vector<SInt32> cpus;   // SMT siblings
+   };
+
+   Policy _policy;
+   bool _isolate_system_threads;
+   bool _numa_local_allocation;
+
+   std::vector<HostCore> _host_cores;
+   // Host CPUs of the app and sim thread of each local tile (-1 if not pinned)
+   std::vector<SInt32> _app_thread_cpu;
+   std::vector<SInt32> _sim_thread_cpu;
+   std::vector<SInt32> _tile_socket;
+   std::vector<SInt32> _system_cpus;
+
+   cpu_set_t _initial_affinity;
+
+   // Processes on this host, and the index of this process among them
+   UInt32 _num_host_processes;
+   UInt32 _host_process_index;
+   // Locks on the host CPUs of this process
+   std::vector<std::pair<int, std::string> > _host_cpu_locks;
+
+   void discoverHostCores();
+   void findHostProcesses();
+   void partitionHostCores();
+   void lockHostCpus();
+   void computePlacement();
+   void pinCurrentThread(const std::vector<SInt32>& cpus);
+
+   static Policy parsePolicy(std::string policy);
+   static SInt32 readTopologyValue(SInt32 cpu, std::string name);
+};
+
+#endif // HOST_PLACEMENT_H
@@ -6,6 +6,7 @@
 #include "tile_manager.h"
 #include "performance_counter_manager.h"
 #include "clock_skew_management_object.h"
+#include "host_placement.h"
 
 #include "log.h"
 
@@ -27,6 +28,7 @@ LCP::~LCP()
 void LCP::run()
 {
    LOG_PRINT("LCP started.");
+   Sim()->getHostPlacement()->pinSystemThread();
 
    while (!_finished)
       processPacket();
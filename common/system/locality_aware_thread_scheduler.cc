@@ -0,0 +1,214 @@
+#include <cmath>
+#include <cstdlib>
+#include <time.h>
+#include "locality_aware_thread_scheduler.h"
+#include "thread_manager.h"
+#include "tile_manager.h"
+#include "config.h"
+#include "tile.h"
+#include "log.h"
+
+LocalityAwareThreadScheduler::LocalityAwareThreadScheduler(ThreadManager* thread_manager, TileManager* tile_manager)
+   : RoundRobinThreadScheduler(thread_manager, tile_manager)
+   , m_last_remap_time((UInt32) time(NULL))
+   , m_num_remaps(0)
+   , m_num_migrations(0)
+   , m_total_remapped_traffic(0)
+   , m_total_weighted_hops_before_remap(0)
+   , m_total_weighted_hops_after_remap(0)
+{
+   m_num_application_tiles = Config::getSingleton()->getApplicationTiles();
+   // Tiles are laid out on the mesh the same way as in the emesh network models
+   m_mesh_width = (SInt32) floor(sqrt((double) m_num_application_tiles));
+
+   m_traffic_matrix.resize(m_num_application_tiles * m_num_application_tiles, 0);
+   m_target_tile.resize(m_num_application_tiles, INVALID_TILE_ID);
+
+   // The traffic is not gathered from the other processes
+   if (m_master && (Config::getSingleton()->getProcessCount() > 1))
+      LOG_PRINT_WARNING("thread_scheduling/scheme = locality_aware only counts the traffic seen by the master process");
+}
+
+LocalityAwareThreadScheduler::~LocalityAwareThreadScheduler()
+{
+}
+
+void LocalityAwareThreadScheduler::recordCommunication(tile_id_t sender, tile_id_t receiver, UInt64 bytes)
+{
+   // Only the master remaps threads, so the traffic seen by the other processes is dropped
+   if (!m_master)
+      return;
+   if ((sender == receiver) || (sender < 0) || (receiver < 0) ||
+       ((UInt32) sender >= m_num_application_tiles) || ((UInt32) receiver >= m_num_application_tiles))
+      return;
+
+   __sync_fetch_and_add(&m_traffic_matrix[sender * m_num_application_tiles + receiver], bytes);
+}
+
+SInt32 LocalityAwareThreadScheduler::getHopDistance(tile_id_t tile_1, tile_id_t tile_2, SInt32 mesh_width)
+{
+   return abs(tile_1 % mesh_width - tile_2 % mesh_width) + abs(tile_1 / mesh_width - tile_2 / mesh_width);
+}
+
+double LocalityAwareThreadScheduler::computeWeightedHops(const std::vector<UInt64>& traffic, const std::vector<tile_id_t>& placement,
+                                                         SInt32 mesh_width)
+{
+   UInt32 n = placement.size();
+   double weighted_hops = 0;
+   for (UInt32 i = 0; i < n; i++)
+      for (UInt32 j = 0; j < n; j++)
+         weighted_hops += ((double) traffic[i * n + j]) * getHopDistance(placement[i], placement[j], mesh_width);
+   return weighted_hops;
+}
+
+double LocalityAwareThreadScheduler::computeSwapDelta(const std::vector<UInt64>& traffic, const std::vector<tile_id_t>& placement,
+                                                      UInt32 a, UInt32 b, SInt32 mesh_width)
+{
+   // The distance between a and b does not change, so only their traffic with the other tiles counts
+   UInt32 n = placement.size();
+   double delta = 0;
+   for (UInt32 k = 0; k < n; k++)
+   {
+      if ((k == a) || (k == b))
+         continue;
+      SInt32 hop_delta = getHopDistance(placement[b], placement[k], mesh_width) - getHopDistance(placement[a], placement[k], mesh_width);
+      UInt64 traffic_a = traffic[a * n + k] + traffic[k * n + a];
+      UInt64 traffic_b = traffic[b * n + k] + traffic[k * n + b];
+      delta += ((double) traffic_a - (double) traffic_b) * hop_delta;
+   }
+   return delta;
+}
+
+void LocalityAwareThreadScheduler::computePlacement(const std::vector<UInt64>& traffic, std::vector<tile_id_t>& placement, SInt32 mesh_width)
+{
+   // Swap the tiles of two threads while that reduces the weighted hop distance.
+   // The main thread on tile 0 never yields, so it keeps its tile.
+   UInt32 n = placement.size();
+   bool improved = true;
+   for (UInt32 pass = 0; improved && (pass < n); pass++)
+   {
+      improved = false;
+      for (UInt32 a = 1; a < n; a++)
+      {
+         for (UInt32 b = a + 1; b < n; b++)
+         {
+            if (computeSwapDelta(traffic, placement, a, b, mesh_width) < 0)
+            {
+               std::swap(placement[a], placement[b]);
+               improved = true;
+            }
+         }
+      }
+   }
+}
+
+void LocalityAwareThreadScheduler::remapThreads()
+{
+   UInt32 n = m_num_application_tiles;
+
+   // Take the traffic of the quantum that just ended and start a new one
+   std::vector<UInt64> traffic(n * n);
+   UInt64 total_traffic = 0;
+   for (UInt32 i = 0; i < n * n; i++)
+   {
+      traffic[i] = __sync_fetch_and_and(&m_traffic_matrix[i], 0);
+      total_traffic += traffic[i];
+   }
+   if (total_traffic == 0)
+      return;
+
+   // placement[i] is the new tile of the thread now on tile i
+   std::vector<tile_id_t> placement(n);
+   for (UInt32 i = 0; i < n; i++)
+      placement[i] = (tile_id_t) i;
+
+   double weighted_hops_before = computeWeightedHops(traffic, placement, m_mesh_width);
+   computePlacement(traffic, placement, m_mesh_width);
+   double weighted_hops_after = computeWeightedHops(traffic, placement, m_mesh_width);
+
+   for (UInt32 i = 0; i < n; i++)
+      m_target_tile[i] = (placement[i] != (tile_id_t) i) ? placement[i] : INVALID_TILE_ID;
+
+   m_num_remaps ++;
+   m_total_remapped_traffic += total_traffic;
+   m_total_weighted_hops_before_remap += weighted_hops_before;
+   m_total_weighted_hops_after_remap += weighted_hops_after;
+
+   LOG_PRINT("Remapped threads: average hop distance before(%f), after(%f)",
+             weighted_hops_before / total_traffic, weighted_hops_after / total_traffic);
+}
+
+bool LocalityAwareThreadScheduler::masterCheckAffinityAndMigrate(core_id_t core_id, thread_id_t thread_idx, core_id_t &dst_core_id, thread_id_t &dst_thread_idx)
+{
+   if (!Tile::isMainCore(core_id) || ((UInt32) core_id.tile_id >= m_num_application_tiles))
+      return ThreadScheduler::masterCheckAffinityAndMigrate(core_id, thread_idx, dst_core_id, dst_thread_idx);
+
+   tile_id_t target_tile_id;
+   {
+      ScopedLock sl(m_remap_lock);
+      UInt32 current_time = (UInt32) time(NULL);
+      if (current_time - m_last_remap_time >= m_thread_switch_quantum)
+      {
+         remapThreads();
+         m_last_remap_time = current_time;
+      }
+      target_tile_id = m_target_tile[core_id.tile_id];
+   }
+
+   if (target_tile_id == INVALID_TILE_ID)
+      return ThreadScheduler::masterCheckAffinityAndMigrate(core_id, thread_idx, dst_core_id, dst_thread_idx);
+
+   // Honor the affinity of the thread, if any
+   size_t setsize = CPU_ALLOC_SIZE(m_total_tiles);
+   cpu_set_t* set = CPU_ALLOC(m_total_tiles);
+   cpu_set_t* zero_set = CPU_ALLOC(m_total_tiles);
+   CPU_ZERO_S(setsize, zero_set);
+   m_thread_manager->getThreadAffinity(core_id.tile_id, thread_idx, set);
+   bool allowed = (CPU_EQUAL_S(setsize, zero_set, set) != 0) || (CPU_ISSET_S(target_tile_id, setsize, set) != 0);
+   CPU_FREE(zero_set);
+   CPU_FREE(set);
+
+   core_id_t target_core_id = Tile::getMainCoreId(target_tile_id);
+   thread_id_t target_thread_idx = m_thread_manager->getIdleThread(target_core_id);
+   if (!allowed || (target_thread_idx == INVALID_THREAD_ID))
+   {
+      // The thread stays where the regular policy puts it and is not retried
+      LOG_PRINT("Thread %i on {%i, %i} cannot move to tile %i", thread_idx, core_id.tile_id, core_id.core_type, target_tile_id);
+      ScopedLock sl(m_remap_lock);
+      m_target_tile[core_id.tile_id] = INVALID_TILE_ID;
+      return ThreadScheduler::masterCheckAffinityAndMigrate(core_id, thread_idx, dst_core_id, dst_thread_idx);
+   }
+
+   {
+      ScopedLock sl(m_remap_lock);
+      m_target_tile[core_id.tile_id] = INVALID_TILE_ID;
+      m_num_migrations ++;
+   }
+
+   dst_core_id = target_core_id;
+   dst_thread_idx = target_thread_idx;
+   LOG_PRINT("Thread %i on {%i, %i} is moving closer to its peers to %i on {%i, %i}", thread_idx, core_id.tile_id, core_id.core_type, dst_thread_idx, dst_core_id.tile_id, dst_core_id.core_type);
+
+   m_core_lock[core_id.tile_id].release();
+   masterMigrateThread(thread_idx, core_id, dst_thread_idx, dst_core_id);
+   m_core_lock[core_id.tile_id].acquire();
+   return false;
+}
+
+void LocalityAwareThreadScheduler::outputSummary(std::ostream& os)
+{
+   os << "Thread Scheduler Summary:" << std::endl;
+   os << "  Scheme: locality_aware" << std::endl;
+   os << "  Remaps: " << m_num_remaps << std::endl;
+   os << "  Migrations: " << m_num_migrations << std::endl;
+   if (m_total_remapped_traffic > 0)
+   {
+      os << "  Average Hop Distance Before Remap: " << m_total_weighted_hops_before_remap / m_total_remapped_traffic << std::endl;
+      os << "  Average Hop Distance After Remap: " << m_total_weighted_hops_after_remap / m_total_remapped_traffic << std::endl;
+   }
+   else
+   {
+      os << "  Average Hop Distance Before Remap: " << std::endl;
+      os << "  Average Hop Distance After Remap: " << std::endl;
+   }
+}
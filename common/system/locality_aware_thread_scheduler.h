@@ -0,0 +1,66 @@
+#ifndef LOCALITY_AWARE_THREAD_SCHEDULER_H
+#define LOCALITY_AWARE_THREAD_SCHEDULER_H
+
+#include <vector>
+
+#include "round_robin_thread_scheduler.h"
+#include "lock.h"
+
+class ThreadManager;
+class TileManager;
+
+// Round robin scheduler that also places communicating threads close to each other.
+// The traffic between every pair of application tiles (user messages and the coherence
+// messages a directory sends to a sharer on behalf of a requester) is counted over a quantum.
+// At the first yield after the quantum expires, the placement that minimizes the traffic
+// weighted hop distance on the mesh is searched with pairwise swaps, and every thread whose
+// tile changed moves to its new tile at its next yield.
+// Only the traffic seen by the master process is counted, so the scheduler is only useful
+// when the target runs in a single host process (see [thread_scheduling] in carbon_sim.cfg).
+class LocalityAwareThreadScheduler : public RoundRobinThreadScheduler
+{
+public:
+   LocalityAwareThreadScheduler(ThreadManager *thread_manager, TileManager *tile_manager);
+   ~LocalityAwareThreadScheduler();
+
+   void recordCommunication(tile_id_t sender, tile_id_t receiver, UInt64 bytes);
+
+   void outputSummary(std::ostream& os);
+
+   // Placement search on a mesh of the given width. traffic[i * n + j] is the traffic from tile i
+   // to tile j and placement[i] is the tile of the thread now on tile i, with n = placement.size().
+   static SInt32 getHopDistance(tile_id_t tile_1, tile_id_t tile_2, SInt32 mesh_width);
+   static double computeWeightedHops(const std::vector<UInt64>& traffic, const std::vector<tile_id_t>& placement,
+                                     SInt32 mesh_width);
+   // Change of the weighted hop distance if the threads now on tiles a and b swap their placements
+   static double computeSwapDelta(const std::vector<UInt64>& traffic, const std::vector<tile_id_t>& placement,
+                                  UInt32 a, UInt32 b, SInt32 mesh_width);
+   // Greedy local search from 'placement' (tile 0 stays in place)
+   static void computePlacement(const std::vector<UInt64>& traffic, std::vector<tile_id_t>& placement, SInt32 mesh_width);
+
+protected:
+   bool masterCheckAffinityAndMigrate(core_id_t core_id, thread_id_t thread_idx, core_id_t &dst_core_id, thread_id_t &dst_thread_idx);
+
+private:
+   UInt32 m_num_application_tiles;
+   SInt32 m_mesh_width;
+
+   // Traffic from tile i to tile j since the last remap, at [i * m_num_application_tiles + j]
+   std::vector<UInt64> m_traffic_matrix;
+   // Tile the thread currently on each tile should move to (INVALID_TILE_ID if none)
+   std::vector<tile_id_t> m_target_tile;
+
+   Lock m_remap_lock;
+   UInt32 m_last_remap_time;
+
+   // Statistics
+   UInt64 m_num_remaps;
+   UInt64 m_num_migrations;
+   UInt64 m_total_remapped_traffic;
+   double m_total_weighted_hops_before_remap;
+   double m_total_weighted_hops_after_remap;
+
+   void remapThreads();
+};
+
+#endif // LOCALITY_AWARE_THREAD_SCHEDULER_H
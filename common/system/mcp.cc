@@ -12,6 +12,8 @@
 #include "thread_manager.h"
 #include "thread_scheduler.h"
 #include "performance_counter_manager.h"
+#include "target_pacing_client.h"
+#include "host_placement.h"
 
 using namespace std;
 
@@ -23,10 +25,14 @@ MCP::MCP(Network& network)
    , _vm_manager()
    , _syscall_server(_network, _send_buff, _recv_buff, _MCP_SERVER_MAX_BUFF, _scratch)
    , _sync_server(_network, _recv_buff)
+   , _target_pacing_server(NULL)
 {
    _clock_skew_management_server = ClockSkewManagementServer::create(
                                        Sim()->getCfg()->getString("clock_skew_management/scheme"),
                                        _network, _recv_buff);
+   if (TargetPacingClient::isEnabled() &&
+       (Config::getSingleton()->getMCPTileID() == Config::getSingleton()->getMasterMCPTileID()))
+      _target_pacing_server = new TargetPacingServer(_network, _recv_buff);
    _thread = Thread::create(this);
 }
 
@@ -35,6 +41,8 @@ MCP::~MCP()
    delete _thread;
    if (_clock_skew_management_server)
       delete _clock_skew_management_server;
+   if (_target_pacing_server)
+      delete _target_pacing_server;
    delete [] _scratch;
 }
 
@@ -142,6 +150,14 @@ void MCP::processPacket()
       Sim()->getThreadManager()->masterJoinThread((ThreadJoinRequest*)recv_pkt.data, recv_pkt.time);
       break;
 
+   // Thread state updates from the distributed sync servers
+   case MCP_MESSAGE_THREAD_STALL:
+      Sim()->getThreadManager()->stallThread(*(core_id_t*)((Byte*)recv_pkt.data+sizeof(msg_type)));
+      break;
+   case MCP_MESSAGE_THREAD_RESUME:
+      Sim()->getThreadManager()->resumeThread(*(core_id_t*)((Byte*)recv_pkt.data+sizeof(msg_type)));
+      break;
+
    case MCP_MESSAGE_CLOCK_SKEW_MANAGEMENT_GLOBAL:
       assert(_clock_skew_management_server);
       _clock_skew_management_server->processSyncMsgGlobal(recv_pkt.sender);
@@ -157,6 +173,11 @@ void MCP::processPacket()
       _clock_skew_management_server->processSyncMsgLocal(recv_pkt.sender);
       break;
       
+   case MCP_MESSAGE_TARGET_PACING_REPORT:
+      assert(_target_pacing_server);
+      _target_pacing_server->processProgressReport(recv_pkt.sender);
+      break;
+      
    case MCP_MESSAGE_TOGGLE_PERFORMANCE_COUNTERS:
       LOG_PRINT("entering masterTogglePerformanceCountersRequest()"); 
       Sim()->getPerformanceCounterManager()->masterTogglePerformanceCountersRequest((Byte*)recv_pkt.data+sizeof(msg_type), recv_pkt.sender); 
@@ -194,6 +215,7 @@ void MCP::run()
 {
    core_id_t mcp_core_id = Config::getSingleton()->getMCPCoreID();   //sqc_multi may need to change later
    LOG_PRINT("Initial MCP thread in MCP.cc, MCP core id: %d", mcp_core_id);   //sqc_multi
+   Sim()->getHostPlacement()->pinSystemThread();
    Sim()->getTileManager()->initializeThread(mcp_core_id);
    Sim()->getTileManager()->initializeCommId(mcp_core_id.tile_id);
 
@@ -8,6 +8,7 @@
 #include "syscall_server.h"
 #include "sync_server.h"
 #include "clock_skew_management_object.h"
+#include "target_pacing_server.h"
 #include "common_types.h"
 #include "thread.h"
 
@@ -24,6 +25,9 @@ public:
    { return &_vm_manager; }
    ClockSkewManagementServer* getClockSkewManagementServer()
    { return _clock_skew_management_server; }
+   // Only in the master MCP of a multi-application run with target pacing enabled
+   TargetPacingServer* getTargetPacingServer()
+   { return _target_pacing_server; }
 
 private:
    void run();
@@ -40,6 +44,7 @@ private:
    SyscallServer _syscall_server;
    SyncServer _sync_server;
    ClockSkewManagementServer* _clock_skew_management_server;
+   TargetPacingServer* _target_pacing_server;
   
    Thread* _thread;
 };
@@ -9,6 +9,8 @@ typedef enum
    MCP_MESSAGE_MUTEX_INIT,
    MCP_MESSAGE_MUTEX_LOCK,
    MCP_MESSAGE_MUTEX_UNLOCK,
+   MCP_MESSAGE_MUTEX_LOCK_ON_BEHALF,
+   MCP_MESSAGE_MUTEX_UNLOCK_ON_BEHALF,
    MCP_MESSAGE_COND_INIT,
    MCP_MESSAGE_COND_WAIT,
    MCP_MESSAGE_COND_SIGNAL,
@@ -27,11 +29,14 @@ typedef enum
    MCP_MESSAGE_THREAD_START,
    MCP_MESSAGE_THREAD_EXIT,
    MCP_MESSAGE_THREAD_JOIN_REQUEST,
+   MCP_MESSAGE_THREAD_STALL,
+   MCP_MESSAGE_THREAD_RESUME,
    MCP_MESSAGE_CLOCK_SKEW_MANAGEMENT_LOCAL,
    MCP_MESSAGE_CLOCK_SKEW_MANAGEMENT_GLOBAL,
    MCP_MESSAGE_CLOCK_SKEW_MANAGEMENT_GLOBAL_ACK,
    MCP_MESSAGE_TOGGLE_PERFORMANCE_COUNTERS,
-   MCP_MESSAGE_TOGGLE_PERFORMANCE_COUNTERS_ACK
+   MCP_MESSAGE_TOGGLE_PERFORMANCE_COUNTERS_ACK,
+   MCP_MESSAGE_TARGET_PACING_REPORT
 } MCPMessageTypes;
 
 typedef enum
@@ -4,6 +4,7 @@
 #include "simulator.h"
 #include "tile.h"
 #include "sim_thread_manager.h"
+#include "host_placement.h"
 
 SimThread::SimThread()
 {
@@ -19,6 +20,7 @@ void SimThread::run()
 {
    LOG_PRINT("Sim thread starting...");
    _tile_id = Sim()->getTileManager()->registerSimThread();
+   Sim()->getHostPlacement()->pinSimThread(Sim()->getTileManager()->getCurrentTileIndex());
 
    Network *net = Sim()->getTileManager()->getTileFromID(_tile_id)->getNetwork();
    bool cont = true;
@@ -1,6 +1,7 @@
 #include <cstdlib>
 #include <sstream>
 #include <iomanip>
+#include <sys/resource.h>
 
 #include "simulator.h"
 #include "version.h"
@@ -18,6 +19,10 @@
 #include "clock_skew_management_object.h"
 #include "statistics_manager.h"
 #include "statistics_thread.h"
+#include "target_pacing_client.h"
+#include "target_pacing_server.h"
+#include "parallel_network_engine.h"
+#include "host_placement.h"
 #include "contrib/dsent/dsent_contrib.h"
 #include "contrib/mcpat/cacti/io.h"
 
@@ -32,6 +37,14 @@ static UInt64 getTime()
    return time;
 }
 
+// Peak resident set size of the host process (in KB)
+static UInt64 getPeakResidentSetSize()
+{
+   rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   return (UInt64) usage.ru_maxrss;
+}
+
 void Simulator::allocate()
 {
    assert(_singleton == NULL);
@@ -66,6 +79,9 @@ Simulator::Simulator()
    , _sim_thread_manager(NULL)
    , _clock_skew_management_manager(NULL)
    , _statistics_manager(NULL)
+   , _target_pacing_client(NULL)
+   , _parallel_network_engine(NULL)
+   , _host_placement(NULL)
    , _mcp(NULL)
    , _lcp(NULL)
    , _finished(false)
@@ -73,6 +89,7 @@ Simulator::Simulator()
    , _start_time(0)
    , _stop_time(0)
    , _shutdown_time(0)
+   , _startup_phase_begin_time(0)
    , _enabled(false)
 {
 }
@@ -80,15 +97,23 @@ Simulator::Simulator()
 void Simulator::start()
 {
    LOG_PRINT("Simulator ctor starting...");
+   _startup_phase_begin_time = getTime();
+
    _config.generateTileMap();
+   recordStartupPhase("Tile Map");
 
    initializeGraphiteHome();
    initializePowerModelingTools();
    DVFSManager::initialize();
+   recordStartupPhase("Power Models");
 
    _transport = Transport::create();
+   recordStartupPhase("Transport");
    
+   _host_placement = new HostPlacement();
    _tile_manager = new TileManager();
+   recordStartupPhase("Tiles");
+
    _thread_manager = new ThreadManager(_tile_manager);
    _thread_scheduler = ThreadScheduler::create(_thread_manager, _tile_manager);
    _performance_counter_manager = new PerformanceCounterManager();
@@ -96,10 +121,15 @@ void Simulator::start()
    _clock_skew_management_manager = ClockSkewManagementManager::create(getCfg()->getString("clock_skew_management/scheme"));
    if (_config_file->getBool("statistics_trace/enabled"))
       _statistics_manager = new StatisticsManager();
+   if (TargetPacingClient::isEnabled())
+      _target_pacing_client = new TargetPacingClient();
+   if (ParallelNetworkEngine::isEnabled())
+      _parallel_network_engine = new ParallelNetworkEngine();
 
    if (_config.isMasterProcess())   //sqc_multi
       _mcp = new MCP(getMCPNetwork());
    _lcp = new LCP();
+   recordStartupPhase("Managers");
 
    // Start threads needed for simulation
    _sim_thread_manager->spawnThreads();
@@ -108,6 +138,9 @@ void Simulator::start()
       _mcp->spawnThread();
    if (_statistics_manager)
       _statistics_manager->spawnThread();
+   if (_parallel_network_engine)
+      _parallel_network_engine->spawnThreads();
+   recordStartupPhase("Threads");
 
    shutdownPowerModelingTools();
    LOG_PRINT("Simulator ctor done...");
@@ -128,12 +161,19 @@ Simulator::~Simulator()
    _lcp->quitThread();
 
    _transport->barrier();
+   // Packets still in flight are delivered before the summary, later ones are routed by their senders
+   if (_parallel_network_engine)
+      _parallel_network_engine->quitThreads();
    printSimulationSummary();
    _sim_thread_manager->quitThreads();
    _transport->barrier();
 
    if (_statistics_manager)
       delete _statistics_manager;
+   if (_target_pacing_client)
+      delete _target_pacing_client;
+   if (_parallel_network_engine)
+      delete _parallel_network_engine;
    delete _lcp;
    if (_mcp)
       delete _mcp;
@@ -146,6 +186,7 @@ Simulator::~Simulator()
    delete _thread_scheduler;
    delete _tile_manager;
    _tile_manager = NULL;
+   delete _host_placement;
    delete _transport;
 }
 
@@ -160,9 +201,17 @@ void Simulator::printSimulationSummary()
       os << "Simulation (Host) Timers: " << endl << left
          << setw(35) << "Start Time (in microseconds)" << (_start_time - _boot_time) << endl
          << setw(35) << "Stop Time (in microseconds)" << (_stop_time - _boot_time) << endl
-         << setw(35) << "Shutdown Time (in microseconds)" << (_shutdown_time - _boot_time) << endl;
+         << setw(35) << "Shutdown Time (in microseconds)" << (_shutdown_time - _boot_time) << endl
+         << setw(35) << "Peak Resident Set Size (in KB)" << getPeakResidentSetSize() << endl;
 
+      printMultiApplicationSummary(os);
       _tile_manager->outputSummary(os);
+      _thread_scheduler->outputSummary(os);
+      if (_mcp && _mcp->getTargetPacingServer())
+         _mcp->getTargetPacingServer()->outputSummary(os);
+      if (_parallel_network_engine)
+         _parallel_network_engine->outputSummary(os);
+      printStartupSummary(os);
       os.close();
    }
    else
@@ -170,7 +219,74 @@ void Simulator::printSimulationSummary()
       stringstream temp;
       _tile_manager->outputSummary(temp);
       assert(temp.str().length() == 0);
+      printStartupSummary(temp);
+   }
+}
+
+void Simulator::recordStartupPhase(const string& phase)
+{
+   UInt64 current_time = getTime();
+   _startup_phase_times.push_back(make_pair(phase, current_time - _startup_phase_begin_time));
+   _startup_phase_begin_time = current_time;
+}
+
+// Host time spent in each phase of Simulator::start(), for every process (target).
+// Process 0 collects the timers of the other processes over the global node once
+// the tile summaries are collected, the same way as the tile summaries.
+// Every process still builds all of its start-up state itself: nothing is shared between
+// the processes yet, these timers show which phases would be worth sharing.
+void Simulator::printStartupSummary(ostream& os)
+{
+   stringstream timers;
+   timers << left;
+   timers << "  Target " << _config.getCurrentTargetNum() << " (Process " << _config.getCurrentProcessNum() << "):" << endl;
+   for (UInt32 i = 0; i < _startup_phase_times.size(); i++)
+   {
+      timers << "    " << setw(45) << (_startup_phase_times[i].first + " Time (in microseconds)")
+             << _startup_phase_times[i].second << endl;
+   }
+
+   Transport::Node *global_node = Transport::getSingleton()->getGlobalNode();
+   UInt32 process_num = _config.getCurrentProcessNum();
+   if (process_num != 0)
+   {
+      Byte *buf = global_node->recv();
+      assert(*((UInt32*)buf) == process_num);
+      delete [] buf;
+      global_node->globalSend(0, timers.str().c_str(), timers.str().length()+1);
+      return;
+   }
+
+   os << "Start-up (Host) Timers: " << endl << left << timers.str();
+   for (UInt32 p = 1; p < _config.getProcessCount(); p++)
+   {
+      global_node->globalSend(p, &p, sizeof(p));
+      Byte *buf = global_node->recv();
+      os << string((char*)buf);
+      delete [] buf;
+   }
+}
+
+// Placement of the targets of a multi-application run, used to split the per-tile
+// statistics by target (see tools/multi_app_slowdown.py)
+void Simulator::printMultiApplicationSummary(ostream& os)
+{
+   if (_config.getTargetCount() <= 1)
+      return;
+
+   os << "Multi-Application Summary: " << endl;
+   for (UInt32 target_num = 0; target_num < _config.getTargetCount(); target_num++)
+   {
+      os << "  Target " << target_num << " Application Tiles:";
+      for (tile_id_t tile_id = 0; tile_id < (tile_id_t) _config.getApplicationTiles(); tile_id++)
+      {
+         if (_config.getTargetNumForTile(tile_id) == target_num)
+            os << " " << tile_id;
+      }
+      os << endl;
    }
+   os << "  Dram Controllers: " << (_config.getPartitionDramByTarget() ? "partitioned" : "shared") << endl;
+   os << "  L2 Home Slices: " << (_config.getPartitionL2HomeByTarget() ? "partitioned" : "shared") << endl;
 }
 
 void Simulator::startTimer()
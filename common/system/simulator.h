@@ -1,6 +1,10 @@
 #ifndef SIMULATOR_H
 #define SIMULATOR_H
 
+#include <string>
+#include <vector>
+#include <utility>
+
 #include "config.h"
 #include "log.h"
 #include "config.hpp"
@@ -17,6 +21,9 @@ class SimThreadManager;
 class ClockSkewManagementManager;
 class StatisticsManager;
 class StatisticsThread;
+class TargetPacingClient;
+class ParallelNetworkEngine;
+class HostPlacement;
 class Network;
 
 class Simulator
@@ -40,6 +47,9 @@ public:
    PerformanceCounterManager *getPerformanceCounterManager()   { return _performance_counter_manager; }
    ClockSkewManagementManager *getClockSkewManagementManager() { return _clock_skew_management_manager; }
    StatisticsManager *getStatisticsManager()                   { return _statistics_manager; } 
+   TargetPacingClient *getTargetPacingClient()                 { return _target_pacing_client; }
+   ParallelNetworkEngine *getParallelNetworkEngine()           { return _parallel_network_engine; }
+   HostPlacement *getHostPlacement()                           { return _host_placement; }
    MCP *getMCP()                                               { return _mcp; }
    LCP *getLCP()                                               { return _lcp; }
    Config *getConfig()                                         { return &_config; }
@@ -59,6 +69,11 @@ public:
 private:
    // Print final output of simulation
    void printSimulationSummary();
+   void printMultiApplicationSummary(std::ostream& os);
+   void printStartupSummary(std::ostream& os);
+
+   // Host time spent in each phase of start()
+   void recordStartupPhase(const std::string& phase);
 
    // handle synchronization of shutdown for distributed simulator objects
    void broadcastFinish();
@@ -89,6 +104,9 @@ private:
    SimThreadManager *_sim_thread_manager;
    ClockSkewManagementManager *_clock_skew_management_manager;
    StatisticsManager *_statistics_manager;
+   TargetPacingClient *_target_pacing_client;
+   ParallelNetworkEngine *_parallel_network_engine;
+   HostPlacement *_host_placement;
 
    MCP *_mcp;
    LCP *_lcp;
@@ -100,6 +118,9 @@ private:
    UInt64 _start_time;
    UInt64 _stop_time;
    UInt64 _shutdown_time;
+
+   UInt64 _startup_phase_begin_time;
+   std::vector<std::pair<std::string, UInt64> > _startup_phase_times;
    
    static config::Config *_config_file;
 
@@ -1,6 +1,8 @@
 #include <cassert>
 #include "statistics_thread.h"
 #include "statistics_manager.h"
+#include "simulator.h"
+#include "host_placement.h"
 #include "log.h"
 
 StatisticsThread::StatisticsThread(StatisticsManager* manager)
@@ -20,6 +22,7 @@ void
 StatisticsThread::run()
 {
    LOG_PRINT("Statistics thread starting...");
+   Sim()->getHostPlacement()->pinSystemThread();
 
    while (!_finished)
    {
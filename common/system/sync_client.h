@@ -3,6 +3,8 @@
 
 #include "sync_api.h"
 #include "packetize.h"
+#include "packet_type.h"
+#include "sync_home_lookup.h"
 
 class Core;
 class Network;
@@ -47,7 +49,9 @@ class SyncClient
       Network *m_network;
       UnstructuredBuffer m_send_buff;
       UnstructuredBuffer m_recv_buff;
-
+      // Requests go to the home of each object (the MCP, unless the sync server is distributed)
+      SyncHomeLookup m_home_lookup;
+      PacketType m_request_type;
 };
 
 #endif
@@ -0,0 +1,81 @@
+#include "sync_home_lookup.h"
+#include "simulator.h"
+#include "config.h"
+#include "tile.h"
+#include "log.h"
+
+SyncHomeLookup::SyncHomeLookup()
+{
+   string scheme_str;
+   try
+   {
+      scheme_str = Sim()->getCfg()->getString("sync_server/scheme", "centralized");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [sync_server/scheme] from the cfg file");
+   }
+   _scheme = parse(scheme_str);
+
+   if (_scheme == DISTRIBUTED)
+   {
+      // Homes are the application tiles of the current target. They live in the same
+      // process as the MCP, so the MCP can update the thread state on their behalf.
+      Config* config = Config::getSingleton();
+      const Config::TileList& tile_list = config->getApplicationTileListForProcess(config->getCurrentProcessNum());
+      _home_list.assign(tile_list.begin(), tile_list.end());
+   }
+   else
+   {
+      _home_list.push_back(Config::getSingleton()->getMCPTileID());
+   }
+   LOG_ASSERT_ERROR(!_home_list.empty(), "No tiles to home the synchronization objects on");
+}
+
+SyncHomeLookup::~SyncHomeLookup()
+{}
+
+SInt32
+SyncHomeLookup::getHomeIdxForAddress(IntPtr address) const
+{
+   // Handles are 4 bytes wide, so neighbouring handles in an array go to different homes
+   return (SInt32) ((address >> 2) % _home_list.size());
+}
+
+core_id_t
+SyncHomeLookup::getHomeCoreForAddress(IntPtr address) const
+{
+   return Tile::getMainCoreId(_home_list[getHomeIdxForAddress(address)]);
+}
+
+core_id_t
+SyncHomeLookup::getHomeCore(SInt32 handle) const
+{
+   LOG_ASSERT_ERROR(handle >= 0, "Invalid synchronization object handle(%i)", handle);
+   return Tile::getMainCoreId(_home_list[handle % _home_list.size()]);
+}
+
+SInt32
+SyncHomeLookup::getHomeIdx(tile_id_t tile_id) const
+{
+   for (UInt32 i = 0; i < _home_list.size(); i++)
+   {
+      if (_home_list[i] == tile_id)
+         return (SInt32) i;
+   }
+   return -1;
+}
+
+SyncHomeLookup::Scheme
+SyncHomeLookup::parse(string scheme_str)
+{
+   if (scheme_str == "centralized")
+      return CENTRALIZED;
+   else if (scheme_str == "distributed")
+      return DISTRIBUTED;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Sync Server Scheme(%s)", scheme_str.c_str());
+      return NUM_SCHEMES;
+   }
+}
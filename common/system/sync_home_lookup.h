@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+#include "fixed_types.h"
+
+// Maps CarbonMutex/CarbonCond/CarbonBarrier objects to the tile that holds their state.
+// With the 'centralized' scheme, all objects live in the MCP. With the 'distributed' scheme,
+// an object is homed on an application tile by the hash of the address of its handle.
+// The home is encoded in the handle, so a handle can be copied around freely after init.
+class SyncHomeLookup
+{
+public:
+   enum Scheme
+   {
+      CENTRALIZED = 0,
+      DISTRIBUTED,
+      NUM_SCHEMES
+   };
+
+   SyncHomeLookup();
+   ~SyncHomeLookup();
+
+   Scheme getScheme() const            { return _scheme; }
+   bool isDistributed() const          { return (_scheme == DISTRIBUTED); }
+   UInt32 getNumHomes() const          { return _home_list.size(); }
+
+   // Home of an object that is being initialized
+   SInt32 getHomeIdxForAddress(IntPtr address) const;
+   core_id_t getHomeCoreForAddress(IntPtr address) const;
+   // Home of an initialized object
+   core_id_t getHomeCore(SInt32 handle) const;
+   SInt32 getHomeIdx(tile_id_t tile_id) const;
+
+   // Handle <-> (home, index of the object within its home)
+   SInt32 getHandle(SInt32 home_idx, SInt32 index) const
+   { return (index * (SInt32) _home_list.size() + home_idx); }
+   SInt32 getIndex(SInt32 handle) const
+   { return (handle / (SInt32) _home_list.size()); }
+
+   static Scheme parse(string scheme_str);
+
+private:
+   Scheme _scheme;
+   vector<tile_id_t> _home_list;
+};
@@ -1,9 +1,13 @@
+#include <algorithm>
 #include "sync_server.h"
 #include "sync_client.h"
 #include "simulator.h"
 #include "thread_manager.h"
 #include "tile_manager.h"
 #include "thread_scheduler.h"
+#include "tile.h"
+#include "message_types.h"
+#include "deterministic_delivery.h"
 
 using namespace std;
 
@@ -33,7 +37,6 @@ bool SimMutex::lock(core_id_t core_id)
    }
    else
    {
-      Sim()->getThreadManager()->stallThread(core_id);
       m_waiting.push(core_id);
       return false;
    }
@@ -51,7 +54,6 @@ core_id_t SimMutex::unlock(core_id_t core_id)
    {
       m_owner =  m_waiting.front();
       m_waiting.pop();
-      Sim()->getThreadManager()->resumeThread(m_owner);
    }
    return m_owner;
 }
@@ -64,61 +66,51 @@ SimCond::~SimCond()
    assert(m_waiting.empty());
 }
 
-core_id_t SimCond::wait(core_id_t core_id, UInt64 time, StableIterator<SimMutex> & simMux)
+void SimCond::wait(core_id_t core_id, UInt64 time, carbon_mutex_t mux)
 {
-   Sim()->getThreadManager()->stallThread(core_id);
-
    // If we don't have any later signals, then put this request in the queue
-   m_waiting.push_back(CondWaiter(core_id, simMux, time));
-   return simMux->unlock(core_id);
+   m_waiting.push_back(CondWaiter(core_id, mux, time));
+}
+
+static bool isEarlierWaiter(const SimCond::CondWaiter &waiter1, const SimCond::CondWaiter &waiter2)
+{
+   if (waiter1.m_arrival_time != waiter2.m_arrival_time)
+      return (waiter1.m_arrival_time < waiter2.m_arrival_time);
+   return (waiter1.m_core_id.tile_id < waiter2.m_core_id.tile_id);
 }
 
-core_id_t SimCond::signal(core_id_t core_id, UInt64 time)
+bool SimCond::signal(core_id_t core_id, UInt64 time, CondWaiter &woken, bool earliest_first)
 {
    // If there is a list of threads waiting, wake up one of them
    if (!m_waiting.empty())
    {
-      CondWaiter woken = *(m_waiting.begin());
-      m_waiting.erase(m_waiting.begin());
-
-      Sim()->getThreadManager()->resumeThread(woken.m_core_id);
-
-      if (woken.m_mutex->lock(woken.m_core_id))
-      {
-         // Woken up thread is able to grab lock immediately
-         return woken.m_core_id;
-      }
-      else
-      {
-         // Woken up thread is *NOT* able to grab lock immediately
-         return INVALID_CORE_ID;
-      }
+      ThreadQueue::iterator it = earliest_first ?
+                                 min_element(m_waiting.begin(), m_waiting.end(), isEarlierWaiter) :
+                                 m_waiting.begin();
+      woken = *it;
+      m_waiting.erase(it);
+      return true;
    }
 
    // There are *NO* threads waiting on the condition variable
-   return INVALID_CORE_ID;
+   return false;
 }
 
 void SimCond::broadcast(core_id_t core_id, UInt64 time, WakeupList &woken_list)
 {
-   for (ThreadQueue::iterator i = m_waiting.begin(); i != m_waiting.end(); i++)
-   {
-      CondWaiter woken = *(i);
-
-      Sim()->getThreadManager()->resumeThread(woken.m_core_id);
-
-      if (woken.m_mutex->lock(woken.m_core_id))
-      {
-         // Woken up thread is able to grab lock immediately
-         woken_list.push_back(woken.m_core_id);
-      }
-   }
-
-   // All waiting threads have been woken up from the CondVar queue
+   // All waiting threads are woken up from the CondVar queue
+   woken_list = m_waiting;
    m_waiting.clear();
 }
 
 // -- SimBarrier -- //
+static bool isLowerTile(const core_id_t &core_id1, const core_id_t &core_id2)
+{
+   if (core_id1.tile_id != core_id2.tile_id)
+      return (core_id1.tile_id < core_id2.tile_id);
+   return (core_id1.core_type < core_id2.core_type);
+}
+
 SimBarrier::SimBarrier(UInt32 count)
       : m_count(count)
       , m_max_time(0)
@@ -134,8 +126,6 @@ void SimBarrier::wait(core_id_t core_id, UInt64 time, WakeupList &woken_list)
 {
    m_waiting.push_back(core_id);
 
-   Sim()->getThreadManager()->stallThread(core_id);
-
    assert(m_waiting.size() <= m_count);
 
    if (m_waiting.size() == 1)
@@ -147,94 +137,264 @@ void SimBarrier::wait(core_id_t core_id, UInt64 time, WakeupList &woken_list)
    if (m_waiting.size() == m_count)
    {
       woken_list = m_waiting;
-
-      for (WakeupList::iterator i = woken_list.begin(); i != woken_list.end(); i++)
-         Sim()->getThreadManager()->resumeThread(*i);
-
       m_waiting.clear();
    }
 }
 
 // -- SyncServer -- //
 
+void SyncServerNetworkCallback(void* obj, NetPacket packet)
+{
+   SyncServer* sync_server = (SyncServer*) obj;
+   assert(sync_server);
+   sync_server->handleRequest(packet);
+}
+
 SyncServer::SyncServer(Network &network, UnstructuredBuffer &recv_buffer)
-      : m_network(network),
-      m_recv_buffer(recv_buffer)
+      : m_tile(NULL),
+      m_network(network),
+      m_recv_buffer(recv_buffer),
+      m_home_idx(0),
+      m_deterministic(DeterministicDelivery::isEnabled())
 { }
 
+SyncServer::SyncServer(Tile* tile)
+      : m_tile(tile),
+      m_network(*tile->getNetwork()),
+      m_recv_buffer(m_home_recv_buffer),
+      m_deterministic(DeterministicDelivery::isEnabled())
+{
+   LOG_ASSERT_ERROR(m_home_lookup.isDistributed(), "Tile(%i): Sync server on a tile needs the distributed scheme", tile->getId());
+   m_home_idx = m_home_lookup.getHomeIdx(tile->getId());
+   LOG_ASSERT_ERROR(m_home_idx >= 0, "Tile(%i) is not a sync server home", tile->getId());
+   m_network.registerCallback(SYNC_SERVER_REQUEST, SyncServerNetworkCallback, this);
+}
+
 SyncServer::~SyncServer()
-{ }
+{
+   if (m_tile)
+      m_network.unregisterCallback(SYNC_SERVER_REQUEST);
+}
 
-void SyncServer::mutexInit(core_id_t core_id)
+void SyncServer::handleRequest(const NetPacket& packet)
 {
-   m_mutexes.push_back(SimMutex());
-   UInt32 mux = (UInt32)m_mutexes.size()-1;
+   m_recv_buffer.clear();
+   m_recv_buffer << make_pair(packet.data, packet.length);
 
-   m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&mux, sizeof(mux));
+   int msg_type;
+   m_recv_buffer >> msg_type;
+
+   LOG_PRINT("Sync server(%i) message type(%i), sender(%i)", m_tile->getId(), msg_type, packet.sender.tile_id);
+
+   switch (msg_type)
+   {
+   case MCP_MESSAGE_MUTEX_INIT:
+      mutexInit(packet.sender);
+      break;
+   case MCP_MESSAGE_MUTEX_LOCK:
+      mutexLock(packet.sender);
+      break;
+   case MCP_MESSAGE_MUTEX_UNLOCK:
+      mutexUnlock(packet.sender);
+      break;
+   case MCP_MESSAGE_MUTEX_LOCK_ON_BEHALF:
+      mutexLockOnBehalf(packet.sender);
+      break;
+   case MCP_MESSAGE_MUTEX_UNLOCK_ON_BEHALF:
+      mutexUnlockOnBehalf(packet.sender);
+      break;
+
+   case MCP_MESSAGE_COND_INIT:
+      condInit(packet.sender);
+      break;
+   case MCP_MESSAGE_COND_WAIT:
+      condWait(packet.sender);
+      break;
+   case MCP_MESSAGE_COND_SIGNAL:
+      condSignal(packet.sender);
+      break;
+   case MCP_MESSAGE_COND_BROADCAST:
+      condBroadcast(packet.sender);
+      break;
+
+   case MCP_MESSAGE_BARRIER_INIT:
+      barrierInit(packet.sender);
+      break;
+   case MCP_MESSAGE_BARRIER_WAIT:
+      barrierWait(packet.sender);
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unhandled sync server message type: %i from %i", msg_type, packet.sender.tile_id);
+      break;
+   }
 }
 
-void SyncServer::mutexLock(core_id_t core_id)
+SInt32 SyncServer::getIndex(SInt32 handle, size_t num_objects)
 {
-   carbon_mutex_t mux;
-   m_recv_buffer >> mux;
+   LOG_ASSERT_ERROR(isLocal(handle), "Handle(%i) is not homed on sync server(%i)", handle, m_home_idx);
+   SInt32 index = m_home_lookup.getIndex(handle);
+   LOG_ASSERT_ERROR((size_t) index < num_objects, "handle(%i), index(%i), total objects(%u)", handle, index, num_objects);
+   return index;
+}
 
-   UInt64 time;
-   m_recv_buffer >> time;
+bool SyncServer::isLocal(SInt32 handle)
+{
+   return ((handle >= 0) && ((handle % (SInt32) m_home_lookup.getNumHomes()) == m_home_idx));
+}
 
-   LOG_ASSERT_ERROR((size_t)mux < m_mutexes.size(), "mux(%i), total muxes(%u)", mux, m_mutexes.size());
+void SyncServer::stallThread(core_id_t core_id)
+{
+   if (!m_tile)
+   {
+      Sim()->getThreadManager()->stallThread(core_id);
+      return;
+   }
+   // Messages from one home reach the MCP in order. A thread is always stalled
+   // and resumed by the same home (the home of the mutex for a condition
+   // variable waiter), so the MCP always sees a stall before the matching resume
+   UnstructuredBuffer send_buff;
+   int msg_type = MCP_MESSAGE_THREAD_STALL;
+   send_buff << msg_type << core_id;
+   m_network.netSend(Config::getSingleton()->getMCPCoreID(), MCP_REQUEST_TYPE, send_buff.getBuffer(), send_buff.size());
+}
 
-   SimMutex *psimmux = &m_mutexes[mux];
+void SyncServer::resumeThread(core_id_t core_id)
+{
+   if (!m_tile)
+   {
+      Sim()->getThreadManager()->resumeThread(core_id);
+      return;
+   }
+   UnstructuredBuffer send_buff;
+   int msg_type = MCP_MESSAGE_THREAD_RESUME;
+   send_buff << msg_type << core_id;
+   m_network.netSend(Config::getSingleton()->getMCPCoreID(), MCP_REQUEST_TYPE, send_buff.getBuffer(), send_buff.size());
+}
+
+void SyncServer::lockMutex(carbon_mutex_t mux, core_id_t core_id, UInt64 time, bool stalled)
+{
+   if (!isLocal(mux))
+   {
+      // Only waiters of a condition variable lock a mutex on a different home
+      assert(stalled);
+      UnstructuredBuffer send_buff;
+      int msg_type = MCP_MESSAGE_MUTEX_LOCK_ON_BEHALF;
+      send_buff << msg_type << mux << time << core_id;
+      m_network.netSend(m_home_lookup.getHomeCore(mux), SYNC_SERVER_REQUEST, send_buff.getBuffer(), send_buff.size());
+      return;
+   }
+
+   SimMutex *psimmux = &m_mutexes[getIndex(mux, m_mutexes.size())];
 
    if (psimmux->lock(core_id))
    {
+      if (stalled)
+         resumeThread(core_id);
+
       // notify the owner
       Reply r;
       r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
       r.time = time;
       m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&r, sizeof(r));
    }
-   else
+   else if (!stalled)
    {
-      // nothing...thread goes to sleep
+      // thread goes to sleep
+      stallThread(core_id);
    }
 }
 
-void SyncServer::mutexUnlock(core_id_t core_id)
+void SyncServer::unlockMutex(carbon_mutex_t mux, core_id_t core_id, UInt64 time, bool stall)
 {
-   carbon_mutex_t mux;
-   m_recv_buffer >> mux;
-
-   UInt64 time;
-   m_recv_buffer >> time;
+   if (!isLocal(mux))
+   {
+      // Only waiters of a condition variable unlock a mutex on a different home
+      assert(stall);
+      UnstructuredBuffer send_buff;
+      int msg_type = MCP_MESSAGE_MUTEX_UNLOCK_ON_BEHALF;
+      send_buff << msg_type << mux << time << core_id;
+      m_network.netSend(m_home_lookup.getHomeCore(mux), SYNC_SERVER_REQUEST, send_buff.getBuffer(), send_buff.size());
+      return;
+   }
 
-   assert((size_t)mux < m_mutexes.size());
+   if (stall)
+      stallThread(core_id);
 
-   SimMutex *psimmux = &m_mutexes[mux];
+   SimMutex *psimmux = &m_mutexes[getIndex(mux, m_mutexes.size())];
 
    core_id_t new_owner = psimmux->unlock(core_id);
 
    if (new_owner.tile_id != INVALID_TILE_ID)
    {
       // wake up the new owner
+      resumeThread(new_owner);
+
       Reply r;
       r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
       r.time = time;
       m_network.netSend(new_owner, MCP_RESPONSE_TYPE, (char*)&r, sizeof(r));
    }
-   else
-   {
-      // nothing...
-   }
+}
+
+void SyncServer::mutexInit(core_id_t core_id)
+{
+   m_mutexes.push_back(SimMutex());
+   carbon_mutex_t mux = m_home_lookup.getHandle(m_home_idx, (SInt32)m_mutexes.size()-1);
+
+   m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&mux, sizeof(mux));
+}
+
+void SyncServer::mutexLock(core_id_t core_id)
+{
+   carbon_mutex_t mux;
+   m_recv_buffer >> mux;
+
+   UInt64 time;
+   m_recv_buffer >> time;
+
+   lockMutex(mux, core_id, time);
+}
+
+void SyncServer::mutexUnlock(core_id_t core_id)
+{
+   carbon_mutex_t mux;
+   m_recv_buffer >> mux;
+
+   UInt64 time;
+   m_recv_buffer >> time;
+
+   unlockMutex(mux, core_id, time);
 
    UInt32 dummy = SyncClient::MUTEX_UNLOCK_RESPONSE;
    m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&dummy, sizeof(dummy));
 }
 
+void SyncServer::mutexLockOnBehalf(core_id_t sender)
+{
+   carbon_mutex_t mux;
+   UInt64 time;
+   core_id_t core_id;
+   m_recv_buffer >> mux >> time >> core_id;
+
+   lockMutex(mux, core_id, time, true);
+}
+
+void SyncServer::mutexUnlockOnBehalf(core_id_t sender)
+{
+   carbon_mutex_t mux;
+   UInt64 time;
+   core_id_t core_id;
+   m_recv_buffer >> mux >> time >> core_id;
+
+   unlockMutex(mux, core_id, time, true);
+}
+
 // -- Condition Variable Stuffs -- //
 void SyncServer::condInit(core_id_t core_id)
 {
    m_conds.push_back(SimCond());
-   UInt32 cond = (UInt32)m_conds.size()-1;
+   carbon_cond_t cond = m_home_lookup.getHandle(m_home_idx, (SInt32)m_conds.size()-1);
 
    m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&cond, sizeof(cond));
 }
@@ -249,23 +409,13 @@ void SyncServer::condWait(core_id_t core_id)
    UInt64 time;
    m_recv_buffer >> time;
 
-   assert((size_t)mux < m_mutexes.size());
-   assert((size_t)cond < m_conds.size());
-
-   SimCond *psimcond = &m_conds[cond];
+   SimCond *psimcond = &m_conds[getIndex(cond, m_conds.size())];
 
-   StableIterator<SimMutex> it(m_mutexes, mux);
-   core_id_t new_mutex_owner = psimcond->wait(core_id, time, it);
+   psimcond->wait(core_id, time, mux);
 
-   if (new_mutex_owner.tile_id != INVALID_TILE_ID)
-   {
-      // wake up the new owner
-      Reply r;
-
-      r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
-      r.time = time;
-      m_network.netSend(new_mutex_owner, MCP_RESPONSE_TYPE, (char*)&r, sizeof(r));
-   }
+   // The waiter sleeps till it owns the mutex again. The home of the mutex stalls it here
+   // and resumes it when it grants the mutex, along with the new owner (if any) now.
+   unlockMutex(mux, core_id, time, true);
 }
 
 
@@ -277,24 +427,14 @@ void SyncServer::condSignal(core_id_t core_id)
    UInt64 time;
    m_recv_buffer >> time;
 
-   assert((size_t)cond < m_conds.size());
-
-   SimCond *psimcond = &m_conds[cond];
+   SimCond *psimcond = &m_conds[getIndex(cond, m_conds.size())];
 
-   core_id_t woken = psimcond->signal(core_id, time);
-
-   if (woken.tile_id != INVALID_TILE_ID)
+   SimCond::CondWaiter woken(INVALID_CORE_ID, -1, 0);
+   if (psimcond->signal(core_id, time, woken, m_deterministic))
    {
-      // wake up the new owner
+      // The woken up thread stays stalled till it grabs the mutex, then it gets the reply
       // (note: COND_WAIT_RESPONSE == MUTEX_LOCK_RESPONSE, see header)
-      Reply r;
-      r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
-      r.time = time;
-      m_network.netSend(woken, MCP_RESPONSE_TYPE, (char*)&r, sizeof(r));
-   }
-   else
-   {
-      // nothing...
+      lockMutex(woken.m_mux, woken.m_core_id, time, true);
    }
 
    // Alert the signaler
@@ -310,23 +450,19 @@ void SyncServer::condBroadcast(core_id_t core_id)
    UInt64 time;
    m_recv_buffer >> time;
 
-   assert((size_t)cond < m_conds.size());
-
-   SimCond *psimcond = &m_conds[cond];
+   SimCond *psimcond = &m_conds[getIndex(cond, m_conds.size())];
 
    SimCond::WakeupList woken_list;
    psimcond->broadcast(core_id, time, woken_list);
+   if (m_deterministic)
+      stable_sort(woken_list.begin(), woken_list.end(), isEarlierWaiter);
 
    for (SimCond::WakeupList::iterator it = woken_list.begin(); it != woken_list.end(); it++)
    {
-      assert((*it).tile_id != INVALID_TILE_ID);
+      assert((*it).m_core_id.tile_id != INVALID_TILE_ID);
 
-      // wake up the new owner
       // (note: COND_WAIT_RESPONSE == MUTEX_LOCK_RESPONSE, see header)
-      Reply r;
-      r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
-      r.time = time;
-      m_network.netSend((*it), MCP_RESPONSE_TYPE, (char*)&r, sizeof(r));
+      lockMutex((*it).m_mux, (*it).m_core_id, time, true);
    }
 
    // Alert the signaler
@@ -340,7 +476,7 @@ void SyncServer::barrierInit(core_id_t core_id)
    m_recv_buffer >> count;
 
    m_barriers.push_back(SimBarrier(count));
-   UInt32 barrier = (UInt32)m_barriers.size()-1;
+   carbon_barrier_t barrier = m_home_lookup.getHandle(m_home_idx, (SInt32)m_barriers.size()-1);
 
    m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&barrier, sizeof(barrier));
 }
@@ -353,15 +489,20 @@ void SyncServer::barrierWait(core_id_t core_id)
    UInt64 time;
    m_recv_buffer >> time;
 
-   LOG_ASSERT_ERROR(barrier < (carbon_barrier_t) m_barriers.size(), "barrier = %i, m_barriers.size()= %u", barrier, m_barriers.size());
+   SimBarrier *psimbarrier = &m_barriers[getIndex(barrier, m_barriers.size())];
 
-   SimBarrier *psimbarrier = &m_barriers[barrier];
+   stallThread(core_id);
 
    SimBarrier::WakeupList woken_list;
    psimbarrier->wait(core_id, time, woken_list);
+   if (m_deterministic)
+      sort(woken_list.begin(), woken_list.end(), isLowerTile);
 
    UInt64 max_time = psimbarrier->getMaxTime();
 
+   for (SimBarrier::WakeupList::iterator it = woken_list.begin(); it != woken_list.end(); it++)
+      resumeThread(*it);
+
    for (SimBarrier::WakeupList::iterator it = woken_list.begin(); it != woken_list.end(); it++)
    {
       assert((*it).tile_id != INVALID_TILE_ID);
@@ -10,8 +10,12 @@
 #include "transport.h"
 #include "network.h"
 #include "packetize.h"
-#include "stable_iterator.h"
+#include "sync_home_lookup.h"
 
+class Tile;
+
+// The Sim* objects only hold the synchronization state. The SyncServer stalls and
+// resumes the threads and sends the replies.
 class SimMutex
 {
    public:
@@ -36,27 +40,28 @@ class SimCond
 {
 
    public:
-      typedef std::vector<core_id_t> WakeupList;
-
-      SimCond();
-      ~SimCond();
-
-      // returns the thread that gets woken up when the mux is unlocked
-      core_id_t wait(core_id_t core_id, UInt64 time, StableIterator<SimMutex> & it);
-      core_id_t signal(core_id_t core_id, UInt64 time);
-      void broadcast(core_id_t core_id, UInt64 time, WakeupList &woken);
-
-   private:
       class CondWaiter
       {
          public:
-            CondWaiter(core_id_t core_id, StableIterator<SimMutex> mutex, UInt64 time)
-                  : m_core_id(core_id), m_mutex(mutex), m_arrival_time(time) {}
+            CondWaiter(core_id_t core_id, carbon_mutex_t mux, UInt64 time)
+                  : m_core_id(core_id), m_mux(mux), m_arrival_time(time) {}
             core_id_t m_core_id;
-            StableIterator<SimMutex> m_mutex;
+            carbon_mutex_t m_mux;
             UInt64 m_arrival_time;
       };
 
+      typedef std::vector<CondWaiter> WakeupList;
+
+      SimCond();
+      ~SimCond();
+
+      void wait(core_id_t core_id, UInt64 time, carbon_mutex_t mux);
+      // returns false if there are no threads waiting
+      // (wakes up the first waiter, or the earliest one by arrival time and tile if earliest_first)
+      bool signal(core_id_t core_id, UInt64 time, CondWaiter &woken, bool earliest_first = false);
+      void broadcast(core_id_t core_id, UInt64 time, WakeupList &woken);
+
+   private:
       typedef std::vector< CondWaiter > ThreadQueue;
       ThreadQueue m_waiting;
 };
@@ -81,6 +86,9 @@ class SimBarrier
       UInt64 m_max_time;
 };
 
+// Callback for the distributed sync server on each application tile
+void SyncServerNetworkCallback(void* obj, NetPacket packet);
+
 class SyncServer
 {
       typedef std::vector<SimMutex> MutexVector;
@@ -94,9 +102,15 @@ class SyncServer
       // FIXME: This should be better organized -- too much redundant crap
 
    public:
+      // Centralized server inside the MCP
       SyncServer(Network &network, UnstructuredBuffer &recv_buffer);
+      // Distributed server on an application tile (runs on the sim thread of the tile)
+      SyncServer(Tile* tile);
       ~SyncServer();
 
+      // Dispatch a request that arrived on the SYNC_SERVER_REQUEST packet type
+      void handleRequest(const NetPacket& packet);
+
       // Remaining parameters to these functions are stored
       // in the recv buffer and get unpacked
       void mutexInit(core_id_t core_id);
@@ -111,9 +125,33 @@ class SyncServer
       void barrierInit(core_id_t);
       void barrierWait(core_id_t);
 
+      // Sent by the home of a condition variable to the home of its mutex
+      void mutexLockOnBehalf(core_id_t sender);
+      void mutexUnlockOnBehalf(core_id_t sender);
+
    private:
+      Tile* m_tile;
+      UnstructuredBuffer m_home_recv_buffer;
       Network &m_network;
       UnstructuredBuffer &m_recv_buffer;
+      SyncHomeLookup m_home_lookup;
+      SInt32 m_home_idx;
+      // Deterministic mode: wake up threads by (simulated time, tile) instead of arrival order
+      bool m_deterministic;
+
+      SInt32 getIndex(SInt32 handle, size_t num_objects);
+      bool isLocal(SInt32 handle);
+
+      // Lock/Unlock a mutex that may live on a different home.
+      // A waiter of a condition variable is stalled by unlockMutex() (stall) and stays
+      // stalled till lockMutex() (stalled) grants it the mutex, both on the home of the mutex.
+      void lockMutex(carbon_mutex_t mux, core_id_t core_id, UInt64 time, bool stalled = false);
+      void unlockMutex(carbon_mutex_t mux, core_id_t core_id, UInt64 time, bool stall = false);
+
+      // The thread state lives in the master thread manager. The distributed
+      // servers forward the updates to the MCP.
+      void stallThread(core_id_t core_id);
+      void resumeThread(core_id_t core_id);
 };
 
 #endif // SYNC_SERVER_H
@@ -0,0 +1,74 @@
+#include <unistd.h>
+#include <cassert>
+
+#include "target_pacing_client.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "config.h"
+#include "message_types.h"
+#include "packet_type.h"
+#include "packetize.h"
+#include "network.h"
+#include "tile.h"
+#include "core.h"
+#include "core_model.h"
+#include "log.h"
+
+TargetPacingClient::TargetPacingClient()
+{
+   try
+   {
+      _interval = (UInt64) Sim()->getCfg()->getInt("target_pacing/interval");
+      _sleep_interval = (UInt32) Sim()->getCfg()->getInt("target_pacing/sleep_interval");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Could not read target_pacing parameters from the config file");
+   }
+   LOG_ASSERT_ERROR(_interval > 0, "target_pacing/interval must be > 0");
+
+   _next_check_time.resize(Config::getSingleton()->getTileListForCurrentProcess().size(), _interval);
+}
+
+TargetPacingClient::~TargetPacingClient()
+{}
+
+bool
+TargetPacingClient::isEnabled()
+{
+   return (Config::getSingleton()->getTargetCount() > 1) && Sim()->getCfg()->getBool("target_pacing/enabled", false);
+}
+
+void
+TargetPacingClient::synchronize(Core* core)
+{
+   UInt32 tile_index = Sim()->getTileManager()->getTileIndexFromID(core->getTile()->getId());
+   UInt64 curr_time_ns = core->getModel()->getCurrTime().toNanosec();
+   if (curr_time_ns < _next_check_time[tile_index])
+      return;
+   _next_check_time[tile_index] = ((curr_time_ns / _interval) * _interval) + _interval;
+
+   Network* network = core->getTile()->getNetwork();
+   core_id_t master_mcp_core_id = Config::getSingleton()->getMasterMCPCoreID();
+   UInt32 target_num = Config::getSingleton()->getCurrentTargetNum();
+
+   while (true)
+   {
+      UnstructuredBuffer send_buff;
+      int msg_type = MCP_MESSAGE_TARGET_PACING_REPORT;
+      send_buff << msg_type << target_num << curr_time_ns;
+      network->netSend(master_mcp_core_id, MCP_SYSTEM_TYPE, send_buff.getBuffer(), send_buff.size());
+
+      NetPacket recv_pkt = network->netRecv(master_mcp_core_id, core->getId(), MCP_SYSTEM_RESPONSE_TYPE);
+      assert(recv_pkt.length == sizeof(UInt32));
+      UInt32 reply = *((UInt32*) recv_pkt.data);
+      delete [] (Byte*) recv_pkt.data;
+
+      if (reply == PACING_PROCEED)
+         break;
+
+      assert(reply == PACING_WAIT);
+      LOG_PRINT("Core(%i, %i) of target %u is ahead at time(%llu), sleeping", core->getId().tile_id, core->getId().core_type, target_num, curr_time_ns);
+      usleep(_sleep_interval);
+   }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include "fixed_types.h"
+
+class Core;
+
+// Keeps the simulated clock of this target within a window of the other targets of a
+// multi-application run. Every 'interval' of simulated time, each application thread reports
+// its time to the pacing server in the master MCP. A thread that is more than 'window' ahead of
+// the slowest target sleeps on the host and asks again, leaving the host CPU to the other targets.
+class TargetPacingClient
+{
+public:
+   TargetPacingClient();
+   ~TargetPacingClient();
+
+   // Called by the application thread running on 'core'
+   void synchronize(Core* core);
+
+   static bool isEnabled();
+
+   static const UInt32 PACING_PROCEED = 0xCAFEF00D;
+   static const UInt32 PACING_WAIT = 0xDEADBEEF;
+
+private:
+   UInt64 _interval;
+   UInt32 _sleep_interval;
+
+   // Next check time of each local tile (indexed by tile index)
+   std::vector<UInt64> _next_check_time;
+};
@@ -0,0 +1,110 @@
+#include <sys/time.h>
+
+#include "target_pacing_server.h"
+#include "target_pacing_client.h"
+#include "simulator.h"
+#include "config.h"
+#include "packet_type.h"
+#include "network.h"
+#include "log.h"
+
+using std::endl;
+
+TargetPacingServer::TargetPacingServer(Network& network, UnstructuredBuffer& recv_buff)
+   : _network(network)
+   , _recv_buff(recv_buff)
+{
+   UInt64 stale_interval_ms = 0;
+   try
+   {
+      _window = (UInt64) Sim()->getCfg()->getInt("target_pacing/window");
+      stale_interval_ms = (UInt64) Sim()->getCfg()->getInt("target_pacing/stale_interval");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Could not read target_pacing parameters from the config file");
+   }
+   _stale_interval = stale_interval_ms * 1000;
+
+   _num_targets = Config::getSingleton()->getTargetCount();
+   _start_wall_clock_time = getWallClockTime();
+   _target_time.resize(_num_targets, 0);
+   _last_report_wall_clock_time.resize(_num_targets, _start_wall_clock_time);
+   _num_reports.resize(_num_targets, 0);
+   _num_throttled_reports.resize(_num_targets, 0);
+
+   string trace_filename = Config::getSingleton()->formatOutputFileName("target_pacing.trace");
+   _trace_file.open(trace_filename.c_str());
+   _trace_file << "# Wall-Clock Time (in microseconds), Target, Simulated Time (in nanoseconds)" << endl;
+}
+
+TargetPacingServer::~TargetPacingServer()
+{
+   _trace_file.close();
+}
+
+UInt64
+TargetPacingServer::getWallClockTime()
+{
+   timeval t;
+   gettimeofday(&t, NULL);
+   return (((UInt64) t.tv_sec) * 1000000 + t.tv_usec);
+}
+
+void
+TargetPacingServer::processProgressReport(core_id_t core_id)
+{
+   UInt32 target_num;
+   UInt64 time_ns;
+   _recv_buff >> target_num >> time_ns;
+   LOG_ASSERT_ERROR(target_num < _num_targets, "Target(%u), Num Targets(%u)", target_num, _num_targets);
+
+   UInt64 wall_clock_time = getWallClockTime();
+   _num_reports[target_num] ++;
+   _last_report_wall_clock_time[target_num] = wall_clock_time;
+   if (time_ns > _target_time[target_num])
+   {
+      _target_time[target_num] = time_ns;
+      _trace_file << (wall_clock_time - _start_wall_clock_time) << " " << target_num << " " << time_ns << endl;
+   }
+
+   // Compare against the slowest of the other targets that are still making progress
+   bool ahead = false;
+   for (UInt32 i = 0; i < _num_targets; i++)
+   {
+      if ((i == target_num) || ((wall_clock_time - _last_report_wall_clock_time[i]) > _stale_interval))
+         continue;
+      if (time_ns > _target_time[i] + _window)
+      {
+         ahead = true;
+         break;
+      }
+   }
+
+   UInt32 reply = TargetPacingClient::PACING_PROCEED;
+   if (ahead)
+   {
+      _num_throttled_reports[target_num] ++;
+      reply = TargetPacingClient::PACING_WAIT;
+   }
+   _network.netSend(core_id, MCP_SYSTEM_RESPONSE_TYPE, (char*) &reply, sizeof(reply));
+}
+
+void
+TargetPacingServer::outputSummary(std::ostream& os)
+{
+   UInt64 elapsed_wall_clock_time = getWallClockTime() - _start_wall_clock_time;
+
+   os << "Target Pacing Summary:" << endl;
+   for (UInt32 i = 0; i < _num_targets; i++)
+   {
+      UInt64 active_wall_clock_time = _last_report_wall_clock_time[i] - _start_wall_clock_time;
+      os << "  Target " << i << ":" << endl;
+      os << "    Simulated Time (in nanoseconds): " << _target_time[i] << endl;
+      os << "    Progress Rate (in simulated nanoseconds per wall-clock millisecond): "
+         << ((active_wall_clock_time > 0) ? (1000.0 * _target_time[i] / active_wall_clock_time) : 0.0) << endl;
+      os << "    Progress Reports: " << _num_reports[i] << endl;
+      os << "    Throttled Reports: " << _num_throttled_reports[i] << endl;
+   }
+   os << "  Elapsed Wall-Clock Time (in microseconds): " << elapsed_wall_clock_time << endl;
+}
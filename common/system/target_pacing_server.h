@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <fstream>
+
+#include "fixed_types.h"
+#include "packetize.h"
+
+class Network;
+
+// Lives in the master MCP. Tracks the simulated time reached by each target of a
+// multi-application run (the latest time reported by any of its application threads),
+// tells the threads of a target that is more than 'window' ahead of the slowest target to wait,
+// and traces the simulated time of every target against the wall-clock time.
+// A target that has not reported for 'stale_interval' (finished, or blocked in a
+// synchronization call) is not waited for.
+class TargetPacingServer
+{
+public:
+   TargetPacingServer(Network& network, UnstructuredBuffer& recv_buff);
+   ~TargetPacingServer();
+
+   void processProgressReport(core_id_t core_id);
+
+   void outputSummary(std::ostream& os);
+
+private:
+   Network& _network;
+   UnstructuredBuffer& _recv_buff;
+
+   UInt64 _window;
+   UInt64 _stale_interval;
+
+   UInt32 _num_targets;
+   UInt64 _start_wall_clock_time;
+   std::vector<UInt64> _target_time;
+   std::vector<UInt64> _last_report_wall_clock_time;
+
+   std::ofstream _trace_file;
+
+   // Statistics
+   std::vector<UInt64> _num_reports;
+   std::vector<UInt64> _num_throttled_reports;
+
+   static UInt64 getWallClockTime();
+};
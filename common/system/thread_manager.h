@@ -102,6 +102,7 @@ public:
    void masterSetOSTid(tile_id_t tile_id, thread_id_t thread_idx, pid_t pid);
 
    friend class ThreadScheduler;
+   friend class LocalityAwareThreadScheduler;
    void setThreadScheduler(ThreadScheduler* thread_scheduler) {m_thread_scheduler = thread_scheduler;}
 
    // Translate between tileID and tileIDX
@@ -4,6 +4,7 @@
 #include "thread_scheduler.h"
 #include "thread_manager.h"
 #include "round_robin_thread_scheduler.h"
+#include "locality_aware_thread_scheduler.h"
 #include "tile_manager.h"
 #include "config.h"
 #include "log.h"
@@ -14,17 +15,25 @@
 #include "tile.h"
 #include "core.h"
 #include "core_model.h"
+#include "instruction.h"
 #include "thread.h"
 
 ThreadScheduler* ThreadScheduler::create(ThreadManager *thread_manager, TileManager *tile_manager)
 {
-   // WARNING: Do not change this parameter. Hard-coded until multi-threading bug is fixed
-   std::string scheme = "none"; // Sim()->getCfg()->getString("thread_scheduling/scheme");
+   std::string scheme = getScheme();
+   if (getConfiguredScheme() != scheme)
+   {
+      LOG_PRINT_WARNING("Thread scheduling scheme(%s) is disabled until the multi-threading bug is fixed, using %s",
+                        getConfiguredScheme().c_str(), scheme.c_str());
+   }
    ThreadScheduler* thread_scheduler = NULL;
 
    if (scheme == "round_robin") {
       thread_scheduler = new RoundRobinThreadScheduler(thread_manager, tile_manager);
    }
+   else if (scheme == "locality_aware") {
+      thread_scheduler = new LocalityAwareThreadScheduler(thread_manager, tile_manager);
+   }
    else if (scheme == "none") {
       thread_scheduler = new ThreadScheduler(thread_manager, tile_manager);
    }
@@ -34,6 +43,26 @@ ThreadScheduler* ThreadScheduler::create(ThreadManager *thread_manager, TileMana
    return thread_scheduler;
 }
 
+std::string ThreadScheduler::getConfiguredScheme()
+{
+   try
+   {
+      return Sim()->getCfg()->getString("thread_scheduling/scheme", "none");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [thread_scheduling/scheme] from the cfg file");
+      return "";
+   }
+}
+
+std::string ThreadScheduler::getScheme()
+{
+   // WARNING: Do not change this parameter. Hard-coded until multi-threading bug is fixed
+   // (thread preemption and migration, used by round_robin and locality_aware, are not safe yet)
+   return "none";
+}
+
 ThreadScheduler::ThreadScheduler(ThreadManager *thread_manager, TileManager *tile_manager)
 {
    Config *config = Config::getSingleton();
@@ -67,10 +96,17 @@ ThreadScheduler::ThreadScheduler(ThreadManager *thread_manager, TileManager *til
    m_thread_migration_enabled = true;
    m_thread_preemption_enabled = true;
 
-   // WARNING: Do not change this parameter. Hard-coded until multi-threading bug is fixed
-   m_thread_switch_quantum = 100; // (UInt64) Sim()->getCfg()->getInt("thread_scheduling/quantum"); 
-   std::string scheme = "none"; // Sim()->getCfg()->getString("thread_scheduling/scheme");
-   m_enabled = (scheme != "none");
+   // Quantum is in seconds of host time, migration cost in nanoseconds of simulated time
+   try
+   {
+      m_thread_switch_quantum = (UInt32) Sim()->getCfg()->getInt("thread_scheduling/quantum", 100);
+      m_migration_cost = Time((UInt64) Sim()->getCfg()->getInt("thread_scheduling/migration_cost", 0) * 1000);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [thread_scheduling] parameters from the cfg file");
+   }
+   m_enabled = (getScheme() != "none");
 }
 
 ThreadScheduler::~ThreadScheduler()
@@ -702,6 +738,10 @@ void ThreadScheduler::yieldThread(bool is_pre_emptive)
          m_tile_manager->updateTLS(dst_core_id.tile_id, dst_thread_idx, m_tile_manager->getCurrentThreadID());
          m_thread_manager->setOSTid(dst_core_id, dst_thread_idx, syscall(SYS_gettid));
 
+         // Charge the cost of moving the thread context on the destination core
+         if (m_migration_cost > Time(0))
+            m_tile_manager->getCurrentCore()->getModel()->processDynamicInstruction(new SyncInstruction(m_migration_cost));
+
          // If no threads are scheduled, then schedule this thread next.
          if (dst_next_tidx == INVALID_THREAD_ID)
          {
@@ -5,12 +5,15 @@
 #include <bitset>
 #include <queue>
 #include <map>
+#include <string>
+#include <iostream>
 
 #include "cond.h"
 #include "core.h"
 #include "fixed_types.h"
 #include "message_types.h"
 #include "lock.h"
+#include "time_types.h"
 
 #include "thread_support.h"
 
@@ -53,12 +56,22 @@ public:
 
    thread_id_t getNextThreadIdx(core_id_t core_id);
 
+   // Communication observed between two tiles (user messages and coherence sharing).
+   // Called from the sim threads; schemes that do not use it ignore it.
+   virtual void recordCommunication(tile_id_t sender, tile_id_t receiver, UInt64 bytes) {}
+
+   virtual void outputSummary(std::ostream& os) {}
+
 protected:
 
    friend class LCP;
    friend class MCP;
 
-   bool masterCheckAffinityAndMigrate(core_id_t core_id, thread_id_t thread_idx, core_id_t &dst_core_id, thread_id_t &dst_thread_idx);
+   // Scheme in the cfg file, and the scheme actually used
+   static std::string getConfiguredScheme();
+   static std::string getScheme();
+
+   virtual bool masterCheckAffinityAndMigrate(core_id_t core_id, thread_id_t thread_idx, core_id_t &dst_core_id, thread_id_t &dst_thread_idx);
    bool m_master;
 
    UInt32 m_total_tiles;
@@ -80,6 +93,7 @@ protected:
    bool m_thread_migration_enabled;
    bool m_thread_preemption_enabled;
    UInt32 m_thread_switch_quantum;
+   Time m_migration_cost;
    bool m_enabled;
 };
 
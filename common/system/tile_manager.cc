@@ -14,6 +14,8 @@
 #include "config.h"
 #include "packetize.h"
 #include "message_types.h"
+#include "simulator.h"
+#include "host_placement.h"
 
 #include "log.h"
 
@@ -39,7 +41,9 @@ TileManager::TileManager()
 
    for (UInt32 i = 0; i < num_local_tiles; i++)
    {
+      Sim()->getHostPlacement()->beginTileConstruction(i);
       m_tiles.push_back(new Tile(local_tiles.at(i)));
+      Sim()->getHostPlacement()->endTileConstruction();
       m_initialized_cores.push_back(false);
       m_num_initialized_threads.push_back(0);
 
@@ -158,6 +162,7 @@ void TileManager::doInitializeThread(UInt32 tile_index, SInt32 thread_index, thr
     m_initialized_cores.at(tile_index) = true;
     LOG_PRINT("Set Initialized Cores Index");
     m_initialized_threads[tile_index][thread_index] = true;
+    Sim()->getHostPlacement()->pinAppThread(tile_index);
     LOG_PRINT("Initialize APP Thread: Thread Index(%d), Tile Index(%i) mapped to Tile ID (%d)",
               thread_index, tile_index, m_tiles.at(tile_index)->getId());
     LOG_ASSERT_ERROR(m_tile_tls->get() == (void*)(m_tiles.at(tile_index)),
@@ -180,6 +185,7 @@ void TileManager::updateTLS(UInt32 tile_index, SInt32 thread_index, thread_id_t
 
     m_initialized_threads[src_tile_idx][src_thread_idx] = false;
     m_initialized_threads[tile_index][thread_index] = true;
+    Sim()->getHostPlacement()->pinAppThread(tile_index);
 
     LOG_ASSERT_ERROR(m_tile_tls->get() == (void*)(m_tiles.at(tile_index)),
                      "TLS appears to be broken. %p != %p", m_tile_tls->get(), (void*)(m_tiles.at(tile_index)));
@@ -14,6 +14,7 @@
 #include "log.h"
 #include "dvfs_manager.h"
 #include "dynamic_memory_info.h"
+#include "memory_trace.h"
 
 Core::Core(Tile *tile, core_type_t core_type)
    : _tile(tile)
@@ -21,6 +22,7 @@ Core::Core(Tile *tile, core_type_t core_type)
    , _state(IDLE)
    , _pin_memory_manager(NULL)
    , _enabled(false)
+   , _memory_trace_writer(NULL)
    , _module(CORE)
 {
 
@@ -43,6 +45,20 @@ Core::Core(Tile *tile, core_type_t core_type)
    initializeMemoryAccessLatencyCounters();
    initializeInstructionBuffer();
 
+   bool memory_trace_capture = false;
+   UInt32 memory_trace_buffer_size = 0;
+   try
+   {
+      memory_trace_capture = Sim()->getCfg()->getBool("memory_trace/capture", false);
+      memory_trace_buffer_size = Sim()->getCfg()->getInt("memory_trace/buffer_size", 65536);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [memory_trace] parameters from the config file");
+   }
+   if (memory_trace_capture && (_tile->getId() < (tile_id_t) Config::getSingleton()->getApplicationTiles()))
+      _memory_trace_writer = new MemoryTraceWriter(_tile->getId(), memory_trace_buffer_size);
+
    // asynchronous communication
    _synchronization_delay = Time(Latency(DVFSManager::getSynchronizationDelay(), _frequency));
    _asynchronous_map[L1_ICACHE] = Time(0);
@@ -53,6 +69,8 @@ Core::Core(Tile *tile, core_type_t core_type)
 
 Core::~Core()
 {
+   delete _memory_trace_writer;
+
    if (_pin_memory_manager)
       delete _pin_memory_manager;
 
@@ -80,6 +98,31 @@ Core::coreSendW(int sender, int receiver, char* buffer, int size, carbon_network
    return (sent == size) ? 0 : -1;
 }
 
+int
+Core::coreMulticastW(int sender, const BitVector& receivers, char* buffer, int size, carbon_network_t net_type)
+{
+   PacketType packet_type = getPacketTypeFromUserNetType(net_type);
+
+   NetPacket packet(_core_model->getCurrTime(), packet_type, _id, _id, size, buffer);
+   SInt32 sent = _tile->getNetwork()->netMulticast(NETWORK_USER, packet, receivers);
+
+   LOG_ASSERT_ERROR(sent == size, "Bytes Sent(%i), Message Size(%i)", sent, size);
+
+   return (sent == size) ? 0 : -1;
+}
+
+bool
+Core::coreTestRecv(int sender, int receiver, carbon_network_t net_type)
+{
+   NetMatch match;
+   if (sender != CAPI_ENDPOINT_ANY)
+      match.senders.push_back((core_id_t) {sender, _id.core_type});
+   match.types.push_back(getPacketTypeFromUserNetType(net_type));
+   match.receiver = _id;
+
+   return _tile->getNetwork()->netQuery(match, _core_model->getCurrTime());
+}
+
 int
 Core::coreRecvW(int sender, int receiver, char* buffer, int size, carbon_network_t net_type)
 {
@@ -140,8 +183,15 @@ Core::initiateMemoryAccess(MemComponent::Type mem_component, lock_signal_t lock_
                            IntPtr address, Byte* data_buf, UInt32 data_size,
                            bool push_info, Time time_arg)
 {
+   // Data accesses made by the application while the models are enabled
+   if (_memory_trace_writer && _enabled && (mem_component == MemComponent::L1_DCACHE) && (data_size > 0))
+   {
+      _memory_trace_writer->record(_core_model ? _core_model->getInstructionCount() : 0,
+                                   lock_signal, mem_op_type, address, data_size);
+   }
+
    // Accommodate the target ID also within the address
-   address = address | (IntPtr) Config::getSingleton()->getCurrentTargetNum() << 48;
+   address = address | (IntPtr) Config::getSingleton()->getCurrentTargetNum() << Config::TARGET_NUM_ADDRESS_BIT;
 
    LOG_ASSERT_ERROR(Config::getSingleton()->isSimulatingSharedMemory(), "Shared Memory Disabled");
    DynamicMemoryInfo dynamic_memory_info(address, data_size, mem_op_type, lock_signal);
@@ -261,6 +311,8 @@ Core::getPacketTypeFromUserNetType(carbon_network_t net_type)
    {
    case CARBON_NET_USER:
       return USER;
+   case CARBON_NET_COLLECTIVE:
+      return USER_COLLECTIVE;
 
    default:
       LOG_PRINT_ERROR("Unrecognized User Network(%u)", net_type);
@@ -296,6 +348,8 @@ Core::outputSummary(ostream& os, const Time& target_completion_time)
    os << "    Average Data Memory Access Latency (in nanoseconds): "
       << 1.0 * total_data_memory_access_latency_in_ns / _num_data_memory_accesses
       << endl;
+
+   _syscall_model->outputSummary(os);
 }
 
 void
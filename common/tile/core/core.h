@@ -13,6 +13,8 @@ class SyncClient;
 class ClockSkewManagementClient;
 class PinMemoryManager;
 class DynamicMemoryInfo;
+class BitVector;
+class MemoryTraceWriter;
 
 #include "mem_component.h"
 #include "common_types.h"
@@ -54,6 +56,10 @@ public:
 
    int coreSendW(int sender, int receiver, char *buffer, int size, carbon_network_t net_type);
    int coreRecvW(int sender, int receiver, char *buffer, int size, carbon_network_t net_type);
+   // Send one message to a set of tiles (uses the broadcast capability of the network model if present)
+   int coreMulticastW(int sender, const BitVector& receivers, char *buffer, int size, carbon_network_t net_type);
+   // Returns true if coreRecvW() would not have to wait for the message
+   bool coreTestRecv(int sender, int receiver, carbon_network_t net_type);
    
    Time readInstructionMemory(IntPtr address, UInt32 instruction_size);
 
@@ -101,6 +107,9 @@ private:
    PinMemoryManager *_pin_memory_manager;
    bool _enabled;
 
+   // Memory reference stream of the tile (NULL unless [memory_trace] capture is enabled)
+   MemoryTraceWriter *_memory_trace_writer;
+
    // Instruction Buffer
    IntPtr _instruction_buffer_address;
    UInt64 _instruction_buffer_hits;
@@ -111,6 +111,8 @@ CoreModel::outputSummary(ostream& os, const Time& target_completion_time)
    
    // Memory fence counters
    os << "    Fence Instructions: " << _total_fence_instructions << endl;
+   // Part of the memory access latency spent waiting for free MSHRs
+   os << "    MSHR Stall Time (in nanoseconds): " << _total_mshr__stall_time.toNanosec() << endl;
 }
 
 void
@@ -213,6 +215,7 @@ CoreModel::initializeStallCounters()
    _total_execution_unit__stall_time = Time(0);
    _total_branch_speculation_violation__stall_time = Time(0);
    _total_load_speculation_violation__stall_time = Time(0);
+   _total_mshr__stall_time = Time(0);
    
    _total_netrecv__stall_time = Time(0);
    _total_sync__stall_time = Time(0);
@@ -323,9 +326,10 @@ CoreModel::popDynamicMemoryInfo()
 {
    assert(_enabled);
    assert(!_dynamic_memory_info_queue.empty());
-   __attribute__((unused)) const DynamicMemoryInfo& info = _dynamic_memory_info_queue.front();
+   const DynamicMemoryInfo& info = _dynamic_memory_info_queue.front();
    LOG_PRINT("popDynamicMemoryInfo[%s Address(%#lx), Size(%u)]",
              SPELL_MEMOP(info._mem_op_type), info._address, info._size);
+   _total_mshr__stall_time += info._mshr_stall_time;
    _dynamic_memory_info_queue.pop_front();
 }
 
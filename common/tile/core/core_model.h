@@ -32,6 +32,7 @@ public:
    void recomputeAverageFrequency(double frequency); 
 
    Time getCurrTime() const { return _curr_time; }
+   UInt64 getInstructionCount() const { return _instruction_count; }
    void setCurrTime(Time time);
 
    void pushDynamicMemoryInfo(const DynamicMemoryInfo &info);
@@ -116,6 +117,8 @@ private:
    // Branch/load speculation
    Time _total_branch_speculation_violation__stall_time;
    Time _total_load_speculation_violation__stall_time;
+   // Memory access latency spent waiting for free MSHRs
+   Time _total_mshr__stall_time;
    // Dynamic instruction stall counters
    Time _total_netrecv__stall_time;
    Time _total_sync__stall_time;
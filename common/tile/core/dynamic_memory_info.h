@@ -12,6 +12,7 @@ public:
       , _mem_op_type(mem_op_type)
       , _lock_signal(lock_signal)
       , _latency(0)
+      , _mshr_stall_time(0)
    {}
    
    IntPtr _address;
@@ -19,5 +20,7 @@ public:
    Core::mem_op_t _mem_op_type;
    Core::lock_signal_t _lock_signal;
    Time _latency;
+   // Part of the latency spent waiting for a free MSHR
+   Time _mshr_stall_time;
 };
 
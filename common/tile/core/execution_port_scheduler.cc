@@ -0,0 +1,67 @@
+#include "execution_port_scheduler.h"
+#include "core_model.h"
+#include "utils.h"
+#include "log.h"
+
+ExecutionPortScheduler::ExecutionPortScheduler(CoreModel* core_model, bool enabled)
+   : _core_model(core_model)
+   , _enabled(enabled)
+   , _total_contention_delay(0)
+{
+   for (UInt32 i = 0; i < _NUM_PORTS; i++)
+   {
+      _port_free_time[i] = Time(0);
+      _total_micro_ops[i] = 0;
+      _total_busy_time[i] = Time(0);
+   }
+}
+
+ExecutionPortScheduler::~ExecutionPortScheduler()
+{}
+
+Time
+ExecutionPortScheduler::schedule(const Time& ready_time, uint8_t port_mask, uint8_t extra_slots)
+{
+   if ((!_enabled) || (port_mask == 0))
+      return ready_time;
+
+   UInt32 mask = port_mask;
+   LOG_ASSERT_ERROR((mask >> _NUM_PORTS) == 0, "Port-Mask(%#x) has ports beyond the (%u) modeled", mask, _NUM_PORTS);
+
+   // Scan the set bits of the mask for the port that frees up first.
+   // A port that is already free at ready_time cannot be beaten, so stop there.
+   UInt32 port = __builtin_ctz(mask);
+   mask &= (mask - 1);
+   while ((mask != 0) && (_port_free_time[port] > ready_time))
+   {
+      UInt32 next_port = __builtin_ctz(mask);
+      mask &= (mask - 1);
+      if (_port_free_time[next_port] < _port_free_time[port])
+         port = next_port;
+   }
+
+   Time issue_time = getMax<Time>(ready_time, _port_free_time[port]);
+   Time occupancy = _core_model->getLatency(1 + extra_slots);
+   _port_free_time[port] = issue_time + occupancy;
+
+   _total_micro_ops[port] ++;
+   _total_busy_time[port] += occupancy;
+   _total_contention_delay += (issue_time - ready_time);
+
+   return issue_time;
+}
+
+void
+ExecutionPortScheduler::outputSummary(ostream& os, const Time& completion_time)
+{
+   os << "    Execution Ports: " << endl;
+   os << "      Contention Delay (in nanoseconds): " << _total_contention_delay.toNanosec() << endl;
+   for (UInt32 i = 0; i < _NUM_PORTS; i++)
+   {
+      os << "      Port " << i << " Micro-Ops: " << _total_micro_ops[i] << endl;
+      if (completion_time > 0)
+         os << "      Port " << i << " Utilization (%): " << 100.0 * _total_busy_time[i].getTime() / completion_time.getTime() << endl;
+      else
+         os << "      Port " << i << " Utilization (%): " << endl;
+   }
+}
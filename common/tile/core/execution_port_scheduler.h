@@ -0,0 +1,42 @@
+#pragma once
+
+#include <iostream>
+using std::ostream;
+using std::endl;
+
+#include <stdint.h>
+#include "fixed_types.h"
+#include "time_types.h"
+
+class CoreModel;
+
+// Structural hazards on the execution ports.
+// The decoder assigns each micro-op a mask of the ports it can issue on and the number of
+// extra cycles it holds the port for (non-pipelined units). A micro-op issues on the port in
+// its mask that frees up first and occupies it for (1 + extra_slots) cycles. Only the time at
+// which each port becomes free is tracked, so a micro-op cannot fill an idle gap left before
+// a micro-op that issued later in simulated time.
+class ExecutionPortScheduler
+{
+public:
+   ExecutionPortScheduler(CoreModel* core_model, bool enabled);
+   ~ExecutionPortScheduler();
+
+   // Returns the time (>= ready_time) at which the micro-op issues
+   Time schedule(const Time& ready_time, uint8_t port_mask, uint8_t extra_slots);
+
+   void outputSummary(ostream& os, const Time& completion_time);
+
+private:
+   // Ports 0-5 of Nehalem (see pin/nehalem_decoder.cc)
+   static const UInt32 _NUM_PORTS = 6;
+
+   CoreModel* _core_model;
+   bool _enabled;
+   Time _port_free_time[_NUM_PORTS];
+
+   // Utilization counters
+   UInt64 _total_micro_ops[_NUM_PORTS];
+   Time _total_busy_time[_NUM_PORTS];
+   Time _total_contention_delay;
+};
@@ -0,0 +1,110 @@
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "local_fd_table.h"
+#include "log.h"
+
+LocalFdTable::LocalFdTable()
+{}
+
+LocalFdTable::~LocalFdTable()
+{}
+
+void
+LocalFdTable::add(int fd, int flags)
+{
+   // Appends always go to the end of the file, whatever the offset
+   if ((fd < 0) || (flags & O_APPEND))
+      return;
+
+   struct stat stat_buf;
+   if ((fstat(fd, &stat_buf) != 0) || !S_ISREG(stat_buf.st_mode))
+      return;
+
+   ScopedLock sl(_lock);
+   _offsets[fd] = 0;
+   LOG_PRINT("Tracking fd(%i) locally", fd);
+}
+
+bool
+LocalFdTable::isTracked(int fd)
+{
+   ScopedLock sl(_lock);
+   return (_offsets.find(fd) != _offsets.end());
+}
+
+// The lock is held during the I/O so that concurrent calls on a descriptor see
+// consecutive offsets, as they would with read/write
+ssize_t
+LocalFdTable::read(int fd, void* buf, size_t count)
+{
+   ScopedLock sl(_lock);
+   off_t& offset = _offsets[fd];
+   ssize_t bytes = pread(fd, buf, count, offset);
+   if (bytes > 0)
+      offset += bytes;
+   return bytes;
+}
+
+ssize_t
+LocalFdTable::write(int fd, const void* buf, size_t count)
+{
+   ScopedLock sl(_lock);
+   off_t& offset = _offsets[fd];
+   ssize_t bytes = pwrite(fd, buf, count, offset);
+   if (bytes > 0)
+      offset += bytes;
+   return bytes;
+}
+
+ssize_t
+LocalFdTable::writev(int fd, const struct iovec* iov, int iovcnt)
+{
+   ScopedLock sl(_lock);
+   off_t& offset = _offsets[fd];
+   ssize_t bytes = pwritev(fd, iov, iovcnt, offset);
+   if (bytes > 0)
+      offset += bytes;
+   return bytes;
+}
+
+off_t
+LocalFdTable::lseek(int fd, off_t offset, int whence)
+{
+   ScopedLock sl(_lock);
+   off_t& curr_offset = _offsets[fd];
+   if (whence == SEEK_CUR)
+   {
+      offset += curr_offset;
+      whence = SEEK_SET;
+   }
+
+   // Let the kernel validate the new offset (and resolve SEEK_END/SEEK_DATA/SEEK_HOLE)
+   off_t new_offset = ::lseek(fd, offset, whence);
+   if (new_offset != (off_t) -1)
+      curr_offset = new_offset;
+   return new_offset;
+}
+
+int
+LocalFdTable::close(int fd)
+{
+   ScopedLock sl(_lock);
+   _offsets.erase(fd);
+   return ::close(fd);
+}
+
+void
+LocalFdTable::release(int fd)
+{
+   ScopedLock sl(_lock);
+   std::map<int, off_t>::iterator it = _offsets.find(fd);
+   if (it == _offsets.end())
+      return;
+
+   if (::lseek(fd, it->second, SEEK_SET) == (off_t) -1)
+      LOG_PRINT_WARNING("Could not restore the offset of fd(%i)", fd);
+   _offsets.erase(it);
+   LOG_PRINT("Stopped tracking fd(%i) locally", fd);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "lock.h"
+
+// Regular files opened by the target, whose read/write/lseek/fstat/close syscalls are run
+// directly on the host process (see SyscallMdl). Only used when the whole target and its MCP
+// live in this host process, so the file descriptors returned by the MCP are valid here.
+// The file offset is kept in the table and the I/O is done with pread/pwrite, so the kernel
+// offset of the descriptor is not updated. Before any other syscall uses a tracked descriptor
+// (dup, fcntl, sendfile, ...), release() writes the offset back to the kernel and stops tracking
+// it, so that the descriptor and its copies share the right offset from then on.
+class LocalFdTable
+{
+public:
+   LocalFdTable();
+   ~LocalFdTable();
+
+   // Called after the MCP opened the file
+   void add(int fd, int flags);
+   bool isTracked(int fd);
+
+   // Same return values as the corresponding syscalls
+   ssize_t read(int fd, void* buf, size_t count);
+   ssize_t write(int fd, const void* buf, size_t count);
+   ssize_t writev(int fd, const struct iovec* iov, int iovcnt);
+   off_t lseek(int fd, off_t offset, int whence);
+   int close(int fd);
+
+   // Sets the kernel offset of the descriptor to its tracked offset and stops tracking it
+   void release(int fd);
+
+private:
+   std::map<int, off_t> _offsets;
+   Lock _lock;
+};
@@ -0,0 +1,120 @@
+#include <sstream>
+#include <algorithm>
+
+#include "memory_trace.h"
+#include "config.h"
+#include "log.h"
+
+using std::string;
+
+static const UInt8 MEMORY_TRACE_MAGIC[VarintOutputStream::MAGIC_SIZE] = { 'G', 'M', 'T', 'R' };
+static const UInt64 MEMORY_TRACE_VERSION = 1;
+
+// -- MemoryTraceWriter -- //
+
+MemoryTraceWriter::MemoryTraceWriter(tile_id_t tile_id, UInt32 buffer_size)
+   : _tile_id(tile_id)
+   , _stream(buffer_size)
+   , _last_instruction_count(0)
+   , _last_address(0)
+   , _num_records(0)
+{
+   string filename = Config::getSingleton()->formatOutputFileName(getFilename(_tile_id));
+   LOG_ASSERT_ERROR(_stream.open(filename), "Could not open memory trace(%s)", filename.c_str());
+
+   _stream.writeHeader(MEMORY_TRACE_MAGIC, MEMORY_TRACE_VERSION, _tile_id);
+}
+
+MemoryTraceWriter::~MemoryTraceWriter()
+{
+   _stream.close();
+   LOG_PRINT("Tile(%i): Recorded %llu memory accesses", _tile_id, _num_records);
+}
+
+string
+MemoryTraceWriter::getFilename(tile_id_t tile_id)
+{
+   std::ostringstream filename;
+   filename << "memory_trace_" << tile_id << ".bin";
+   return filename.str();
+}
+
+void
+MemoryTraceWriter::record(UInt64 instruction_count, Core::lock_signal_t lock_signal, Core::mem_op_t mem_op_type,
+                          IntPtr address, UInt32 size)
+{
+   MemoryTraceRecord record;
+   record._instruction_gap = (instruction_count > _last_instruction_count) ? (instruction_count - _last_instruction_count) : 0;
+   record._lock_signal = lock_signal;
+   record._mem_op_type = mem_op_type;
+   record._address = address;
+   record._size = size;
+   write(record);
+
+   _last_instruction_count = std::max(_last_instruction_count, instruction_count);
+}
+
+void
+MemoryTraceWriter::write(const MemoryTraceRecord& record)
+{
+   _stream.putVarint(record._instruction_gap);
+   _stream.putByte((UInt8) (record._mem_op_type | (record._lock_signal << 2)));
+   _stream.putVarint(record._size);
+   _stream.putSignedVarint((SInt64) (record._address - _last_address));
+   _last_address = record._address;
+
+   _num_records ++;
+}
+
+// -- MemoryTraceReader -- //
+
+MemoryTraceReader::MemoryTraceReader(string filename, UInt32 buffer_size)
+   : _stream(buffer_size)
+   , _is_open(false)
+   , _tile_id(INVALID_TILE_ID)
+   , _last_address(0)
+{
+   if (!_stream.open(filename))
+      return;
+
+   switch (_stream.readHeader(MEMORY_TRACE_MAGIC, MEMORY_TRACE_VERSION, _tile_id))
+   {
+   case VarintInputStream::INVALID_MAGIC:
+      LOG_PRINT_WARNING("%s is not a memory trace", filename.c_str());
+      return;
+   case VarintInputStream::INVALID_VERSION:
+      LOG_PRINT_WARNING("Unsupported memory trace version in %s", filename.c_str());
+      return;
+   default:
+      _is_open = true;
+      return;
+   }
+}
+
+MemoryTraceReader::~MemoryTraceReader()
+{}
+
+bool
+MemoryTraceReader::next(MemoryTraceRecord& record)
+{
+   if (!_is_open)
+      return false;
+
+   if (!_stream.getVarint(record._instruction_gap))
+      return false;
+
+   UInt8 flags = 0;
+   UInt64 size = 0;
+   SInt64 address_delta = 0;
+   bool valid = _stream.getByte(flags) && _stream.getVarint(size) && _stream.getSignedVarint(address_delta);
+   LOG_ASSERT_ERROR(valid, "Truncated memory trace of tile(%i)", _tile_id);
+
+   record._mem_op_type = (Core::mem_op_t) (flags & 0x3);
+   record._lock_signal = (Core::lock_signal_t) ((flags >> 2) & 0x3);
+   LOG_ASSERT_ERROR((record._mem_op_type <= Core::WRITE) && (record._lock_signal <= Core::UNLOCK),
+                    "Corrupt memory trace of tile(%i)", _tile_id);
+   record._size = (UInt32) size;
+   _last_address += address_delta;
+   record._address = _last_address;
+   return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+
+#include "fixed_types.h"
+#include "core.h"
+#include "varint_stream.h"
+
+// A data memory access of the application thread of a tile, as recorded in a memory trace
+class MemoryTraceRecord
+{
+public:
+   MemoryTraceRecord()
+      : _instruction_gap(0), _lock_signal(Core::NONE), _mem_op_type(Core::READ)
+      , _address(INVALID_ADDRESS), _size(0) {}
+
+   // Instructions executed since the instruction of the previous access
+   // (0 if both accesses are made by the same instruction)
+   UInt64 _instruction_gap;
+   Core::lock_signal_t _lock_signal;
+   Core::mem_op_t _mem_op_type;
+   IntPtr _address;
+   UInt32 _size;
+};
+
+// Per-tile memory reference stream (memory_trace_<tile>.bin in the output directory),
+// captured in Core::initiateMemoryAccess() when [memory_trace] capture = true (e.g. while
+// running a binary under Pin) and replayed by MemoryTracePlayer.
+// Each record is a varint instruction gap, a flags byte (memory operation and lock signal),
+// a varint size and the (zigzag varint) address delta from the previous record, written
+// through a VarintOutputStream.
+class MemoryTraceWriter
+{
+public:
+   MemoryTraceWriter(tile_id_t tile_id, UInt32 buffer_size);
+   ~MemoryTraceWriter();
+
+   // 'instruction_count' is the number of instructions the core model has executed
+   void record(UInt64 instruction_count, Core::lock_signal_t lock_signal, Core::mem_op_t mem_op_type,
+               IntPtr address, UInt32 size);
+   void write(const MemoryTraceRecord& record);
+
+   UInt64 getNumRecords() const { return _num_records; }
+
+   static std::string getFilename(tile_id_t tile_id);
+
+private:
+   tile_id_t _tile_id;
+   VarintOutputStream _stream;
+
+   UInt64 _last_instruction_count;
+   IntPtr _last_address;
+   UInt64 _num_records;
+};
+
+class MemoryTraceReader
+{
+public:
+   MemoryTraceReader(std::string filename, UInt32 buffer_size = 1 << 16);
+   ~MemoryTraceReader();
+
+   bool isOpen() const { return _is_open; }
+   tile_id_t getTileId() const { return _tile_id; }
+
+   // Returns false at the end of the trace
+   bool next(MemoryTraceRecord& record);
+
+private:
+   VarintInputStream _stream;
+   bool _is_open;
+   tile_id_t _tile_id;
+
+   IntPtr _last_address;
+};
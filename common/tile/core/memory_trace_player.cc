@@ -0,0 +1,186 @@
+#include "memory_trace_player.h"
+#include "tile.h"
+#include "core.h"
+#include "core_model.h"
+#include "instruction.h"
+#include "micro_op.h"
+#include "mcpat_info.h"
+#include "clock_skew_management_object.h"
+#include "log.h"
+
+// Execution ports of the micro-ops (see pin/nehalem_decoder.cc)
+#define ALU_PORTS          (0x1 | 0x2 | 0x20)
+#define LOAD_PORT          (0x4)
+#define STORE_ADDR_PORT    (0x8)
+#define STORE_PORT         (0x10)
+
+// The synthetic instructions are fetched from a small code region, so instruction
+// fetch hits in the L1-I (and the instruction buffer) once warm
+#define CODE_BASE_ADDRESS  ((IntPtr) 0x400000)
+#define INSTRUCTION_SIZE   (4)
+
+MemoryTracePlayer::MemoryTracePlayer(Core* core)
+   : _core(core)
+   , _num_instructions(0)
+   , _num_memory_accesses(0)
+{
+   LOG_ASSERT_ERROR(_core->getModel(), "Replaying a memory trace needs the core model ([general] enable_core_modeling)");
+
+   MicroOp micro_op;
+   micro_op.clear();
+   micro_op.type = MicroOp::GENERAL;
+   micro_op.lat = 1;
+   micro_op.portMask = ALU_PORTS;
+   _general_instruction = createInstruction(CODE_BASE_ADDRESS, std::vector<MicroOp>(1, micro_op));
+}
+
+MemoryTracePlayer::~MemoryTracePlayer()
+{
+   for (UInt32 i = 0; i < _instructions.size(); i++)
+   {
+      delete _instructions[i]->getMcPATInfo();
+      delete [] &(_instructions[i]->getUop(0));
+      delete _instructions[i];
+   }
+}
+
+Instruction*
+MemoryTracePlayer::createInstruction(IntPtr address, const std::vector<MicroOp>& micro_ops)
+{
+   McPATInfo::MicroOpList mcpat_micro_op_list;
+   McPATInfo::RegisterFile mcpat_register_file;
+   McPATInfo::ExecutionUnitList mcpat_execution_unit_list;
+
+   MicroOp* micro_op_array = new MicroOp[micro_ops.size()];
+   for (UInt32 i = 0; i < micro_ops.size(); i++)
+   {
+      micro_op_array[i] = micro_ops[i];
+      switch (micro_ops[i].type)
+      {
+      case MicroOp::GENERAL:
+         mcpat_micro_op_list.push_back(McPATInfo::INTEGER_INST);
+         mcpat_execution_unit_list.push_back(McPATInfo::ALU);
+         mcpat_register_file._num_integer_reads += 2;
+         mcpat_register_file._num_integer_writes ++;
+         break;
+      case MicroOp::LOAD:
+         mcpat_micro_op_list.push_back(McPATInfo::LOAD_INST);
+         mcpat_register_file._num_integer_writes ++;
+         break;
+      case MicroOp::STORE:
+         mcpat_micro_op_list.push_back(McPATInfo::STORE_INST);
+         mcpat_register_file._num_integer_reads ++;
+         break;
+      default:
+         break;
+      }
+   }
+
+   Instruction* instruction = new Instruction(address, INSTRUCTION_SIZE, micro_ops.size(), micro_op_array);
+   instruction->setMcPATInfo(new McPATInfo(mcpat_micro_op_list, mcpat_register_file, mcpat_execution_unit_list));
+   _instructions.push_back(instruction);
+   return instruction;
+}
+
+// Loads first, then the store address/store pairs (as emitted by the decoder)
+Instruction*
+MemoryTracePlayer::getMemoryInstruction(UInt32 num_loads, UInt32 num_stores)
+{
+   std::map<std::pair<UInt32,UInt32>, Instruction*>::iterator it =
+      _memory_instructions.find(std::make_pair(num_loads, num_stores));
+   if (it != _memory_instructions.end())
+      return it->second;
+
+   std::vector<MicroOp> micro_ops;
+   MicroOp micro_op;
+   for (UInt32 i = 0; i < num_loads; i++)
+   {
+      micro_op.clear();
+      micro_op.type = MicroOp::LOAD;
+      micro_op.portMask = LOAD_PORT;
+      micro_ops.push_back(micro_op);
+   }
+   for (UInt32 i = 0; i < num_stores; i++)
+   {
+      micro_op.clear();
+      micro_op.type = MicroOp::STORE_ADDR;
+      micro_op.lat = 1;
+      micro_op.portMask = STORE_ADDR_PORT;
+      micro_ops.push_back(micro_op);
+
+      micro_op.clear();
+      micro_op.type = MicroOp::STORE;
+      micro_op.portMask = STORE_PORT;
+      micro_ops.push_back(micro_op);
+   }
+
+   IntPtr address = CODE_BASE_ADDRESS + INSTRUCTION_SIZE * (1 + _memory_instructions.size());
+   Instruction* instruction = createInstruction(address, micro_ops);
+   _memory_instructions[std::make_pair(num_loads, num_stores)] = instruction;
+   return instruction;
+}
+
+// Same as the instrumentation callback: the core model handles an instruction once the next
+// one is queued, after the accesses of the instruction have pushed their memory info
+void
+MemoryTracePlayer::issueInstruction(Instruction* instruction)
+{
+   CoreModel* core_model = _core->getModel();
+   core_model->queueInstruction(instruction);
+   core_model->iterate();
+   _num_instructions ++;
+}
+
+void
+MemoryTracePlayer::playMemoryInstruction(const std::vector<MemoryTraceRecord>& accesses)
+{
+   UInt32 num_loads = 0;
+   UInt32 num_stores = 0;
+   for (UInt32 i = 0; i < accesses.size(); i++)
+   {
+      if (accesses[i]._mem_op_type == Core::WRITE)
+         num_stores ++;
+      else
+         num_loads ++;
+   }
+   issueInstruction(getMemoryInstruction(num_loads, num_stores));
+
+   for (UInt32 i = 0; i < accesses.size(); i++)
+   {
+      const MemoryTraceRecord& access = accesses[i];
+      if (_data_buffer.size() < access._size)
+         _data_buffer.resize(access._size);
+      _core->initiateMemoryAccess(MemComponent::L1_DCACHE, access._lock_signal, access._mem_op_type,
+                                  access._address, &_data_buffer[0], access._size, true);
+      _num_memory_accesses ++;
+   }
+}
+
+void
+MemoryTracePlayer::play(MemoryTraceReader& reader)
+{
+   ClockSkewManagementClient* clock_skew_management_client = _core->getClockSkewManagementClient();
+
+   std::vector<MemoryTraceRecord> accesses;
+   MemoryTraceRecord record;
+   bool more_records = reader.next(record);
+   while (more_records)
+   {
+      // The accesses of one instruction
+      accesses.clear();
+      accesses.push_back(record);
+      while ((more_records = reader.next(record)) && (record._instruction_gap == 0))
+         accesses.push_back(record);
+
+      // The gap includes the memory instruction itself
+      for (UInt64 i = 1; i < accesses[0]._instruction_gap; i++)
+         issueInstruction(_general_instruction);
+      playMemoryInstruction(accesses);
+
+      if (clock_skew_management_client)
+         clock_skew_management_client->synchronize();
+   }
+
+   LOG_PRINT("Tile(%i): Replayed %llu instructions, %llu memory accesses",
+             _core->getTile()->getId(), _num_instructions, _num_memory_accesses);
+}
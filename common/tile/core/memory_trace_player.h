@@ -0,0 +1,49 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "fixed_types.h"
+#include "memory_trace.h"
+#include "micro_op.h"
+
+class Core;
+class Instruction;
+
+// Trace-driven front end: replays a memory trace on the core of a tile, from the app thread
+// of the tile, in place of an instrumented binary.
+// Each instruction gap is fed to the core model as single-cycle ALU instructions, and the
+// accesses of each memory instruction go through Core::initiateMemoryAccess() (and hence the
+// cache hierarchy and coherence protocol of the tile) before the core model consumes them with
+// a load/store instruction of matching shape. The trace carries no register dependences, so
+// the instructions are independent of each other.
+class MemoryTracePlayer
+{
+public:
+   MemoryTracePlayer(Core* core);
+   ~MemoryTracePlayer();
+
+   void play(MemoryTraceReader& reader);
+
+   UInt64 getNumInstructions() const   { return _num_instructions; }
+   UInt64 getNumMemoryAccesses() const { return _num_memory_accesses; }
+
+private:
+   Core* _core;
+
+   // Single-cycle ALU instruction used for the instruction gaps
+   Instruction* _general_instruction;
+   // Memory instructions, by number of loads and stores
+   std::map<std::pair<UInt32,UInt32>, Instruction*> _memory_instructions;
+   std::vector<Instruction*> _instructions;
+
+   std::vector<Byte> _data_buffer;
+
+   UInt64 _num_instructions;
+   UInt64 _num_memory_accesses;
+
+   Instruction* getMemoryInstruction(UInt32 num_loads, UInt32 num_stores);
+   Instruction* createInstruction(IntPtr address, const std::vector<MicroOp>& micro_ops);
+   void issueInstruction(Instruction* instruction);
+   void playMemoryInstruction(const std::vector<MemoryTraceRecord>& accesses);
+};
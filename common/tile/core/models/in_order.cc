@@ -16,10 +16,21 @@ InOrderCoreModel::InOrderCoreModel(Core* core)
 {
    // Initialize instruction fetch unit
    _instruction_fetch_stage = new InstructionFetchStage(this);
+   // Initialize execution ports (shared by the execution and branch units)
+   bool execution_port_contention_enabled = false;
+   try
+   {
+      execution_port_contention_enabled = Sim()->getCfg()->getBool("core/execution_port_contention_enabled", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [core] params from the config file");
+   }
+   _execution_port_scheduler = new ExecutionPortScheduler(this, execution_port_contention_enabled);
    // Initialize execution unit
-   _execution_unit = new ExecutionUnit(this);
+   _execution_unit = new ExecutionUnit(this, _execution_port_scheduler);
    // Initialize branch unit
-   _branch_unit = new BranchUnit(this);
+   _branch_unit = new BranchUnit(this, _execution_port_scheduler);
    // Initialize load/store queues
    _load_queue = new LoadQueue(this);
    _store_queue = new StoreQueue(this);
@@ -51,6 +62,7 @@ InOrderCoreModel::~InOrderCoreModel()
    delete _load_queue;
    delete _branch_unit;
    delete _execution_unit;
+   delete _execution_port_scheduler;
    delete _instruction_fetch_stage;
 }
 
@@ -66,6 +78,7 @@ InOrderCoreModel::outputSummary(std::ostream &os, const Time& target_completion_
                                _total_branch_speculation_violation__stall_time,
                                _total_load_speculation_violation__stall_time);
    CoreModel::outputSummary(os, target_completion_time);
+   _execution_port_scheduler->outputSummary(os, _curr_time);
 }
 
 void
@@ -125,10 +138,14 @@ InOrderCoreModel::handleInstruction(Instruction *instruction)
       switch (micro_op.type)
       {
       case MicroOp::GENERAL:
-         // Assumption is that execution units have latency but with occupancy of 1
-         // Calculate the completion time of instruction (after fetching read operands + execution unit)
-         // Assume that there is no structural hazard at the execution unit
-         results_ready = _execution_unit->handle(_dispatch_time, _commit_time, micro_op.lat);
+         {
+            // Calculate the completion time of instruction (after fetching read operands + execution unit)
+            // The micro-op holds its execution port for (1 + extra slots) cycles, so later micro-ops
+            // that need the same ports stall in the (in-order) issue stage
+            Time port_ready = _dispatch_time;
+            results_ready = _execution_unit->handle(_dispatch_time, _commit_time, micro_op);
+            _total_execution_unit__stall_time += (_dispatch_time - port_ready);
+         }
          break;
 
       case MicroOp::LOAD:
@@ -150,7 +167,11 @@ InOrderCoreModel::handleInstruction(Instruction *instruction)
          break;
 
       case MicroOp::STORE_ADDR:
-         results_ready = _execution_unit->handle(_dispatch_time, _commit_time, micro_op.lat);
+         {
+            Time port_ready = _dispatch_time;
+            results_ready = _execution_unit->handle(_dispatch_time, _commit_time, micro_op);
+            _total_execution_unit__stall_time += (_dispatch_time - port_ready);
+         }
          break;
 
       case MicroOp::FENCE:
@@ -164,9 +185,11 @@ InOrderCoreModel::handleInstruction(Instruction *instruction)
       case MicroOp::BRANCH:
          {
             bool speculation_failed = false;
-            results_ready = _branch_unit->handle(_dispatch_time, _commit_time, micro_op.lat,
+            Time port_ready = _dispatch_time;
+            results_ready = _branch_unit->handle(_dispatch_time, _commit_time, micro_op,
                                                  instruction->getAddress(), _branch_predictor,
                                                  speculation_failed);
+            _total_execution_unit__stall_time += (_dispatch_time - port_ready);
             if (speculation_failed)
             {
                // For the branch stall time, have to wait for the greater of the following
@@ -277,30 +300,34 @@ InOrderCoreModel::InstructionFetchStage::sync(const Time& next_stage_timestamp)
 }
 
 // Execution Unit
-InOrderCoreModel::ExecutionUnit::ExecutionUnit(CoreModel* core_model)
+InOrderCoreModel::ExecutionUnit::ExecutionUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler)
    : _core_model(core_model)
+   , _execution_port_scheduler(execution_port_scheduler)
 {}
 
 Time
-InOrderCoreModel::ExecutionUnit::handle(const Time& issue_time, Time& commit_time, uint16_t lat)
+InOrderCoreModel::ExecutionUnit::handle(Time& issue_time, Time& commit_time, const MicroOp& micro_op)
 {
-   Time cost = _core_model->getLatency(lat);
+   issue_time = _execution_port_scheduler->schedule(issue_time, micro_op.portMask, micro_op.extraSlots);
+   Time cost = _core_model->getLatency(micro_op.lat);
    Time results_ready = issue_time + cost;
    commit_time = getMax<Time>(commit_time, results_ready);
    return results_ready;
 }
 
 // Branch Unit
-InOrderCoreModel::BranchUnit::BranchUnit(CoreModel* core_model)
+InOrderCoreModel::BranchUnit::BranchUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler)
    : _core_model(core_model)
+   , _execution_port_scheduler(execution_port_scheduler)
 {}
 
 Time
-InOrderCoreModel::BranchUnit::handle(const Time& issue_time, Time& commit_time, uint16_t lat,
+InOrderCoreModel::BranchUnit::handle(Time& issue_time, Time& commit_time, const MicroOp& micro_op,
                                      uintptr_t address, BranchPredictor* branch_predictor,
                                      bool& speculation_failed)
 {
-   Time cost = _core_model->getLatency(lat);
+   issue_time = _execution_port_scheduler->schedule(issue_time, micro_op.portMask, micro_op.extraSlots);
+   Time cost = _core_model->getLatency(micro_op.lat);
    Time results_ready = issue_time + cost;
    commit_time = getMax<Time>(commit_time, results_ready);
    speculation_failed = branch_predictor->handle(address);
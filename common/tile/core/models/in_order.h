@@ -6,6 +6,7 @@ using std::pair;
 
 #include "core_model.h"
 #include "load_speculation_handler.h"
+#include "execution_port_scheduler.h"
 
 // In-order core, out-of-order memory model.
 //   We use a simple scoreboard to keep track of registers.
@@ -43,23 +44,27 @@ public:
    class ExecutionUnit
    {
    public:
-      ExecutionUnit(CoreModel* core_model);
+      ExecutionUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler);
 
-      Time handle(const Time& issue_time, Time& commit_time, uint16_t lat);
+      // 'issue_time' is delayed if the micro-op has to wait for an execution port
+      Time handle(Time& issue_time, Time& commit_time, const MicroOp& micro_op);
    private:
       CoreModel* _core_model;
+      ExecutionPortScheduler* _execution_port_scheduler;
    };
 
    class BranchUnit
    {
    public:
-      BranchUnit(CoreModel* core_model);
+      BranchUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler);
 
-      Time handle(const Time& issue_time, Time& commit_time, uint16_t lat,
+      // 'issue_time' is delayed if the micro-op has to wait for an execution port
+      Time handle(Time& issue_time, Time& commit_time, const MicroOp& micro_op,
                   uintptr_t address, BranchPredictor* branch_predictor,
                   bool& speculation_failed);
    private:
       CoreModel* _core_model;
+      ExecutionPortScheduler* _execution_port_scheduler;
    };
 
    class StoreQueue
@@ -139,6 +144,7 @@ public:
 
 private:
    InstructionFetchStage* _instruction_fetch_stage;
+   ExecutionPortScheduler* _execution_port_scheduler;
    ExecutionUnit* _execution_unit;
    BranchUnit* _branch_unit;
    LoadQueue* _load_queue;
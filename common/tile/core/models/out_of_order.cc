@@ -20,10 +20,21 @@ OutOfOrderCoreModel::OutOfOrderCoreModel(Core* core)
    _instruction_fetch_stage = new InstructionFetchStage(this);
    // Initialize reorder buffer
    _reorder_buffer = new ReorderBuffer(this);
+   // Initialize execution ports (shared by the execution and branch units)
+   bool execution_port_contention_enabled = false;
+   try
+   {
+      execution_port_contention_enabled = Sim()->getCfg()->getBool("core/execution_port_contention_enabled", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [core] params from the config file");
+   }
+   _execution_port_scheduler = new ExecutionPortScheduler(this, execution_port_contention_enabled);
    // Initialize execution unit
-   _execution_unit = new ExecutionUnit(this);
+   _execution_unit = new ExecutionUnit(this, _execution_port_scheduler);
    // Initialize branch unit
-   _branch_unit = new BranchUnit(this);
+   _branch_unit = new BranchUnit(this, _execution_port_scheduler);
    // Initialize load/store queues
    _load_queue = new LoadQueue(this);
    _store_queue = new StoreQueue(this);
@@ -54,6 +65,7 @@ OutOfOrderCoreModel::~OutOfOrderCoreModel()
    delete _load_queue;
    delete _branch_unit;
    delete _execution_unit;
+   delete _execution_port_scheduler;
    delete _reorder_buffer;
    delete _instruction_fetch_stage;
 }
@@ -70,6 +82,7 @@ OutOfOrderCoreModel::outputSummary(std::ostream &os, const Time& target_completi
                                _total_branch_speculation_violation__stall_time,
                                _total_load_speculation_violation__stall_time);
    CoreModel::outputSummary(os, target_completion_time);
+   _execution_port_scheduler->outputSummary(os, _curr_time);
 
    _load_queue->outputSummaryLoadSpeculation(os);
 }
@@ -130,7 +143,7 @@ OutOfOrderCoreModel::handleInstruction(Instruction* instruction)
       {
       case MicroOp::GENERAL:
          results_ready = _execution_unit->handle(_dispatch_time, _commit_time,
-                                                 all_operands_ready, micro_op.lat);
+                                                 all_operands_ready, micro_op);
          break;
 
       case MicroOp::LOAD:
@@ -155,7 +168,7 @@ OutOfOrderCoreModel::handleInstruction(Instruction* instruction)
 
       case MicroOp::STORE_ADDR:
          results_ready = _execution_unit->handle(_dispatch_time, _commit_time,
-                                                 all_operands_ready, micro_op.lat);
+                                                 all_operands_ready, micro_op);
          break;
 
       case MicroOp::FENCE:
@@ -170,7 +183,7 @@ OutOfOrderCoreModel::handleInstruction(Instruction* instruction)
          {
             bool speculation_failed = false;
             results_ready = _branch_unit->handle(_dispatch_time, _commit_time,
-                                                 all_operands_ready, micro_op.lat,
+                                                 all_operands_ready, micro_op,
                                                  instruction->getAddress(), _branch_predictor,
                                                  speculation_failed);
             assert(results_ready > _dispatch_time);
@@ -323,34 +336,38 @@ OutOfOrderCoreModel::ReorderBuffer::updateStallCounters(const Time& stall_time)
 }
 
 // Execution Unit
-OutOfOrderCoreModel::ExecutionUnit::ExecutionUnit(CoreModel* core_model)
+OutOfOrderCoreModel::ExecutionUnit::ExecutionUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler)
    : _core_model(core_model)
+   , _execution_port_scheduler(execution_port_scheduler)
 {}
 
 Time
 OutOfOrderCoreModel::ExecutionUnit::handle(const Time& dispatch_time, Time& commit_time,
-                                           const Time& operands_ready, uint16_t lat)
+                                           const Time& operands_ready, const MicroOp& micro_op)
 {
-   Time cost = _core_model->getLatency(lat);
-   Time issue_time = getMax<Time>(dispatch_time, operands_ready);
+   Time cost = _core_model->getLatency(micro_op.lat);
+   Time issue_time = _execution_port_scheduler->schedule(getMax<Time>(dispatch_time, operands_ready),
+                                                         micro_op.portMask, micro_op.extraSlots);
    Time results_ready = issue_time + cost;
    commit_time = getMax<Time>(commit_time, results_ready);
    return results_ready;
 }
 
 // Branch Unit
-OutOfOrderCoreModel::BranchUnit::BranchUnit(CoreModel* core_model)
+OutOfOrderCoreModel::BranchUnit::BranchUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler)
    : _core_model(core_model)
+   , _execution_port_scheduler(execution_port_scheduler)
 {}
 
 Time
 OutOfOrderCoreModel::BranchUnit::handle(const Time& dispatch_time, Time& commit_time,
-                                        const Time& operands_ready, uint16_t lat,
+                                        const Time& operands_ready, const MicroOp& micro_op,
                                         uintptr_t address, BranchPredictor* branch_predictor,
                                         bool& speculation_failed)
 {
-   Time cost = _core_model->getLatency(lat);
-   Time issue_time = getMax<Time>(dispatch_time, operands_ready);
+   Time cost = _core_model->getLatency(micro_op.lat);
+   Time issue_time = _execution_port_scheduler->schedule(getMax<Time>(dispatch_time, operands_ready),
+                                                         micro_op.portMask, micro_op.extraSlots);
    Time results_ready = issue_time + cost;
    commit_time = getMax<Time>(commit_time, results_ready);
    speculation_failed = branch_predictor->handle(address);
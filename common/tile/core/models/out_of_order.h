@@ -6,6 +6,7 @@ using std::pair;
 
 #include "core_model.h"
 #include "load_speculation_handler.h"
+#include "execution_port_scheduler.h"
 
 // Out-of-order core model.
 
@@ -72,25 +73,27 @@ public:
    class ExecutionUnit
    {
    public:
-      ExecutionUnit(CoreModel* core_model);
+      ExecutionUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler);
 
       Time handle(const Time& dispatch_time, Time& commit_time,
-                  const Time& operands_ready, uint16_t lat);
+                  const Time& operands_ready, const MicroOp& micro_op);
    private:
       CoreModel* _core_model;
+      ExecutionPortScheduler* _execution_port_scheduler;
    };
 
    class BranchUnit
    {
    public:
-      BranchUnit(CoreModel* core_model);
+      BranchUnit(CoreModel* core_model, ExecutionPortScheduler* execution_port_scheduler);
 
       Time handle(const Time& dispatch_time, Time& commit_time,
-                  const Time& operands_ready, uint16_t lat,
+                  const Time& operands_ready, const MicroOp& micro_op,
                   uintptr_t address, BranchPredictor* branch_predictor,
                   bool& speculation_failed);
    private:
       CoreModel* _core_model;
+      ExecutionPortScheduler* _execution_port_scheduler;
    };
 
    class StoreQueue
@@ -172,6 +175,7 @@ public:
 private:
    InstructionFetchStage* _instruction_fetch_stage;
    ReorderBuffer* _reorder_buffer;
+   ExecutionPortScheduler* _execution_port_scheduler;
    ExecutionUnit* _execution_unit;
    BranchUnit* _branch_unit;
    LoadQueue* _load_queue;
@@ -47,12 +47,36 @@
 
 using namespace std;
 
+LocalFdTable SyscallMdl::m_local_fd_table;
+
 SyscallMdl::SyscallMdl(Core *core)
    : m_called_enter(false)
    , m_ret_val(0)
    , m_network(core->getTile()->getNetwork())
    , m_target_start_time(0.0)
+   , m_local_fast_path(false)
+   , m_handled_locally(false)
+   , m_num_local_syscalls(0)
+   , m_num_forwarded_syscalls(0)
 {
+   UInt64 local_syscall_latency = 0;
+   try
+   {
+      m_local_fast_path = Sim()->getCfg()->getBool("syscall_model/local_fast_path", false);
+      local_syscall_latency = (UInt64) Sim()->getCfg()->getInt("syscall_model/local_latency", 0);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [syscall_model] parameters from the config file");
+   }
+   m_local_syscall_latency = Time(local_syscall_latency * 1000);
+
+   // The file descriptors returned by the MCP are only valid in the host process of the MCP,
+   // and the offsets tracked here are not seen by the syscalls forwarded from other processes
+   Config* config = Config::getSingleton();
+   if ((config->getProcessCountCurrentTarget() > 1) ||
+       (config->getProcessNumForTile(config->getMCPTileID()) != config->getCurrentProcessNum()))
+      m_local_fast_path = false;
 }
 
 // --------------------------------------------
@@ -129,11 +153,15 @@ IntPtr SyscallMdl::runEnter(IntPtr syscall_number, syscall_args_t &args)
    // Reset the buffers for the new transmission
    m_recv_buff.clear();
    m_send_buff.clear();
+   m_handled_locally = false;
 
    int msg_type = MCP_MESSAGE_SYS_CALL;
 
    m_send_buff << msg_type << syscall_number;
 
+   if (m_local_fast_path)
+      releaseLocalFds(syscall_number, args);
+
    switch (syscall_number)
    {
    case SYS_open:
@@ -277,6 +305,14 @@ IntPtr SyscallMdl::runEnter(IntPtr syscall_number, syscall_args_t &args)
       break;
    }
 
+   if (m_called_enter)
+   {
+      if (m_handled_locally)
+         m_num_local_syscalls ++;
+      else
+         m_num_forwarded_syscalls ++;
+   }
+
    LOG_PRINT("Syscall finished");
 
    return m_called_enter ? SYS_getpid : syscall_number;
@@ -328,6 +364,9 @@ IntPtr SyscallMdl::marshallOpenCall(syscall_args_t &args)
    int status;
    m_recv_buff >> status;
 
+   if (m_local_fast_path)
+      m_local_fd_table.add(status, flags);
+
    delete [] path_buf;
    delete [] (Byte*) recv_pkt.data;
 
@@ -364,6 +403,9 @@ IntPtr SyscallMdl::marshallReadCall(syscall_args_t &args)
    size_t count = (size_t)args.arg2;
    Core *core = Sim()->getTileManager()->getCurrentCore();
 
+   if (isLocalFd(fd))
+      return handleLocalReadCall(fd, buf, count);
+
    // if shared mem, provide the buf to read into
    m_send_buff << fd << count;
    m_network->netSend(Config::getSingleton()->getMCPCoreID(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
@@ -426,6 +468,9 @@ IntPtr SyscallMdl::marshallWriteCall(syscall_args_t &args)
    void *buf = (void *)args.arg1;
    size_t count = (size_t)args.arg2;
 
+   if (isLocalFd(fd))
+      return handleLocalWriteCall(fd, buf, count);
+
    char *write_buf = new char [count];
    // Always pass all the data in the message, even if shared memory is available
    // I think this is a reasonable model and is definitely one less thing to keep
@@ -476,6 +521,9 @@ IntPtr SyscallMdl::marshallWritevCall(syscall_args_t &args)
    struct iovec *iov = (struct iovec*) args.arg1;
    int iovcnt = (int) args.arg2;
 
+   if (isLocalFd(fd))
+      return handleLocalWritevCall(fd, iov, iovcnt);
+
    Core *core = Sim()->getTileManager()->getCurrentCore();
    
    struct iovec *iov_buf = new struct iovec [iovcnt];
@@ -538,6 +586,13 @@ IntPtr SyscallMdl::marshallCloseCall(syscall_args_t &args)
 
    int fd = (int)args.arg0;
 
+   if (isLocalFd(fd))
+   {
+      m_handled_locally = true;
+      chargeLocalSyscallLatency();
+      return m_local_fd_table.close(fd);
+   }
+
    m_send_buff << fd;
    m_network->netSend(Config::getSingleton()->getMCPCoreID(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
@@ -561,6 +616,13 @@ IntPtr SyscallMdl::marshallLseekCall(syscall_args_t &args)
    off_t offset = (off_t) args.arg1;
    int whence = (int) args.arg2;
 
+   if (isLocalFd(fd))
+   {
+      m_handled_locally = true;
+      chargeLocalSyscallLatency();
+      return m_local_fd_table.lseek(fd, offset, whence);
+   }
+
    m_send_buff << fd << offset << whence ;
    m_network->netSend(Config::getSingleton()->getMCPCoreID(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
@@ -660,6 +722,9 @@ IntPtr SyscallMdl::marshallFstatCall(syscall_args_t &args)
    int fd = (int) args.arg0;
    struct stat buf;
 
+   if (isLocalFd(fd))
+      return handleLocalFstatCall(fd, (struct stat*) args.arg1);
+
    Core* core = Sim()->getTileManager()->getCurrentCore();
    // Read the data from memory
    core->accessMemory(Core::NONE, Core::READ, (IntPtr) args.arg1, (char*) &buf, sizeof(struct stat));
@@ -1159,6 +1224,8 @@ IntPtr SyscallMdl::marshallRmdirCall(syscall_args_t &args)
 
 IntPtr SyscallMdl::handleTimeCall(syscall_args_t &args)
 {
+   m_handled_locally = true;
+
    time_t* t = (time_t*) args.arg0;
 
    Core* core = Sim()->getTileManager()->getCurrentCore();
@@ -1179,6 +1246,8 @@ IntPtr SyscallMdl::handleTimeCall(syscall_args_t &args)
 
 IntPtr SyscallMdl::handleGetTimeofDayCall(syscall_args_t &args)
 {
+   m_handled_locally = true;
+
    struct timeval* tv = (struct timeval*) args.arg0;
    __attribute__((unused)) struct timezone* tz = (struct timezone*) args.arg1;
    LOG_ASSERT_WARNING(tz == NULL, "SYS_gettimeofday - timezone argument ignored");
@@ -1207,6 +1276,8 @@ IntPtr SyscallMdl::handleGetTimeofDayCall(syscall_args_t &args)
 
 IntPtr SyscallMdl::handleClockGettimeCall(syscall_args_t &args)
 {
+   m_handled_locally = true;
+
    /* Notes
       (0) This syscall is handled locally rather than marshalling
           over to the MCP to handle it.  The reason is that
@@ -1248,6 +1319,8 @@ IntPtr SyscallMdl::handleClockGettimeCall(syscall_args_t &args)
 
 IntPtr SyscallMdl::handleClockGetResCall(syscall_args_t &args)
 {
+   m_handled_locally = true;
+
    __attribute__((unused)) clockid_t clk_id = (clockid_t) args.arg0;
    struct timespec *res = (struct timespec *) args.arg1;
 
@@ -1478,6 +1551,145 @@ double SyscallMdl::getStartTime()
    return m_target_start_time;
 }
 
+// A tracked fd used by any syscall that does not go through the table (dup, dup2, fcntl,
+// sendfile, ...) gets its kernel offset back and is not tracked any more
+void SyscallMdl::releaseLocalFds(IntPtr syscall_number, syscall_args_t &args)
+{
+   switch (syscall_number)
+   {
+   case SYS_open:
+   case SYS_read:
+   case SYS_write:
+   case SYS_writev:
+   case SYS_lseek:
+   case SYS_close:
+   case SYS_fstat:
+   // Do not take a descriptor, or do not use its offset
+   case SYS_access:
+   case SYS_stat:
+   case SYS_lstat:
+   case SYS_getpid:
+   case SYS_pipe:
+   case SYS_mmap:
+   case SYS_munmap:
+   case SYS_brk:
+   case SYS_futex:
+   case SYS_rmdir:
+   case SYS_unlink:
+   case SYS_time:
+   case SYS_gettimeofday:
+   case SYS_clock_gettime:
+   case SYS_clock_getres:
+   case SYS_getcwd:
+   case SYS_exit_group:
+   case SYS_sched_setaffinity:
+   case SYS_sched_getaffinity:
+      return;
+
+   default:
+      // Checks the first two arguments, so that the new fd of dup2/dup3 and the
+      // input fd of sendfile are covered too (a value that is not an fd is ignored)
+      m_local_fd_table.release((int) args.arg0);
+      m_local_fd_table.release((int) args.arg1);
+      return;
+   }
+}
+
+bool SyscallMdl::isLocalFd(int fd)
+{
+   return m_local_fast_path && m_local_fd_table.isTracked(fd);
+}
+
+// The syscall does not see the round trip to the MCP, charge the configured latency
+// instead (accounted like the wait for the MCP response)
+void SyscallMdl::chargeLocalSyscallLatency()
+{
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   if (core->getModel() && (m_local_syscall_latency > Time(0)))
+      core->getModel()->processDynamicInstruction(new NetRecvInstruction(m_local_syscall_latency));
+}
+
+IntPtr SyscallMdl::handleLocalReadCall(int fd, void* buf, size_t count)
+{
+   m_handled_locally = true;
+   chargeLocalSyscallLatency();
+
+   char* read_buf = new char[count];
+   ssize_t bytes = m_local_fd_table.read(fd, read_buf, count);
+   LOG_PRINT("Local Read(%i,%u) returns %i", fd, count, bytes);
+
+   // Write the data to memory
+   if (bytes > 0)
+   {
+      Core* core = Sim()->getTileManager()->getCurrentCore();
+      core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) buf, read_buf, bytes);
+   }
+
+   delete [] read_buf;
+   return bytes;
+}
+
+IntPtr SyscallMdl::handleLocalWriteCall(int fd, void* buf, size_t count)
+{
+   m_handled_locally = true;
+   chargeLocalSyscallLatency();
+
+   char* write_buf = new char[count];
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   core->accessMemory(Core::NONE, Core::READ, (IntPtr) buf, write_buf, count);
+
+   ssize_t bytes = m_local_fd_table.write(fd, write_buf, count);
+   LOG_PRINT("Local Write(%i,%u) returns %i", fd, count, bytes);
+
+   delete [] write_buf;
+   return bytes;
+}
+
+IntPtr SyscallMdl::handleLocalWritevCall(int fd, struct iovec* iov, int iovcnt)
+{
+   m_handled_locally = true;
+   chargeLocalSyscallLatency();
+
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   struct iovec* iov_buf = new struct iovec[iovcnt];
+   core->accessMemory(Core::NONE, Core::READ, (IntPtr) iov, (char*) iov_buf, iovcnt * sizeof(struct iovec));
+
+   // Point the iovec's to local copies of the data
+   for (int i = 0; i < iovcnt; i++)
+   {
+      char* data = new char[iov_buf[i].iov_len];
+      core->accessMemory(Core::NONE, Core::READ, (IntPtr) iov_buf[i].iov_base, data, iov_buf[i].iov_len);
+      iov_buf[i].iov_base = data;
+   }
+
+   IntPtr bytes = m_local_fd_table.writev(fd, iov_buf, iovcnt);
+
+   for (int i = 0; i < iovcnt; i++)
+      delete [] (char*) iov_buf[i].iov_base;
+   delete [] iov_buf;
+   return bytes;
+}
+
+IntPtr SyscallMdl::handleLocalFstatCall(int fd, struct stat* buf)
+{
+   m_handled_locally = true;
+   chargeLocalSyscallLatency();
+
+   struct stat stat_buf;
+   int result = fstat(fd, &stat_buf);
+
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) buf, (char*) &stat_buf, sizeof(struct stat));
+   return result;
+}
+
+void SyscallMdl::outputSummary(std::ostream& os)
+{
+   os << "Syscall Model Summary:" << endl;
+   os << "    Local Syscalls: " << m_num_local_syscalls << endl;
+   os << "    Forwarded Syscalls: " << m_num_forwarded_syscalls << endl;
+}
+
 UInt32 SyscallMdl::getStrLen (char *str)
 {
    UInt32 len = 0;
@@ -7,6 +7,7 @@
 #include "network.h"
 #include "fixed_types.h"
 #include "core.h"
+#include "local_fd_table.h"
 
 class SyscallMdl
 {
@@ -39,6 +40,8 @@ class SyscallMdl
 
       //---------------------------------------------------------
 
+      void outputSummary(std::ostream& os);
+
    private:
       
       // ------------------------------------------------------
@@ -61,6 +64,24 @@ class SyscallMdl
       // Target time when simulation was started
       double m_target_start_time;
 
+      // Syscalls on the regular files of the target run on this host process
+      // instead of the MCP, if the target and the MCP live in this process
+      static LocalFdTable m_local_fd_table;
+      bool m_local_fast_path;
+      Time m_local_syscall_latency;
+      bool m_handled_locally;
+
+      UInt64 m_num_local_syscalls;
+      UInt64 m_num_forwarded_syscalls;
+
+      bool isLocalFd(int fd);
+      void releaseLocalFds(IntPtr syscall_number, syscall_args_t &args);
+      void chargeLocalSyscallLatency();
+      IntPtr handleLocalReadCall(int fd, void* buf, size_t count);
+      IntPtr handleLocalWriteCall(int fd, void* buf, size_t count);
+      IntPtr handleLocalWritevCall(int fd, struct iovec* iov, int iovcnt);
+      IntPtr handleLocalFstatCall(int fd, struct stat* buf);
+
       IntPtr marshallOpenCall(syscall_args_t &args);
       IntPtr marshallReadCall(syscall_args_t &args);
       IntPtr marshallWriteCall(syscall_args_t &args);
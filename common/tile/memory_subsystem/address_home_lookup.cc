@@ -1,7 +1,9 @@
 #include "address_home_lookup.h"
+#include "config.h"
 #include "log.h"
 
-AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_list, UInt32 cache_line_size):
+AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_list, UInt32 cache_line_size,
+                                     bool partition_by_target):
    _ahl_param(ahl_param),
    _tile_list(tile_list),
    _cache_line_size(cache_line_size)
@@ -10,6 +12,24 @@ AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_l
                     "[1 << AHL param](%u) must be >= [Cache Block Size](%u)",
                     1 << _ahl_param, _cache_line_size);
    _total_modules = tile_list.size();
+
+   Config* config = Config::getSingleton();
+   if (partition_by_target && (config->getTargetCount() > 1))
+   {
+      _target_tile_list.resize(config->getTargetCount());
+      for (vector<tile_id_t>::iterator it = _tile_list.begin(); it != _tile_list.end(); it++)
+         _target_tile_list[config->getTargetNumForTile(*it)].push_back(*it);
+
+      // A target that owns none of the tiles keeps using all of them
+      for (UInt32 i = 0; i < _target_tile_list.size(); i++)
+      {
+         if (_target_tile_list[i].empty())
+         {
+            LOG_PRINT("Target(%u) owns none of the home tiles, sharing all of them", i);
+            _target_tile_list[i] = _tile_list;
+         }
+      }
+   }
 }
 
 AddressHomeLookup::~AddressHomeLookup()
@@ -18,6 +38,17 @@ AddressHomeLookup::~AddressHomeLookup()
 tile_id_t
 AddressHomeLookup::getHome(IntPtr address) const
 {
+   if (!_target_tile_list.empty())
+   {
+      UInt32 target_num = Config::getSingleton()->getTargetNumFromAddress(address);
+      LOG_ASSERT_ERROR(target_num < _target_tile_list.size(), "address(%#lx), target(%u)", address, target_num);
+
+      const vector<tile_id_t>& target_tile_list = _target_tile_list[target_num];
+      SInt32 module_num = (address >> _ahl_param) % target_tile_list.size();
+      LOG_PRINT("address(%#lx), target(%u), module_num(%i)", address, target_num, module_num);
+      return (target_tile_list[module_num]);
+   }
+
    SInt32 module_num = (address >> _ahl_param) % _total_modules;
    LOG_ASSERT_ERROR(0 <= module_num && module_num < (SInt32) _total_modules, "module_num(%i), total_modules(%u)", module_num, _total_modules);
    
@@ -18,10 +18,13 @@ using namespace std;
  * Maybe allow the ability to have public and private memory space?
  */
 
+// With 'partition_by_target', the addresses of each target of a multi-application run
+// are homed only on the tiles of that target (when it owns any of the tiles in the list)
 class AddressHomeLookup
 {
 public:
-   AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_list, UInt32 cache_line_size);
+   AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_list, UInt32 cache_line_size,
+                     bool partition_by_target = false);
    ~AddressHomeLookup();
    tile_id_t getHome(IntPtr address) const;
 
@@ -30,4 +33,6 @@ private:
    vector<tile_id_t> _tile_list;
    UInt32 _total_modules;
    UInt32 _cache_line_size;
+   // Home tiles of each target (empty if not partitioned)
+   vector<vector<tile_id_t> > _target_tile_list;
 };
@@ -1,6 +1,7 @@
 #include "simulator.h"
 #include "cache.h"
 #include "cache_set.h"
+#include "fixed_cache_set.h"
 #include "cache_line_info.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
@@ -58,12 +59,15 @@ Cache::Cache(string name,
 
    _log_line_size = floorLog2(_line_size);
   
-   // Instantiate cache sets 
+   // Instantiate cache sets
    _sets = new CacheSet*[_num_sets];
    for (UInt32 i = 0; i < _num_sets; i++)
    {
       _sets[i] = new CacheSet(i, caching_protocol_type, cache_level, _replacement_policy, _associativity, _line_size);
    }
+   // Operations on the sets specialized for the common configurations (if enabled)
+   _fixed_cache_set_ops = MemoryManager::getSpecializeCacheSets() ?
+                          FixedCacheSetOps::get(_replacement_policy, _associativity, _line_size) : NULL;
 
    // Initialize DVFS variables
    initializeDVFS();
@@ -107,11 +111,16 @@ Cache::readCacheLine(IntPtr address, Byte* buf, UInt32 num_bytes)
    UInt32 line_offset = getLineOffset(address);
    UInt32 line_index = -1;
   
-   __attribute__((unused)) CacheLineInfo* cache_line_info = set->find(tag, &line_index);
+   __attribute__((unused)) CacheLineInfo* cache_line_info = _fixed_cache_set_ops ?
+                                                            _fixed_cache_set_ops->find(set, tag, &line_index) :
+                                                            set->find(tag, &line_index);
    LOG_ASSERT_ERROR(cache_line_info, "readCacheLine: Cache(%s), Address(%#lx), Num-Bytes(%u)",
                     _name.c_str(), address, num_bytes);
 
-   set->read_line(line_index, line_offset, buf, num_bytes);
+   if (_fixed_cache_set_ops)
+      _fixed_cache_set_ops->read_line(set, line_index, line_offset, buf, num_bytes);
+   else
+      set->read_line(line_index, line_offset, buf, num_bytes);
 
    // Update data array reads
    if (_enabled)
@@ -133,11 +142,16 @@ Cache::writeCacheLine(IntPtr address, const Byte* buf, UInt32 num_bytes)
    UInt32 line_offset = getLineOffset(address);
    UInt32 line_index = -1;
   
-   __attribute__((unused)) CacheLineInfo* cache_line_info = set->find(tag, &line_index);
+   __attribute__((unused)) CacheLineInfo* cache_line_info = _fixed_cache_set_ops ?
+                                                            _fixed_cache_set_ops->find(set, tag, &line_index) :
+                                                            set->find(tag, &line_index);
    LOG_ASSERT_ERROR(cache_line_info, "writeCacheLine: Cache(%s), Address(%#lx), Num-Bytes(%u)",
                     _name.c_str(), address, num_bytes);
 
-   set->write_line(line_index, line_offset, buf, num_bytes);
+   if (_fixed_cache_set_ops)
+      _fixed_cache_set_ops->write_line(set, line_index, line_offset, buf, num_bytes);
+   else
+      set->write_line(line_index, line_offset, buf, num_bytes);
 
    // Update data array writes
    if (_enabled)
@@ -155,8 +169,16 @@ Cache::insertCacheLine(IntPtr inserted_address, CacheLineInfo* inserted_cache_li
    CacheSet* set = getSet(inserted_address);
 
    // Write into the data array
-   set->insert(inserted_cache_line_info, fill_buf,
-               eviction, evicted_cache_line_info, writeback_buf);
+   if (_fixed_cache_set_ops)
+   {
+      _fixed_cache_set_ops->insert(set, inserted_cache_line_info, fill_buf,
+                                   eviction, evicted_cache_line_info, writeback_buf);
+   }
+   else
+   {
+      set->insert(inserted_cache_line_info, fill_buf,
+                  eviction, evicted_cache_line_info, writeback_buf);
+   }
   
    // Evicted address 
    *evicted_address = getAddressFromTag(evicted_cache_line_info->getTag());
@@ -246,7 +268,7 @@ Cache::getCacheLineInfo(IntPtr address)
    CacheSet* set = getSet(address);
    IntPtr tag = getTag(address);
 
-   CacheLineInfo* line_info = set->find(tag);
+   CacheLineInfo* line_info = _fixed_cache_set_ops ? _fixed_cache_set_ops->find(set, tag, NULL) : set->find(tag);
 
    LOG_PRINT("__getCacheLineInfo: Cache(%s), Address(%#lx) end", _name.c_str(), address);
    return line_info;
@@ -18,6 +18,7 @@ using std::set;
 
 // Forwards Decls
 class CacheSet;
+struct FixedCacheSetOps;
 class CacheLineInfo;
 class CacheReplacementPolicy;
 class CacheHashFn;
@@ -140,6 +141,8 @@ private:
    CacheCategory _cache_category;
    WritePolicy _write_policy;
    CacheSet** _sets;
+   // Operations specialized for the configuration of the sets (NULL: generic CacheSet methods)
+   const FixedCacheSetOps* _fixed_cache_set_ops;
 
    // Cache params
    UInt32 _cache_size;
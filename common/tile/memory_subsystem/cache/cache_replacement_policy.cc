@@ -1,11 +1,15 @@
 #include "cache_replacement_policy.h"
 #include "round_robin_replacement_policy.h"
 #include "lru_replacement_policy.h"
+#include "tree_plru_replacement_policy.h"
+#include "rrip_replacement_policy.h"
+#include "dip_replacement_policy.h"
 #include "cache_line_info.h"
 #include "log.h"
 
 CacheReplacementPolicy::CacheReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
-   : _associativity(associativity)
+   : _type(NUM_TYPES)
+   , _associativity(associativity)
 {
    _num_sets = cache_size * k_KILO / (cache_line_size * _associativity);
 }
@@ -17,17 +21,35 @@ CacheReplacementPolicy*
 CacheReplacementPolicy::create(string policy_str, UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
 {
    Type policy = parse(policy_str);
+   CacheReplacementPolicy* replacement_policy = (CacheReplacementPolicy*) NULL;
 
    switch (policy)
    {
    case ROUND_ROBIN:
-      return new RoundRobinReplacementPolicy(cache_size, associativity, cache_line_size);
+      replacement_policy = new RoundRobinReplacementPolicy(cache_size, associativity, cache_line_size);
+      break;
    case LRU:
-      return new LRUReplacementPolicy(cache_size, associativity, cache_line_size);
+      replacement_policy = new LRUReplacementPolicy(cache_size, associativity, cache_line_size);
+      break;
+   case TREE_PLRU:
+      replacement_policy = new TreePLRUReplacementPolicy(cache_size, associativity, cache_line_size);
+      break;
+   case SRRIP:
+      replacement_policy = new SRRIPReplacementPolicy(cache_size, associativity, cache_line_size);
+      break;
+   case BRRIP:
+      replacement_policy = new BRRIPReplacementPolicy(cache_size, associativity, cache_line_size);
+      break;
+   case DIP:
+      replacement_policy = new DIPReplacementPolicy(cache_size, associativity, cache_line_size);
+      break;
    default:
       LOG_PRINT_ERROR("Unrecognized Replacement Policy(%u)", policy);
       return (CacheReplacementPolicy*) NULL;
    }
+
+   replacement_policy->_type = policy;
+   return replacement_policy;
 }
 
 CacheReplacementPolicy::Type
@@ -37,6 +59,14 @@ CacheReplacementPolicy::parse(string policy_str)
       return ROUND_ROBIN;
    if (policy_str == "lru")
       return LRU;
+   if (policy_str == "tree_plru")
+      return TREE_PLRU;
+   if (policy_str == "srrip")
+      return SRRIP;
+   if (policy_str == "brrip")
+      return BRRIP;
+   if (policy_str == "dip")
+      return DIP;
    else
    {
       LOG_PRINT_ERROR("Unrecognized Cache Replacement Policy(%s)", policy_str.c_str());
@@ -15,6 +15,10 @@ public:
    {
       ROUND_ROBIN = 0,
       LRU,
+      TREE_PLRU,
+      SRRIP,
+      BRRIP,
+      DIP,
       NUM_TYPES
    };
 
@@ -23,11 +27,18 @@ public:
 
    static CacheReplacementPolicy* create(string policy_str, UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
    static Type parse(string policy_str);
+   // NUM_TYPES for policies not created through create()
+   Type getType() const       { return _type; }
    
    virtual UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num) = 0;
    virtual void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way) = 0;
+   // Called when a new line is filled into 'inserted_way' (i.e., on a miss).
+   // Policies that do not distinguish fills from hits treat it as an access.
+   virtual void insert(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 inserted_way)
+   { update(cache_line_info_array, set_num, inserted_way); }
 
 protected:
+   Type _type;
    UInt32 _num_sets;
    UInt32 _associativity;
 };
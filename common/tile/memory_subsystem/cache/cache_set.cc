@@ -102,5 +102,5 @@ CacheSet::insert(CacheLineInfo* inserted_cache_line_info, const Byte* fill_buf,
       memcpy(&_lines[index * _line_size], fill_buf, _line_size);
 
    // Update replacement policy
-   _replacement_policy->update(_cache_line_info_array, _set_num, index);
+   _replacement_policy->insert(_cache_line_info_array, _set_num, index);
 }
@@ -19,6 +19,9 @@ public:
                bool* eviction, CacheLineInfo* evicted_cache_line_info, Byte* writeback_buf);
    CacheLineInfo** getCacheLineInfoArray() const               { return _cache_line_info_array; }
 
+   // Specialized operations on the set (see fixed_cache_set.h)
+   template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy> friend class FixedCacheSet;
+
 private:
    CacheLineInfo** _cache_line_info_array;
    char* _lines;
@@ -0,0 +1,68 @@
+#include <algorithm>
+using std::max;
+
+#include "dip_replacement_policy.h"
+#include "cache_line_info.h"
+#include "log.h"
+
+DIPReplacementPolicy::DIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : LRUReplacementPolicy(cache_size, associativity, cache_line_size)
+   , _psel(1 << (_PSEL_BITS - 1))
+   , _num_bip_fills(0)
+{
+   // Small caches use fewer leader sets so that most sets still follow the winning policy
+   _leader_set_spacing = max<UInt32>(_num_sets / _NUM_LEADER_SETS, _MIN_LEADER_SET_SPACING);
+}
+
+DIPReplacementPolicy::~DIPReplacementPolicy()
+{}
+
+void
+DIPReplacementPolicy::insert(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 inserted_way)
+{
+   // Every fill is a miss
+   SetType set_type = getSetType(set_num);
+   if ((set_type == LRU_LEADER) && (_psel < ((1U << _PSEL_BITS) - 1)))
+      _psel ++;
+   else if ((set_type == BIP_LEADER) && (_psel > 0))
+      _psel --;
+
+   bool use_bip = (set_type == BIP_LEADER) ||
+                  ((set_type == FOLLOWER) && (_psel >= (1U << (_PSEL_BITS - 1))));
+   if (use_bip)
+   {
+      _num_bip_fills ++;
+      if ((_num_bip_fills % _BIMODAL_THROTTLE) != 0)
+      {
+         moveToLRUPosition(set_num, inserted_way);
+         return;
+      }
+   }
+   update(cache_line_info_array, set_num, inserted_way);
+}
+
+DIPReplacementPolicy::SetType
+DIPReplacementPolicy::getSetType(UInt32 set_num) const
+{
+   if (_num_sets < 2)
+      return LRU_LEADER;
+   UInt32 offset = set_num % _leader_set_spacing;
+   if (offset == 0)
+      return LRU_LEADER;
+   else if (offset == 1)
+      return BIP_LEADER;
+   else
+      return FOLLOWER;
+}
+
+void
+DIPReplacementPolicy::moveToLRUPosition(UInt32 set_num, UInt32 way)
+{
+   vector<UInt8>& lru_bits = _lru_bits_vec[set_num];
+   for (UInt32 i = 0; i < _associativity; i++)
+   {
+      if (lru_bits[i] > lru_bits[way])
+         lru_bits[i] --;
+   }
+   lru_bits[way] = _associativity - 1;
+}
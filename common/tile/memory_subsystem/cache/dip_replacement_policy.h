@@ -0,0 +1,37 @@
+#pragma once
+
+#include "lru_replacement_policy.h"
+
+// Dynamic insertion policy (DIP): LRU and bimodal insertion (BIP) compete on a few dedicated
+// leader sets and a saturating counter of their misses picks the policy for all the other sets.
+// BIP inserts new lines at the LRU position and only occasionally at the MRU position, so lines
+// that are never reused leave the cache quickly.
+class DIPReplacementPolicy : public LRUReplacementPolicy
+{
+public:
+   DIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~DIPReplacementPolicy();
+
+   void insert(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 inserted_way);
+
+private:
+   enum SetType
+   {
+      LRU_LEADER,
+      BIP_LEADER,
+      FOLLOWER
+   };
+
+   static const UInt32 _NUM_LEADER_SETS = 32;
+   static const UInt32 _MIN_LEADER_SET_SPACING = 8;
+   static const UInt32 _PSEL_BITS = 10;
+   static const UInt32 _BIMODAL_THROTTLE = 32;
+
+   UInt32 _leader_set_spacing;
+   // Policy selector: incremented on misses in LRU leader sets, decremented on misses in BIP leader sets
+   UInt32 _psel;
+   UInt32 _num_bip_fills;
+
+   SetType getSetType(UInt32 set_num) const;
+   void moveToLRUPosition(UInt32 set_num, UInt32 way);
+};
@@ -0,0 +1,131 @@
+#include <cstring>
+#include "fixed_cache_set.h"
+#include "lru_replacement_policy.h"
+#include "tree_plru_replacement_policy.h"
+#include "cache_line_info.h"
+#include "log.h"
+
+template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy>
+void
+FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::read_line(CacheSet* set, UInt32 line_index, UInt32 offset,
+                                                                      Byte *out_buf, UInt32 bytes)
+{
+   assert(offset + bytes <= LINE_SIZE);
+   assert((out_buf == NULL) == (bytes == 0));
+
+   if (out_buf != NULL)
+      memcpy((void*) out_buf, &set->_lines[line_index * LINE_SIZE + offset], bytes);
+
+   // Update replacement policy
+   getReplacementPolicy(set)->template updateFixedAssoc<ASSOCIATIVITY>(set->_set_num, line_index);
+}
+
+template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy>
+void
+FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::write_line(CacheSet* set, UInt32 line_index, UInt32 offset,
+                                                                       const Byte *in_buf, UInt32 bytes)
+{
+   assert(offset + bytes <= LINE_SIZE);
+   assert((in_buf == NULL) == (bytes == 0));
+
+   if (in_buf != NULL)
+      memcpy(&set->_lines[line_index * LINE_SIZE + offset], in_buf, bytes);
+
+   // Update replacement policy
+   getReplacementPolicy(set)->template updateFixedAssoc<ASSOCIATIVITY>(set->_set_num, line_index);
+}
+
+template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy>
+CacheLineInfo*
+FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::find(CacheSet* set, IntPtr tag, UInt32* line_index)
+{
+   CacheLineInfo** cache_line_info_array = set->_cache_line_info_array;
+   for (SInt32 index = ASSOCIATIVITY-1; index >= 0; index--)
+   {
+      if (cache_line_info_array[index]->getTag() == tag)
+      {
+         if (line_index != NULL)
+            *line_index = index;
+         return (cache_line_info_array[index]);
+      }
+   }
+   return NULL;
+}
+
+template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy>
+void
+FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::insert(CacheSet* set, CacheLineInfo* inserted_cache_line_info,
+                                                                   const Byte* fill_buf, bool* eviction,
+                                                                   CacheLineInfo* evicted_cache_line_info, Byte* writeback_buf)
+{
+   CacheLineInfo** cache_line_info_array = set->_cache_line_info_array;
+   ReplacementPolicy* replacement_policy = getReplacementPolicy(set);
+
+   const UInt32 index = replacement_policy->template getFixedAssocReplacementWay<ASSOCIATIVITY>(cache_line_info_array, set->_set_num);
+   assert(index < ASSOCIATIVITY);
+
+   assert(eviction != NULL);
+
+   if (cache_line_info_array[index]->isValid())
+   {
+      *eviction = true;
+      evicted_cache_line_info->assign(cache_line_info_array[index]);
+      if (writeback_buf != NULL)
+         memcpy((void*) writeback_buf, &set->_lines[index * LINE_SIZE], LINE_SIZE);
+   }
+   else
+   {
+      *eviction = false;
+   }
+
+   cache_line_info_array[index]->assign(inserted_cache_line_info);
+   if (fill_buf != NULL)
+      memcpy(&set->_lines[index * LINE_SIZE], fill_buf, LINE_SIZE);
+
+   // Update replacement policy
+   replacement_policy->template updateFixedAssoc<ASSOCIATIVITY>(set->_set_num, index);
+}
+
+template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy>
+const FixedCacheSetOps FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::_ops =
+{
+   FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::read_line,
+   FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::write_line,
+   FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::find,
+   FixedCacheSet<ASSOCIATIVITY, LINE_SIZE, ReplacementPolicy>::insert
+};
+
+// Production configurations: 64 byte lines, 4-way L1 and 8-way L2 caches
+template class FixedCacheSet<4, 64, LRUReplacementPolicy>;
+template class FixedCacheSet<8, 64, LRUReplacementPolicy>;
+template class FixedCacheSet<4, 64, TreePLRUReplacementPolicy>;
+template class FixedCacheSet<8, 64, TreePLRUReplacementPolicy>;
+
+const FixedCacheSetOps*
+FixedCacheSetOps::get(CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size)
+{
+   if (line_size != 64)
+      return NULL;
+
+   // getType() is exact: policies derived from LRU (e.g., DIP) do not match
+   switch (replacement_policy->getType())
+   {
+   case CacheReplacementPolicy::LRU:
+      if (associativity == 4)
+         return &FixedCacheSet<4, 64, LRUReplacementPolicy>::_ops;
+      else if (associativity == 8)
+         return &FixedCacheSet<8, 64, LRUReplacementPolicy>::_ops;
+      break;
+
+   case CacheReplacementPolicy::TREE_PLRU:
+      if (associativity == 4)
+         return &FixedCacheSet<4, 64, TreePLRUReplacementPolicy>::_ops;
+      else if (associativity == 8)
+         return &FixedCacheSet<8, 64, TreePLRUReplacementPolicy>::_ops;
+      break;
+
+   default:
+      break;
+   }
+   return NULL;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "cache_set.h"
+
+// Cache set operations with the associativity, line size and replacement policy fixed at compile time.
+// The tag search and data copies run over constant bounds and the replacement policy is
+// called directly instead of through CacheReplacementPolicy, so the compiler can unroll
+// and inline both. The sets themselves stay plain CacheSets: Cache picks the table of
+// operations once, at construction (FixedCacheSetOps::get()), and every other configuration
+// calls the (non-virtual) CacheSet methods as before.
+// The common configurations are instantiated in fixed_cache_set.cc.
+// Only policies that treat a fill like any other access (lru, tree_plru) can be used here.
+struct FixedCacheSetOps
+{
+   void (*read_line)(CacheSet* set, UInt32 line_index, UInt32 offset, Byte *out_buf, UInt32 bytes);
+   void (*write_line)(CacheSet* set, UInt32 line_index, UInt32 offset, const Byte *in_buf, UInt32 bytes);
+   CacheLineInfo* (*find)(CacheSet* set, IntPtr tag, UInt32* line_index);
+   void (*insert)(CacheSet* set, CacheLineInfo* inserted_cache_line_info, const Byte* fill_buf,
+                  bool* eviction, CacheLineInfo* evicted_cache_line_info, Byte* writeback_buf);
+
+   // Returns NULL if the (associativity, line size, replacement policy) combination has not been instantiated
+   static const FixedCacheSetOps* get(CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size);
+};
+
+template <UInt32 ASSOCIATIVITY, UInt32 LINE_SIZE, class ReplacementPolicy>
+class FixedCacheSet
+{
+public:
+   static void read_line(CacheSet* set, UInt32 line_index, UInt32 offset, Byte *out_buf, UInt32 bytes);
+   static void write_line(CacheSet* set, UInt32 line_index, UInt32 offset, const Byte *in_buf, UInt32 bytes);
+   static CacheLineInfo* find(CacheSet* set, IntPtr tag, UInt32* line_index);
+   static void insert(CacheSet* set, CacheLineInfo* inserted_cache_line_info, const Byte* fill_buf,
+                      bool* eviction, CacheLineInfo* evicted_cache_line_info, Byte* writeback_buf);
+
+   static const FixedCacheSetOps _ops;
+
+private:
+   static ReplacementPolicy* getReplacementPolicy(CacheSet* set)
+   { return static_cast<ReplacementPolicy*>(set->_replacement_policy); }
+};
@@ -4,6 +4,8 @@
 using std::vector;
 
 #include "cache_replacement_policy.h"
+#include "cache_line_info.h"
+#include "log.h"
 
 class LRUReplacementPolicy : public CacheReplacementPolicy
 {
@@ -13,7 +15,44 @@ public:
 
    UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
    void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+
+   // Same as above with the associativity fixed at compile time (used by FixedCacheSet)
+   template <UInt32 ASSOCIATIVITY>
+   UInt32 getFixedAssocReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
+   template <UInt32 ASSOCIATIVITY>
+   void updateFixedAssoc(UInt32 set_num, UInt32 accessed_way);
   
 protected: 
    vector<vector<UInt8> > _lru_bits_vec;
 };
+
+template <UInt32 ASSOCIATIVITY>
+inline UInt32
+LRUReplacementPolicy::getFixedAssocReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
+{
+   const UInt8* lru_bits = &_lru_bits_vec[set_num][0];
+   UInt32 way = ASSOCIATIVITY;
+   for (UInt32 i = 0; i < ASSOCIATIVITY; i++)
+   {
+      if (!cache_line_info_array[i]->isValid())
+         return i;
+      else if (lru_bits[i] == (ASSOCIATIVITY-1))
+         way = i;
+   }
+   LOG_ASSERT_ERROR(way < ASSOCIATIVITY, "Error Finding LRU bits");
+   return way;
+}
+
+template <UInt32 ASSOCIATIVITY>
+inline void
+LRUReplacementPolicy::updateFixedAssoc(UInt32 set_num, UInt32 accessed_way)
+{
+   UInt8* lru_bits = &_lru_bits_vec[set_num][0];
+   UInt8 accessed_lru_bits = lru_bits[accessed_way];
+   for (UInt32 i = 0; i < ASSOCIATIVITY; i++)
+   {
+      if (lru_bits[i] < accessed_lru_bits)
+         lru_bits[i] ++;
+   }
+   lru_bits[accessed_way] = 0;
+}
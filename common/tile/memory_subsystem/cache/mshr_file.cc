@@ -0,0 +1,140 @@
+#include <cassert>
+#include "mshr_file.h"
+#include "log.h"
+
+MshrFile::MshrFile(string name, UInt32 num_entries)
+   : _name(name)
+   , _num_entries(num_entries)
+   , _enabled(false)
+   , _total_allocations(0)
+   , _total_merged_accesses(0)
+   , _total_full_stalls(0)
+   , _total_full_stall_time(0)
+   , _total_occupancy(0)
+   , _max_occupancy(0)
+{
+   LOG_ASSERT_ERROR(_num_entries > 0, "%s: Number of MSHRs must be > 0", _name.c_str());
+   _entry_list.reserve(_num_entries);
+}
+
+MshrFile::~MshrFile()
+{}
+
+MshrFile*
+MshrFile::create(string name, UInt32 num_entries)
+{
+   if (num_entries == 0)
+      return (MshrFile*) NULL;
+   return new MshrFile(name, num_entries);
+}
+
+Time
+MshrFile::getAllocateTime(const Time& issue_time)
+{
+   releaseEntries(issue_time);
+   if (_entry_list.size() < _num_entries)
+      return issue_time;
+
+   // All entries are busy - wait for the earliest fill
+   Time allocate_time = getEarliestCompletingEntry()->_completion_time;
+   if (_enabled)
+   {
+      _total_full_stalls ++;
+      _total_full_stall_time += (allocate_time - issue_time);
+   }
+   return allocate_time;
+}
+
+void
+MshrFile::allocate(IntPtr address, const Time& allocate_time, const Time& completion_time)
+{
+   LOG_ASSERT_ERROR(completion_time >= allocate_time, "%s: Address(%#lx), Allocate time(%llu ns), Completion time(%llu ns)",
+                    _name.c_str(), address, allocate_time.toNanosec(), completion_time.toNanosec());
+
+   releaseEntries(allocate_time);
+   // Misses are not always seen in simulated time order, so the file can appear full here.
+   // Reuse the entry that frees up first in that case.
+   if (_entry_list.size() == _num_entries)
+      _entry_list.erase(getEarliestCompletingEntry());
+   _entry_list.push_back(Entry(address, allocate_time, completion_time));
+
+   if (_enabled)
+   {
+      _total_allocations ++;
+      _total_occupancy += _entry_list.size();
+      if (_entry_list.size() > _max_occupancy)
+         _max_occupancy = _entry_list.size();
+   }
+}
+
+bool
+MshrFile::lookup(IntPtr address, const Time& time, Time& completion_time)
+{
+   for (vector<Entry>::iterator it = _entry_list.begin(); it != _entry_list.end(); it ++)
+   {
+      if (((*it)._address == address) && ((*it)._completion_time > time))
+      {
+         completion_time = (*it)._completion_time;
+         if (_enabled)
+            _total_merged_accesses ++;
+         return true;
+      }
+   }
+   return false;
+}
+
+void
+MshrFile::releaseEntries(const Time& time)
+{
+   vector<Entry>::iterator it = _entry_list.begin();
+   while (it != _entry_list.end())
+   {
+      if ((*it)._completion_time <= time)
+         it = _entry_list.erase(it);
+      else
+         it ++;
+   }
+}
+
+vector<MshrFile::Entry>::iterator
+MshrFile::getEarliestCompletingEntry()
+{
+   assert(!_entry_list.empty());
+   vector<Entry>::iterator earliest_it = _entry_list.begin();
+   for (vector<Entry>::iterator it = _entry_list.begin(); it != _entry_list.end(); it ++)
+   {
+      if ((*it)._completion_time < (*earliest_it)._completion_time)
+         earliest_it = it;
+   }
+   return earliest_it;
+}
+
+void
+MshrFile::outputSummary(ostream& out)
+{
+   out << "    MSHRs: " << _num_entries << endl;
+   out << "      Allocations: " << _total_allocations << endl;
+   out << "      Merged Accesses: " << _total_merged_accesses << endl;
+   out << "      Full Stalls: " << _total_full_stalls << endl;
+   if (_total_full_stalls > 0)
+      out << "      Average Full Stall Time (in nanoseconds): " << ((float) _total_full_stall_time.toNanosec()) / _total_full_stalls << endl;
+   else
+      out << "      Average Full Stall Time (in nanoseconds): " << endl;
+   if (_total_allocations > 0)
+      out << "      Average Occupancy: " << ((float) _total_occupancy) / _total_allocations << endl;
+   else
+      out << "      Average Occupancy: " << endl;
+   out << "      Max Occupancy: " << _max_occupancy << endl;
+}
+
+void
+MshrFile::dummyOutputSummary(ostream& out)
+{
+   out << "    MSHRs: " << endl;
+   out << "      Allocations: " << endl;
+   out << "      Merged Accesses: " << endl;
+   out << "      Full Stalls: " << endl;
+   out << "      Average Full Stall Time (in nanoseconds): " << endl;
+   out << "      Average Occupancy: " << endl;
+   out << "      Max Occupancy: " << endl;
+}
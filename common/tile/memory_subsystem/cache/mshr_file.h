@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+using std::string;
+using std::vector;
+using std::ostream;
+using std::endl;
+
+#include "fixed_types.h"
+#include "time_types.h"
+
+// Miss status holding registers (MSHRs) of a cache.
+// Each tile still resolves its misses one at a time functionally, so the MSHR file tracks
+// the misses that overlap in simulated time. A miss holds an entry from the time it leaves
+// the cache till its fill arrives. A miss that finds all entries busy waits for the earliest
+// fill, and an access to a line whose fill is still in flight merges with that miss and
+// completes when the fill arrives.
+class MshrFile
+{
+public:
+   MshrFile(string name, UInt32 num_entries);
+   ~MshrFile();
+
+   // Returns NULL if num_entries is 0 (MSHRs are not modeled)
+   static MshrFile* create(string name, UInt32 num_entries);
+
+   UInt32 getNumEntries() const  { return _num_entries; }
+
+   // Time at which a miss issued at 'issue_time' gets a free entry
+   Time getAllocateTime(const Time& issue_time);
+   // Record a miss that holds an entry from 'allocate_time' till 'completion_time'
+   void allocate(IntPtr address, const Time& allocate_time, const Time& completion_time);
+   // Returns true if a fill for 'address' is still in flight at 'time' and sets its completion time
+   bool lookup(IntPtr address, const Time& time, Time& completion_time);
+
+   void enable()                 { _enabled = true; }
+   void disable()                { _enabled = false; }
+
+   void outputSummary(ostream& out);
+   static void dummyOutputSummary(ostream& out);
+
+private:
+   class Entry
+   {
+   public:
+      Entry(IntPtr address, const Time& allocate_time, const Time& completion_time)
+         : _address(address), _allocate_time(allocate_time), _completion_time(completion_time) {}
+
+      IntPtr _address;
+      Time _allocate_time;
+      Time _completion_time;
+   };
+
+   string _name;
+   UInt32 _num_entries;
+   vector<Entry> _entry_list;
+   bool _enabled;
+
+   // Occupancy counters
+   UInt64 _total_allocations;
+   UInt64 _total_merged_accesses;
+   UInt64 _total_full_stalls;
+   Time _total_full_stall_time;
+   UInt64 _total_occupancy;
+   UInt32 _max_occupancy;
+
+   // Free the entries whose fills have arrived by 'time'
+   void releaseEntries(const Time& time);
+   vector<Entry>::iterator getEarliestCompletingEntry();
+};
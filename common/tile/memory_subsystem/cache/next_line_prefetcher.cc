@@ -0,0 +1,15 @@
+#include "next_line_prefetcher.h"
+
+NextLinePrefetcher::NextLinePrefetcher(UInt32 cache_line_size, UInt32 prefetch_degree)
+   : Prefetcher(NEXT_LINE, cache_line_size, prefetch_degree)
+{}
+
+NextLinePrefetcher::~NextLinePrefetcher()
+{}
+
+void
+NextLinePrefetcher::computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list)
+{
+   for (UInt32 i = 1; i <= _prefetch_degree; i++)
+      prefetch_line_list.push_back(line + i);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "prefetcher.h"
+
+// Prefetches the next 'prefetch_degree' lines following every trigger access
+class NextLinePrefetcher : public Prefetcher
+{
+public:
+   NextLinePrefetcher(UInt32 cache_line_size, UInt32 prefetch_degree);
+   ~NextLinePrefetcher();
+
+protected:
+   void computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list);
+};
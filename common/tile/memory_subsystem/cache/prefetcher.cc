@@ -0,0 +1,143 @@
+#include "prefetcher.h"
+#include "next_line_prefetcher.h"
+#include "stride_prefetcher.h"
+#include "stream_prefetcher.h"
+#include "utils.h"
+#include "log.h"
+
+Prefetcher::Prefetcher(Type type, UInt32 cache_line_size, UInt32 prefetch_degree)
+   : _cache_line_size(cache_line_size)
+   , _prefetch_degree(prefetch_degree)
+   , _type(type)
+   , _enabled(false)
+   , _total_demand_misses(0)
+   , _total_prefetches_issued(0)
+   , _total_useful_prefetches(0)
+   , _total_late_prefetches(0)
+   , _total_useless_prefetches(0)
+{
+   LOG_ASSERT_ERROR(isPower2(_cache_line_size), "Cache line size(%u) must be a power of 2", _cache_line_size);
+   LOG_ASSERT_ERROR(_prefetch_degree > 0, "Prefetch degree must be > 0");
+   _log_cache_line_size = floorLog2(_cache_line_size);
+}
+
+Prefetcher::~Prefetcher()
+{}
+
+Prefetcher*
+Prefetcher::create(string type_str, UInt32 cache_line_size, UInt32 prefetch_degree, UInt32 table_size)
+{
+   Type type = parse(type_str);
+
+   switch (type)
+   {
+   case NONE:
+      return (Prefetcher*) NULL;
+   case NEXT_LINE:
+      return new NextLinePrefetcher(cache_line_size, prefetch_degree);
+   case STRIDE:
+      return new StridePrefetcher(cache_line_size, prefetch_degree, table_size);
+   case STREAM:
+      return new StreamPrefetcher(cache_line_size, prefetch_degree, table_size);
+   default:
+      LOG_PRINT_ERROR("Unrecognized Prefetcher Type(%u)", type);
+      return (Prefetcher*) NULL;
+   }
+}
+
+Prefetcher::Type
+Prefetcher::parse(string type_str)
+{
+   if (type_str == "none")
+      return NONE;
+   else if (type_str == "next_line")
+      return NEXT_LINE;
+   else if (type_str == "stride")
+      return STRIDE;
+   else if (type_str == "stream")
+      return STREAM;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Prefetcher Type(%s)", type_str.c_str());
+      return NUM_TYPES;
+   }
+}
+
+string
+Prefetcher::spell(Type type)
+{
+   switch (type)
+   {
+   case NONE:
+      return "none";
+   case NEXT_LINE:
+      return "next_line";
+   case STRIDE:
+      return "stride";
+   case STREAM:
+      return "stream";
+   default:
+      LOG_PRINT_ERROR("Unrecognized Prefetcher Type(%u)", type);
+      return "";
+   }
+}
+
+void
+Prefetcher::getPrefetchAddressList(IntPtr address, bool cache_miss, vector<IntPtr>& prefetch_address_list)
+{
+   if (cache_miss && _enabled)
+      _total_demand_misses ++;
+
+   SInt64 line = (SInt64) (address >> _log_cache_line_size);
+   SInt64 page = (SInt64) (address / _PAGE_SIZE);
+
+   vector<SInt64> prefetch_line_list;
+   computePrefetchLines(line, cache_miss, prefetch_line_list);
+
+   for (vector<SInt64>::iterator it = prefetch_line_list.begin(); it != prefetch_line_list.end(); it ++)
+   {
+      if ((*it < 0) || (*it == line))
+         continue;
+      IntPtr prefetch_address = ((IntPtr) *it) << _log_cache_line_size;
+      if ((SInt64) (prefetch_address / _PAGE_SIZE) != page)
+         continue;
+      prefetch_address_list.push_back(prefetch_address);
+   }
+}
+
+void
+Prefetcher::outputSummary(ostream& out)
+{
+   UInt64 total_covered_misses = _total_useful_prefetches + _total_late_prefetches;
+
+   out << "    Prefetcher: " << spell(_type) << endl;
+   out << "      Prefetches Issued: " << _total_prefetches_issued << endl;
+   out << "      Useful Prefetches: " << _total_useful_prefetches << endl;
+   out << "      Late Prefetches: " << _total_late_prefetches << endl;
+   out << "      Useless Prefetches: " << _total_useless_prefetches << endl;
+   if (_total_prefetches_issued > 0)
+      out << "      Accuracy (%): " << 100.0 * total_covered_misses / _total_prefetches_issued << endl;
+   else
+      out << "      Accuracy (%): " << endl;
+   if ((total_covered_misses + _total_demand_misses) > 0)
+      out << "      Coverage (%): " << 100.0 * total_covered_misses / (total_covered_misses + _total_demand_misses) << endl;
+   else
+      out << "      Coverage (%): " << endl;
+   if (total_covered_misses > 0)
+      out << "      Timeliness (%): " << 100.0 * _total_useful_prefetches / total_covered_misses << endl;
+   else
+      out << "      Timeliness (%): " << endl;
+}
+
+void
+Prefetcher::dummyOutputSummary(ostream& out)
+{
+   out << "    Prefetcher: " << spell(NONE) << endl;
+   out << "      Prefetches Issued: " << endl;
+   out << "      Useful Prefetches: " << endl;
+   out << "      Late Prefetches: " << endl;
+   out << "      Useless Prefetches: " << endl;
+   out << "      Accuracy (%): " << endl;
+   out << "      Coverage (%): " << endl;
+   out << "      Timeliness (%): " << endl;
+}
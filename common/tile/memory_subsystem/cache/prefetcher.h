@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+using std::string;
+using std::vector;
+using std::ostream;
+
+#include "fixed_types.h"
+
+// Hardware prefetcher attached to a cache controller.
+// The controller trains the prefetcher on demand misses and on the first demand access
+// to a prefetched line, issues the returned addresses as non-blocking shared requests,
+// and reports back whether each prefetched line was used in time, late or not at all.
+// Demand accesses that find their line prefetched (in time or late) are not counted as misses.
+class Prefetcher
+{
+public:
+   enum Type
+   {
+      NONE = 0,
+      NEXT_LINE,
+      STRIDE,
+      STREAM,
+      NUM_TYPES
+   };
+
+   Prefetcher(Type type, UInt32 cache_line_size, UInt32 prefetch_degree);
+   virtual ~Prefetcher();
+
+   // Returns NULL if the prefetcher type is 'none'
+   static Prefetcher* create(string type_str, UInt32 cache_line_size, UInt32 prefetch_degree, UInt32 table_size);
+   static Type parse(string type_str);
+   static string spell(Type type);
+
+   // Train on a demand access and get the (line-aligned) addresses to prefetch
+   void getPrefetchAddressList(IntPtr address, bool cache_miss, vector<IntPtr>& prefetch_address_list);
+
+   // Feedback from the cache controller
+   void incrPrefetchesIssued()   { if (_enabled) _total_prefetches_issued ++;   }
+   void incrUsefulPrefetches()   { if (_enabled) _total_useful_prefetches ++;   }
+   void incrLatePrefetches()     { if (_enabled) _total_late_prefetches ++;     }
+   void incrUselessPrefetches()  { if (_enabled) _total_useless_prefetches ++;  }
+
+   void enable()                 { _enabled = true; }
+   void disable()                { _enabled = false; }
+
+   void outputSummary(ostream& out);
+   static void dummyOutputSummary(ostream& out);
+
+protected:
+   UInt32 _cache_line_size;
+   UInt32 _log_cache_line_size;
+   UInt32 _prefetch_degree;
+
+   // Compute the candidate lines to prefetch given the line number of a demand access
+   virtual void computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list) = 0;
+
+private:
+   // Prefetches never cross a page boundary
+   static const UInt32 _PAGE_SIZE = 4096;
+
+   Type _type;
+   bool _enabled;
+
+   UInt64 _total_demand_misses;
+   UInt64 _total_prefetches_issued;
+   UInt64 _total_useful_prefetches;
+   UInt64 _total_late_prefetches;
+   UInt64 _total_useless_prefetches;
+};
@@ -0,0 +1,71 @@
+#include "rrip_replacement_policy.h"
+#include "cache_line_info.h"
+#include "log.h"
+
+const UInt8 RRIPReplacementPolicy::_MAX_RRPV;
+
+RRIPReplacementPolicy::RRIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : CacheReplacementPolicy(cache_size, associativity, cache_line_size)
+{
+   _rrpv_vec.resize(_num_sets * _associativity, _MAX_RRPV);
+}
+
+RRIPReplacementPolicy::~RRIPReplacementPolicy()
+{}
+
+UInt32
+RRIPReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
+{
+   for (UInt32 i = 0; i < _associativity; i++)
+   {
+      if (!cache_line_info_array[i]->isValid())
+         return i;
+   }
+
+   UInt8* rrpv = &_rrpv_vec[set_num * _associativity];
+   // Age the whole set till some line is predicted to be re-referenced in the distant future
+   while (1)
+   {
+      for (UInt32 i = 0; i < _associativity; i++)
+      {
+         if (rrpv[i] == _MAX_RRPV)
+            return i;
+      }
+      for (UInt32 i = 0; i < _associativity; i++)
+         rrpv[i] ++;
+   }
+}
+
+void
+RRIPReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way)
+{
+   _rrpv_vec[set_num * _associativity + accessed_way] = 0;
+}
+
+void
+RRIPReplacementPolicy::insert(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 inserted_way)
+{
+   _rrpv_vec[set_num * _associativity + inserted_way] = getInsertionRRPV();
+}
+
+SRRIPReplacementPolicy::SRRIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : RRIPReplacementPolicy(cache_size, associativity, cache_line_size)
+{}
+
+SRRIPReplacementPolicy::~SRRIPReplacementPolicy()
+{}
+
+BRRIPReplacementPolicy::BRRIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : RRIPReplacementPolicy(cache_size, associativity, cache_line_size)
+   , _num_fills(0)
+{}
+
+BRRIPReplacementPolicy::~BRRIPReplacementPolicy()
+{}
+
+UInt8
+BRRIPReplacementPolicy::getInsertionRRPV()
+{
+   _num_fills ++;
+   return ((_num_fills % _BIMODAL_THROTTLE) == 0) ? (_MAX_RRPV - 1) : _MAX_RRPV;
+}
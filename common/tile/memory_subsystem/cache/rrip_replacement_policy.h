@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "cache_replacement_policy.h"
+
+// Re-reference interval prediction (RRIP) with 2-bit re-reference prediction values (RRPVs).
+// Hits promote a line to RRPV 0 and the victim is a line with the maximum RRPV.
+// SRRIP inserts new lines with a long re-reference interval (RRPV 2), BRRIP inserts them with a
+// distant one (RRPV 3) and only occasionally with a long one, which protects the cache from scans.
+class RRIPReplacementPolicy : public CacheReplacementPolicy
+{
+public:
+   RRIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~RRIPReplacementPolicy();
+
+   UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
+   void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+   void insert(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 inserted_way);
+
+protected:
+   static const UInt8 _MAX_RRPV = 3;
+
+   virtual UInt8 getInsertionRRPV() = 0;
+
+private:
+   // RRPVs of all the ways of all the sets (set-major)
+   vector<UInt8> _rrpv_vec;
+};
+
+class SRRIPReplacementPolicy : public RRIPReplacementPolicy
+{
+public:
+   SRRIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~SRRIPReplacementPolicy();
+
+protected:
+   UInt8 getInsertionRRPV() { return _MAX_RRPV - 1; }
+};
+
+class BRRIPReplacementPolicy : public RRIPReplacementPolicy
+{
+public:
+   BRRIPReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~BRRIPReplacementPolicy();
+
+protected:
+   UInt8 getInsertionRRPV();
+
+private:
+   // One in every _BIMODAL_THROTTLE fills is inserted with a long re-reference interval
+   static const UInt32 _BIMODAL_THROTTLE = 32;
+   UInt32 _num_fills;
+};
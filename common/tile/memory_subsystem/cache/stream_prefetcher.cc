@@ -0,0 +1,68 @@
+#include "stream_prefetcher.h"
+#include "log.h"
+
+StreamPrefetcher::StreamPrefetcher(UInt32 cache_line_size, UInt32 prefetch_degree, UInt32 table_size)
+   : Prefetcher(STREAM, cache_line_size, prefetch_degree)
+   , _stream_table(table_size)
+   , _num_accesses(0)
+{
+   LOG_ASSERT_ERROR(table_size > 0, "Stream prefetcher table size must be > 0");
+}
+
+StreamPrefetcher::~StreamPrefetcher()
+{}
+
+void
+StreamPrefetcher::computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list)
+{
+   _num_accesses ++;
+
+   // Look for a stream that this access continues
+   Stream* stream = NULL;
+   for (vector<Stream>::iterator it = _stream_table.begin(); it != _stream_table.end(); it ++)
+   {
+      SInt64 distance = line - (*it)._last_line;
+      if ((*it)._valid && (distance != 0) && (distance <= _STREAM_WINDOW) && (distance >= -_STREAM_WINDOW))
+      {
+         stream = &(*it);
+         break;
+      }
+   }
+
+   if (stream == NULL)
+   {
+      if (!cache_miss)
+         return;
+
+      // Allocate a new stream in place of the least recently used one
+      Stream* lru_stream = &_stream_table[0];
+      for (vector<Stream>::iterator it = _stream_table.begin(); it != _stream_table.end(); it ++)
+      {
+         if (!(*it)._valid)
+         {
+            lru_stream = &(*it);
+            break;
+         }
+         if ((*it)._last_access < lru_stream->_last_access)
+            lru_stream = &(*it);
+      }
+      lru_stream->_valid = true;
+      lru_stream->_last_line = line;
+      lru_stream->_direction = 0;
+      lru_stream->_last_access = _num_accesses;
+      return;
+   }
+
+   SInt32 direction = (line > stream->_last_line) ? 1 : -1;
+   bool confirmed = (stream->_direction == direction);
+
+   stream->_direction = direction;
+   stream->_last_line = line;
+   stream->_last_access = _num_accesses;
+
+   if (confirmed)
+   {
+      for (UInt32 i = 1; i <= _prefetch_degree; i++)
+         prefetch_line_list.push_back(line + direction * (SInt64) i);
+   }
+}
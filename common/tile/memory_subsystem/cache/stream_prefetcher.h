@@ -0,0 +1,34 @@
+#pragma once
+
+#include "prefetcher.h"
+
+// Stream prefetcher: tracks up to 'table_size' streams of misses.
+// A stream is allocated on a miss and trained on the next access that falls
+// within _STREAM_WINDOW lines of it. Once two consecutive accesses move the
+// stream in the same direction, 'prefetch_degree' lines ahead are prefetched.
+class StreamPrefetcher : public Prefetcher
+{
+public:
+   StreamPrefetcher(UInt32 cache_line_size, UInt32 prefetch_degree, UInt32 table_size);
+   ~StreamPrefetcher();
+
+protected:
+   void computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list);
+
+private:
+   class Stream
+   {
+   public:
+      Stream() : _valid(false), _last_line(0), _direction(0), _last_access(0) {}
+
+      bool _valid;
+      SInt64 _last_line;
+      SInt32 _direction;
+      UInt64 _last_access;
+   };
+
+   static const SInt64 _STREAM_WINDOW = 16;
+
+   vector<Stream> _stream_table;
+   UInt64 _num_accesses;
+};
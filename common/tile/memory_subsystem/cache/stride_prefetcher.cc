@@ -0,0 +1,60 @@
+#include "stride_prefetcher.h"
+#include "log.h"
+
+StridePrefetcher::StridePrefetcher(UInt32 cache_line_size, UInt32 prefetch_degree, UInt32 table_size)
+   : Prefetcher(STRIDE, cache_line_size, prefetch_degree)
+   , _table(table_size)
+{
+   LOG_ASSERT_ERROR(table_size > 0, "Stride prefetcher table size must be > 0");
+   // Pages are 4KB
+   _log_lines_per_page = (_log_cache_line_size < 12) ? (12 - _log_cache_line_size) : 0;
+}
+
+StridePrefetcher::~StridePrefetcher()
+{}
+
+void
+StridePrefetcher::computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list)
+{
+   SInt64 tag = line >> _log_lines_per_page;
+   Entry& entry = _table[tag % _table.size()];
+
+   if (!entry._valid || (entry._tag != tag))
+   {
+      // Allocate a new entry on a miss only
+      if (cache_miss)
+      {
+         entry._valid = true;
+         entry._tag = tag;
+         entry._last_line = line;
+         entry._stride = 0;
+         entry._confidence = 0;
+      }
+      return;
+   }
+
+   SInt64 stride = line - entry._last_line;
+   if (stride == 0)
+      return;
+
+   if (stride == entry._stride)
+   {
+      if (entry._confidence < _MAX_CONFIDENCE)
+         entry._confidence ++;
+   }
+   else
+   {
+      // Replace the stride only after the confidence has decayed
+      if (entry._confidence > 0)
+         entry._confidence --;
+      else
+         entry._stride = stride;
+   }
+   entry._last_line = line;
+
+   if ((entry._confidence >= _CONFIDENCE_THRESHOLD) && (entry._stride == stride))
+   {
+      for (UInt32 i = 1; i <= _prefetch_degree; i++)
+         prefetch_line_list.push_back(line + i * stride);
+   }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "prefetcher.h"
+
+// Stride prefetcher with a direct-mapped reference prediction table.
+// The memory requests seen by the cache controllers do not carry the
+// instruction pointer, so the table is indexed by the page of the access
+// rather than by PC. A stride is trusted once it repeats _CONFIDENCE_THRESHOLD times.
+class StridePrefetcher : public Prefetcher
+{
+public:
+   StridePrefetcher(UInt32 cache_line_size, UInt32 prefetch_degree, UInt32 table_size);
+   ~StridePrefetcher();
+
+protected:
+   void computePrefetchLines(SInt64 line, bool cache_miss, vector<SInt64>& prefetch_line_list);
+
+private:
+   class Entry
+   {
+   public:
+      Entry() : _valid(false), _tag(0), _last_line(0), _stride(0), _confidence(0) {}
+
+      bool _valid;
+      SInt64 _tag;
+      SInt64 _last_line;
+      SInt64 _stride;
+      UInt32 _confidence;
+   };
+
+   static const UInt32 _CONFIDENCE_THRESHOLD = 2;
+   static const UInt32 _MAX_CONFIDENCE = 3;
+
+   vector<Entry> _table;
+   UInt32 _log_lines_per_page;
+};
@@ -0,0 +1,49 @@
+#include "tree_plru_replacement_policy.h"
+#include "cache_line_info.h"
+#include "utils.h"
+#include "log.h"
+
+TreePLRUReplacementPolicy::TreePLRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : CacheReplacementPolicy(cache_size, associativity, cache_line_size)
+{
+   LOG_ASSERT_ERROR(isPower2(_associativity) && (_associativity <= 64),
+                    "Tree-PLRU needs a power of 2 associativity <= 64, got (%u)", _associativity);
+   _plru_bits_vec.resize(_num_sets, 0);
+}
+
+TreePLRUReplacementPolicy::~TreePLRUReplacementPolicy()
+{}
+
+UInt32
+TreePLRUReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
+{
+   for (UInt32 i = 0; i < _associativity; i++)
+   {
+      if (!cache_line_info_array[i]->isValid())
+         return i;
+   }
+
+   // Follow the bits from the root down to a leaf
+   UInt64 plru_bits = _plru_bits_vec[set_num];
+   UInt32 node = 1;
+   while (node < _associativity)
+      node = (2 * node) + ((plru_bits >> node) & 1);
+   return node - _associativity;
+}
+
+void
+TreePLRUReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way)
+{
+   // Walk up from the accessed leaf, pointing every node on the path away from it
+   UInt64& plru_bits = _plru_bits_vec[set_num];
+   UInt32 node = accessed_way + _associativity;
+   while (node > 1)
+   {
+      UInt32 parent = node / 2;
+      if (node & 1)
+         plru_bits &= ~(((UInt64) 1) << parent);
+      else
+         plru_bits |= (((UInt64) 1) << parent);
+      node = parent;
+   }
+}
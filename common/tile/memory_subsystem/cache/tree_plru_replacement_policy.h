@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "cache_replacement_policy.h"
+#include "cache_line_info.h"
+
+// Tree pseudo-LRU: (associativity - 1) bits per set arranged as a binary tree.
+// Each bit points towards the half of its subtree that was used less recently.
+class TreePLRUReplacementPolicy : public CacheReplacementPolicy
+{
+public:
+   TreePLRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~TreePLRUReplacementPolicy();
+
+   UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
+   void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+
+   // Same as above with the associativity fixed at compile time (used by FixedCacheSet)
+   template <UInt32 ASSOCIATIVITY>
+   UInt32 getFixedAssocReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
+   template <UInt32 ASSOCIATIVITY>
+   void updateFixedAssoc(UInt32 set_num, UInt32 accessed_way);
+
+private:
+   // Bit 'n' holds tree node 'n' (root is node 1, children of 'n' are 2n and 2n+1)
+   vector<UInt64> _plru_bits_vec;
+};
+
+template <UInt32 ASSOCIATIVITY>
+inline UInt32
+TreePLRUReplacementPolicy::getFixedAssocReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
+{
+   for (UInt32 i = 0; i < ASSOCIATIVITY; i++)
+   {
+      if (!cache_line_info_array[i]->isValid())
+         return i;
+   }
+
+   UInt64 plru_bits = _plru_bits_vec[set_num];
+   UInt32 node = 1;
+   while (node < ASSOCIATIVITY)
+      node = (2 * node) + ((plru_bits >> node) & 1);
+   return node - ASSOCIATIVITY;
+}
+
+template <UInt32 ASSOCIATIVITY>
+inline void
+TreePLRUReplacementPolicy::updateFixedAssoc(UInt32 set_num, UInt32 accessed_way)
+{
+   UInt64& plru_bits = _plru_bits_vec[set_num];
+   UInt32 node = accessed_way + ASSOCIATIVITY;
+   while (node > 1)
+   {
+      UInt32 parent = node / 2;
+      if (node & 1)
+         plru_bits &= ~(((UInt64) 1) << parent);
+      else
+         plru_bits |= (((UInt64) 1) << parent);
+      node = parent;
+   }
+}
@@ -10,6 +10,7 @@ using std::string;
 #include "directory_type.h"
 #include "caching_protocol.h"
 #include "scalable_allocator.h"
+#include "bit_vector.h"
 
 class DirectoryEntry : public ScalableAllocator<DirectoryEntry>
 {
@@ -24,6 +25,8 @@ public:
    virtual bool isSharer(tile_id_t sharer_id) const = 0;
    virtual bool isTrackedSharer(tile_id_t sharer_id) const = 0;
    virtual bool getSharersList(vector<tile_id_t>& sharers_list) const = 0;
+   // Same as getSharersList() but fills in a caller-owned bit-vector (one bit per tile)
+   virtual bool getSharersMask(BitVector& sharers_mask) const = 0;
    virtual tile_id_t getOneSharer() = 0;
    virtual SInt32 getNumSharers() const = 0;
    
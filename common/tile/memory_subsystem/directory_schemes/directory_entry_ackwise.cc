@@ -84,6 +84,13 @@ DirectoryEntryAckwise::getSharersList(vector<tile_id_t>& sharers_list) const
    return _global_enabled;
 }
 
+bool
+DirectoryEntryAckwise::getSharersMask(BitVector& sharers_mask) const
+{
+   DirectoryEntryLimited::getSharersMask(sharers_mask);
+   return _global_enabled;
+}
+
 SInt32
 DirectoryEntryAckwise::getNumSharers() const
 {
@@ -11,6 +11,7 @@ public:
    // Sharer list query operations 
    bool isSharer(tile_id_t sharer_id) const;
    bool getSharersList(vector<tile_id_t>& sharers_list) const;
+   bool getSharersMask(BitVector& sharers_mask) const;
    SInt32 getNumSharers() const;
    bool inBroadcastMode() const;
    
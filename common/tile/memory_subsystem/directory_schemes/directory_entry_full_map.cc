@@ -67,6 +67,14 @@ DirectoryEntryFullMap::getSharersList(vector<tile_id_t>& sharers_list) const
    return false;
 }
 
+bool
+DirectoryEntryFullMap::getSharersMask(BitVector& sharers_mask) const
+{
+   sharers_mask.reset();
+   sharers_mask.set(*_sharers);
+   return false;
+}
+
 tile_id_t
 DirectoryEntryFullMap::getOneSharer()
 {
@@ -103,6 +103,22 @@ DirectoryEntryLimited::getSharersList(vector<tile_id_t>& sharers_list) const
    return false;
 }
 
+// A bit-vector of tracked sharers
+bool
+DirectoryEntryLimited::getSharersMask(BitVector& sharers_mask) const
+{
+   sharers_mask.reset();
+   for (SInt32 i = 0; i < _max_hw_sharers; i++)
+   {
+      if (_sharers[i] != INVALID_SHARER)
+         sharers_mask.set((tile_id_t) _sharers[i]);
+   }
+   LOG_ASSERT_ERROR(_num_tracked_sharers == (SInt32) sharers_mask.size(),
+                    "Num Tracked Sharers(%i), Sharers Mask Size(%u)",
+                    _num_tracked_sharers, sharers_mask.size());
+   return false;
+}
+
 // Number of Tracked Sharers
 SInt32
 DirectoryEntryLimited::getNumSharers() const
@@ -13,6 +13,7 @@ public:
    bool isSharer(tile_id_t sharer_id) const;
    bool isTrackedSharer(tile_id_t sharer_id) const;
    bool getSharersList(vector<tile_id_t>& sharers) const;
+   bool getSharersMask(BitVector& sharers_mask) const;
    tile_id_t getOneSharer();
    SInt32 getNumSharers() const;
    
@@ -136,6 +136,22 @@ DirectoryEntryLimitless::getSharersList(vector<tile_id_t>& sharers_list) const
    return false;
 }
 
+bool
+DirectoryEntryLimitless::getSharersMask(BitVector& sharers_mask) const
+{
+   if (_software_trap_enabled) // Explicit software tracking of sharers
+   {
+      sharers_mask.reset();
+      sharers_mask.set(*_software_sharers);
+   }
+   else // (!_software_trap_enabled) - Explicit hardware tracking of sharers
+   {
+      DirectoryEntryLimited::getSharersMask(sharers_mask);
+   }
+
+   return false;
+}
+
 SInt32
 DirectoryEntryLimitless::getNumSharers() const
 {
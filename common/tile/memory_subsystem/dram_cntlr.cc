@@ -4,6 +4,7 @@
 #include "core_model.h"
 #include "tile.h"
 #include "memory_manager.h"
+#include "config.h"
 #include "log.h"
 #include "constants.h"
 
@@ -43,7 +44,7 @@ DramCntlr::getDataFromDram(IntPtr address, Byte* data_buf, bool modeled)
    }
    memcpy((void*) data_buf, (void*) _data_map[address], _cache_line_size);
 
-   Latency dram_access_latency = modeled ? runDramPerfModel() : Latency(0, DRAM_FREQUENCY);
+   Latency dram_access_latency = modeled ? runDramPerfModel(address) : Latency(0, DRAM_FREQUENCY);
    LOG_PRINT("Dram Access Latency(%llu)", dram_access_latency.getCycles());
    getShmemPerfModel()->incrCurrTime(dram_access_latency);
 
@@ -57,20 +58,22 @@ DramCntlr::putDataToDram(IntPtr address, const Byte* data_buf, bool modeled)
    
    memcpy((void*) _data_map[address], data_buf, _cache_line_size);
 
-   __attribute__((unused)) Latency dram_access_latency = modeled ? runDramPerfModel() : Latency(0, DRAM_FREQUENCY);
+   __attribute__((unused)) Latency dram_access_latency = modeled ? runDramPerfModel(address) : Latency(0, DRAM_FREQUENCY);
    
    addToDramAccessCount(address, WRITE);
 }
 
 Latency
-DramCntlr::runDramPerfModel()
+DramCntlr::runDramPerfModel(IntPtr address)
 {
 
    Time pkt_time = getShmemPerfModel()->getCurrTime();
 
    UInt64 pkt_size = (UInt64) _cache_line_size;
 
-   return _dram_perf_model->getAccessLatency(pkt_time, pkt_size);
+   UInt32 target_num = Config::getSingleton()->getTargetNumFromAddress(address);
+
+   return _dram_perf_model->getAccessLatency(pkt_time, pkt_size, target_num);
 }
 
 void
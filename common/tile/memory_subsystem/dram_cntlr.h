@@ -41,7 +41,7 @@ private:
    AccessCountMap* _dram_access_count;
 
    ShmemPerfModel* getShmemPerfModel();
-   Latency runDramPerfModel();
+   Latency runDramPerfModel(IntPtr address);
 
    void addToDramAccessCount(IntPtr address, AccessType access_type);
    void printDramAccessCount();
@@ -1,19 +1,34 @@
+#include <sched.h>
+#include <cstring>
+
 #include "simulator.h"
 #include "config.h"
+#include "tile_manager.h"
 #include "memory_manager.h"
 #include "pr_l1_pr_l2_dram_directory_msi/memory_manager.h"
 #include "pr_l1_pr_l2_dram_directory_mosi/memory_manager.h"
 #include "pr_l1_sh_l2_msi/memory_manager.h"
 #include "network_model.h"
+#include "thread_scheduler.h"
 #include "dynamic_memory_info.h"
 #include "log.h"
 
 // Static Members
 CachingProtocol::Type MemoryManager::_caching_protocol_type;
+bool MemoryManager::_specialize_cache_sets = false;
+bool MemoryManager::_inline_local_handling = false;
+UInt32 MemoryManager::_handoff_spin_count = 0;
 
 MemoryManager::MemoryManager(Tile* tile)
    : _tile(tile)
+   , _inline_handling_active(false)
+   , _inline_reply_received(false)
+   , _total_inline_requests(0)
+   , _total_handed_off_requests(0)
+   , _total_spin_handoffs(0)
+   , _total_parked_handoffs(0)
    , _enabled(false)
+   , _mshr_stall_time(0)
 {
    _network = _tile->getNetwork();
    _shmem_perf_model = new ShmemPerfModel();
@@ -30,12 +45,27 @@ MemoryManager::~MemoryManager()
 void
 MemoryManager::outputSummary(ostream& out, const Time& target_completion_time)
 {
+   out << "App + Sim Thread Synchronization Summary:" << endl;
+   out << "  Inline Requests: " << _total_inline_requests << endl;
+   out << "  Handed-off Requests: " << _total_handed_off_requests << endl;
+   out << "    Spin Handoffs: " << _total_spin_handoffs << endl;
+   out << "    Parked Handoffs: " << _total_parked_handoffs << endl;
 }
 
 MemoryManager* 
 MemoryManager::createMMU(std::string protocol_type, Tile* tile)
 {
    _caching_protocol_type = CachingProtocol::parse(protocol_type);
+   try
+   {
+      _specialize_cache_sets = Sim()->getCfg()->getBool("caching_protocol/specialize_cache_sets", false);
+      _inline_local_handling = Sim()->getCfg()->getBool("caching_protocol/inline_local_handling", false);
+      _handoff_spin_count = (UInt32) Sim()->getCfg()->getInt("caching_protocol/handoff_spin_count", 0);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Error reading [caching_protocol] parameters from the config file");
+   }
 
    switch (_caching_protocol_type)
    {
@@ -76,17 +106,25 @@ MemoryManager::__coreInitiateMemoryAccess(MemComponent::Type mem_component,
    
    Time initial_time = curr_time;
    _shmem_perf_model->setCurrTime(initial_time);
+   _mshr_stall_time = Time(0);
+   _inline_handling_active = _inline_local_handling;
 
    coreInitiateMemoryAccess(mem_component, lock_signal, mem_op_type,
                             address, offset, data_buf, data_length);
 
    Time final_time = _shmem_perf_model->getCurrTime();
+   Time mshr_stall_time = _mshr_stall_time;
+
+   // Messages to itself not needed by this access are handled by the sim thread as usual
+   flushInlineMsgs();
+   _inline_handling_active = false;
 
    if (lock_signal != Core::LOCK)
       _lock.release();
 
    assert(final_time >= initial_time);
    dynamic_memory_info._latency += (final_time - initial_time);
+   dynamic_memory_info._mshr_stall_time += mshr_stall_time;
    // Update curr_time
    curr_time = final_time;
 }
@@ -129,13 +167,23 @@ MemoryManager::disableModels()
 void
 MemoryManager::waitForAppThread()
 {
-   _sim_thread_sem.wait();
+   // The reply was handled on the app thread itself, which goes on with the memory access
+   if (_inline_local_handling && !Sim()->getTileManager()->amiSimThread())
+      return;
+
+   handoffWait(_sim_thread_sem);
    _lock.acquire();
 }
 
 void
 MemoryManager::wakeUpAppThread()
 {
+   if (_inline_handling_active)
+   {
+      _inline_reply_received = true;
+      return;
+   }
+
    _lock.release();
    _app_thread_sem.signal();
 }
@@ -143,17 +191,107 @@ MemoryManager::wakeUpAppThread()
 void
 MemoryManager::waitForSimThread()
 {
+   if (_inline_handling_active)
+   {
+      handleInlineMsgs();
+      if (_inline_reply_received)
+      {
+         _total_inline_requests ++;
+         return;
+      }
+      // The request left the tile, the reply arrives on the sim thread
+      _inline_handling_active = false;
+   }
+
+   _total_handed_off_requests ++;
    _lock.release();
-   _app_thread_sem.wait();
+   if (handoffWait(_app_thread_sem))
+      _total_spin_handoffs ++;
+   else
+      _total_parked_handoffs ++;
 }
 
 void
 MemoryManager::wakeUpSimThread()
 {
+   if (_inline_reply_received)
+   {
+      // The sim thread was never involved
+      _inline_reply_received = false;
+      return;
+   }
+
    _lock.acquire();
    _sim_thread_sem.signal();
 }
 
+void
+MemoryManager::sendMsgToSelf(NetPacket& packet)
+{
+   if (!_inline_handling_active)
+   {
+      getNetwork()->netSend(packet);
+      return;
+   }
+
+   // Queue a copy, the caller owns the message buffer
+   NetPacket inline_packet(packet);
+   if (packet.length > 0)
+   {
+      Byte* data = new(_tile->getId()) Byte[packet.length];
+      memcpy(data, packet.data, packet.length);
+      inline_packet.data = data;
+   }
+   _inline_msg_queue.push(inline_packet);
+}
+
+// Handle the messages the tile sent to itself, on the app thread and with the lock held,
+// until the reply to the memory request in progress arrives
+void
+MemoryManager::handleInlineMsgs()
+{
+   while (!_inline_msg_queue.empty() && !_inline_reply_received)
+   {
+      NetPacket packet = _inline_msg_queue.front();
+      _inline_msg_queue.pop();
+
+      _shmem_perf_model->setCurrTime(packet.time);
+      handleMsgFromNetwork(packet);
+
+      if (packet.length > 0)
+         delete [] (Byte*) packet.data;
+   }
+}
+
+void
+MemoryManager::flushInlineMsgs()
+{
+   while (!_inline_msg_queue.empty())
+   {
+      NetPacket packet = _inline_msg_queue.front();
+      _inline_msg_queue.pop();
+
+      getNetwork()->netSend(packet);
+
+      if (packet.length > 0)
+         delete [] (Byte*) packet.data;
+   }
+}
+
+// Spin for a while before blocking, the other thread usually hands back control quickly
+bool
+MemoryManager::handoffWait(Semaphore& sem)
+{
+   for (UInt32 i = 0; i < _handoff_spin_count; i++)
+   {
+      if ((sem.getCount() > 0) && sem.tryWait())
+         return true;
+      sched_yield();
+   }
+   sem.wait();
+   return false;
+}
+
 void
 MemoryManager::openCacheLineReplicationTraceFiles()
 {
@@ -274,3 +412,21 @@ MemoryManager::printTileListWithMemoryControllers(vector<tile_id_t>& tile_list_w
    }
    fprintf(stderr, "\n[[Graphite]] --> [ Tile IDs' with memory controllers = (%s) ]\n", (tile_list.str()).c_str());
 }
+
+void
+MemoryManager::recordSharing(tile_id_t requester, tile_id_t sharer)
+{
+   ThreadScheduler* thread_scheduler = Sim()->getThreadScheduler();
+   if (thread_scheduler && (requester != INVALID_TILE_ID) && (requester != sharer))
+      thread_scheduler->recordCommunication(requester, sharer, getCacheLineSize());
+}
+
+void
+MemoryManager::recordSharing(tile_id_t requester, const BitVector& sharers)
+{
+   for (UInt32 i = 0; i < sharers.capacity(); i++)
+   {
+      if (sharers.at(i))
+         recordSharing(requester, (tile_id_t) i);
+   }
+}
@@ -2,6 +2,8 @@
 
 using namespace std;
 
+#include <queue>
+
 #include "common_types.h"
 #include "tile.h"
 #include "core.h"
@@ -12,6 +14,7 @@ using namespace std;
 #include "caching_protocol.h"
 #include "shmem_perf_model.h"
 #include "dvfs.h"
+#include "bit_vector.h"
 
 void MemoryManagerNetworkCallback(void* obj, NetPacket packet);
 
@@ -37,6 +40,9 @@ public:
    virtual void enableModels();
    virtual void disableModels();
    bool isEnabled()                       { return _enabled;  }
+
+   // Time the memory access in progress spent waiting for a free MSHR
+   void incrMshrStallTime(const Time& stall_time)  { _mshr_stall_time += stall_time; }
   
    // APP + SIM thread synchronization 
    void waitForAppThread();
@@ -45,6 +51,7 @@ public:
    void wakeUpSimThread();
 
    virtual tile_id_t getShmemRequester(const void* pkt_data) = 0;
+   virtual IntPtr getShmemAddress(const void* pkt_data) = 0;
    // getModeledLength() returns the length of the msg in bits
    virtual UInt32 getModeledLength(const void* pkt_data) = 0;
    virtual bool isModeled(const void* pkt_data) = 0;
@@ -63,6 +70,8 @@ public:
 
    // Caching protocol type
    static CachingProtocol::Type getCachingProtocolType() { return _caching_protocol_type; }
+   // Use the compile-time specialized cache sets for the common cache configurations
+   static bool getSpecializeCacheSets() { return _specialize_cache_sets; }
    
    virtual int getDVFS(module_t module, double &frequency, double &voltage) = 0;
    virtual int setDVFS(module_t module, double frequency, voltage_option_t voltage_flag, const Time& curr_time) = 0;
@@ -73,8 +82,19 @@ protected:
    vector<tile_id_t> getTileListWithMemoryControllers();
    void printTileListWithMemoryControllers(vector<tile_id_t>& tile_list_with_memory_controllers);
 
+   // Report coherence messages sent by a directory to a sharer on behalf of a requester
+   // to the thread scheduler (the two threads share the cache line)
+   void recordSharing(tile_id_t requester, tile_id_t sharer);
+   void recordSharing(tile_id_t requester, const BitVector& sharers);
+
+   // Send a message to a memory component of this tile
+   void sendMsgToSelf(NetPacket& packet);
+
 private:
    static CachingProtocol::Type _caching_protocol_type;
+   static bool _specialize_cache_sets;
+   static bool _inline_local_handling;
+   static UInt32 _handoff_spin_count;
    Tile* _tile;
    Network* _network;
    ShmemPerfModel* _shmem_perf_model;
@@ -84,13 +104,33 @@ private:
    Semaphore _app_thread_sem;
    Semaphore _sim_thread_sem;
 
+   // Inline handling of the messages the tile sends to itself during a memory access
+   // of the app thread (only if caching_protocol/inline_local_handling is set)
+   bool _inline_handling_active;
+   bool _inline_reply_received;
+   std::queue<NetPacket> _inline_msg_queue;
+
+   // App + Sim thread synchronization statistics
+   UInt64 _total_inline_requests;
+   UInt64 _total_handed_off_requests;
+   UInt64 _total_spin_handoffs;
+   UInt64 _total_parked_handoffs;
+
    // Enabled
    bool _enabled;
 
+   // MSHR stall time of the memory access in progress
+   Time _mshr_stall_time;
+
    virtual void coreInitiateMemoryAccess(MemComponent::Type mem_component,
                                          Core::lock_signal_t lock_signal, Core::mem_op_t mem_op_type,
                                          IntPtr address, UInt32 offset, Byte* data_buf, UInt32 data_length) = 0;
    virtual void handleMsgFromNetwork(NetPacket& packet) = 0;
+
+   void handleInlineMsgs();
+   void flushInlineMsgs();
+   // Spin on the semaphore before blocking on it, returns true if the spin succeeded
+   bool handoffWait(Semaphore& sem);
    
    void parseMemoryControllerList(string& memory_controller_positions,
                                   vector<tile_id_t>& tile_list_from_cfg_file,
@@ -29,7 +29,8 @@ DramPerfModel::DramPerfModel(float dram_access_cost,
    m_cache_block_size(cache_block_size),
    m_queue_model_type(queue_model_type),
    m_queue_model_enabled(queue_model_enabled),
-   m_enabled(false)
+   m_enabled(false),
+   m_target_interference_counters("Dram")
 {
    initializePerformanceCounters();
    createQueueModels();
@@ -69,10 +70,11 @@ DramPerfModel::initializePerformanceCounters()
    m_num_accesses = 0;
    m_total_access_latency = 0;
    m_total_queueing_delay = 0;
+   m_target_interference_counters.reset();
 }
 
 Latency 
-DramPerfModel::getAccessLatency(Time pkt_time, UInt64 pkt_size)
+DramPerfModel::getAccessLatency(Time pkt_time, UInt64 pkt_size, UInt32 target_num)
 {
 
    // In the following we assume a 1GHz frequency, so that
@@ -111,6 +113,7 @@ DramPerfModel::getAccessLatency(Time pkt_time, UInt64 pkt_size)
    m_num_accesses ++;
    m_total_access_latency += (double) access_latency;
    m_total_queueing_delay += (double) queue_delay;
+   m_target_interference_counters.record(target_num, Time(processing_time * 1000), Time(queue_delay * 1000));
 
    return Latency(access_latency,DRAM_FREQUENCY);
 }
@@ -136,6 +139,7 @@ DramPerfModel::outputSummary(ostream& out)
       (float) (m_total_access_latency / m_num_accesses) << endl;
    out << "    Average Dram Contention Delay (in nanoseconds): " << 
       (float) (m_total_queueing_delay / m_num_accesses) << endl;
+   m_target_interference_counters.outputSummary(out, "    ");
 
 
    std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
@@ -171,6 +175,7 @@ DramPerfModel::dummyOutputSummary(ostream& out)
    out << "    Total Dram Accesses: " << endl;
    out << "    Average Dram Access Latency (in nanoseconds): " << endl;
    out << "    Average Dram Contention Delay (in nanoseconds): " << endl;
+   TargetInterferenceCounters::dummyOutputSummary(out, "Dram", "    ");
    
    bool queue_model_enabled = Sim()->getCfg()->getBool("dram/queue_model/enabled");
    std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
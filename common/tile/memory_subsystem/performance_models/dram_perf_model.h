@@ -4,6 +4,7 @@
 #include "fixed_types.h"
 #include "moving_average.h"
 #include "time_types.h"
+#include "target_interference_counters.h"
 
 // Note: Each Dram Controller owns a single DramModel object
 // Hence, m_dram_bandwidth is the bandwidth for a single DRAM controller
@@ -37,6 +38,8 @@ class DramPerfModel
       UInt64 m_num_accesses;
       double m_total_access_latency;
       double m_total_queueing_delay;
+      // Accesses, busy time and queueing delay of each target
+      TargetInterferenceCounters m_target_interference_counters;
 
       void createQueueModels();
       void destroyQueueModels();
@@ -51,7 +54,7 @@ class DramPerfModel
 
       ~DramPerfModel();
 
-      Latency getAccessLatency(Time pkt_time, UInt64 pkt_size);
+      Latency getAccessLatency(Time pkt_time, UInt64 pkt_size, UInt32 target_num = 0);
       void enable();
       void disable();
 
@@ -22,7 +22,9 @@ DramDirectoryCntlr::DramDirectoryCntlr(MemoryManager* memory_manager,
    : _memory_manager(memory_manager)
    , _dram_cntlr(dram_cntlr)
    , _cached_data_list(this)
+   , _sharers_mask(dram_directory_max_num_sharers)
    , _enabled(false)
+   , _target_interference_counters("Directory")
 {
    _dram_directory_cache = new DirectoryCache(_memory_manager->getTile(),
                                               CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MOSI,
@@ -250,11 +252,10 @@ DramDirectoryCntlr::processNullifyReq(ShmemReq* shmem_req, DirectoryEntry* direc
          // FLUSH_REQ to Owner
          // INV_REQ to all sharers except owner (Also sent to the Owner for sake of convenience)
          
-         vector<tile_id_t> sharers_list;
-         bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+         bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
          
          sendShmemMsg(ShmemMsg::NULLIFY_REQ, ShmemMsg::INV_FLUSH_COMBINED_REQ, address, requester, 
-               directory_entry->getOwner(), all_tiles_sharers, sharers_list,
+               directory_entry->getOwner(), all_tiles_sharers, _sharers_mask,
                msg_modeled);
       }
       break;
@@ -264,11 +265,10 @@ DramDirectoryCntlr::processNullifyReq(ShmemReq* shmem_req, DirectoryEntry* direc
          LOG_ASSERT_ERROR(directory_entry->getOwner() == INVALID_TILE_ID,
                "Address(0x%x), State(SHARED), owner(%i)", address, directory_entry->getOwner());
          
-         vector<tile_id_t> sharers_list;
-         bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+         bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
          
          sendShmemMsg(ShmemMsg::NULLIFY_REQ, ShmemMsg::INV_REQ, address, requester, 
-               INVALID_TILE_ID, all_tiles_sharers, sharers_list,
+               INVALID_TILE_ID, all_tiles_sharers, _sharers_mask,
                msg_modeled);
       }
       break;
@@ -350,11 +350,10 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, DirectoryEntry*
             // FLUSH_REQ to Owner
             // INV_REQ to all sharers except owner (Also sent to the Owner for sake of convenience)
             
-            vector<tile_id_t> sharers_list;
-            bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+            bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
             
             sendShmemMsg(ShmemMsg::EX_REQ, ShmemMsg::INV_FLUSH_COMBINED_REQ, address, requester, 
-                  directory_entry->getOwner(), all_tiles_sharers, sharers_list,
+                  directory_entry->getOwner(), all_tiles_sharers, _sharers_mask,
                   msg_modeled);
          }
       }
@@ -383,11 +382,10 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, DirectoryEntry*
             // FLUSH_REQ to One Sharer (If present)
             // INV_REQ to all other sharers
             
-            vector<tile_id_t> sharers_list;
-            bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+            bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
           
             sendShmemMsg(ShmemMsg::EX_REQ, ShmemMsg::INV_FLUSH_COMBINED_REQ, address, requester,
-                  directory_entry->getOneSharer(), all_tiles_sharers, sharers_list,
+                  directory_entry->getOneSharer(), all_tiles_sharers, _sharers_mask,
                   msg_modeled);
          }
       }
@@ -535,25 +533,20 @@ DramDirectoryCntlr::processShReqFromL2Cache(ShmemReq* shmem_req, DirectoryEntry*
 
 void
 DramDirectoryCntlr::sendShmemMsg(ShmemMsg::Type requester_msg_type, ShmemMsg::Type send_msg_type, IntPtr address,
-      tile_id_t requester, tile_id_t single_receiver, bool all_tiles_sharers, vector<tile_id_t>& sharers_list, bool msg_modeled)
+      tile_id_t requester, tile_id_t single_receiver, bool all_tiles_sharers, const BitVector& sharers_mask, bool msg_modeled)
 {
+   ShmemMsg shmem_msg(send_msg_type, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, 
+         requester, single_receiver, address, msg_modeled);
    if (all_tiles_sharers)
    {
       // Broadcast Invalidation Request to all tiles 
       // (irrespective of whether they are sharers or not)
-      ShmemMsg shmem_msg(send_msg_type, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, 
-            requester, single_receiver, address, msg_modeled);
       _memory_manager->broadcastMsg(shmem_msg);
    }
    else
    {
       // Send Invalidation Request to only a specific set of sharers
-      for (UInt32 i = 0; i < sharers_list.size(); i++)
-      {
-         ShmemMsg shmem_msg(send_msg_type, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE,
-               requester, single_receiver, address, msg_modeled);
-         _memory_manager->sendMsg(sharers_list[i], shmem_msg);
-      }
+      _memory_manager->multicastMsg(sharers_mask, shmem_msg);
    }
 }
 
@@ -865,6 +858,8 @@ DramDirectoryCntlr::initializeEventCounters()
    _total_sharers_invalidated_broadcast_mode = 0;
    _total_invalidation_processing_time_unicast_mode = Time(0);
    _total_invalidation_processing_time_broadcast_mode = Time(0);
+
+   _target_interference_counters.reset();
 }
 
 void
@@ -1002,6 +997,9 @@ DramDirectoryCntlr::updateShmemReqLatencyCounters(const ShmemReq* shmem_req)
       LOG_PRINT_ERROR("Unrecognized Shmem Req Type(%u)", shmem_req_type);
       break;
    }
+
+   UInt32 target_num = Config::getSingleton()->getTargetNumFromAddress(shmem_req->getShmemMsg().getAddress());
+   _target_interference_counters.record(target_num, shmem_req->getProcessingTime(), shmem_req->getSerializationTime());
 }
 
 void
@@ -1130,6 +1128,8 @@ DramDirectoryCntlr::outputSummary(ostream& out)
       out << "    Average Sharers Invalidated - Broadcast Mode: " << endl;
       out << "    Average Invalidation Processing Time - Broadcast Mode (in nanoseconds): " << endl;
    }
+
+   _target_interference_counters.outputSummary(out, "    ");
 }
 
 void
@@ -1170,6 +1170,8 @@ DramDirectoryCntlr::dummyOutputSummary(ostream& out)
    out << "    Total Invalidation Requests - Broadcast Mode: " << endl;
    out << "    Average Sharers Invalidated - Broadcast Mode: " << endl;
    out << "    Average Invalidation Processing Time - Broadcast Mode (in nanoseconds): " << endl;
+
+   TargetInterferenceCounters::dummyOutputSummary(out, "Directory", "    ");
 }
 
 tile_id_t
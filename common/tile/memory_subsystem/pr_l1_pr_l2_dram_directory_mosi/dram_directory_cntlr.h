@@ -19,6 +19,7 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "shmem_msg.h"
 #include "mem_component.h"
 #include "time_types.h"
+#include "target_interference_counters.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -74,6 +75,9 @@ namespace PrL1PrL2DramDirectoryMOSI
       DirectoryReqQueue _dram_directory_req_queue;
       DataList _cached_data_list;
 
+      // Scratch bit-vector for the sharers of the line being invalidated
+      BitVector _sharers_mask;
+
       // Type of directory - (full_map, limited_no_broadcast, ackwise, limitless)
       UInt32 _directory_type;
 
@@ -110,6 +114,9 @@ namespace PrL1PrL2DramDirectoryMOSI
       UInt64 _total_sharers_invalidated_broadcast_mode;
       Time _total_invalidation_processing_time_broadcast_mode;
 
+      // Requests, processing time and serialization time of each target
+      TargetInterferenceCounters _target_interference_counters;
+
       tile_id_t getTileID() const;
       UInt32 getCacheLineSize();
       ShmemPerfModel* getShmemPerfModel();
@@ -129,7 +136,7 @@ namespace PrL1PrL2DramDirectoryMOSI
       void sendDataToDram(IntPtr address, const Byte* data_buf, bool msg_modeled);
    
       void sendShmemMsg(ShmemMsg::Type requester_msg_type, ShmemMsg::Type send_msg_type, IntPtr address,
-                        tile_id_t requester, tile_id_t single_receiver, bool all_tiles_sharers, vector<tile_id_t>& sharers_list,
+                        tile_id_t requester, tile_id_t single_receiver, bool all_tiles_sharers, const BitVector& sharers_mask,
                         bool msg_modeled);
       void restartShmemReq(tile_id_t sender, ShmemReq* shmem_req, DirectoryEntry* directory_entry);
 
@@ -17,6 +17,7 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
                            UInt32 L1_icache_tags_access_cycles,
                            string L1_icache_perf_model_type,
                            bool L1_icache_track_miss_types,
+                           UInt32 L1_icache_num_mshrs,
                            UInt32 L1_dcache_size,
                            UInt32 L1_dcache_associativity,
                            UInt32 L1_dcache_num_banks,
@@ -24,7 +25,8 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
                            UInt32 L1_dcache_data_access_cycles,
                            UInt32 L1_dcache_tags_access_cycles,
                            string L1_dcache_perf_model_type,
-                           bool L1_dcache_track_miss_types)
+                           bool L1_dcache_track_miss_types,
+                           UInt32 L1_dcache_num_mshrs)
    : _memory_manager(memory_manager)
    , _L2_cache_cntlr(NULL)
 {
@@ -65,6 +67,9 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
          L1_dcache_tags_access_cycles,
          L1_dcache_perf_model_type,
          L1_dcache_track_miss_types);
+
+   _L1_icache_mshr_file = MshrFile::create("L1-I", L1_icache_num_mshrs);
+   _L1_dcache_mshr_file = MshrFile::create("L1-D", L1_dcache_num_mshrs);
 }
 
 L1CacheCntlr::~L1CacheCntlr()
@@ -75,6 +80,8 @@ L1CacheCntlr::~L1CacheCntlr()
    delete _L1_dcache_replacement_policy_obj;
    delete _L1_icache_hash_fn_obj;
    delete _L1_dcache_hash_fn_obj;
+   delete _L1_icache_mshr_file;
+   delete _L1_dcache_mshr_file;
 }      
 
 void
@@ -95,6 +102,8 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
 
    bool L1_cache_hit = true;
    UInt32 access_num = 0;
+   MshrFile* L1_mshr_file = getL1MshrFile(mem_component);
+   Time mshr_allocate_time(0);
 
    // Core synchronization delay
    getShmemPerfModel()->incrCurrTime(getL1Cache(mem_component)->getSynchronizationDelay(CORE));
@@ -115,6 +124,15 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
          // L1 Cache
          _memory_manager->incrCurrTime(mem_component, CachePerfModel::ACCESS_DATA_AND_TAGS);
 
+         if (L1_mshr_file)
+         {
+            // A hit can still find the line's fill in flight (in simulated time)
+            if (access_num == 1)
+               waitForInFlightFill(L1_mshr_file, address);
+            else
+               L1_mshr_file->allocate(address, mshr_allocate_time, getShmemPerfModel()->getCurrTime());
+         }
+
          accessCache(mem_component, mem_op_type, address, offset, data_buf, data_length);
          return L1_cache_hit;
       }
@@ -127,6 +145,10 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
       if (lock_signal == Core::UNLOCK)
          LOG_PRINT_ERROR("Expected to find address(%#lx) in L1 Cache", address);
 
+      // The miss needs a free MSHR before it can leave the L1 cache
+      if (L1_mshr_file)
+         mshr_allocate_time = waitForFreeMshr(L1_mshr_file);
+
       pair<bool,Cache::MissType> L2_cache_miss_info = _L2_cache_cntlr->processShmemRequestFromL1Cache(mem_component, mem_op_type, address);
       bool L2_cache_miss = L2_cache_miss_info.first;
 
@@ -141,6 +163,9 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
          // L1 Cache
          _memory_manager->incrCurrTime(mem_component, CachePerfModel::ACCESS_DATA_AND_TAGS);
 
+         if (L1_mshr_file)
+            L1_mshr_file->allocate(address, mshr_allocate_time, getShmemPerfModel()->getCurrTime());
+
          accessCache(mem_component, mem_op_type, address, offset, data_buf, data_length);
 
          return false;
@@ -323,6 +348,44 @@ L1CacheCntlr::getL1Cache(MemComponent::Type mem_component)
    }
 }
 
+MshrFile*
+L1CacheCntlr::getL1MshrFile(MemComponent::Type mem_component)
+{
+   switch (mem_component)
+   {
+   case MemComponent::L1_ICACHE:
+      return _L1_icache_mshr_file;
+
+   case MemComponent::L1_DCACHE:
+      return _L1_dcache_mshr_file;
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized Memory Component(%u)", mem_component);
+      return NULL;
+   }
+}
+
+Time
+L1CacheCntlr::waitForFreeMshr(MshrFile* mshr_file)
+{
+   Time curr_time = getShmemPerfModel()->getCurrTime();
+   Time allocate_time = mshr_file->getAllocateTime(curr_time);
+   if (allocate_time > curr_time)
+   {
+      _memory_manager->incrMshrStallTime(allocate_time - curr_time);
+      getShmemPerfModel()->updateCurrTime(allocate_time);
+   }
+   return allocate_time;
+}
+
+void
+L1CacheCntlr::waitForInFlightFill(MshrFile* mshr_file, IntPtr address)
+{
+   Time completion_time;
+   if (mshr_file->lookup(address, getShmemPerfModel()->getCurrTime(), completion_time))
+      getShmemPerfModel()->updateCurrTime(completion_time);
+}
+
 tile_id_t
 L1CacheCntlr::getTileID()
 {
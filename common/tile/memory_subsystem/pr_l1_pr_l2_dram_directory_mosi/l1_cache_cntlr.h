@@ -19,6 +19,8 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "mshr_file.h"
+#include "time_types.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -35,6 +37,7 @@ namespace PrL1PrL2DramDirectoryMOSI
                    UInt32 L1_icache_tags_access_cycles,
                    string L1_icache_perf_model_type,
                    bool L1_icache_track_miss_types,
+                   UInt32 L1_icache_num_mshrs,
                    UInt32 L1_dcache_size,
                    UInt32 L1_dcache_associativity,
                    UInt32 L1_dcache_num_banks,
@@ -42,11 +45,15 @@ namespace PrL1PrL2DramDirectoryMOSI
                    UInt32 L1_dcache_data_access_cycles,
                    UInt32 L1_dcache_tags_access_cycles,
                    string L1_dcache_perf_model_type,
-                   bool L1_dcache_track_miss_types);
+                   bool L1_dcache_track_miss_types,
+                   UInt32 L1_dcache_num_mshrs);
       ~L1CacheCntlr();
 
       Cache* getL1ICache() { return _L1_icache; }
       Cache* getL1DCache() { return _L1_dcache; }
+      // Return NULL if MSHRs are not modeled
+      MshrFile* getL1IMshrFile() { return _L1_icache_mshr_file; }
+      MshrFile* getL1DMshrFile() { return _L1_dcache_mshr_file; }
 
       void setL2CacheCntlr(L2CacheCntlr* L2_cache_cntlr);
 
@@ -74,6 +81,8 @@ namespace PrL1PrL2DramDirectoryMOSI
       CacheReplacementPolicy* _L1_dcache_replacement_policy_obj;
       CacheHashFn* _L1_icache_hash_fn_obj;
       CacheHashFn* _L1_dcache_hash_fn_obj;
+      MshrFile* _L1_icache_mshr_file;
+      MshrFile* _L1_dcache_mshr_file;
       L2CacheCntlr* _L2_cache_cntlr;
 
       void accessCache(MemComponent::Type mem_component,
@@ -85,6 +94,11 @@ namespace PrL1PrL2DramDirectoryMOSI
             UInt32 access_num);
 
       Cache* getL1Cache(MemComponent::Type mem_component);
+      MshrFile* getL1MshrFile(MemComponent::Type mem_component);
+
+      // MSHRs
+      Time waitForFreeMshr(MshrFile* mshr_file);
+      void waitForInFlightFill(MshrFile* mshr_file, IntPtr address);
       ShmemMsg::Type getShmemMsgType(Core::mem_op_t mem_op_type);
 
       // Utilities
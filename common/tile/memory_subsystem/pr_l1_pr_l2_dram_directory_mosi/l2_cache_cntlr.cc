@@ -18,7 +18,11 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                            UInt32 L2_cache_data_access_cycles,
                            UInt32 L2_cache_tags_access_cycles,
                            string L2_cache_perf_model_type,
-                           bool L2_cache_track_miss_types)
+                           bool L2_cache_track_miss_types,
+                           UInt32 L2_cache_num_mshrs,
+                           string L2_cache_prefetcher_type,
+                           UInt32 L2_cache_prefetch_degree,
+                           UInt32 L2_cache_prefetcher_table_size)
    : _memory_manager(memory_manager)
    , _L1_cache_cntlr(L1_cache_cntlr)
    , _dram_directory_home_lookup(dram_directory_home_lookup)
@@ -44,6 +48,11 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
          L2_cache_perf_model_type,
          L2_cache_track_miss_types);
 
+   _L2_mshr_file = MshrFile::create("L2", L2_cache_num_mshrs);
+
+   _L2_prefetcher = Prefetcher::create(L2_cache_prefetcher_type, cache_line_size,
+                                       L2_cache_prefetch_degree, L2_cache_prefetcher_table_size);
+
    initializeEvictionCounters();
    initializeInvalidationCounters();
 }
@@ -53,6 +62,8 @@ L2CacheCntlr::~L2CacheCntlr()
    delete _L2_cache;
    delete _L2_cache_replacement_policy_obj;
    delete _L2_cache_hash_fn_obj;
+   delete _L2_mshr_file;
+   delete _L2_prefetcher;
 }
 
 void
@@ -75,6 +86,7 @@ L2CacheCntlr::initializeInvalidationCounters()
 void
 L2CacheCntlr::invalidateCacheLine(IntPtr address, PrL2CacheLineInfo& L2_cache_line_info)
 {
+   dropPrefetchedLine(address);
    L2_cache_line_info.invalidate();
    _L2_cache->setCacheLineInfo(address, &L2_cache_line_info);
 }
@@ -115,6 +127,7 @@ L2CacheCntlr::insertCacheLine(IntPtr address, CacheState::Type cstate, const Byt
       CacheState::Type evicted_cstate = evicted_cache_line_info.getCState();
       // Update eviction counters so as to track clean and dirty evictions
       updateEvictionCounters(cstate, evicted_cstate);
+      dropPrefetchedLine(evicted_address);
 
       // Invalidate the cache line in L1-I/L1-D + get utilization
       invalidateCacheLineInL1(evicted_cache_line_info.getCachedLoc(), evicted_address);
@@ -235,6 +248,10 @@ L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, C
    pair<bool,Cache::MissType> shmem_request_status_in_L2_cache = operationPermissibleinL2Cache(mem_op_type, address, L2_cstate);
    if (!shmem_request_status_in_L2_cache.first)
    {
+      // The line may still be on its way in (in simulated time)
+      if (_L2_mshr_file)
+         waitForInFlightFill(address);
+
       Byte data_buf[getCacheLineSize()];
       
       // Read the cache line from L2 cache
@@ -257,6 +274,18 @@ L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, C
          L2_cache_line_info.setCachedLoc(mem_component);
       }
       _L2_cache->setCacheLineInfo(address, &L2_cache_line_info);
+
+      // First demand access to a prefetched line - keep the prefetcher running ahead
+      if (_L2_prefetcher && (_prefetched_line_set.erase(address) > 0))
+      {
+         _L2_prefetcher->incrUsefulPrefetches();
+         issuePrefetches(address, false, Config::getSingleton()->isApplicationTile(getTileID()));
+      }
+   }
+   else if (_L2_mshr_file)
+   {
+      // The miss needs a free MSHR before it can be sent to the directory
+      waitForFreeMshr();
    }
    
    return shmem_request_status_in_L2_cache;
@@ -278,9 +307,23 @@ L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
    _outstanding_shmem_msg = *shmem_msg;
    _outstanding_shmem_msg_time = getShmemPerfModel()->getCurrTime();
 
-   ShmemMsg send_shmem_msg(shmem_msg_type, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
-                           getTileID(), INVALID_TILE_ID, address, shmem_msg->isModeled()); 
-   _memory_manager->sendMsg(getHome(address), send_shmem_msg);
+   if (_outstanding_prefetch_map.count(address) > 0)
+   {
+      // A prefetch for this line is already in flight - wait for its reply
+      // instead of sending a second request to the directory
+      _L2_prefetcher->incrLatePrefetches();
+      issuePrefetches(address, false, shmem_msg->isModeled());
+   }
+   else
+   {
+      ShmemMsg send_shmem_msg(shmem_msg_type, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
+                              getTileID(), INVALID_TILE_ID, address, shmem_msg->isModeled()); 
+      _memory_manager->sendMsg(getHome(address), send_shmem_msg);
+
+      // Train the prefetcher on the demand miss
+      if (_L2_prefetcher)
+         issuePrefetches(address, true, shmem_msg->isModeled());
+   }
 }
 
 void
@@ -295,35 +338,44 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
    }
 
    ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
-   switch (shmem_msg_type)
+   bool demand_rep = ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP) || (shmem_msg_type == ShmemMsg::UPGRADE_REP));
+
+   if (demand_rep && (_outstanding_prefetch_map.count(shmem_msg->getAddress()) > 0))
    {
-   case ShmemMsg::EX_REP:
-      processExRepFromDramDirectory(sender, shmem_msg);
-      break;
-   case ShmemMsg::SH_REP:
-      processShRepFromDramDirectory(sender, shmem_msg);
-      break;
-   case ShmemMsg::UPGRADE_REP:
-      processUpgradeRepFromDramDirectory(sender, shmem_msg);
-      break;
-   case ShmemMsg::INV_REQ:
-      processInvReqFromDramDirectory(sender, shmem_msg);
-      break;
-   case ShmemMsg::FLUSH_REQ:
-      processFlushReqFromDramDirectory(sender, shmem_msg);
-      break;
-   case ShmemMsg::WB_REQ:
-      processWbReqFromDramDirectory(sender, shmem_msg);
-      break;
-   case ShmemMsg::INV_FLUSH_COMBINED_REQ:
-      processInvFlushCombinedReqFromDramDirectory(sender, shmem_msg);
-      break;
-   default:
-      LOG_PRINT_ERROR("Unrecognized msg type: %u", shmem_msg_type);
-      break;
+      demand_rep = processPrefetchRepFromDramDirectory(sender, shmem_msg);
+   }
+   else
+   {
+      switch (shmem_msg_type)
+      {
+      case ShmemMsg::EX_REP:
+         processExRepFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::SH_REP:
+         processShRepFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::UPGRADE_REP:
+         processUpgradeRepFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::INV_REQ:
+         processInvReqFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::FLUSH_REQ:
+         processFlushReqFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::WB_REQ:
+         processWbReqFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::INV_FLUSH_COMBINED_REQ:
+         processInvFlushCombinedReqFromDramDirectory(sender, shmem_msg);
+         break;
+      default:
+         LOG_PRINT_ERROR("Unrecognized msg type: %u", shmem_msg_type);
+         break;
+      }
    }
    
-   if ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP) || (shmem_msg_type == ShmemMsg::UPGRADE_REP))
+   if (demand_rep)
    {
       assert(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCurrTime());
       
@@ -338,6 +390,13 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
       // Increment the clock by the time taken to update the L2 cache
       _memory_manager->incrCurrTime(MemComponent::L2_CACHE, CachePerfModel::ACCESS_DATA_AND_TAGS);
 
+      // The miss held an MSHR till its fill arrived
+      if (_L2_mshr_file && _outstanding_shmem_msg.isModeled())
+      {
+         _L2_mshr_file->allocate(_outstanding_shmem_msg.getAddress(), _outstanding_shmem_msg_time,
+                                 getShmemPerfModel()->getCurrTime());
+      }
+
       // There are no more outstanding memory requests
       _outstanding_shmem_msg = ShmemMsg();
       
@@ -574,6 +633,103 @@ L2CacheCntlr::processInvFlushCombinedReqFromDramDirectory(tile_id_t sender, Shme
    }
 }
 
+bool
+L2CacheCntlr::processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   const Byte* data_buf = shmem_msg->getDataBuf();
+   LOG_ASSERT_ERROR(shmem_msg->getType() == ShmemMsg::SH_REP,
+                    "Address(%#lx), Prefetch reply type(%u)", address, shmem_msg->getType());
+
+   Time prefetch_time = _outstanding_prefetch_map[address];
+   _outstanding_prefetch_map.erase(address);
+
+   if (address != _outstanding_shmem_msg.getAddress())
+   {
+      // Fill the line in the L2 cache only
+      _memory_manager->incrCurrTime(MemComponent::L2_CACHE, CachePerfModel::ACCESS_DATA_AND_TAGS);
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+      _prefetched_line_set.insert(address);
+      if (_L2_mshr_file && shmem_msg->isModeled())
+         _L2_mshr_file->allocate(address, prefetch_time, getShmemPerfModel()->getCurrTime());
+      return false;
+   }
+
+   // A demand request for this line arrived while the prefetch was in flight
+   if (_outstanding_shmem_msg.getType() == ShmemMsg::SH_REQ)
+   {
+      processShRepFromDramDirectory(sender, shmem_msg);
+      return true;
+   }
+
+   // The demand request needs exclusive access - fill the line and ask for an upgrade
+   insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+   ShmemMsg send_shmem_msg(ShmemMsg::EX_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
+                           getTileID(), INVALID_TILE_ID, address, _outstanding_shmem_msg.isModeled()); 
+   _memory_manager->sendMsg(getHome(address), send_shmem_msg);
+   return false;
+}
+
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool cache_miss, bool msg_modeled)
+{
+   vector<IntPtr> prefetch_address_list;
+   _L2_prefetcher->getPrefetchAddressList(address, cache_miss, prefetch_address_list);
+
+   for (vector<IntPtr>::iterator it = prefetch_address_list.begin(); it != prefetch_address_list.end(); it ++)
+   {
+      IntPtr prefetch_address = *it;
+
+      // Skip lines that are already present or being fetched
+      if ((prefetch_address == _outstanding_shmem_msg.getAddress()) || (_outstanding_prefetch_map.count(prefetch_address) > 0))
+         continue;
+      PrL2CacheLineInfo L2_cache_line_info;
+      _L2_cache->getCacheLineInfo(prefetch_address, &L2_cache_line_info);
+      if (L2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Prefetches hold MSHRs too - always leave one free for demand misses
+      if (_L2_mshr_file && ((_outstanding_prefetch_map.size() + 1) >= _L2_mshr_file->getNumEntries()))
+         break;
+
+      _outstanding_prefetch_map[prefetch_address] = getShmemPerfModel()->getCurrTime();
+      _L2_prefetcher->incrPrefetchesIssued();
+
+      // Prefetches are sent out as non-blocking SH_REQs
+      ShmemMsg send_shmem_msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
+                              getTileID(), INVALID_TILE_ID, prefetch_address, msg_modeled);
+      _memory_manager->sendMsg(getHome(prefetch_address), send_shmem_msg);
+   }
+}
+
+void
+L2CacheCntlr::dropPrefetchedLine(IntPtr address)
+{
+   // A prefetched line that leaves the cache before it is used was useless
+   if (_L2_prefetcher && (_prefetched_line_set.erase(address) > 0))
+      _L2_prefetcher->incrUselessPrefetches();
+}
+
+void
+L2CacheCntlr::waitForFreeMshr()
+{
+   Time curr_time = getShmemPerfModel()->getCurrTime();
+   Time allocate_time = _L2_mshr_file->getAllocateTime(curr_time);
+   if (allocate_time > curr_time)
+   {
+      _memory_manager->incrMshrStallTime(allocate_time - curr_time);
+      getShmemPerfModel()->updateCurrTime(allocate_time);
+   }
+}
+
+void
+L2CacheCntlr::waitForInFlightFill(IntPtr address)
+{
+   Time completion_time;
+   if (_L2_mshr_file->lookup(address, getShmemPerfModel()->getCurrTime(), completion_time))
+      getShmemPerfModel()->updateCurrTime(completion_time);
+}
+
 void
 L2CacheCntlr::updateInvalidationCounters()
 {
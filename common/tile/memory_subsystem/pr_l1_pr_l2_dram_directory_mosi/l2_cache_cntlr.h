@@ -1,5 +1,10 @@
 #pragma once
 
+#include <set>
+#include <map>
+using std::set;
+using std::map;
+
 // Forward declarations
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -16,6 +21,8 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "prefetcher.h"
+#include "mshr_file.h"
 #include "time_types.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
@@ -34,10 +41,18 @@ namespace PrL1PrL2DramDirectoryMOSI
                    UInt32 L2_cache_data_access_cycles,
                    UInt32 L2_cache_tags_access_cycles,
                    string L2_cache_perf_model_type,
-                   bool L2_cache_track_miss_types);
+                   bool L2_cache_track_miss_types,
+                   UInt32 L2_cache_num_mshrs,
+                   string L2_cache_prefetcher_type,
+                   UInt32 L2_cache_prefetch_degree,
+                   UInt32 L2_cache_prefetcher_table_size);
       ~L2CacheCntlr();
 
       Cache* getL2Cache() { return _L2_cache; }
+      // Returns NULL if prefetching is disabled
+      Prefetcher* getL2Prefetcher() { return _L2_prefetcher; }
+      // Returns NULL if MSHRs are not modeled
+      MshrFile* getL2MshrFile() { return _L2_mshr_file; }
 
       // Handle Request from L1 Cache - This is done for better simulator performance
       pair<bool,Cache::MissType> processShmemRequestFromL1Cache(MemComponent::Type req_mem_component, Core::mem_op_t mem_op_type, IntPtr address);
@@ -51,8 +66,22 @@ namespace PrL1PrL2DramDirectoryMOSI
       // Output summary
       void outputSummary(ostream& out);
 
-      void enable() { _enabled = true; }
-      void disable() { _enabled = false; }
+      void enable()
+      {
+         _enabled = true;
+         if (_L2_mshr_file)
+            _L2_mshr_file->enable();
+         if (_L2_prefetcher)
+            _L2_prefetcher->enable();
+      }
+      void disable()
+      {
+         _enabled = false;
+         if (_L2_mshr_file)
+            _L2_mshr_file->disable();
+         if (_L2_prefetcher)
+            _L2_prefetcher->disable();
+      }
 
    private:
       // Data Members
@@ -67,6 +96,16 @@ namespace PrL1PrL2DramDirectoryMOSI
       ShmemMsg _outstanding_shmem_msg;
       Time _outstanding_shmem_msg_time;
 
+      // MSHRs
+      MshrFile* _L2_mshr_file;
+
+      // Prefetcher
+      Prefetcher* _L2_prefetcher;
+      // Lines for which a prefetch SH_REQ has been sent but no reply received (and the time it was sent)
+      map<IntPtr,Time> _outstanding_prefetch_map;
+      // Prefetched lines that have not yet been accessed by a demand request
+      set<IntPtr> _prefetched_line_set;
+
       // Is enabled?
       bool _enabled;
 
@@ -104,9 +143,19 @@ namespace PrL1PrL2DramDirectoryMOSI
       void processFlushReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
       void processWbReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
       void processInvFlushCombinedReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
+      // Returns true if the reply also completes the outstanding demand request
+      bool processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
 
       void processBufferedShmemReqFromDramDirectory();
 
+      // Prefetching
+      void issuePrefetches(IntPtr address, bool cache_miss, bool msg_modeled);
+      void dropPrefetchedLine(IntPtr address);
+
+      // MSHRs
+      void waitForFreeMshr();
+      void waitForInFlightFill(IntPtr address);
+
       // Utilities
       tile_id_t getTileID();
       UInt32 getCacheLineSize();
@@ -29,6 +29,7 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L1_icache_tags_access_cycles = 0;
    std::string L1_icache_perf_model_type;
    bool L1_icache_track_miss_types = false;
+   UInt32 L1_icache_num_mshrs = 0;
 
    std::string L1_dcache_type;
    __attribute__((unused)) UInt32 L1_dcache_line_size = 0;
@@ -40,6 +41,7 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L1_dcache_tags_access_cycles = 0;
    std::string L1_dcache_perf_model_type;
    bool L1_dcache_track_miss_types = false;
+   UInt32 L1_dcache_num_mshrs = 0;
 
    std::string L2_cache_type;
    __attribute__((unused)) UInt32 L2_cache_line_size = 0;
@@ -51,6 +53,10 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L2_cache_tags_access_cycles = 0;
    std::string L2_cache_perf_model_type;
    bool L2_cache_track_miss_types = false;
+   UInt32 L2_cache_num_mshrs = 0;
+   std::string L2_cache_prefetcher_type;
+   UInt32 L2_cache_prefetch_degree = 0;
+   UInt32 L2_cache_prefetcher_table_size = 0;
 
    std::string dram_directory_total_entries_str;
    UInt32 dram_directory_associativity = 0;
@@ -78,6 +84,7 @@ MemoryManager::MemoryManager(Tile* tile)
       L1_icache_tags_access_cycles = Sim()->getCfg()->getInt(L1_icache_type + "/tags_access_time");
       L1_icache_perf_model_type = Sim()->getCfg()->getString(L1_icache_type + "/perf_model_type");
       L1_icache_track_miss_types = Sim()->getCfg()->getBool(L1_icache_type + "/track_miss_types");
+      L1_icache_num_mshrs = Sim()->getCfg()->getInt(L1_icache_type + "/num_mshrs", 0);
 
       // L1 DCache
       L1_dcache_type = "l1_dcache/" + Config::getSingleton()->getL1DCacheType(getTile()->getId());
@@ -90,6 +97,7 @@ MemoryManager::MemoryManager(Tile* tile)
       L1_dcache_tags_access_cycles = Sim()->getCfg()->getInt(L1_dcache_type + "/tags_access_time");
       L1_dcache_perf_model_type = Sim()->getCfg()->getString(L1_dcache_type + "/perf_model_type");
       L1_dcache_track_miss_types = Sim()->getCfg()->getBool(L1_dcache_type + "/track_miss_types");
+      L1_dcache_num_mshrs = Sim()->getCfg()->getInt(L1_dcache_type + "/num_mshrs", 0);
 
       // L2 Cache
       L2_cache_type = "l2_cache/" + Config::getSingleton()->getL2CacheType(getTile()->getId());
@@ -102,6 +110,10 @@ MemoryManager::MemoryManager(Tile* tile)
       L2_cache_tags_access_cycles = Sim()->getCfg()->getInt(L2_cache_type + "/tags_access_time");
       L2_cache_perf_model_type = Sim()->getCfg()->getString(L2_cache_type + "/perf_model_type");
       L2_cache_track_miss_types = Sim()->getCfg()->getBool(L2_cache_type + "/track_miss_types");
+      L2_cache_num_mshrs = Sim()->getCfg()->getInt(L2_cache_type + "/num_mshrs", 0);
+      L2_cache_prefetcher_type = Sim()->getCfg()->getString(L2_cache_type + "/prefetcher", "none");
+      L2_cache_prefetch_degree = Sim()->getCfg()->getInt(L2_cache_type + "/prefetch_degree", 2);
+      L2_cache_prefetcher_table_size = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_table_size", 16);
 
       // Dram Directory Cache
       dram_directory_total_entries_str = Sim()->getCfg()->getString("dram_directory/total_entries");
@@ -158,7 +170,8 @@ MemoryManager::MemoryManager(Tile* tile)
             dram_directory_access_cycles_str);
    }
 
-   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize());
+   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize(),
+                                                       Config::getSingleton()->getPartitionDramByTarget());
 
    _L1_cache_cntlr = new L1CacheCntlr(this,
          getCacheLineSize(),
@@ -170,6 +183,7 @@ MemoryManager::MemoryManager(Tile* tile)
          L1_icache_tags_access_cycles,
          L1_icache_perf_model_type,
          L1_icache_track_miss_types,
+         L1_icache_num_mshrs,
          L1_dcache_size,
          L1_dcache_associativity,
          L1_dcache_num_banks,
@@ -177,7 +191,8 @@ MemoryManager::MemoryManager(Tile* tile)
          L1_dcache_data_access_cycles,
          L1_dcache_tags_access_cycles,
          L1_dcache_perf_model_type,
-         L1_dcache_track_miss_types);
+         L1_dcache_track_miss_types,
+         L1_dcache_num_mshrs);
    
    _L2_cache_cntlr = new L2CacheCntlr(this,
          _L1_cache_cntlr,
@@ -190,7 +205,11 @@ MemoryManager::MemoryManager(Tile* tile)
          L2_cache_data_access_cycles,
          L2_cache_tags_access_cycles,
          L2_cache_perf_model_type,
-         L2_cache_track_miss_types);
+         L2_cache_track_miss_types,
+         L2_cache_num_mshrs,
+         L2_cache_prefetcher_type,
+         L2_cache_prefetch_degree,
+         L2_cache_prefetcher_table_size);
 
    _L1_cache_cntlr->setL2CacheCntlr(_L2_cache_cntlr);
 }
@@ -296,12 +315,16 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
              SPELL_MEMCOMP(shmem_msg.getSenderMemComponent()), SPELL_MEMCOMP(shmem_msg.getReceiverMemComponent()),
              shmem_msg.getRequester(), getTile()->getId(), receiver);
 
+   // Forwarded coherence requests mean the requester shares the line with the receiver
+   if ((shmem_msg.getSenderMemComponent() == MemComponent::DRAM_DIRECTORY) && (shmem_msg.getReceiverMemComponent() != MemComponent::DRAM_CNTLR))
+      recordSharing(shmem_msg.getRequester(), receiver);
+
    NetPacket packet(msg_time, SHARED_MEM,
                     getTile()->getId(), receiver,
                     shmem_msg.getMsgLen(), (const void*) msg_buf);
 
    if (getTile()->getId() == receiver)
-      getNetwork()->netSend(packet);
+      sendMsgToSelf(packet);
    else
       getNetwork()->netSend(DVFSManager::convertToModule(shmem_msg.getSenderMemComponent()), packet);
 }
@@ -329,6 +352,34 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
    getNetwork()->netSend(packet);
 }
 
+void
+MemoryManager::multicastMsg(const BitVector& receivers, ShmemMsg& shmem_msg)
+{
+   assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
+
+   // Package into msg buffer
+   Byte msg_buf[shmem_msg.getMsgLen()];
+   shmem_msg.makeMsgBuf(msg_buf);
+
+   Time msg_time = getShmemPerfModel()->getCurrTime();
+
+   LOG_PRINT("Time(%llu), Multicasting Msg: type(%s), address(%#lx), "
+             "sender_mem_component(%s), receiver_mem_component(%s), requester(%i), sender(%i)",
+             msg_time.toNanosec(), SPELL_SHMSG(shmem_msg.getType()), shmem_msg.getAddress(),
+             SPELL_MEMCOMP(shmem_msg.getSenderMemComponent()), SPELL_MEMCOMP(shmem_msg.getReceiverMemComponent()),
+             shmem_msg.getRequester(), getTile()->getId());
+
+   NetPacket packet(msg_time, SHARED_MEM,
+                    getTile()->getId(), NetPacket::BROADCAST,
+                    shmem_msg.getMsgLen(), (const void*) msg_buf);
+
+   // Forwarded coherence requests mean the requester shares the line with the receiver
+   if ((shmem_msg.getSenderMemComponent() == MemComponent::DRAM_DIRECTORY) && (shmem_msg.getReceiverMemComponent() != MemComponent::DRAM_CNTLR))
+      recordSharing(shmem_msg.getRequester(), receivers);
+
+   getNetwork()->netMulticast(DVFSManager::convertToModule(shmem_msg.getSenderMemComponent()), packet, receivers);
+}
+
 void
 MemoryManager::incrCurrTime(MemComponent::Type mem_component, CachePerfModel::AccessType access_type)
 {
@@ -360,6 +411,10 @@ MemoryManager::enableModels()
 {
    _L1_cache_cntlr->getL1ICache()->enable();
    _L1_cache_cntlr->getL1DCache()->enable();
+   if (_L1_cache_cntlr->getL1IMshrFile())
+      _L1_cache_cntlr->getL1IMshrFile()->enable();
+   if (_L1_cache_cntlr->getL1DMshrFile())
+      _L1_cache_cntlr->getL1DMshrFile()->enable();
    _L2_cache_cntlr->getL2Cache()->enable();
    
    _L2_cache_cntlr->enable();
@@ -379,6 +434,10 @@ MemoryManager::disableModels()
 {
    _L1_cache_cntlr->getL1ICache()->disable();
    _L1_cache_cntlr->getL1DCache()->disable();
+   if (_L1_cache_cntlr->getL1IMshrFile())
+      _L1_cache_cntlr->getL1IMshrFile()->disable();
+   if (_L1_cache_cntlr->getL1DMshrFile())
+      _L1_cache_cntlr->getL1DMshrFile()->disable();
    _L2_cache_cntlr->getL2Cache()->disable();
 
    _L2_cache_cntlr->disable();
@@ -400,8 +459,24 @@ MemoryManager::outputSummary(std::ostream &os, const Time& target_completion_tim
    
    os << "Cache Summary:\n";
    _L1_cache_cntlr->getL1ICache()->outputSummary(os, target_completion_time);
+   if (_L1_cache_cntlr->getL1IMshrFile())
+      _L1_cache_cntlr->getL1IMshrFile()->outputSummary(os);
+   else
+      MshrFile::dummyOutputSummary(os);
    _L1_cache_cntlr->getL1DCache()->outputSummary(os, target_completion_time);
+   if (_L1_cache_cntlr->getL1DMshrFile())
+      _L1_cache_cntlr->getL1DMshrFile()->outputSummary(os);
+   else
+      MshrFile::dummyOutputSummary(os);
    _L2_cache_cntlr->getL2Cache()->outputSummary(os, target_completion_time);
+   if (_L2_cache_cntlr->getL2MshrFile())
+      _L2_cache_cntlr->getL2MshrFile()->outputSummary(os);
+   else
+      MshrFile::dummyOutputSummary(os);
+   if (_L2_cache_cntlr->getL2Prefetcher())
+      _L2_cache_cntlr->getL2Prefetcher()->outputSummary(os);
+   else
+      Prefetcher::dummyOutputSummary(os);
    _L2_cache_cntlr->outputSummary(os);
 
    if (_dram_cntlr_present)
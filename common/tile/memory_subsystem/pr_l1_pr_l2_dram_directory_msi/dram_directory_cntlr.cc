@@ -19,6 +19,7 @@ DramDirectoryCntlr::DramDirectoryCntlr(MemoryManager* memory_manager,
       UInt32 num_dram_cntlrs)
    : _memory_manager(memory_manager)
    , _dram_cntlr(dram_cntlr)
+   , _sharers_mask(dram_directory_max_num_sharers)
 {
    _dram_directory_cache = new DirectoryCache(_memory_manager->getTile(),
                                               CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI,
@@ -194,25 +195,19 @@ DramDirectoryCntlr::processNullifyReq(ShmemReq* shmem_req)
    case DirectoryState::SHARED:
 
       {
-         vector<tile_id_t> sharers_list;
-         bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+         bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
+         ShmemMsg msg(ShmemMsg::INV_REQ, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, requester, address,
+                      msg_modeled);
          if (all_tiles_sharers)
          {
             // Broadcast Invalidation Request to all tiles 
             // (irrespective of whether they are sharers or not)
-            ShmemMsg msg(ShmemMsg::INV_REQ, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, requester, address,
-                         msg_modeled);
             _memory_manager->broadcastMsg(msg);
          }
          else
          {
             // Send Invalidation Request to only a specific set of sharers
-            for (UInt32 i = 0; i < sharers_list.size(); i++)
-            {
-               ShmemMsg msg(ShmemMsg::INV_REQ, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, requester, address,
-                            msg_modeled);
-               _memory_manager->sendMsg(sharers_list[i], msg);
-            }
+            _memory_manager->multicastMsg(_sharers_mask, msg);
          }
       }
       break;
@@ -264,25 +259,19 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, const Byte* cac
 
       {
          assert(cached_data_buf == NULL);
-         vector<tile_id_t> sharers_list;
-         bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+         bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
+         ShmemMsg msg(ShmemMsg::INV_REQ, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, requester, address,
+                      msg_modeled);
          if (all_tiles_sharers)
          {
             // Broadcast Invalidation Request to all tiles 
             // (irrespective of whether they are sharers or not)
-            ShmemMsg msg(ShmemMsg::INV_REQ, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, requester, address,
-                         msg_modeled);
             _memory_manager->broadcastMsg(msg);
          }
          else
          {
             // Send Invalidation Request to only a specific set of sharers
-            for (UInt32 i = 0; i < sharers_list.size(); i++)
-            {
-               ShmemMsg msg(ShmemMsg::INV_REQ, MemComponent::DRAM_DIRECTORY, MemComponent::L2_CACHE, requester, address,
-                            msg_modeled);
-               _memory_manager->sendMsg(sharers_list[i], msg);
-            }
+            _memory_manager->multicastMsg(_sharers_mask, msg);
          }
       }
       break;
@@ -45,6 +45,9 @@ namespace PrL1PrL2DramDirectoryMSI
       DramCntlr* _dram_cntlr;
       DirectoryReqQueue _dram_directory_req_queue;
 
+      // Scratch bit-vector for the sharers of the line being invalidated
+      BitVector _sharers_mask;
+
       tile_id_t getTileID() const;
       UInt32 getCacheLineSize();
       ShmemPerfModel* getShmemPerfModel();
@@ -17,6 +17,7 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
                            UInt32 l1_icache_tags_access_cycles,
                            string l1_icache_perf_model_type,
                            bool l1_icache_track_miss_types,
+                           UInt32 l1_icache_num_mshrs,
                            UInt32 l1_dcache_size,
                            UInt32 l1_dcache_associativity,
                            UInt32 l1_dcache_num_banks,
@@ -24,7 +25,8 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
                            UInt32 l1_dcache_data_access_cycles,
                            UInt32 l1_dcache_tags_access_cycles,
                            string l1_dcache_perf_model_type,
-                           bool l1_dcache_track_miss_types)
+                           bool l1_dcache_track_miss_types,
+                           UInt32 l1_dcache_num_mshrs)
    : _memory_manager(memory_manager)
    , _l2_cache_cntlr(NULL)
 {
@@ -66,6 +68,9 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
          l1_dcache_tags_access_cycles,
          l1_dcache_perf_model_type,
          l1_icache_track_miss_types);
+
+   _l1_icache_mshr_file = MshrFile::create("L1-I", l1_icache_num_mshrs);
+   _l1_dcache_mshr_file = MshrFile::create("L1-D", l1_dcache_num_mshrs);
 }
 
 L1CacheCntlr::~L1CacheCntlr()
@@ -76,6 +81,8 @@ L1CacheCntlr::~L1CacheCntlr()
    delete _l1_dcache_replacement_policy_obj;
    delete _l1_icache_hash_fn_obj;
    delete _l1_dcache_hash_fn_obj;
+   delete _l1_icache_mshr_file;
+   delete _l1_dcache_mshr_file;
 }      
 
 void
@@ -96,6 +103,8 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
 
    bool l1_cache_hit = true;
    UInt32 access_num = 0;
+   MshrFile* l1_mshr_file = getL1MshrFile(mem_component);
+   Time mshr_allocate_time(0);
 
    // Core synchronization delay
    getShmemPerfModel()->incrCurrTime(getL1Cache(mem_component)->getSynchronizationDelay(CORE));
@@ -116,6 +125,15 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
          // L1 Cache
          _memory_manager->incrCurrTime(mem_component, CachePerfModel::ACCESS_DATA_AND_TAGS);
 
+         if (l1_mshr_file)
+         {
+            // A hit can still find the line's fill in flight (in simulated time)
+            if (access_num == 1)
+               waitForInFlightFill(l1_mshr_file, address);
+            else
+               l1_mshr_file->allocate(address, mshr_allocate_time, getShmemPerfModel()->getCurrTime());
+         }
+
          accessCache(mem_component, mem_op_type, address, offset, data_buf, data_length);
                  
          return l1_cache_hit;
@@ -131,6 +149,10 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
       // Invalidate the cache line before passing the request to L2 Cache
       invalidateCacheLine(mem_component, address);
 
+      // The miss needs a free MSHR before it can leave the L1 cache
+      if (l1_mshr_file)
+         mshr_allocate_time = waitForFreeMshr(l1_mshr_file);
+
       // (1) Is cache miss? (2) Cache miss type (COLD, CAPACITY, UPGRADE, SHARING)
       pair<bool,Cache::MissType> l2_cache_miss_info = _l2_cache_cntlr->processShmemRequestFromL1Cache(mem_component, mem_op_type, address);
       bool l2_cache_miss = l2_cache_miss_info.first;
@@ -147,6 +169,9 @@ L1CacheCntlr::processMemOpFromCore(MemComponent::Type mem_component,
          // L1 Cache
          _memory_manager->incrCurrTime(mem_component, CachePerfModel::ACCESS_DATA_AND_TAGS);
 
+         if (l1_mshr_file)
+            l1_mshr_file->allocate(address, mshr_allocate_time, getShmemPerfModel()->getCurrTime());
+
          accessCache(mem_component, mem_op_type, address, offset, data_buf, data_length);
 
          return false;
@@ -341,6 +366,44 @@ L1CacheCntlr::getL1Cache(MemComponent::Type mem_component)
    }
 }
 
+MshrFile*
+L1CacheCntlr::getL1MshrFile(MemComponent::Type mem_component)
+{
+   switch (mem_component)
+   {
+   case MemComponent::L1_ICACHE:
+      return _l1_icache_mshr_file;
+
+   case MemComponent::L1_DCACHE:
+      return _l1_dcache_mshr_file;
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized Memory Component(%u)", mem_component);
+      return NULL;
+   }
+}
+
+Time
+L1CacheCntlr::waitForFreeMshr(MshrFile* mshr_file)
+{
+   Time curr_time = getShmemPerfModel()->getCurrTime();
+   Time allocate_time = mshr_file->getAllocateTime(curr_time);
+   if (allocate_time > curr_time)
+   {
+      _memory_manager->incrMshrStallTime(allocate_time - curr_time);
+      getShmemPerfModel()->updateCurrTime(allocate_time);
+   }
+   return allocate_time;
+}
+
+void
+L1CacheCntlr::waitForInFlightFill(MshrFile* mshr_file, IntPtr address)
+{
+   Time completion_time;
+   if (mshr_file->lookup(address, getShmemPerfModel()->getCurrTime(), completion_time))
+      getShmemPerfModel()->updateCurrTime(completion_time);
+}
+
 tile_id_t
 L1CacheCntlr::getTileID()
 {
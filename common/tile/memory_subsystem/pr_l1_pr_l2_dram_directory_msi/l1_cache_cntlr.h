@@ -18,6 +18,8 @@ namespace PrL1PrL2DramDirectoryMSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "mshr_file.h"
+#include "time_types.h"
 
 namespace PrL1PrL2DramDirectoryMSI
 {
@@ -34,6 +36,7 @@ namespace PrL1PrL2DramDirectoryMSI
                    UInt32 l1_icache_tags_access_cycles,
                    string l1_icache_perf_model_type,
                    bool l1_icache_track_miss_types,
+                   UInt32 l1_icache_num_mshrs,
                    UInt32 l1_dcache_size,
                    UInt32 l1_dcache_associativity,
                    UInt32 l1_dcache_num_banks,
@@ -41,11 +44,15 @@ namespace PrL1PrL2DramDirectoryMSI
                    UInt32 l1_dcache_data_access_cycles,
                    UInt32 l1_dcache_tags_access_cycles,
                    string l1_dcache_perf_model_type,
-                   bool l1_dcache_track_miss_types);
+                   bool l1_dcache_track_miss_types,
+                   UInt32 l1_dcache_num_mshrs);
       ~L1CacheCntlr();
 
       Cache* getL1ICache() { return _l1_icache; }
       Cache* getL1DCache() { return _l1_dcache; }
+      // Return NULL if MSHRs are not modeled
+      MshrFile* getL1IMshrFile() { return _l1_icache_mshr_file; }
+      MshrFile* getL1DMshrFile() { return _l1_dcache_mshr_file; }
 
       void setL2CacheCntlr(L2CacheCntlr* l2_cache_cntlr);
 
@@ -73,6 +80,8 @@ namespace PrL1PrL2DramDirectoryMSI
       CacheReplacementPolicy* _l1_dcache_replacement_policy_obj;
       CacheHashFn* _l1_icache_hash_fn_obj;
       CacheHashFn* _l1_dcache_hash_fn_obj;
+      MshrFile* _l1_icache_mshr_file;
+      MshrFile* _l1_dcache_mshr_file;
       L2CacheCntlr* _l2_cache_cntlr;
 
       void accessCache(MemComponent::Type mem_component,
@@ -84,6 +93,11 @@ namespace PrL1PrL2DramDirectoryMSI
             UInt32 access_num);
 
       Cache* getL1Cache(MemComponent::Type mem_component);
+      MshrFile* getL1MshrFile(MemComponent::Type mem_component);
+
+      // MSHRs
+      Time waitForFreeMshr(MshrFile* mshr_file);
+      void waitForInFlightFill(MshrFile* mshr_file, IntPtr address);
       ShmemMsg::Type getShmemMsgType(Core::mem_op_t mem_op_type);
 
       // Utilities
@@ -18,7 +18,11 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                            UInt32 l2_cache_data_access_cycles,
                            UInt32 l2_cache_tags_access_cycles,
                            string l2_cache_perf_model_type,
-                           bool l2_cache_track_miss_types)
+                           bool l2_cache_track_miss_types,
+                           UInt32 l2_cache_num_mshrs,
+                           string l2_cache_prefetcher_type,
+                           UInt32 l2_cache_prefetch_degree,
+                           UInt32 l2_cache_prefetcher_table_size)
    : _memory_manager(memory_manager)
    , _l1_cache_cntlr(l1_cache_cntlr)
    , _dram_directory_home_lookup(dram_directory_home_lookup)
@@ -42,6 +46,11 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
          l2_cache_tags_access_cycles,
          l2_cache_perf_model_type,
          l2_cache_track_miss_types);
+
+   _l2_mshr_file = MshrFile::create("L2", l2_cache_num_mshrs);
+
+   _l2_prefetcher = Prefetcher::create(l2_cache_prefetcher_type, cache_line_size,
+                                       l2_cache_prefetch_degree, l2_cache_prefetcher_table_size);
 }
 
 L2CacheCntlr::~L2CacheCntlr()
@@ -49,11 +58,14 @@ L2CacheCntlr::~L2CacheCntlr()
    delete _l2_cache;
    delete _l2_cache_replacement_policy_obj;
    delete _l2_cache_hash_fn_obj;
+   delete _l2_mshr_file;
+   delete _l2_prefetcher;
 }
 
 void
 L2CacheCntlr::invalidateCacheLine(IntPtr address, PrL2CacheLineInfo& l2_cache_line_info)
 {
+   dropPrefetchedLine(address);
    l2_cache_line_info.invalidate();
    _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
 }
@@ -91,6 +103,7 @@ L2CacheCntlr::insertCacheLine(IntPtr address, CacheState::Type cstate, const Byt
    if (eviction)
    {
       LOG_PRINT("Eviction: address(%#lx)", evicted_address);
+      dropPrefetchedLine(evicted_address);
       invalidateCacheLineInL1(evicted_cache_line_info.getCachedLoc(), evicted_address);
 
       UInt32 home_node_id = getHome(evicted_address);
@@ -196,6 +209,10 @@ L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, C
    pair<bool,Cache::MissType> shmem_request_status_in_l2_cache = operationPermissibleinL2Cache(mem_op_type, address, cstate);
    if (!shmem_request_status_in_l2_cache.first)
    {
+      // The line may still be on its way in (in simulated time)
+      if (_l2_mshr_file)
+         waitForInFlightFill(address);
+
       Byte data_buf[getCacheLineSize()];
       // Read the cache line from L2 cache
       readCacheLine(address, data_buf);
@@ -217,6 +234,18 @@ L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, C
          l2_cache_line_info.setCachedLoc(mem_component);
       }
       _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
+
+      // First demand access to a prefetched line - keep the prefetcher running ahead
+      if (_l2_prefetcher && (_prefetched_line_set.erase(address) > 0))
+      {
+         _l2_prefetcher->incrUsefulPrefetches();
+         issuePrefetches(address, false, Config::getSingleton()->isApplicationTile(getTileID()));
+      }
+   }
+   else if (_l2_mshr_file)
+   {
+      // The miss needs a free MSHR before it can be sent to the directory
+      waitForFreeMshr();
    }
    
    return shmem_request_status_in_l2_cache;
@@ -238,21 +267,36 @@ L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
    // Set outstanding shmem msg parameters
    _outstanding_shmem_msg.setAddress(address);
    _outstanding_shmem_msg.setSenderMemComponent(sender_mem_component);
+   _outstanding_shmem_msg.setMsgType(shmem_msg_type);
    _outstanding_shmem_msg_time = getShmemPerfModel()->getCurrTime();
    
-   switch (shmem_msg_type)
+   if (_outstanding_prefetch_map.count(address) > 0)
    {
-      case ShmemMsg::EX_REQ:
-         processExReqFromL1Cache(shmem_msg);
-         break;
+      // A prefetch for this line is already in flight - wait for its reply
+      // instead of sending a second request to the directory
+      _l2_prefetcher->incrLatePrefetches();
+      issuePrefetches(address, false, shmem_msg->isModeled());
+   }
+   else
+   {
+      switch (shmem_msg_type)
+      {
+         case ShmemMsg::EX_REQ:
+            processExReqFromL1Cache(shmem_msg);
+            break;
 
-      case ShmemMsg::SH_REQ:
-         processShReqFromL1Cache(shmem_msg);
-         break;
+         case ShmemMsg::SH_REQ:
+            processShReqFromL1Cache(shmem_msg);
+            break;
 
-      default:
-         LOG_PRINT_ERROR("Unrecognized shmem msg type (%u)", shmem_msg_type);
-         break;
+         default:
+            LOG_PRINT_ERROR("Unrecognized shmem msg type (%u)", shmem_msg_type);
+            break;
+      }
+
+      // Train the prefetcher on the demand miss
+      if (_l2_prefetcher)
+         issuePrefetches(address, true, shmem_msg->isModeled());
    }
 }
 
@@ -302,29 +346,38 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
    }
 
    ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
-   switch (shmem_msg_type)
+   bool demand_rep = ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP));
+
+   if (demand_rep && (_outstanding_prefetch_map.count(shmem_msg->getAddress()) > 0))
    {
-      case ShmemMsg::EX_REP:
-         processExRepFromDramDirectory(sender, shmem_msg);
-         break;
-      case ShmemMsg::SH_REP:
-         processShRepFromDramDirectory(sender, shmem_msg);
-         break;
-      case ShmemMsg::INV_REQ:
-         processInvReqFromDramDirectory(sender, shmem_msg);
-         break;
-      case ShmemMsg::FLUSH_REQ:
-         processFlushReqFromDramDirectory(sender, shmem_msg);
-         break;
-      case ShmemMsg::WB_REQ:
-         processWbReqFromDramDirectory(sender, shmem_msg);
-         break;
-      default:
-         LOG_PRINT_ERROR("Unrecognized msg type: %u", shmem_msg_type);
-         break;
+      demand_rep = processPrefetchRepFromDramDirectory(sender, shmem_msg);
+   }
+   else
+   {
+      switch (shmem_msg_type)
+      {
+         case ShmemMsg::EX_REP:
+            processExRepFromDramDirectory(sender, shmem_msg);
+            break;
+         case ShmemMsg::SH_REP:
+            processShRepFromDramDirectory(sender, shmem_msg);
+            break;
+         case ShmemMsg::INV_REQ:
+            processInvReqFromDramDirectory(sender, shmem_msg);
+            break;
+         case ShmemMsg::FLUSH_REQ:
+            processFlushReqFromDramDirectory(sender, shmem_msg);
+            break;
+         case ShmemMsg::WB_REQ:
+            processWbReqFromDramDirectory(sender, shmem_msg);
+            break;
+         default:
+            LOG_PRINT_ERROR("Unrecognized msg type: %u", shmem_msg_type);
+            break;
+      }
    }
 
-   if ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP))
+   if (demand_rep)
    {
       LOG_ASSERT_ERROR(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCurrTime(),
                        "Outstanding msg time(%llu), Curr time(%llu)",
@@ -337,6 +390,13 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
       // Increment the clock by the time taken to update the L2 cache
       _memory_manager->incrCurrTime(MemComponent::L2_CACHE, CachePerfModel::ACCESS_DATA_AND_TAGS);
 
+      // The miss held an MSHR till its fill arrived
+      if (_l2_mshr_file && shmem_msg->isModeled())
+      {
+         _l2_mshr_file->allocate(_outstanding_shmem_msg.getAddress(), _outstanding_shmem_msg_time,
+                                 getShmemPerfModel()->getCurrTime());
+      }
+
       // There are no more outstanding memory requests
       _outstanding_shmem_msg.setAddress(INVALID_ADDRESS);
       
@@ -500,6 +560,102 @@ L2CacheCntlr::processWbReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_ms
    }
 }
 
+bool
+L2CacheCntlr::processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   const Byte* data_buf = shmem_msg->getDataBuf();
+   LOG_ASSERT_ERROR(shmem_msg->getType() == ShmemMsg::SH_REP,
+                    "Address(%#lx), Prefetch reply type(%u)", address, shmem_msg->getType());
+
+   Time prefetch_time = _outstanding_prefetch_map[address];
+   _outstanding_prefetch_map.erase(address);
+
+   if (address != _outstanding_shmem_msg.getAddress())
+   {
+      // Fill the line in the L2 cache only
+      _memory_manager->incrCurrTime(MemComponent::L2_CACHE, CachePerfModel::ACCESS_DATA_AND_TAGS);
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+      _prefetched_line_set.insert(address);
+      if (_l2_mshr_file && shmem_msg->isModeled())
+         _l2_mshr_file->allocate(address, prefetch_time, getShmemPerfModel()->getCurrTime());
+      return false;
+   }
+
+   // A demand request for this line arrived while the prefetch was in flight
+   if (_outstanding_shmem_msg.getType() == ShmemMsg::SH_REQ)
+   {
+      processShRepFromDramDirectory(sender, shmem_msg);
+      return true;
+   }
+
+   // The demand request needs exclusive access - fill the line and upgrade it
+   insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+   ShmemMsg ex_req_msg(ShmemMsg::EX_REQ, _outstanding_shmem_msg.getSenderMemComponent(), MemComponent::L2_CACHE,
+                       getTileID(), address, shmem_msg->isModeled());
+   processExReqFromL1Cache(&ex_req_msg);
+   return false;
+}
+
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool cache_miss, bool msg_modeled)
+{
+   vector<IntPtr> prefetch_address_list;
+   _l2_prefetcher->getPrefetchAddressList(address, cache_miss, prefetch_address_list);
+
+   for (vector<IntPtr>::iterator it = prefetch_address_list.begin(); it != prefetch_address_list.end(); it ++)
+   {
+      IntPtr prefetch_address = *it;
+      
+      // Skip lines that are already present or being fetched
+      if ((prefetch_address == _outstanding_shmem_msg.getAddress()) || (_outstanding_prefetch_map.count(prefetch_address) > 0))
+         continue;
+      PrL2CacheLineInfo l2_cache_line_info;
+      _l2_cache->getCacheLineInfo(prefetch_address, &l2_cache_line_info);
+      if (l2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Prefetches hold MSHRs too - always leave one free for demand misses
+      if (_l2_mshr_file && ((_outstanding_prefetch_map.size() + 1) >= _l2_mshr_file->getNumEntries()))
+         break;
+
+      _outstanding_prefetch_map[prefetch_address] = getShmemPerfModel()->getCurrTime();
+      _l2_prefetcher->incrPrefetchesIssued();
+
+      // Prefetches are sent out as non-blocking SH_REQs
+      ShmemMsg msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileID(), prefetch_address, msg_modeled);
+      _memory_manager->sendMsg(getHome(prefetch_address), msg);
+   }
+}
+
+void
+L2CacheCntlr::dropPrefetchedLine(IntPtr address)
+{
+   // A prefetched line that leaves the cache before it is used was useless
+   if (_l2_prefetcher && (_prefetched_line_set.erase(address) > 0))
+      _l2_prefetcher->incrUselessPrefetches();
+}
+
+void
+L2CacheCntlr::waitForFreeMshr()
+{
+   Time curr_time = getShmemPerfModel()->getCurrTime();
+   Time allocate_time = _l2_mshr_file->getAllocateTime(curr_time);
+   if (allocate_time > curr_time)
+   {
+      _memory_manager->incrMshrStallTime(allocate_time - curr_time);
+      getShmemPerfModel()->updateCurrTime(allocate_time);
+   }
+}
+
+void
+L2CacheCntlr::waitForInFlightFill(IntPtr address)
+{
+   Time completion_time;
+   if (_l2_mshr_file->lookup(address, getShmemPerfModel()->getCurrTime(), completion_time))
+      getShmemPerfModel()->updateCurrTime(completion_time);
+}
+
 pair<bool,Cache::MissType>
 L2CacheCntlr::operationPermissibleinL2Cache(Core::mem_op_t mem_op_type, IntPtr address, CacheState::Type cstate)
 {
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <string>
+#include <set>
+#include <map>
 using std::string;
+using std::set;
+using std::map;
 
 // Forward declarations
 namespace PrL1PrL2DramDirectoryMSI
@@ -19,6 +23,8 @@ namespace PrL1PrL2DramDirectoryMSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "prefetcher.h"
+#include "mshr_file.h"
 #include "time_types.h"
 
 namespace PrL1PrL2DramDirectoryMSI
@@ -37,10 +43,18 @@ namespace PrL1PrL2DramDirectoryMSI
                    UInt32 l2_cache_data_access_cycles,
                    UInt32 l2_cache_tags_access_cycles,
                    string l2_cache_perf_model_type,
-                   bool l2_cache_track_miss_types);
+                   bool l2_cache_track_miss_types,
+                   UInt32 l2_cache_num_mshrs,
+                   string l2_cache_prefetcher_type,
+                   UInt32 l2_cache_prefetch_degree,
+                   UInt32 l2_cache_prefetcher_table_size);
       ~L2CacheCntlr();
 
       Cache* getL2Cache() { return _l2_cache; }
+      // Returns NULL if prefetching is disabled
+      Prefetcher* getL2Prefetcher() { return _l2_prefetcher; }
+      // Returns NULL if MSHRs are not modeled
+      MshrFile* getL2MshrFile() { return _l2_mshr_file; }
 
       // Handle Request from L1 Cache - This is done for better simulator performance
       pair<bool,Cache::MissType> processShmemRequestFromL1Cache(MemComponent::Type mem_component, Core::mem_op_t mem_op_type, IntPtr address);
@@ -64,6 +78,16 @@ namespace PrL1PrL2DramDirectoryMSI
       // Outstanding Miss information
       ShmemMsg _outstanding_shmem_msg;
       Time _outstanding_shmem_msg_time;
+
+      // MSHRs
+      MshrFile* _l2_mshr_file;
+
+      // Prefetcher
+      Prefetcher* _l2_prefetcher;
+      // Lines for which a prefetch SH_REQ has been sent but no reply received (and the time it was sent)
+      map<IntPtr,Time> _outstanding_prefetch_map;
+      // Prefetched lines that have not yet been accessed by a demand request
+      set<IntPtr> _prefetched_line_set;
       
       // L2 cache operations
       void readCacheLine(IntPtr address, Byte* data_buf);
@@ -90,6 +114,16 @@ namespace PrL1PrL2DramDirectoryMSI
       void processInvReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
       void processFlushReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
       void processWbReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
+      // Returns true if the reply also completes the outstanding demand request
+      bool processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
+
+      // Prefetching
+      void issuePrefetches(IntPtr address, bool cache_miss, bool msg_modeled);
+      void dropPrefetchedLine(IntPtr address);
+
+      // MSHRs
+      void waitForFreeMshr();
+      void waitForInFlightFill(IntPtr address);
 
       // Utilities
       tile_id_t getTileID();
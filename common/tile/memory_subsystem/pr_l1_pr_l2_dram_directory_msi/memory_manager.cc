@@ -25,6 +25,7 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L1_icache_tags_access_cycles = 0;
    std::string L1_icache_perf_model_type;
    bool L1_icache_track_miss_types = false;
+   UInt32 L1_icache_num_mshrs = 0;
 
    std::string L1_dcache_type;
    __attribute__((unused)) UInt32 L1_dcache_line_size = 0;
@@ -36,6 +37,7 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L1_dcache_tags_access_cycles = 0;
    std::string L1_dcache_perf_model_type;
    bool L1_dcache_track_miss_types = false;
+   UInt32 L1_dcache_num_mshrs = 0;
 
    std::string L2_cache_type;
    __attribute__((unused)) UInt32 L2_cache_line_size = 0;
@@ -47,6 +49,10 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L2_cache_tags_access_cycles = 0;
    std::string L2_cache_perf_model_type;
    bool L2_cache_track_miss_types = false;
+   UInt32 L2_cache_num_mshrs = 0;
+   std::string L2_cache_prefetcher_type;
+   UInt32 L2_cache_prefetch_degree = 0;
+   UInt32 L2_cache_prefetcher_table_size = 0;
 
    std::string dram_directory_total_entries_str;
    UInt32 dram_directory_associativity = 0;
@@ -76,6 +82,7 @@ MemoryManager::MemoryManager(Tile* tile)
       L1_icache_tags_access_cycles = Sim()->getCfg()->getInt(L1_icache_type + "/tags_access_time");
       L1_icache_perf_model_type = Sim()->getCfg()->getString(L1_icache_type + "/perf_model_type");
       L1_icache_track_miss_types = Sim()->getCfg()->getBool(L1_icache_type + "/track_miss_types");
+      L1_icache_num_mshrs = Sim()->getCfg()->getInt(L1_icache_type + "/num_mshrs", 0);
 
       // L1 DCache
       L1_dcache_type = "l1_dcache/" + Config::getSingleton()->getL1DCacheType(getTile()->getId());
@@ -88,6 +95,7 @@ MemoryManager::MemoryManager(Tile* tile)
       L1_dcache_tags_access_cycles = Sim()->getCfg()->getInt(L1_dcache_type + "/tags_access_time");
       L1_dcache_perf_model_type = Sim()->getCfg()->getString(L1_dcache_type + "/perf_model_type");
       L1_dcache_track_miss_types = Sim()->getCfg()->getBool(L1_dcache_type + "/track_miss_types");
+      L1_dcache_num_mshrs = Sim()->getCfg()->getInt(L1_dcache_type + "/num_mshrs", 0);
 
       // L2 Cache
       L2_cache_type = "l2_cache/" + Config::getSingleton()->getL2CacheType(getTile()->getId());
@@ -100,6 +108,10 @@ MemoryManager::MemoryManager(Tile* tile)
       L2_cache_tags_access_cycles = Sim()->getCfg()->getInt(L2_cache_type + "/tags_access_time");
       L2_cache_perf_model_type = Sim()->getCfg()->getString(L2_cache_type + "/perf_model_type");
       L2_cache_track_miss_types = Sim()->getCfg()->getBool(L2_cache_type + "/track_miss_types");
+      L2_cache_num_mshrs = Sim()->getCfg()->getInt(L2_cache_type + "/num_mshrs", 0);
+      L2_cache_prefetcher_type = Sim()->getCfg()->getString(L2_cache_type + "/prefetcher", "none");
+      L2_cache_prefetch_degree = Sim()->getCfg()->getInt(L2_cache_type + "/prefetch_degree", 2);
+      L2_cache_prefetcher_table_size = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_table_size", 16);
 
       // Dram Directory Cache
       dram_directory_total_entries_str = Sim()->getCfg()->getString("dram_directory/total_entries");
@@ -163,7 +175,8 @@ MemoryManager::MemoryManager(Tile* tile)
       LOG_PRINT("Instantiated Dram Directory Cntlr");
    }
 
-   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize());
+   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize(),
+                                                       Config::getSingleton()->getPartitionDramByTarget());
 
    LOG_PRINT("Instantiated Dram Directory Home Lookup");
 
@@ -177,6 +190,7 @@ MemoryManager::MemoryManager(Tile* tile)
          L1_icache_tags_access_cycles,
          L1_icache_perf_model_type,
          L1_icache_track_miss_types,
+         L1_icache_num_mshrs,
          L1_dcache_size,
          L1_dcache_associativity,
          L1_dcache_num_banks,
@@ -184,7 +198,8 @@ MemoryManager::MemoryManager(Tile* tile)
          L1_dcache_data_access_cycles,
          L1_dcache_tags_access_cycles,
          L1_dcache_perf_model_type,
-         L1_dcache_track_miss_types);
+         L1_dcache_track_miss_types,
+         L1_dcache_num_mshrs);
    
    LOG_PRINT("Instantiated L1 Cache Cntlr");
 
@@ -199,7 +214,11 @@ MemoryManager::MemoryManager(Tile* tile)
          L2_cache_data_access_cycles,
          L2_cache_tags_access_cycles,
          L2_cache_perf_model_type,
-         L2_cache_track_miss_types);
+         L2_cache_track_miss_types,
+         L2_cache_num_mshrs,
+         L2_cache_prefetcher_type,
+         L2_cache_prefetch_degree,
+         L2_cache_prefetcher_table_size);
    LOG_PRINT("Instantiated L2 Cache Cntlr");
 
    _L1_cache_cntlr->setL2CacheCntlr(_L2_cache_cntlr);
@@ -301,12 +320,16 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
              shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent(),
              shmem_msg.getRequester(), getTile()->getId(), receiver);
 
+   // Forwarded coherence requests mean the requester shares the line with the receiver
+   if ((shmem_msg.getSenderMemComponent() == MemComponent::DRAM_DIRECTORY) && (shmem_msg.getReceiverMemComponent() != MemComponent::DRAM_CNTLR))
+      recordSharing(shmem_msg.getRequester(), receiver);
+
    NetPacket packet(msg_time, SHARED_MEM,
                     getTile()->getId(), receiver,
                     shmem_msg.getMsgLen(), (const void*) msg_buf);
 
    if (getTile()->getId() == receiver)
-      getNetwork()->netSend(packet);
+      sendMsgToSelf(packet);
    else
       getNetwork()->netSend(DVFSManager::convertToModule(shmem_msg.getSenderMemComponent()), packet);
 }
@@ -334,6 +357,34 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
    getNetwork()->netSend(packet);
 }
 
+void
+MemoryManager::multicastMsg(const BitVector& receivers, ShmemMsg& shmem_msg)
+{
+   assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
+
+   // Package into msg buffer
+   Byte msg_buf[shmem_msg.getMsgLen()];
+   shmem_msg.makeMsgBuf(msg_buf);
+
+   Time msg_time = getShmemPerfModel()->getCurrTime();
+
+   LOG_PRINT("Multicasting Msg: type(%u), address(%#lx), sender_mem_component(%u), receiver_mem_component(%u), "
+             "requester(%i), sender(%i)",
+             shmem_msg.getType(), shmem_msg.getAddress(),
+             shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent(),
+             shmem_msg.getRequester(), getTile()->getId());
+
+   NetPacket packet(msg_time, SHARED_MEM,
+                    getTile()->getId(), NetPacket::BROADCAST,
+                    shmem_msg.getMsgLen(), (const void*) msg_buf);
+
+   // Forwarded coherence requests mean the requester shares the line with the receiver
+   if ((shmem_msg.getSenderMemComponent() == MemComponent::DRAM_DIRECTORY) && (shmem_msg.getReceiverMemComponent() != MemComponent::DRAM_CNTLR))
+      recordSharing(shmem_msg.getRequester(), receivers);
+
+   getNetwork()->netMulticast(DVFSManager::convertToModule(shmem_msg.getSenderMemComponent()), packet, receivers);
+}
+
 void
 MemoryManager::incrCurrTime(MemComponent::Type mem_component, CachePerfModel::AccessType access_type)
 {
@@ -366,6 +417,14 @@ MemoryManager::enableModels()
    _L1_cache_cntlr->getL1ICache()->enable();
    _L1_cache_cntlr->getL1DCache()->enable();
    _L2_cache_cntlr->getL2Cache()->enable();
+   if (_L1_cache_cntlr->getL1IMshrFile())
+      _L1_cache_cntlr->getL1IMshrFile()->enable();
+   if (_L1_cache_cntlr->getL1DMshrFile())
+      _L1_cache_cntlr->getL1DMshrFile()->enable();
+   if (_L2_cache_cntlr->getL2MshrFile())
+      _L2_cache_cntlr->getL2MshrFile()->enable();
+   if (_L2_cache_cntlr->getL2Prefetcher())
+      _L2_cache_cntlr->getL2Prefetcher()->enable();
 
    if (_dram_cntlr_present)
    {
@@ -382,6 +441,14 @@ MemoryManager::disableModels()
    _L1_cache_cntlr->getL1ICache()->disable();
    _L1_cache_cntlr->getL1DCache()->disable();
    _L2_cache_cntlr->getL2Cache()->disable();
+   if (_L1_cache_cntlr->getL1IMshrFile())
+      _L1_cache_cntlr->getL1IMshrFile()->disable();
+   if (_L1_cache_cntlr->getL1DMshrFile())
+      _L1_cache_cntlr->getL1DMshrFile()->disable();
+   if (_L2_cache_cntlr->getL2MshrFile())
+      _L2_cache_cntlr->getL2MshrFile()->disable();
+   if (_L2_cache_cntlr->getL2Prefetcher())
+      _L2_cache_cntlr->getL2Prefetcher()->disable();
 
    if (_dram_cntlr_present)
    {
@@ -399,8 +466,24 @@ MemoryManager::outputSummary(std::ostream &os, const Time& target_completion_tim
    
    os << "Cache Summary:\n";
    _L1_cache_cntlr->getL1ICache()->outputSummary(os, target_completion_time);
+   if (_L1_cache_cntlr->getL1IMshrFile())
+      _L1_cache_cntlr->getL1IMshrFile()->outputSummary(os);
+   else
+      MshrFile::dummyOutputSummary(os);
    _L1_cache_cntlr->getL1DCache()->outputSummary(os, target_completion_time);
+   if (_L1_cache_cntlr->getL1DMshrFile())
+      _L1_cache_cntlr->getL1DMshrFile()->outputSummary(os);
+   else
+      MshrFile::dummyOutputSummary(os);
    _L2_cache_cntlr->getL2Cache()->outputSummary(os, target_completion_time);
+   if (_L2_cache_cntlr->getL2MshrFile())
+      _L2_cache_cntlr->getL2MshrFile()->outputSummary(os);
+   else
+      MshrFile::dummyOutputSummary(os);
+   if (_L2_cache_cntlr->getL2Prefetcher())
+      _L2_cache_cntlr->getL2Prefetcher()->outputSummary(os);
+   else
+      Prefetcher::dummyOutputSummary(os);
 
    if (_dram_cntlr_present)
    {      
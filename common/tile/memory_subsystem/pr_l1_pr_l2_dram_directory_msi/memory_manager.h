@@ -34,12 +34,15 @@ namespace PrL1PrL2DramDirectoryMSI
       // Send/Broadcast msg
       void sendMsg(tile_id_t receiver, ShmemMsg& msg);
       void broadcastMsg(ShmemMsg& msg);
+      void multicastMsg(const BitVector& receivers, ShmemMsg& msg);
      
       void enableModels();
       void disableModels();
 
       tile_id_t getShmemRequester(const void* pkt_data)
       { return ((ShmemMsg*) pkt_data)->getRequester(); }
+      IntPtr getShmemAddress(const void* pkt_data)
+      { return ((ShmemMsg*) pkt_data)->getAddress(); }
       UInt32 getModeledLength(const void* pkt_data)
       { return ((ShmemMsg*) pkt_data)->getModeledLength(); }
       bool isModeled(const void* pkt_data)
@@ -64,6 +64,7 @@ namespace PrL1PrL2DramDirectoryMSI
       UInt32 getDataLength() const                       { return _data_length; }
       bool isModeled() const                             { return _modeled; }
 
+      void setMsgType(Type msg_type)                                 { _msg_type = msg_type; }
       void setAddress(IntPtr address)                                { _address = address; }
       void setSenderMemComponent(MemComponent::Type mem_component)   { _sender_mem_component = mem_component; }
 
@@ -13,6 +13,7 @@ namespace PrL1ShL2MSI
 {
 
 L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
+                           AddressHomeLookup* L2_cache_home_lookup,
                            AddressHomeLookup* dram_home_lookup,
                            UInt32 cache_line_size,
                            UInt32 L2_cache_size,
@@ -22,9 +23,14 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                            UInt32 L2_cache_data_access_cycles,
                            UInt32 L2_cache_tags_access_cycles,
                            string L2_cache_perf_model_type,
-                           bool L2_cache_track_miss_types)
+                           bool L2_cache_track_miss_types,
+                           string L2_cache_prefetcher_type,
+                           UInt32 L2_cache_prefetch_degree,
+                           UInt32 L2_cache_prefetcher_table_size)
    : _memory_manager(memory_manager)
+   , _L2_cache_home_lookup(L2_cache_home_lookup)
    , _dram_home_lookup(dram_home_lookup)
+   , _sharers_mask(L2DirectoryCfg::getMaxNumSharers())
    , _enabled(false)
 {
    _L2_cache_replacement_policy_obj =
@@ -52,6 +58,9 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                                                         L2DirectoryCfg::getDirectoryType(),
                                                         L2DirectoryCfg::getMaxHWSharers(),
                                                         L2DirectoryCfg::getMaxNumSharers());
+
+   _L2_prefetcher = Prefetcher::create(L2_cache_prefetcher_type, cache_line_size,
+                                       L2_cache_prefetch_degree, L2_cache_prefetcher_table_size);
 }
 
 L2CacheCntlr::~L2CacheCntlr()
@@ -60,6 +69,7 @@ L2CacheCntlr::~L2CacheCntlr()
    delete _L2_cache;
    delete _L2_cache_replacement_policy_obj;
    delete _L2_cache_hash_fn_obj;
+   delete _L2_prefetcher;
 }
 
 void
@@ -71,9 +81,9 @@ L2CacheCntlr::getCacheLineInfo(IntPtr address, ShL2CacheLineInfo* L2_cache_line_
       assert(shmem_msg_type != ShmemMsg::NULLIFY_REQ);
       // Read it from the cache
       _L2_cache->getCacheLineInfo(address, L2_cache_line_info);
+      bool cache_miss = (L2_cache_line_info->getCState() == CacheState::INVALID);
       if (update_miss_counters)
       {
-         bool cache_miss = (L2_cache_line_info->getCState() == CacheState::INVALID);
          Core::mem_op_t mem_op_type = getMemOpTypeFromShmemMsgType(shmem_msg_type);
          _L2_cache->updateMissCounters(address, mem_op_type, cache_miss);
       }
@@ -90,6 +100,20 @@ L2CacheCntlr::getCacheLineInfo(IntPtr address, ShL2CacheLineInfo* L2_cache_line_
             LOG_PRINT_ERROR("Unrecognized shmem msg type(%u)", shmem_msg_type);
          }
       }
+
+      // Train the prefetcher on demand misses and on the first demand access to a prefetched line
+      if (update_miss_counters && _L2_prefetcher)
+      {
+         if (cache_miss)
+         {
+            issuePrefetches(address, true);
+         }
+         else if (_prefetched_line_set.erase(address) > 0)
+         {
+            _L2_prefetcher->incrUsefulPrefetches();
+            issuePrefetches(address, false);
+         }
+      }
    }
    else // (present in the evicted map [_evicted_cache_line_map])
    {
@@ -150,6 +174,7 @@ L2CacheCntlr::allocateCacheLine(IntPtr address, ShL2CacheLineInfo* L2_cache_line
    if (eviction)
    {
       assert(evicted_cache_line_info.isValid());
+      dropPrefetchedLine(evicted_address);
       LOG_ASSERT_ERROR(_L2_cache_req_queue.empty(evicted_address),
                        "Address(%#lx) is already being processed", evicted_address);
       LOG_ASSERT_ERROR(evicted_cache_line_info.getCState() == CacheState::CLEAN || evicted_cache_line_info.getCState() == CacheState::DIRTY,
@@ -213,6 +238,13 @@ L2CacheCntlr::handleMsgFromL1Cache(tile_id_t sender, ShmemMsg* shmem_msg)
          // Process the request
          processShmemReq(shmem_req);
       }
+      else if ((_L2_cache_req_queue.size(address) == 2) &&
+               (TYPE(dynamic_cast<ShmemReq*>(_L2_cache_req_queue.front(address))) == ShmemMsg::PREFETCH_REQ))
+      {
+         // The line is still being prefetched from DRAM
+         _L2_prefetcher->incrLatePrefetches();
+         issuePrefetches(address, false);
+      }
    }
 
    else if ( (shmem_msg_type == ShmemMsg::INV_REP) || (shmem_msg_type == ShmemMsg::FLUSH_REP) || (shmem_msg_type == ShmemMsg::WB_REP) )
@@ -282,9 +314,9 @@ L2CacheCntlr::handleMsgFromDram(tile_id_t sender, ShmemMsg* shmem_msg)
    ShL2CacheLineInfo L2_cache_line_info;
    _L2_cache->getCacheLineInfo(address, &L2_cache_line_info);
 
-   // Write the data into the L2 cache if it is a SH_REQ
+   // Write the data into the L2 cache if it is a SH_REQ or a PREFETCH_REQ
    ShmemReq* shmem_req = dynamic_cast<ShmemReq*>(_L2_cache_req_queue.front(address));
-   if (TYPE(shmem_req) == ShmemMsg::SH_REQ)
+   if ((TYPE(shmem_req) == ShmemMsg::SH_REQ) || (TYPE(shmem_req) == ShmemMsg::PREFETCH_REQ))
       writeCacheLine(address, shmem_msg->getDataBuf());
    else
       LOG_ASSERT_ERROR(TYPE(shmem_req) == ShmemMsg::EX_REQ, "Type(%u)", TYPE(shmem_req));
@@ -294,8 +326,19 @@ L2CacheCntlr::handleMsgFromDram(tile_id_t sender, ShmemMsg* shmem_msg)
    // Write-back the cache line info
    setCacheLineInfo(address, &L2_cache_line_info);
 
-   // Restart the shmem request
-   restartShmemReq(shmem_req, &L2_cache_line_info, shmem_msg->getDataBuf());
+   if (TYPE(shmem_req) == ShmemMsg::PREFETCH_REQ)
+   {
+      // Track the line till its first demand access (unless a demand request is already waiting)
+      if (_L2_cache_req_queue.size(address) == 1)
+         _prefetched_line_set.insert(address);
+      // The prefetch is complete, process the requests that arrived meanwhile
+      processNextReqFromL1Cache(address);
+   }
+   else
+   {
+      // Restart the shmem request
+      restartShmemReq(shmem_req, &L2_cache_line_info, shmem_msg->getDataBuf());
+   }
 }
 
 void
@@ -391,12 +434,11 @@ L2CacheCntlr::processNullifyReq(ShmemReq* nullify_req, const Byte* data_buf)
                           "Address(%#lx), Directory State(SHARED), Num Sharers(%u)",
                           address, directory_entry->getNumSharers());
          
-         vector<tile_id_t> sharers_list;
-         bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+         bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
          
          sendInvalidationMsg(ShmemMsg::NULLIFY_REQ,
                              address, L2_cache_line_info.getCachingComponent(),
-                             all_tiles_sharers, sharers_list,
+                             all_tiles_sharers, _sharers_mask,
                              requester, msg_modeled);
 
          // Send line to DRAM_CNTLR if dirty
@@ -504,12 +546,11 @@ L2CacheCntlr::processExReqFromL1Cache(ShmemReq* shmem_req, const Byte* data_buf,
             else
             {
                // Invalidate all the sharers
-               vector<tile_id_t> sharers_list;
-               bool all_tiles_sharers = directory_entry->getSharersList(sharers_list);
+               bool all_tiles_sharers = directory_entry->getSharersMask(_sharers_mask);
               
                sendInvalidationMsg(ShmemMsg::EX_REQ,
                                    address, MemComponent::L1_DCACHE,
-                                   all_tiles_sharers, sharers_list,
+                                   all_tiles_sharers, _sharers_mask,
                                    requester, msg_modeled);
             }
          }
@@ -842,28 +883,22 @@ L2CacheCntlr::restartShmemReq(ShmemReq* shmem_req, ShL2CacheLineInfo* L2_cache_l
 void
 L2CacheCntlr::sendInvalidationMsg(ShmemMsg::Type requester_msg_type,
                                   IntPtr address, MemComponent::Type receiver_mem_component,
-                                  bool all_tiles_sharers, vector<tile_id_t>& sharers_list,
+                                  bool all_tiles_sharers, const BitVector& sharers_mask,
                                   tile_id_t requester, bool msg_modeled)
 {
+   ShmemMsg shmem_msg(ShmemMsg::INV_REQ, MemComponent::L2_CACHE, receiver_mem_component, 
+                      requester, address,
+                      msg_modeled);
    if (all_tiles_sharers)
    {
       // Broadcast invalidation request to all tiles 
       // (irrespective of whether they are sharers or not)
-      ShmemMsg shmem_msg(ShmemMsg::INV_REQ, MemComponent::L2_CACHE, receiver_mem_component, 
-                         requester, address,
-                         msg_modeled);
       _memory_manager->broadcastMsg(shmem_msg);
    }
    else // not all tiles are sharers
    {
       // Send Invalidation Request to only a specific set of sharers
-      for (UInt32 i = 0; i < sharers_list.size(); i++)
-      {
-         ShmemMsg shmem_msg(ShmemMsg::INV_REQ, MemComponent::L2_CACHE, receiver_mem_component,
-                            requester, address,
-                            msg_modeled);
-         _memory_manager->sendMsg(sharers_list[i], shmem_msg);
-      }
+      _memory_manager->multicastMsg(sharers_mask, shmem_msg);
    }
 }
 
@@ -915,6 +950,52 @@ L2CacheCntlr::storeDataInDram(IntPtr address, const Byte* data_buf, tile_id_t re
    _memory_manager->sendMsg(getDramHome(address), send_msg);
 }
 
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool cache_miss)
+{
+   vector<IntPtr> prefetch_address_list;
+   _L2_prefetcher->getPrefetchAddressList(address, cache_miss, prefetch_address_list);
+
+   bool msg_modeled = Config::getSingleton()->isApplicationTile(getTileID());
+   Time msg_time = getShmemPerfModel()->getCurrTime();
+
+   for (vector<IntPtr>::iterator it = prefetch_address_list.begin(); it != prefetch_address_list.end(); it ++)
+   {
+      IntPtr prefetch_address = *it;
+
+      // Only lines homed at this L2 cache slice are prefetched
+      if (getL2CacheHome(prefetch_address) != getTileID())
+         continue;
+      // Skip lines that are already present or being processed
+      if (!_L2_cache_req_queue.empty(prefetch_address))
+         continue;
+      ShL2CacheLineInfo L2_cache_line_info;
+      _L2_cache->getCacheLineInfo(prefetch_address, &L2_cache_line_info);
+      if (L2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Queue a PREFETCH_REQ so that demand requests for the line wait for the data
+      ShmemMsg prefetch_msg(ShmemMsg::PREFETCH_REQ, MemComponent::L2_CACHE, MemComponent::L2_CACHE,
+                            getTileID(), prefetch_address,
+                            msg_modeled);
+      ShmemReq* prefetch_req = new(getTileID()) ShmemReq(prefetch_msg, msg_time);
+      _L2_cache_req_queue.push(prefetch_address, prefetch_req);
+
+      // Allocate the line and fetch the data from DRAM
+      allocateCacheLine(prefetch_address, &L2_cache_line_info);
+      _L2_prefetcher->incrPrefetchesIssued();
+      fetchDataFromDram(prefetch_address, getTileID(), msg_modeled);
+   }
+}
+
+void
+L2CacheCntlr::dropPrefetchedLine(IntPtr address)
+{
+   // A prefetched line that is evicted before it is used was useless
+   if (_L2_prefetcher && (_prefetched_line_set.erase(address) > 0))
+      _L2_prefetcher->incrUselessPrefetches();
+}
+
 Core::mem_op_t
 L2CacheCntlr::getMemOpTypeFromShmemMsgType(ShmemMsg::Type shmem_msg_type)
 {
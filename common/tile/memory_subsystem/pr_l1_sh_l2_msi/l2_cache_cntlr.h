@@ -7,7 +7,9 @@ namespace PrL1ShL2MSI
 }
 
 #include <map>
+#include <set>
 using std::map;
+using std::set;
 
 #include "core.h"
 #include "cache.h"
@@ -21,6 +23,7 @@ using std::map;
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "prefetcher.h"
 #include "directory_entry.h"
 
 namespace PrL1ShL2MSI
@@ -29,6 +32,7 @@ namespace PrL1ShL2MSI
    {
    public:
       L2CacheCntlr(MemoryManager* memory_manager,
+                   AddressHomeLookup* L2_cache_home_lookup,
                    AddressHomeLookup* dram_home_lookup,
                    UInt32 cache_line_size,
                    UInt32 L2_cache_size,
@@ -38,10 +42,15 @@ namespace PrL1ShL2MSI
                    UInt32 L2_cache_data_access_cycles,
                    UInt32 L2_cache_tags_access_cycles,
                    string L2_cache_perf_model_type,
-                   bool L2_cache_track_miss_types);
+                   bool L2_cache_track_miss_types,
+                   string L2_cache_prefetcher_type,
+                   UInt32 L2_cache_prefetch_degree,
+                   UInt32 L2_cache_prefetcher_table_size);
       ~L2CacheCntlr();
 
       Cache* getL2Cache() { return _L2_cache; }
+      // Returns NULL if prefetching is disabled
+      Prefetcher* getL2Prefetcher() { return _L2_prefetcher; }
 
       // Handle message from L1 Cache
       void handleMsgFromL1Cache(tile_id_t sender, ShmemMsg* shmem_msg);
@@ -50,8 +59,18 @@ namespace PrL1ShL2MSI
       // Output summary
       void outputSummary(ostream& out);
 
-      void enable() { _enabled = true; }
-      void disable() { _enabled = false; }
+      void enable()
+      {
+         _enabled = true;
+         if (_L2_prefetcher)
+            _L2_prefetcher->enable();
+      }
+      void disable()
+      {
+         _enabled = false;
+         if (_L2_prefetcher)
+            _L2_prefetcher->disable();
+      }
 
    private:
       // Data Members
@@ -59,9 +78,12 @@ namespace PrL1ShL2MSI
       Cache* _L2_cache;
       CacheReplacementPolicy* _L2_cache_replacement_policy_obj;
       CacheHashFn* _L2_cache_hash_fn_obj;
+      AddressHomeLookup* _L2_cache_home_lookup;
       AddressHomeLookup* _dram_home_lookup;
 
       DirectoryEntryFactory* _directory_entry_factory;
+      // Scratch bit-vector for the sharers of the line being invalidated
+      BitVector _sharers_mask;
 
       // Is enabled?
       bool _enabled;
@@ -71,6 +93,11 @@ namespace PrL1ShL2MSI
       // Evicted cache line map
       map<IntPtr,ShL2CacheLineInfo> _evicted_cache_line_map;
 
+      // Prefetcher
+      Prefetcher* _L2_prefetcher;
+      // Prefetched lines that have not yet been accessed by a demand request
+      set<IntPtr> _prefetched_line_set;
+
       // L2 cache operations
       void getCacheLineInfo(IntPtr address, ShL2CacheLineInfo* L2_cache_line_info,
                             ShmemMsg::Type shmem_msg_type, bool update_miss_counters = false);
@@ -97,7 +124,7 @@ namespace PrL1ShL2MSI
       // Send invalidation msg to multiple tiles
       void sendInvalidationMsg(ShmemMsg::Type requester_msg_type,
                                IntPtr address, MemComponent::Type receiver_mem_component,
-                               bool all_tiles_sharers, vector<tile_id_t>& sharers_list,
+                               bool all_tiles_sharers, const BitVector& sharers_mask,
                                tile_id_t requester, bool msg_modeled);
       // Read data from L2 cache and send to L1-I/L1-D cache
       void readCacheLineAndSendToL1Cache(ShmemMsg::Type reply_msg_type,
@@ -108,12 +135,18 @@ namespace PrL1ShL2MSI
       void fetchDataFromDram(IntPtr address, tile_id_t requester, bool msg_modeled);
       void storeDataInDram(IntPtr address, const Byte* data_buf, tile_id_t requester, bool msg_modeled);
 
+      // Prefetching
+      void issuePrefetches(IntPtr address, bool cache_miss);
+      void dropPrefetchedLine(IntPtr address);
+
       // Utilities
       tile_id_t getTileID();
       UInt32 getCacheLineSize();
       ShmemPerfModel* getShmemPerfModel();
       Core::mem_op_t getMemOpTypeFromShmemMsgType(ShmemMsg::Type shmem_msg_type);
 
+      // L2 Cache Home Lookup
+      tile_id_t getL2CacheHome(IntPtr address) { return _L2_cache_home_lookup->getHome(address); }
       // Dram Home Lookup
       tile_id_t getDramHome(IntPtr address) { return _dram_home_lookup->getHome(address); }
    };
@@ -47,6 +47,9 @@ MemoryManager::MemoryManager(Tile* tile)
    UInt32 L2_cache_tags_access_cycles = 0;
    std::string L2_cache_perf_model_type;
    bool L2_cache_track_miss_types = false;
+   std::string L2_cache_prefetcher_type;
+   UInt32 L2_cache_prefetch_degree = 0;
+   UInt32 L2_cache_prefetcher_table_size = 0;
    
    // L2 Directory
    SInt32 L2_directory_max_hw_sharers = 0;
@@ -95,6 +98,9 @@ MemoryManager::MemoryManager(Tile* tile)
       L2_cache_tags_access_cycles = Sim()->getCfg()->getInt(L2_cache_type + "/tags_access_time");
       L2_cache_perf_model_type = Sim()->getCfg()->getString(L2_cache_type + "/perf_model_type");
       L2_cache_track_miss_types = Sim()->getCfg()->getBool(L2_cache_type + "/track_miss_types");
+      L2_cache_prefetcher_type = Sim()->getCfg()->getString(L2_cache_type + "/prefetcher", "none");
+      L2_cache_prefetch_degree = Sim()->getCfg()->getInt(L2_cache_type + "/prefetch_degree", 2);
+      L2_cache_prefetcher_table_size = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_table_size", 16);
 
       // Directory
       L2_directory_max_hw_sharers = Sim()->getCfg()->getInt("l2_directory/max_hw_sharers");
@@ -127,13 +133,15 @@ MemoryManager::MemoryManager(Tile* tile)
    // DRAM home lookup 
    UInt32 dram_home_lookup_param = ceilLog2(_cache_line_size);
    std::vector<tile_id_t> tile_list_with_dram_controllers = getTileListWithMemoryControllers();
-   _dram_home_lookup = new AddressHomeLookup(dram_home_lookup_param, tile_list_with_dram_controllers, getCacheLineSize());
+   _dram_home_lookup = new AddressHomeLookup(dram_home_lookup_param, tile_list_with_dram_controllers, getCacheLineSize(),
+                                             Config::getSingleton()->getPartitionDramByTarget());
    
    UInt32 L2_cache_home_lookup_param = ceilLog2(_cache_line_size);
    std::vector<tile_id_t> tile_list;
    for (tile_id_t i = 0; i < (tile_id_t) Config::getSingleton()->getApplicationTiles(); i++)
       tile_list.push_back(i);
-   _L2_cache_home_lookup = new AddressHomeLookup(L2_cache_home_lookup_param, tile_list, getCacheLineSize());
+   _L2_cache_home_lookup = new AddressHomeLookup(L2_cache_home_lookup_param, tile_list, getCacheLineSize(),
+                                                 Config::getSingleton()->getPartitionL2HomeByTarget());
 
    if (find(tile_list_with_dram_controllers.begin(), tile_list_with_dram_controllers.end(), getTile()->getId())
          != tile_list_with_dram_controllers.end())
@@ -171,6 +179,7 @@ MemoryManager::MemoryManager(Tile* tile)
    
    // Instantiate L2 cache cntlr
    _L2_cache_cntlr = new L2CacheCntlr(this,
+         _L2_cache_home_lookup,
          _dram_home_lookup,
          getCacheLineSize(),
          L2_cache_size,
@@ -180,7 +189,10 @@ MemoryManager::MemoryManager(Tile* tile)
          L2_cache_data_access_cycles,
          L2_cache_tags_access_cycles,
          L2_cache_perf_model_type,
-         L2_cache_track_miss_types);
+         L2_cache_track_miss_types,
+         L2_cache_prefetcher_type,
+         L2_cache_prefetch_degree,
+         L2_cache_prefetcher_table_size);
 }
 
 MemoryManager::~MemoryManager()
@@ -304,11 +316,17 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
              shmem_msg.getRequester(), getTile()->getId(), receiver,
              shmem_msg.isModeled() ? "TRUE" : "FALSE");
 
+   // Forwarded coherence requests mean the requester shares the line with the receiver
+   if ((shmem_msg.getSenderMemComponent() == MemComponent::L2_CACHE) && (shmem_msg.getReceiverMemComponent() != MemComponent::DRAM_CNTLR))
+      recordSharing(shmem_msg.getRequester(), receiver);
+
    NetPacket packet(msg_time, SHARED_MEM,
                     getTile()->getId(), receiver,
                     shmem_msg.getMsgLen(), (const void*) msg_buf);
 
-   if ((getTile()->getId() == receiver) || (shmem_msg.getSenderMemComponent() == MemComponent::DRAM_CNTLR))
+   if (getTile()->getId() == receiver)
+      sendMsgToSelf(packet);
+   else if (shmem_msg.getSenderMemComponent() == MemComponent::DRAM_CNTLR)
       getNetwork()->netSend(packet);
    else
       getNetwork()->netSend(DVFSManager::convertToModule(shmem_msg.getSenderMemComponent()), packet);
@@ -339,6 +357,36 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
    getNetwork()->netSend(packet);
 }
 
+void
+MemoryManager::multicastMsg(const BitVector& receivers, ShmemMsg& shmem_msg)
+{
+   assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
+
+   // Package into msg buffer
+   Byte msg_buf[shmem_msg.getMsgLen()];
+   shmem_msg.makeMsgBuf(msg_buf);
+
+   Time msg_time = getShmemPerfModel()->getCurrTime();
+
+   LOG_PRINT("Time(%llu), Multicasting Msg: type(%u), address(%#lx), "
+             "sender_mem_component(%u), receiver_mem_component(%u), "
+             "requester(%i), sender(%i), modeled(%s)",
+             msg_time.toNanosec(), shmem_msg.getType(), shmem_msg.getAddress(),
+             shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent(),
+             shmem_msg.getRequester(), getTile()->getId(),
+             shmem_msg.isModeled() ? "TRUE" : "FALSE");
+
+   NetPacket packet(msg_time, SHARED_MEM,
+                    getTile()->getId(), NetPacket::BROADCAST,
+                    shmem_msg.getMsgLen(), (const void*) msg_buf);
+
+   // Forwarded coherence requests mean the requester shares the line with the receiver
+   if ((shmem_msg.getSenderMemComponent() == MemComponent::L2_CACHE) && (shmem_msg.getReceiverMemComponent() != MemComponent::DRAM_CNTLR))
+      recordSharing(shmem_msg.getRequester(), receivers);
+
+   getNetwork()->netMulticast(DVFSManager::convertToModule(shmem_msg.getSenderMemComponent()), packet, receivers);
+}
+
 void
 MemoryManager::incrCurrTime(MemComponent::Type mem_component, CachePerfModel::AccessType access_type)
 {
@@ -407,6 +455,10 @@ MemoryManager::outputSummary(std::ostream &os, const Time& target_completion_tim
    _L1_cache_cntlr->getL1ICache()->outputSummary(os, target_completion_time);
    _L1_cache_cntlr->getL1DCache()->outputSummary(os, target_completion_time);
    _L2_cache_cntlr->getL2Cache()->outputSummary(os, target_completion_time);
+   if (_L2_cache_cntlr->getL2Prefetcher())
+      _L2_cache_cntlr->getL2Prefetcher()->outputSummary(os);
+   else
+      Prefetcher::dummyOutputSummary(os);
 
    if (_dram_cntlr_present)
    {
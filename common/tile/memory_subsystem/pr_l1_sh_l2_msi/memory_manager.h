@@ -36,6 +36,7 @@ namespace PrL1ShL2MSI
       
       void sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg);
       void broadcastMsg(ShmemMsg& shmem_msg);
+      void multicastMsg(const BitVector& receivers, ShmemMsg& shmem_msg);
     
       void enableModels();
       void disableModels();
@@ -46,6 +47,8 @@ namespace PrL1ShL2MSI
       { return  ((ShmemMsg*) pkt_data)->isModeled(); }
       tile_id_t getShmemRequester(const void* pkt_data)
       { return ((ShmemMsg*) pkt_data)->getRequester(); }
+      IntPtr getShmemAddress(const void* pkt_data)
+      { return ((ShmemMsg*) pkt_data)->getAddress(); }
 
       void outputSummary(std::ostream &os, const Time& target_completion_time);
 
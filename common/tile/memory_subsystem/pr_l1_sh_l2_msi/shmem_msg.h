@@ -31,7 +31,9 @@ public:
       DRAM_FETCH_REP,
       // Nullify req
       NULLIFY_REQ,
-      MAX_MSG_TYPE = NULLIFY_REQ,
+      // Prefetch req (internal to the L2 cache)
+      PREFETCH_REQ,
+      MAX_MSG_TYPE = PREFETCH_REQ,
       NUM_MSG_TYPES = MAX_MSG_TYPE - MIN_MSG_TYPE + 1
    }; 
 
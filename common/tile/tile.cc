@@ -7,6 +7,8 @@
 #include "memory_manager.h"
 #include "dvfs_manager.h"
 #include "remote_query_helper.h"
+#include "sync_server.h"
+#include "sync_home_lookup.h"
 #include "main_core.h"
 #include "simulator.h"
 #include "log.h"
@@ -16,6 +18,7 @@ Tile::Tile(tile_id_t id)
    : _id(id)
    , _memory_manager(NULL)
    , _tile_energy_monitor(NULL)
+   , _sync_server(NULL)
 {
    LOG_PRINT("Tile ctor for (%i)", _id);
 
@@ -34,10 +37,17 @@ Tile::Tile(tile_id_t id)
 
    // Create Remote Query helper
    _remote_query_helper = new RemoteQueryHelper(this);   
+
+   // Create the home of the synchronization objects (only with the distributed sync server)
+   SyncHomeLookup sync_home_lookup;
+   if (sync_home_lookup.isDistributed() && (sync_home_lookup.getHomeIdx(_id) >= 0))
+      _sync_server = new SyncServer(this);
 }
 
 Tile::~Tile()
 {
+   if (_sync_server)
+      delete _sync_server;
    delete _remote_query_helper;
    delete _dvfs_manager;
    if (_memory_manager)
@@ -11,6 +11,7 @@ class MemoryManager;
 class TileEnergyMonitor;
 class RemoteQueryHelper;
 class DVFSManager;
+class SyncServer;
 
 #include "fixed_types.h"
 #include "common_types.h"
@@ -31,6 +32,7 @@ public:
    DVFSManager* getDVFSManager()       { return _dvfs_manager; }
    TileEnergyMonitor* getTileEnergyMonitor()       { return _tile_energy_monitor; }
    RemoteQueryHelper* getRemoteQueryHelper()       { return _remote_query_helper; }
+   SyncServer* getSyncServer()         { return _sync_server; }
 
    Time getCoreTime(tile_id_t tile_id) const;
 
@@ -48,6 +50,7 @@ private:
    DVFSManager* _dvfs_manager;
    TileEnergyMonitor* _tile_energy_monitor;
    RemoteQueryHelper* _remote_query_helper;
+   SyncServer* _sync_server;
 
    Time getTargetCompletionTime();
 };
@@ -1,9 +1,12 @@
+#include <cstring>
+#include <vector>
 #include "simulator.h"
 #include "tile_manager.h"
 #include "config.h"
 #include "tile.h"
 #include "core.h"
 #include "carbon_user.h"
+#include "bit_vector.h"
 #include "log.h"
 
 CAPI_return_t CAPI_rank(int *tile_id)
@@ -111,3 +114,262 @@ CAPI_return_t CAPI_message_receive_w_ex(CAPI_endpoint_t sender,
 
    return core ? core->coreRecvW(sending_tile, receiving_tile, buffer, size, net_type) : CAPI_ReceiverNotInitialized;
 }
+
+CAPI_return_t CAPI_message_isend(CAPI_endpoint_t sender,
+      CAPI_endpoint_t receiver,
+      char *buffer,
+      int size,
+      CAPI_request_t *request)
+{
+   LOG_PRINT("SimISend - sender: %d, recv: %d, size: %d", sender, receiver, size);
+
+   request->is_receive = 0;
+   request->send_endpoint = sender;
+   request->receive_endpoint = receiver;
+   request->buffer = buffer;
+   request->size = size;
+   request->net_type = CARBON_NET_USER;
+
+   // The message is copied into the network right away
+   CAPI_return_t ret = CAPI_message_send_w(sender, receiver, buffer, size);
+   request->completed = 1;
+   return ret;
+}
+
+CAPI_return_t CAPI_message_irecv(CAPI_endpoint_t sender,
+      CAPI_endpoint_t receiver,
+      char *buffer,
+      int size,
+      CAPI_request_t *request)
+{
+   LOG_PRINT("SimIRecv - sender: %d, recv: %d, size: %d", sender, receiver, size);
+
+   tile_id_t sending_tile = CAPI_ENDPOINT_ANY;
+   if (sender != CAPI_ENDPOINT_ANY)
+      sending_tile = Config::getSingleton()->getTileFromCommId(sender);
+   tile_id_t receiving_tile = Config::getSingleton()->getTileFromCommId(receiver);
+
+   if(sending_tile == INVALID_TILE_ID)
+       return CAPI_SenderNotInitialized;
+   if(receiving_tile == INVALID_TILE_ID)
+       return CAPI_ReceiverNotInitialized;
+
+   request->is_receive = 1;
+   request->send_endpoint = sender;
+   request->receive_endpoint = receiver;
+   request->buffer = buffer;
+   request->size = size;
+   request->net_type = CARBON_NET_USER;
+   request->completed = 0;
+   return CAPI_StatusOk;
+}
+
+CAPI_return_t CAPI_message_wait(CAPI_request_t *request)
+{
+   if (request->completed)
+      return CAPI_StatusOk;
+
+   // The core is only charged for the time from now till the message arrives
+   CAPI_return_t ret = CAPI_message_receive_w_ex(request->send_endpoint, request->receive_endpoint,
+                                                 request->buffer, request->size, request->net_type);
+   request->completed = 1;
+   return ret;
+}
+
+CAPI_return_t CAPI_message_test(CAPI_request_t *request, int *completed)
+{
+   if (!request->completed)
+   {
+      Core *core = Sim()->getTileManager()->getCurrentCore();
+      if (!core)
+         return CAPI_ReceiverNotInitialized;
+
+      tile_id_t sending_tile = CAPI_ENDPOINT_ANY;
+      if (request->send_endpoint != CAPI_ENDPOINT_ANY)
+         sending_tile = Config::getSingleton()->getTileFromCommId(request->send_endpoint);
+      tile_id_t receiving_tile = Config::getSingleton()->getTileFromCommId(request->receive_endpoint);
+
+      // The message has arrived, so receiving it does not stall the core
+      if (core->coreTestRecv(sending_tile, receiving_tile, request->net_type))
+      {
+         CAPI_return_t ret = CAPI_message_wait(request);
+         if (ret != CAPI_StatusOk)
+            return ret;
+      }
+   }
+
+   *completed = request->completed;
+   return CAPI_StatusOk;
+}
+
+// -- Collectives -- //
+
+static tile_id_t getCollectiveTile(CAPI_endpoint_t endpoint, int num_endpoints)
+{
+   if ((endpoint < 0) || (endpoint >= num_endpoints))
+      return INVALID_TILE_ID;
+   return Config::getSingleton()->getTileFromCommId(endpoint);
+}
+
+static int getDatatypeSize(CAPI_datatype_t datatype)
+{
+   switch (datatype)
+   {
+   case CAPI_INT:
+      return sizeof(int);
+   case CAPI_LONG:
+      return sizeof(long);
+   case CAPI_FLOAT:
+      return sizeof(float);
+   case CAPI_DOUBLE:
+      return sizeof(double);
+   default:
+      return 0;
+   }
+}
+
+template <class T>
+static void reduceTyped(T* accumulator, const T* operand, int count, CAPI_reduce_op_t op)
+{
+   for (int i = 0; i < count; i++)
+   {
+      switch (op)
+      {
+      case CAPI_SUM:
+         accumulator[i] += operand[i];
+         break;
+      case CAPI_PROD:
+         accumulator[i] *= operand[i];
+         break;
+      case CAPI_MIN:
+         accumulator[i] = (operand[i] < accumulator[i]) ? operand[i] : accumulator[i];
+         break;
+      case CAPI_MAX:
+         accumulator[i] = (operand[i] > accumulator[i]) ? operand[i] : accumulator[i];
+         break;
+      default:
+         LOG_PRINT_ERROR("Unrecognized reduce op(%i)", op);
+         break;
+      }
+   }
+}
+
+static void reduceInto(char* accumulator, const char* operand, int count, CAPI_datatype_t datatype, CAPI_reduce_op_t op)
+{
+   switch (datatype)
+   {
+   case CAPI_INT:
+      reduceTyped((int*) accumulator, (const int*) operand, count, op);
+      break;
+   case CAPI_LONG:
+      reduceTyped((long*) accumulator, (const long*) operand, count, op);
+      break;
+   case CAPI_FLOAT:
+      reduceTyped((float*) accumulator, (const float*) operand, count, op);
+      break;
+   case CAPI_DOUBLE:
+      reduceTyped((double*) accumulator, (const double*) operand, count, op);
+      break;
+   default:
+      LOG_PRINT_ERROR("Unrecognized datatype(%i)", datatype);
+      break;
+   }
+}
+
+CAPI_return_t CAPI_broadcast(CAPI_endpoint_t root,
+      CAPI_endpoint_t endpoint,
+      int num_endpoints,
+      char *buffer,
+      int size)
+{
+   Core *core = Sim()->getTileManager()->getCurrentCore();
+
+   LOG_PRINT("SimBroadcast - root: %d, endpoint: %d, num_endpoints: %d, size: %d", root, endpoint, num_endpoints, size);
+
+   tile_id_t root_tile = getCollectiveTile(root, num_endpoints);
+   tile_id_t tile = getCollectiveTile(endpoint, num_endpoints);
+   if ((root_tile == INVALID_TILE_ID) || (tile == INVALID_TILE_ID))
+      return CAPI_InvalidArgument;
+   if (!core)
+      return CAPI_SenderNotInitialized;
+
+   if (endpoint != root)
+      return core->coreRecvW(root_tile, tile, buffer, size, CARBON_NET_COLLECTIVE);
+
+   // A single multicast from the root, the network model fans it out
+   BitVector receivers(Config::getSingleton()->getTotalTiles());
+   for (CAPI_endpoint_t e = 0; e < num_endpoints; e++)
+   {
+      tile_id_t receiver_tile = getCollectiveTile(e, num_endpoints);
+      if (receiver_tile == INVALID_TILE_ID)
+         return CAPI_ReceiverNotInitialized;
+      if (e != root)
+         receivers.set(receiver_tile);
+   }
+   if (receivers.size() == 0)
+      return CAPI_StatusOk;
+   return core->coreMulticastW(root_tile, receivers, buffer, size, CARBON_NET_COLLECTIVE);
+}
+
+CAPI_return_t CAPI_reduce(CAPI_endpoint_t root,
+      CAPI_endpoint_t endpoint,
+      int num_endpoints,
+      char *send_buffer,
+      char *receive_buffer,
+      int count,
+      CAPI_datatype_t datatype,
+      CAPI_reduce_op_t op)
+{
+   Core *core = Sim()->getTileManager()->getCurrentCore();
+
+   LOG_PRINT("SimReduce - root: %d, endpoint: %d, num_endpoints: %d, count: %d", root, endpoint, num_endpoints, count);
+
+   int size = count * getDatatypeSize(datatype);
+   tile_id_t tile = getCollectiveTile(endpoint, num_endpoints);
+   if ((getCollectiveTile(root, num_endpoints) == INVALID_TILE_ID) || (tile == INVALID_TILE_ID) || (size <= 0))
+      return CAPI_InvalidArgument;
+   if (!core)
+      return CAPI_SenderNotInitialized;
+
+   // Binomial tree rooted at 'root': log2(num_endpoints) steps instead of
+   // num_endpoints-1 messages serialized at the root
+   std::vector<char> accumulator(send_buffer, send_buffer + size);
+   std::vector<char> operand(size);
+   CAPI_endpoint_t relative = (endpoint - root + num_endpoints) % num_endpoints;
+
+   for (int mask = 1; mask < num_endpoints; mask <<= 1)
+   {
+      if (relative & mask)
+      {
+         // Pass the partial result up the tree and leave
+         tile_id_t parent_tile = getCollectiveTile((relative - mask + root) % num_endpoints, num_endpoints);
+         return core->coreSendW(tile, parent_tile, &accumulator[0], size, CARBON_NET_COLLECTIVE);
+      }
+      if ((relative + mask) < num_endpoints)
+      {
+         tile_id_t child_tile = getCollectiveTile((relative + mask + root) % num_endpoints, num_endpoints);
+         CAPI_return_t ret = core->coreRecvW(child_tile, tile, &operand[0], size, CARBON_NET_COLLECTIVE);
+         if (ret != CAPI_StatusOk)
+            return ret;
+         reduceInto(&accumulator[0], &operand[0], count, datatype, op);
+      }
+   }
+
+   // Only the root gets here
+   memcpy(receive_buffer, &accumulator[0], size);
+   return CAPI_StatusOk;
+}
+
+CAPI_return_t CAPI_allreduce(CAPI_endpoint_t endpoint,
+      int num_endpoints,
+      char *send_buffer,
+      char *receive_buffer,
+      int count,
+      CAPI_datatype_t datatype,
+      CAPI_reduce_op_t op)
+{
+   CAPI_return_t ret = CAPI_reduce(0, endpoint, num_endpoints, send_buffer, receive_buffer, count, datatype, op);
+   if (ret != CAPI_StatusOk)
+      return ret;
+   return CAPI_broadcast(0, endpoint, num_endpoints, receive_buffer, count * getDatatypeSize(datatype));
+}
@@ -9,12 +9,40 @@ extern "C" {
 #define CAPI_ENDPOINT_ANY ((SInt32) 0x20000000)
 
 typedef enum {
-   CARBON_NET_USER = 0
+   CARBON_NET_USER = 0,
+   // Used by the collective operations, so they never match point-to-point messages
+   CARBON_NET_COLLECTIVE
 } carbon_network_t;
 
 typedef int CAPI_return_t;
 typedef int CAPI_endpoint_t;
 
+// State of a non-blocking send/receive. It lives in user memory and must stay
+// valid till CAPI_message_wait() returns or CAPI_message_test() reports completion.
+typedef struct {
+   int is_receive;
+   CAPI_endpoint_t send_endpoint;
+   CAPI_endpoint_t receive_endpoint;
+   char *buffer;
+   int size;
+   carbon_network_t net_type;
+   int completed;
+} CAPI_request_t;
+
+typedef enum {
+   CAPI_INT = 0,
+   CAPI_LONG,
+   CAPI_FLOAT,
+   CAPI_DOUBLE
+} CAPI_datatype_t;
+
+typedef enum {
+   CAPI_SUM = 0,
+   CAPI_PROD,
+   CAPI_MIN,
+   CAPI_MAX
+} CAPI_reduce_op_t;
+
 CAPI_return_t CAPI_Initialize(int rank);
 CAPI_return_t CAPI_rank(int *rank);
 CAPI_return_t CAPI_message_send_w(CAPI_endpoint_t send_endpoint, CAPI_endpoint_t receive_endpoint, char * buffer, int size);
@@ -23,10 +51,28 @@ CAPI_return_t CAPI_message_receive_w(CAPI_endpoint_t send_endpoint, CAPI_endpoin
 CAPI_return_t CAPI_message_send_w_ex(CAPI_endpoint_t send_endpoint, CAPI_endpoint_t receive_endpoint, char * buffer, int size, carbon_network_t net_type);
 CAPI_return_t CAPI_message_receive_w_ex(CAPI_endpoint_t send_endpoint, CAPI_endpoint_t receive_endpoint, char * buffer, int size, carbon_network_t net_type);
 
+// Non-blocking operations
+// A send never waits, so CAPI_message_isend() completes immediately and the buffer can be reused.
+// A receive completes in CAPI_message_wait(), which only waits for the part of the message
+// latency that was not overlapped with the computation done since CAPI_message_irecv().
+CAPI_return_t CAPI_message_isend(CAPI_endpoint_t send_endpoint, CAPI_endpoint_t receive_endpoint, char * buffer, int size, CAPI_request_t * request);
+CAPI_return_t CAPI_message_irecv(CAPI_endpoint_t send_endpoint, CAPI_endpoint_t receive_endpoint, char * buffer, int size, CAPI_request_t * request);
+CAPI_return_t CAPI_message_wait(CAPI_request_t * request);
+CAPI_return_t CAPI_message_test(CAPI_request_t * request, int * completed);
+
+// Collective operations over the endpoints [0, num_endpoints)
+// Every endpoint calls them in the same order, passing its own endpoint.
+CAPI_return_t CAPI_broadcast(CAPI_endpoint_t root, CAPI_endpoint_t endpoint, int num_endpoints, char * buffer, int size);
+CAPI_return_t CAPI_reduce(CAPI_endpoint_t root, CAPI_endpoint_t endpoint, int num_endpoints,
+                          char * send_buffer, char * receive_buffer, int count, CAPI_datatype_t datatype, CAPI_reduce_op_t op);
+CAPI_return_t CAPI_allreduce(CAPI_endpoint_t endpoint, int num_endpoints,
+                             char * send_buffer, char * receive_buffer, int count, CAPI_datatype_t datatype, CAPI_reduce_op_t op);
+
 enum {
    CAPI_StatusOk,
    CAPI_SenderNotInitialized,
-   CAPI_ReceiverNotInitialized
+   CAPI_ReceiverNotInitialized,
+   CAPI_InvalidArgument
 };
 
 #ifdef __cplusplus
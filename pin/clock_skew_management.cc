@@ -4,6 +4,7 @@
 #include "tile.h"
 #include "core.h"
 #include "clock_skew_management_object.h"
+#include "target_pacing_client.h"
 #include "hash_map.h"
 
 extern HashMap core_map;
@@ -11,7 +12,7 @@ extern HashMap core_map;
 static bool enabled()
 {
    std::string scheme = Sim()->getCfg()->getString("clock_skew_management/scheme", "lax");
-   return (scheme != "lax");
+   return (scheme != "lax") || TargetPacingClient::isEnabled();
 }
 
 void handlePeriodicSync(THREADID thread_id)
@@ -28,6 +29,10 @@ void handlePeriodicSync(THREADID thread_id)
    ClockSkewManagementClient *client = core->getClockSkewManagementClient();
    if (client)
       client->synchronize();
+
+   TargetPacingClient *target_pacing_client = Sim()->getTargetPacingClient();
+   if (target_pacing_client)
+      target_pacing_client->synchronize(core);
 }
 
 void addPeriodicSync(INS ins)
@@ -0,0 +1,619 @@
+// Times the data structures on the hot paths of the simulator in isolation, without Pin:
+// the caches and their replacement policies, the directory cache, the queue models, the
+// router model, the matching done by Network::netRecv, UnstructuredBuffer marshalling and
+// the allocators.
+// Every benchmark does its set-up first, then times a loop of operations on the main thread.
+// Reports the host time per operation (ns/op) and the calls to operator new made by the
+// main thread per operation (allocations/op), to give performance changes a baseline.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <fstream>
+#include <sstream>
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "core.h"
+#include "core_model.h"
+#include "network.h"
+#include "network_model.h"
+#include "router_model.h"
+#include "queue_model.h"
+#include "cache.h"
+#include "cache_line_info.h"
+#include "cache_replacement_policy.h"
+#include "cache_hash_fn.h"
+#include "directory_cache.h"
+#include "pr_l1_pr_l2_dram_directory_msi/cache_level.h"
+#include "packetize.h"
+#include "fsb_allocator.h"
+#include "heap_allocator.h"
+#include "carbon_user.h"
+#include "random.h"
+#include "log.h"
+
+// Calls to operator new made by each host thread
+static __thread UInt64 _num_allocations = 0;
+
+void* operator new(size_t sz)
+{
+   _num_allocations ++;
+   void* ptr = malloc((sz > 0) ? sz : 1);
+   if (ptr == NULL)
+      throw std::bad_alloc();
+   return ptr;
+}
+
+void* operator new[](size_t sz)
+{
+   return operator new(sz);
+}
+
+void operator delete(void* ptr) throw()
+{
+   free(ptr);
+}
+
+void operator delete[](void* ptr) throw()
+{
+   free(ptr);
+}
+
+class Measurement
+{
+public:
+   Measurement(string name, UInt64 num_ops)
+      : _name(name), _num_ops(num_ops), _start_allocations(_num_allocations), _start_time(getHostTime()) {}
+
+   void stop();
+
+private:
+   string _name;
+   UInt64 _num_ops;
+   UInt64 _start_allocations;
+   UInt64 _start_time;
+
+   static UInt64 getHostTime();
+};
+
+void benchmarkCache(UInt64 num_ops);
+void benchmarkReplacementPolicies(UInt64 num_ops);
+void benchmarkDirectoryCache(UInt64 num_ops);
+void benchmarkQueueModels(UInt64 num_ops);
+void benchmarkRouterModel(UInt64 num_ops);
+void benchmarkNetRecv(UInt64 num_ops);
+void benchmarkUnstructuredBuffer(UInt64 num_ops);
+void benchmarkAllocators(UInt64 num_ops);
+bool isSelected(string name);
+void printHelpMessage();
+
+UInt64 _num_ops = 1000000;             // Operations timed by each benchmark
+string _filter;                        // Only run the benchmarks whose name contains this string
+long int _seed = 1;
+
+std::ofstream _output_file;
+// Keeps the compiler from optimizing away the results of the timed operations
+volatile UInt64 _sink = 0;
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   // The network and router models only count packets when enabled
+   CarbonEnableModels();
+
+   // Read Command Line Arguments
+   for (SInt32 i = 1; i < argc-1; i += 2)
+   {
+      if (string(argv[i]) == "-n")
+         _num_ops = (UInt64) atoll(argv[i+1]);
+      else if (string(argv[i]) == "-f")
+         _filter = string(argv[i+1]);
+      else if (string(argv[i]) == "-r")
+         _seed = atol(argv[i+1]);
+      else if (string(argv[i]) == "-c") // Simulator arguments
+         break;
+      else if (string(argv[i]) == "-h")
+      {
+         printHelpMessage();
+         exit(0);
+      }
+      else
+      {
+         fprintf(stderr, "** ERROR **\n");
+         printHelpMessage();
+         exit(-1);
+      }
+   }
+   LOG_ASSERT_ERROR(_num_ops > 0, "Number of Operations(%llu) must be > 0", _num_ops);
+
+   _output_file.open(Config::getSingleton()->formatOutputFileName("component_microbenchmarks.out").c_str());
+   std::ostringstream header;
+   header << "# Benchmark, Host Time per Operation (in nanoseconds), Allocations per Operation, Operations" << endl;
+   std::cout << header.str();
+   _output_file << header.str();
+
+   benchmarkCache(_num_ops);
+   benchmarkReplacementPolicies(_num_ops);
+   benchmarkDirectoryCache(_num_ops);
+   benchmarkQueueModels(_num_ops);
+   benchmarkRouterModel(_num_ops);
+   // A netRecv goes through the transport and the sim thread, so fewer are timed
+   benchmarkNetRecv(std::max<UInt64>(_num_ops / 100, 1));
+   benchmarkUnstructuredBuffer(_num_ops);
+   benchmarkAllocators(_num_ops);
+
+   _output_file.close();
+
+   CarbonDisableModels();
+
+   CarbonStopSim();
+
+   return 0;
+}
+
+void printHelpMessage()
+{
+   fprintf(stderr, "[Usage]: ./component_microbenchmarks -n <arg1> -f <arg2> -r <arg3>\n");
+   fprintf(stderr, "where <arg1> = Number of Operations timed by each Benchmark (default 1000000, netRecv times 1/100 of them)\n");
+   fprintf(stderr, " and  <arg2> = Only run the Benchmarks whose name contains this string (default all)\n");
+   fprintf(stderr, " and  <arg3> = Random seed (default 1)\n");
+}
+
+bool isSelected(string name)
+{
+   return (_filter == "") || (name.find(_filter) != string::npos);
+}
+
+void Measurement::stop()
+{
+   UInt64 host_time = getHostTime() - _start_time;
+   UInt64 num_allocations = _num_allocations - _start_allocations;
+
+   std::ostringstream row;
+   row << _name << ", " << ((double) host_time) / _num_ops << ", "
+       << ((double) num_allocations) / _num_ops << ", " << _num_ops << endl;
+   std::cout << row.str();
+   _output_file << row.str();
+}
+
+UInt64 Measurement::getHostTime()
+{
+   timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (((UInt64) t.tv_sec) * 1000000000 + t.tv_nsec);
+}
+
+// Cache::getCacheLineInfo() (hits and misses) and Cache::insertCacheLine() on a 256 KB,
+// 8-way L2 cache with 64 byte lines and LRU replacement
+void benchmarkCache(UInt64 num_ops)
+{
+   if (!isSelected("Cache::"))
+      return;
+
+   const UInt32 cache_size = 256;   // In KB
+   const UInt32 associativity = 8;
+   const UInt32 line_size = 64;
+   const UInt32 num_lines = cache_size * k_KILO / line_size;
+   const CachingProtocol::Type caching_protocol = CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI;
+   const SInt32 cache_level = PrL1PrL2DramDirectoryMSI::L2;
+
+   CacheReplacementPolicy* replacement_policy = CacheReplacementPolicy::create("lru", cache_size, associativity, line_size);
+   CacheHashFn* hash_fn = new CacheHashFn(cache_size, associativity, line_size);
+   Cache* cache = new Cache("L2", caching_protocol, Cache::UNIFIED_CACHE, cache_level, Cache::WRITE_BACK,
+                            cache_size, associativity, line_size, 1,
+                            replacement_policy, hash_fn, 8, 2, "parallel", false);
+
+   CacheLineInfo* inserted_cache_line_info = CacheLineInfo::create(caching_protocol, cache_level);
+   CacheLineInfo* evicted_cache_line_info = CacheLineInfo::create(caching_protocol, cache_level);
+   CacheLineInfo* cache_line_info = CacheLineInfo::create(caching_protocol, cache_level);
+   bool eviction;
+   IntPtr evicted_address;
+
+   // Streams through twice the capacity of the cache, so that insertions evict a line once it is full
+   {
+      Measurement measurement("Cache::insertCacheLine", num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         IntPtr address = (i % (2 * num_lines)) * line_size;
+         inserted_cache_line_info->setTag(cache->getTag(address));
+         inserted_cache_line_info->setCState(CacheState::SHARED);
+         cache->insertCacheLine(address, inserted_cache_line_info, NULL,
+                                &eviction, &evicted_address, evicted_cache_line_info, NULL);
+         _sink += eviction;
+      }
+      measurement.stop();
+   }
+
+   // Fill the cache with the lines [0, num_lines)
+   for (UInt32 i = 0; i < num_lines; i++)
+   {
+      IntPtr address = i * line_size;
+      cache_line_info->invalidate();
+      cache->getCacheLineInfo(address, cache_line_info);
+      if (!cache_line_info->isValid())
+      {
+         inserted_cache_line_info->setTag(cache->getTag(address));
+         inserted_cache_line_info->setCState(CacheState::SHARED);
+         cache->insertCacheLine(address, inserted_cache_line_info, NULL,
+                                &eviction, &evicted_address, evicted_cache_line_info, NULL);
+      }
+   }
+
+   {
+      Measurement measurement("Cache::getCacheLineInfo (hit)", num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         cache->getCacheLineInfo((i % num_lines) * line_size, cache_line_info);
+         _sink += cache_line_info->getCState();
+      }
+      measurement.stop();
+   }
+
+   {
+      Measurement measurement("Cache::getCacheLineInfo (miss)", num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         cache_line_info->invalidate();
+         cache->getCacheLineInfo((num_lines + (i % num_lines)) * line_size, cache_line_info);
+         _sink += cache_line_info->isValid();
+      }
+      measurement.stop();
+   }
+
+   delete cache_line_info;
+   delete evicted_cache_line_info;
+   delete inserted_cache_line_info;
+   delete cache;
+   delete hash_fn;
+   delete replacement_policy;
+}
+
+// getReplacementWay() followed by update() of the chosen way, on the sets of a 256 KB,
+// 16-way cache, for every replacement policy. A random way is accessed in between.
+void benchmarkReplacementPolicies(UInt64 num_ops)
+{
+   const UInt32 cache_size = 256;   // In KB
+   const UInt32 associativity = 16;
+   const UInt32 line_size = 64;
+   const UInt32 num_sets = cache_size * k_KILO / (associativity * line_size);
+   const CachingProtocol::Type caching_protocol = CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI;
+   const SInt32 cache_level = PrL1PrL2DramDirectoryMSI::L2;
+
+   const char* policy_list[] = {"round_robin", "lru", "tree_plru", "srrip", "brrip", "dip"};
+   const UInt32 num_policies = sizeof(policy_list) / sizeof(policy_list[0]);
+
+   // Ways accessed between two replacements
+   const UInt32 num_random_ways = 4096;
+   Random<UInt32> random;
+   random.seed(_seed);
+   vector<UInt32> random_way_list(num_random_ways);
+   for (UInt32 i = 0; i < num_random_ways; i++)
+      random_way_list[i] = random.next(associativity);
+
+   for (UInt32 p = 0; p < num_policies; p++)
+   {
+      string name = string("CacheReplacementPolicy (") + policy_list[p] + ")";
+      if (!isSelected(name))
+         continue;
+
+      CacheReplacementPolicy* replacement_policy =
+         CacheReplacementPolicy::create(policy_list[p], cache_size, associativity, line_size);
+
+      // All the lines are valid, so that every replacement has to choose a victim
+      vector<CacheLineInfo**> set_list(num_sets);
+      for (UInt32 s = 0; s < num_sets; s++)
+      {
+         set_list[s] = new CacheLineInfo*[associativity];
+         for (UInt32 w = 0; w < associativity; w++)
+         {
+            set_list[s][w] = CacheLineInfo::create(caching_protocol, cache_level);
+            set_list[s][w]->setTag(s * associativity + w);
+            set_list[s][w]->setCState(CacheState::SHARED);
+         }
+      }
+
+      Measurement measurement(name, num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         UInt32 set_num = (UInt32) (i % num_sets);
+         UInt32 way = replacement_policy->getReplacementWay(set_list[set_num], set_num);
+         replacement_policy->insert(set_list[set_num], set_num, way);
+         replacement_policy->update(set_list[set_num], set_num, random_way_list[i % num_random_ways]);
+         _sink += way;
+      }
+      measurement.stop();
+
+      for (UInt32 s = 0; s < num_sets; s++)
+      {
+         for (UInt32 w = 0; w < associativity; w++)
+            delete set_list[s][w];
+         delete [] set_list[s];
+      }
+      delete replacement_policy;
+   }
+}
+
+// DirectoryCache::getDirectoryEntry() on the entries already allocated (the common case)
+// in a 16K-entry, 16-way full-map directory
+void benchmarkDirectoryCache(UInt64 num_ops)
+{
+   if (!isSelected("DirectoryCache::getDirectoryEntry"))
+      return;
+
+   const UInt32 line_size = 64;
+   const UInt32 num_lines = 4096;
+   Tile* tile = Sim()->getTileManager()->getCurrentCore()->getTile();
+   UInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
+
+   DirectoryCache* directory_cache = new DirectoryCache(tile, CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI,
+                                                        "full_map", "16384", 16, line_size,
+                                                        num_application_tiles, num_application_tiles, 1, "auto");
+   for (UInt32 i = 0; i < num_lines; i++)
+   {
+      __attribute__((unused)) DirectoryEntry* directory_entry = directory_cache->getDirectoryEntry(i * line_size);
+      LOG_ASSERT_ERROR(directory_entry, "Could not allocate the directory entry of Address(%#lx)", i * line_size);
+   }
+
+   Measurement measurement("DirectoryCache::getDirectoryEntry", num_ops);
+   for (UInt64 i = 0; i < num_ops; i++)
+   {
+      DirectoryEntry* directory_entry = directory_cache->getDirectoryEntry((i % num_lines) * line_size);
+      _sink += (UInt64) directory_entry;
+   }
+   measurement.stop();
+
+   delete directory_cache;
+}
+
+// QueueModel::computeQueueDelay() for every queue model type, with random inter-arrival
+// times (the queue is about 50% utilized) and a few late (out of order) packets
+void benchmarkQueueModels(UInt64 num_ops)
+{
+   const char* model_type_list[] = {"basic", "history_list", "history_tree"};
+   const UInt32 num_model_types = sizeof(model_type_list) / sizeof(model_type_list[0]);
+   const UInt64 processing_time = 4;
+
+   const UInt32 num_packets = 4096;
+   Random<UInt64> random;
+   random.seed(_seed);
+   vector<UInt64> inter_arrival_time_list(num_packets);
+   vector<UInt64> lateness_list(num_packets);
+   for (UInt32 i = 0; i < num_packets; i++)
+   {
+      inter_arrival_time_list[i] = random.next(4 * processing_time);
+      lateness_list[i] = (random.next(8) == 0) ? random.next(32) : 0;
+   }
+
+   for (UInt32 m = 0; m < num_model_types; m++)
+   {
+      string name = string("QueueModel::computeQueueDelay (") + model_type_list[m] + ")";
+      if (!isSelected(name))
+         continue;
+
+      QueueModel* queue_model = QueueModel::create(model_type_list[m], processing_time);
+
+      UInt64 pkt_time = 1000;
+      Measurement measurement(name, num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         pkt_time += inter_arrival_time_list[i % num_packets];
+         _sink += queue_model->computeQueueDelay(pkt_time - lateness_list[i % num_packets], processing_time);
+      }
+      measurement.stop();
+
+      delete queue_model;
+   }
+}
+
+// RouterModel::processPacket() on a 5-port router (of the user network model of this tile),
+// with the queue model based contention model and with credit-based flow control
+void benchmarkRouterModel(UInt64 num_ops)
+{
+   const SInt32 num_ports = 5;
+   const SInt32 num_flits_per_port_buffer = 4;
+   const UInt64 router_delay = 1;
+   string contention_model_type = "history_tree";
+
+   NetworkModel* network_model = Sim()->getTileManager()->getCurrentCore()->getTile()->getNetwork()->
+                                 getNetworkModel(STATIC_NETWORK_USER);
+   double frequency = network_model->getFrequency();
+   Latency cycle_time(1, frequency);
+
+   const UInt32 num_packets = 4096;
+   Random<SInt32> random;
+   random.seed(_seed);
+   vector<SInt32> output_port_list(num_packets);
+   for (UInt32 i = 0; i < num_packets; i++)
+      output_port_list[i] = random.next(num_ports);
+
+   Byte payload[64];
+   memset(payload, 0, sizeof(payload));
+   NetPacket packet(Time(0), USER, 0, 1, sizeof(payload), payload);
+
+   for (SInt32 num_vcs_per_class = 0; num_vcs_per_class <= 2; num_vcs_per_class += 2)
+   {
+      string name = (num_vcs_per_class == 0) ?
+                    "RouterModel::processPacket (queue model)" :
+                    "RouterModel::processPacket (credit flow control)";
+      if (!isSelected(name))
+         continue;
+
+      RouterModel* router_model = new RouterModel(network_model, frequency, network_model->getVoltage(),
+                                                  num_ports, num_ports, num_flits_per_port_buffer,
+                                                  router_delay, 64, true, contention_model_type,
+                                                  1, num_vcs_per_class, 3);
+
+      Time pkt_time(0);
+      Measurement measurement(name, num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         // One packet every other cycle
+         pkt_time = pkt_time + cycle_time + cycle_time;
+         packet.time = pkt_time;
+         UInt64 zero_load_delay = 0;
+         UInt64 contention_delay = 0;
+         router_model->processPacket(packet, output_port_list[i % num_packets], zero_load_delay, contention_delay);
+         _sink += contention_delay;
+      }
+      measurement.stop();
+
+      delete router_model;
+   }
+}
+
+// Network::netRecv() of packets already waiting in the queue of this tile, when they are at
+// the head of the queue and when they are behind 64 packets that do not match (from another
+// sender). The packets are sent to this tile by netSend() before the timed loop.
+void benchmarkNetRecv(UInt64 num_ops)
+{
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   Network* network = core->getTile()->getNetwork();
+   UInt64 payload = 0;
+
+   for (UInt32 queue_depth = 0; queue_depth <= 64; queue_depth += 64)
+   {
+      std::ostringstream name;
+      name << "Network::netRecv (" << queue_depth << " packets ahead)";
+      if (!isSelected(name.str()))
+         continue;
+      if ((queue_depth > 0) && (Config::getSingleton()->getApplicationTiles() < 2))
+      {
+         fprintf(stderr, "%s needs at least 2 tiles, skipped\n", name.str().c_str());
+         continue;
+      }
+
+      // The packets that do not match claim to come from tile 1
+      for (UInt32 i = 0; i < queue_depth; i++)
+      {
+         NetPacket packet(core->getModel()->getCurrTime(), USER, Tile::getMainCoreId(1), core->getId(),
+                          sizeof(payload), &payload);
+         network->netSend(packet);
+      }
+      for (UInt64 i = 0; i < num_ops; i++)
+         network->netSend(core->getId(), USER, &payload, sizeof(payload));
+      // The transport delivers the packets of a sender in order, so all of them are
+      // in the queue once this one is received
+      network->netSend(core->getId(), USER_COLLECTIVE, &payload, sizeof(payload));
+      NetPacket last_packet = network->netRecvType(USER_COLLECTIVE, core->getId());
+      delete [] (Byte*) last_packet.data;
+
+      Measurement measurement(name.str(), num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         NetPacket packet = network->netRecv(core->getId(), core->getId(), USER);
+         delete [] (Byte*) packet.data;
+      }
+      measurement.stop();
+
+      for (UInt32 i = 0; i < queue_depth; i++)
+      {
+         NetPacket packet = network->netRecv(Tile::getMainCoreId(1), core->getId(), USER);
+         delete [] (Byte*) packet.data;
+      }
+   }
+}
+
+// Marshalling and unmarshalling of a typical memory message: a header of scalars followed by
+// a cache line of data
+void benchmarkUnstructuredBuffer(UInt64 num_ops)
+{
+   if (!isSelected("UnstructuredBuffer"))
+      return;
+
+   Byte line[64];
+   memset(line, 0, sizeof(line));
+
+   Measurement measurement("UnstructuredBuffer (marshal + unmarshal)", num_ops);
+   for (UInt64 i = 0; i < num_ops; i++)
+   {
+      UnstructuredBuffer buffer;
+      buffer << (SInt32) i << (IntPtr) (i * 64) << (UInt64) i << (SInt32) 0
+             << std::make_pair((const void*) line, (int) sizeof(line));
+
+      SInt32 msg_type;
+      IntPtr address;
+      UInt64 time;
+      SInt32 requester;
+      buffer >> msg_type >> address >> time >> requester
+             >> std::make_pair((void*) line, (int) sizeof(line));
+      _sink += address;
+   }
+   measurement.stop();
+}
+
+// Allocation and release of a 64 byte block with the FSBAllocator, the HeapAllocator
+// and the ScalableAllocator (new(heap_id) Byte[]) used for the network packets
+void benchmarkAllocators(UInt64 num_ops)
+{
+   const size_t block_size = 64;
+   // Blocks live at the same time, so that the free lists are exercised
+   const UInt32 num_live_blocks = 256;
+   vector<char*> block_list(num_live_blocks, (char*) NULL);
+
+   if (isSelected("FSBAllocator"))
+   {
+      FSBAllocator fsb_allocator(block_size);
+      Measurement measurement("FSBAllocator (allocate + free)", num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         char*& block = block_list[i % num_live_blocks];
+         if (block)
+            fsb_allocator.free(block);
+         block = fsb_allocator.allocate();
+      }
+      measurement.stop();
+
+      for (UInt32 i = 0; i < num_live_blocks; i++)
+      {
+         if (block_list[i])
+            fsb_allocator.free(block_list[i]);
+         block_list[i] = NULL;
+      }
+   }
+
+   if (isSelected("HeapAllocator"))
+   {
+      HeapAllocator heap_allocator;
+      Measurement measurement("HeapAllocator (allocate + free)", num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         char*& block = block_list[i % num_live_blocks];
+         if (block)
+            heap_allocator.free(block_size, block);
+         block = heap_allocator.allocate(block_size);
+      }
+      measurement.stop();
+
+      for (UInt32 i = 0; i < num_live_blocks; i++)
+      {
+         if (block_list[i])
+            heap_allocator.free(block_size, block_list[i]);
+         block_list[i] = NULL;
+      }
+   }
+
+   if (isSelected("ScalableAllocator"))
+   {
+      heap_id_t heap_id = Sim()->getTileManager()->getCurrentCore()->getTile()->getId();
+      vector<Byte*> buffer_list(num_live_blocks, (Byte*) NULL);
+      Measurement measurement("ScalableAllocator (new + delete)", num_ops);
+      for (UInt64 i = 0; i < num_ops; i++)
+      {
+         Byte*& buffer = buffer_list[i % num_live_blocks];
+         if (buffer)
+            delete [] buffer;
+         buffer = new(heap_id) Byte[block_size];
+      }
+      measurement.stop();
+
+      for (UInt32 i = 0; i < num_live_blocks; i++)
+      {
+         if (buffer_list[i])
+            delete [] buffer_list[i];
+      }
+   }
+}
@@ -0,0 +1,215 @@
+// Drives the cache hierarchy and coherence protocol of every application tile with memory traces,
+// without Pin: either the traces captured from a binary ([memory_trace] capture = true) or
+// synthetic traces generated at start-up.
+// One thread per tile replays the trace of the tile through the core model (MemoryTracePlayer).
+// Reports the simulated completion time of every tile and the host memory access rate.
+
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+#include <fstream>
+#include <sstream>
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "core.h"
+#include "core_model.h"
+#include "memory_manager.h"
+#include "memory_trace.h"
+#include "memory_trace_player.h"
+#include "carbon_user.h"
+#include "random.h"
+#include "log.h"
+
+struct TileStats
+{
+   TileStats()
+      : _num_instructions(0), _num_memory_accesses(0), _completion_time(0) {}
+
+   UInt64 _num_instructions;
+   UInt64 _num_memory_accesses;
+   Time _completion_time;
+};
+
+void* threadFunc(void* arg);
+void generateTraces();
+string getTraceFilename(tile_id_t tile_id);
+double getHostTime();
+void printHelpMessage();
+
+string _trace_directory;                        // Output directory of a run with captured memory traces
+UInt64 _num_generated_accesses = 0;             // Memory accesses per tile of the synthetic traces
+double _shared_fraction = 0.5;                  // Fraction of the accesses to shared data
+double _write_fraction = 0.33;                  // Fraction of the accesses that are writes
+UInt32 _mean_instruction_gap = 3;               // Mean number of instructions between two memory accesses
+UInt32 _num_shared_lines = 1024;                // Cache lines of shared data
+UInt32 _num_private_lines = 1024;               // Cache lines of private data per tile
+long int _seed = 1;
+
+SInt32 _num_tiles;
+vector<TileStats> _tile_stats;
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   // Read Command Line Arguments
+   for (SInt32 i = 1; i < argc-1; i += 2)
+   {
+      if (string(argv[i]) == "-t")
+         _trace_directory = string(argv[i+1]);
+      else if (string(argv[i]) == "-g")
+         _num_generated_accesses = (UInt64) atoll(argv[i+1]);
+      else if (string(argv[i]) == "-s")
+         _shared_fraction = atof(argv[i+1]);
+      else if (string(argv[i]) == "-w")
+         _write_fraction = atof(argv[i+1]);
+      else if (string(argv[i]) == "-i")
+         _mean_instruction_gap = std::max(atoi(argv[i+1]), 1);
+      else if (string(argv[i]) == "-r")
+         _seed = atol(argv[i+1]);
+      else if (string(argv[i]) == "-c") // Simulator arguments
+         break;
+      else if (string(argv[i]) == "-h")
+      {
+         printHelpMessage();
+         exit(0);
+      }
+      else
+      {
+         fprintf(stderr, "** ERROR **\n");
+         printHelpMessage();
+         exit(-1);
+      }
+   }
+   if ((_trace_directory == "") && (_num_generated_accesses == 0))
+   {
+      printHelpMessage();
+      exit(-1);
+   }
+
+   _num_tiles = (SInt32) Config::getSingleton()->getApplicationTiles();
+   _tile_stats.resize(_num_tiles);
+
+   if (_trace_directory == "")
+   {
+      // The generated traces would be overwritten by the captured ones
+      LOG_ASSERT_ERROR(!Sim()->getCfg()->getBool("memory_trace/capture", false),
+                       "Disable [memory_trace] capture to replay generated traces");
+      generateTraces();
+   }
+
+   CarbonEnableModels();
+
+   double host_start_time = getHostTime();
+   vector<carbon_thread_t> thread_list(_num_tiles);
+   for (tile_id_t i = 1; i < _num_tiles; i++)
+      thread_list[i] = CarbonSpawnThreadOnTile(i, threadFunc, (void*) (IntPtr) i);
+   threadFunc((void*) 0);
+   for (tile_id_t i = 1; i < _num_tiles; i++)
+      CarbonJoinThread(thread_list[i]);
+   double host_time = getHostTime() - host_start_time;
+
+   CarbonDisableModels();
+
+   std::ostringstream summary;
+   UInt64 total_memory_accesses = 0;
+   Time max_completion_time(0);
+   summary << "# Tile, Instructions, Memory Accesses, Completion Time (in nanoseconds)" << endl;
+   for (tile_id_t i = 0; i < _num_tiles; i++)
+   {
+      summary << i << ", " << _tile_stats[i]._num_instructions << ", " << _tile_stats[i]._num_memory_accesses << ", "
+              << _tile_stats[i]._completion_time.toNanosec() << endl;
+      total_memory_accesses += _tile_stats[i]._num_memory_accesses;
+      max_completion_time = std::max(max_completion_time, _tile_stats[i]._completion_time);
+   }
+   summary << "# Completion Time (in nanoseconds): " << max_completion_time.toNanosec()
+           << ", Memory Accesses: " << total_memory_accesses << ", Host Time (in seconds): " << host_time
+           << ", Host Memory Access Rate (accesses/second): " << ((host_time > 0) ? (total_memory_accesses / host_time) : 0.0) << endl;
+
+   std::cout << summary.str();
+   std::ofstream output_file(Config::getSingleton()->formatOutputFileName("memory_trace_driver.out").c_str());
+   output_file << summary.str();
+   output_file.close();
+
+   CarbonStopSim();
+
+   return 0;
+}
+
+void printHelpMessage()
+{
+   fprintf(stderr, "[Usage]: ./memory_trace_driver -t <arg1> | -g <arg2> [-s <arg3> -w <arg4> -i <arg5> -r <arg6>]\n");
+   fprintf(stderr, "where <arg1> = Output directory of a simulation run with [memory_trace] capture = true,\n");
+   fprintf(stderr, "               whose memory traces are replayed\n");
+   fprintf(stderr, " or   <arg2> = Number of Memory Accesses per Tile of the synthetic traces to replay instead\n");
+   fprintf(stderr, " and  <arg3> = Fraction of the Memory Accesses to Shared Data (default 0.5)\n");
+   fprintf(stderr, " and  <arg4> = Fraction of the Memory Accesses that are Writes (default 0.33)\n");
+   fprintf(stderr, " and  <arg5> = Mean Number of Instructions between two Memory Accesses (default 3)\n");
+   fprintf(stderr, " and  <arg6> = Random seed (default 1)\n");
+}
+
+double getHostTime()
+{
+   timeval t;
+   gettimeofday(&t, NULL);
+   return t.tv_sec + (t.tv_usec / 1000000.0);
+}
+
+string getTraceFilename(tile_id_t tile_id)
+{
+   return (_trace_directory != "") ?
+          (_trace_directory + "/" + MemoryTraceWriter::getFilename(tile_id)) :
+          Config::getSingleton()->formatOutputFileName(MemoryTraceWriter::getFilename(tile_id));
+}
+
+// Each tile reads and writes a set of cache lines shared by all the tiles and a set of its own
+void generateTraces()
+{
+   UInt32 cache_line_size = Sim()->getTileManager()->getCurrentTile()->getMemoryManager()->getCacheLineSize();
+   IntPtr shared_base_address = (IntPtr) 0x10000000;
+   IntPtr private_base_address = shared_base_address + ((IntPtr) _num_shared_lines) * cache_line_size;
+
+   for (tile_id_t i = 0; i < _num_tiles; i++)
+   {
+      Random<double> rand_num;
+      rand_num.seed(_seed + i);
+
+      MemoryTraceWriter writer(i, 1 << 16);
+      MemoryTraceRecord record;
+      record._size = sizeof(UInt64);
+      for (UInt64 j = 0; j < _num_generated_accesses; j++)
+      {
+         record._instruction_gap = 1 + (UInt64) rand_num.next(2 * _mean_instruction_gap - 1);
+         record._mem_op_type = (rand_num.next(1) < _write_fraction) ? Core::WRITE : Core::READ;
+         if (rand_num.next(1) < _shared_fraction)
+            record._address = shared_base_address + ((IntPtr) rand_num.next(_num_shared_lines)) * cache_line_size;
+         else
+            record._address = private_base_address + ((IntPtr) (i * _num_private_lines + rand_num.next(_num_private_lines))) * cache_line_size;
+         writer.write(record);
+      }
+   }
+}
+
+void* threadFunc(void* arg)
+{
+   tile_id_t tile_id = (tile_id_t) (IntPtr) arg;
+   Tile* tile = Sim()->getTileManager()->getCurrentTile();
+   LOG_ASSERT_ERROR(tile->getId() == tile_id, "Thread(%i) is running on tile(%i)", tile_id, tile->getId());
+
+   string filename = getTraceFilename(tile_id);
+   MemoryTraceReader reader(filename);
+   if (!reader.isOpen())
+   {
+      LOG_PRINT_WARNING("No memory trace for tile(%i) (%s)", tile_id, filename.c_str());
+      return NULL;
+   }
+
+   MemoryTracePlayer player(tile->getCore());
+   player.play(reader);
+
+   _tile_stats[tile_id]._num_instructions = player.getNumInstructions();
+   _tile_stats[tile_id]._num_memory_accesses = player.getNumMemoryAccesses();
+   _tile_stats[tile_id]._completion_time = tile->getCore()->getModel()->getCurrTime();
+   return NULL;
+}
@@ -0,0 +1,405 @@
+// Drives the network models of every tile directly with synthetic traffic (on the user network)
+// or with the packet traces recorded by a simulation ([network/packet_trace]), without the
+// app/sim threads and the transport.
+// Each packet is routed hop by hop through the network models of the tiles on its path
+// (as with the shared memory shortcut), on a single host thread.
+// Reports the latency and accepted throughput at every offered load, and the host packet rate.
+// With dependency-aware throttling (-d 1), a memory packet is not injected before the last
+// memory packet its tile received for the same cache line (the request it answers or the
+// reply it waits for) has arrived in the replay, and the delay carries over to the later
+// packets of the tile.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+#include <fstream>
+#include <sstream>
+#include <queue>
+#include <map>
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "core.h"
+#include "network.h"
+#include "network_model.h"
+#include "packet_trace.h"
+#include "carbon_user.h"
+#include "random.h"
+#include "log.h"
+#include "../synthetic_network/traffic_patterns.h"
+
+struct DriverStats
+{
+   DriverStats()
+      : _num_packets(0), _total_latency(0), _total_contention_delay(0), _last_arrival_time(0) {}
+
+   UInt64 _num_packets;
+   Time _total_latency;
+   Time _total_contention_delay;
+   Time _last_arrival_time;
+};
+
+// Packet trace record waiting to be replayed, ordered by recorded time
+struct PendingRecord
+{
+   PacketTraceRecord _record;
+   UInt64 _sequence_num;
+
+   bool operator>(const PendingRecord& other) const
+   {
+      return ( (_record._time > other._record._time) ||
+               ((_record._time == other._record._time) && (_sequence_num > other._sequence_num)) );
+   }
+};
+
+// Arrival time of the last memory packet received by each tile for each cache line
+typedef std::map<std::pair<tile_id_t, IntPtr>, Time> ArrivalMap;
+
+void runSyntheticTraffic(double offered_load, Time start_time, DriverStats& stats);
+void runPacketTrace(string trace_directory, DriverStats& stats);
+void replayRecord(const PacketTraceRecord& record, Time injection_time, DriverStats& stats, ArrivalMap* arrival_map);
+void routePacket(NetPacket& packet, SInt32 network_id, DriverStats& stats, IntPtr address = INVALID_ADDRESS, ArrivalMap* arrival_map = NULL);
+void outputStats(std::ostream& os, string offered_load, DriverStats& stats, Time start_time, double host_time);
+void parseOfferedLoads(string offered_loads);
+double getHostTime();
+void printHelpMessage();
+
+NetworkTrafficType _traffic_pattern_type = UNIFORM_RANDOM;     // Network Traffic Pattern Type
+vector<double> _offered_loads;                                 // Packets injected per tile per cycle
+SInt32 _packet_size = 8;                                       // Size of each Packet in Bytes
+UInt64 _total_packets = 10000;                                 // Packets injected per tile at each offered load
+string _trace_directory;                                       // Output directory of a run with recorded packet traces
+bool _dependency_throttling = false;                           // Delay memory packets until their dependences arrive
+UInt32 _reorder_window = 1024;                                 // Records of each tile looked ahead to put the trace in time order
+long int _seed = 1;
+
+PacketType _packet_type = USER;
+SInt32 _num_tiles;
+// Network models of every tile, for each network
+vector<vector<NetworkModel*> > _network_models(NUM_STATIC_NETWORKS);
+Time _cycle_time;
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   CarbonEnableModels();
+
+   // Read Command Line Arguments
+   for (SInt32 i = 1; i < argc-1; i += 2)
+   {
+      if (string(argv[i]) == "-p")
+         _traffic_pattern_type = parseTrafficPattern(string(argv[i+1]));
+      else if (string(argv[i]) == "-l")
+         parseOfferedLoads(string(argv[i+1]));
+      else if (string(argv[i]) == "-s")
+         _packet_size = (SInt32) atoi(argv[i+1]);
+      else if (string(argv[i]) == "-N")
+         _total_packets = (UInt64) atoll(argv[i+1]);
+      else if (string(argv[i]) == "-t")
+         _trace_directory = string(argv[i+1]);
+      else if (string(argv[i]) == "-d")
+         _dependency_throttling = (atoi(argv[i+1]) != 0);
+      else if (string(argv[i]) == "-w")
+         _reorder_window = std::max(atoi(argv[i+1]), 1);
+      else if (string(argv[i]) == "-r")
+         _seed = atol(argv[i+1]);
+      else if (string(argv[i]) == "-c") // Simulator arguments
+         break;
+      else if (string(argv[i]) == "-h")
+      {
+         printHelpMessage();
+         exit(0);
+      }
+      else
+      {
+         fprintf(stderr, "** ERROR **\n");
+         printHelpMessage();
+         exit(-1);
+      }
+   }
+   if (_offered_loads.empty())
+      _offered_loads.push_back(0.1);
+
+   // The network models of all the tiles are driven from this thread
+   LOG_ASSERT_ERROR(Config::getSingleton()->getProcessCount() == 1,
+                    "network_model_driver runs in a single host process");
+
+   _num_tiles = (SInt32) Config::getSingleton()->getApplicationTiles();
+   for (tile_id_t i = 0; i < _num_tiles; i++)
+   {
+      Tile* tile = Sim()->getTileManager()->getTileFromID(i);
+      for (SInt32 network_id = 0; network_id < NUM_STATIC_NETWORKS; network_id++)
+         _network_models[network_id].push_back(tile->getNetwork()->getNetworkModel(network_id));
+   }
+   _cycle_time = Latency(1, Sim()->getTileManager()->getCurrentTile()->getCore()->getFrequency());
+
+   std::ofstream output_file(Config::getSingleton()->formatOutputFileName("network_model_driver.out").c_str());
+   std::ostringstream header;
+   if (_trace_directory != "")
+   {
+      header << "# Network Models: " << _network_models[STATIC_NETWORK_USER][0]->getNetworkName() << " (user), "
+             << _network_models[STATIC_NETWORK_MEMORY][0]->getNetworkName() << " (memory), Tiles: " << _num_tiles
+             << ", Dependency Throttling: " << (_dependency_throttling ? "true" : "false") << endl;
+   }
+   else
+   {
+      header << "# Network Model: " << _network_models[STATIC_NETWORK_USER][0]->getNetworkName() << ", Tiles: " << _num_tiles << endl;
+   }
+   header << "# Offered Load (packets/tile/cycle), Accepted Load (packets/tile/cycle), Average Latency (in nanoseconds), "
+          << "Average Contention Delay (in nanoseconds), Packets, Host Time (in seconds), Host Packet Rate (packets/second)" << endl;
+   std::cout << header.str();
+   output_file << header.str();
+
+   Time start_time(0);
+   if (_trace_directory != "")
+   {
+      DriverStats stats;
+      double host_start_time = getHostTime();
+      runPacketTrace(_trace_directory, stats);
+      double host_time = getHostTime() - host_start_time;
+
+      outputStats(std::cout, "trace", stats, start_time, host_time);
+      outputStats(output_file, "trace", stats, start_time, host_time);
+   }
+   else
+   {
+      for (UInt32 i = 0; i < _offered_loads.size(); i++)
+      {
+         DriverStats stats;
+         double host_start_time = getHostTime();
+         runSyntheticTraffic(_offered_loads[i], start_time, stats);
+         double host_time = getHostTime() - host_start_time;
+
+         std::ostringstream offered_load;
+         offered_load << _offered_loads[i];
+         outputStats(std::cout, offered_load.str(), stats, start_time, host_time);
+         outputStats(output_file, offered_load.str(), stats, start_time, host_time);
+
+         // The network is drained between two offered loads
+         start_time = stats._last_arrival_time;
+      }
+   }
+   output_file.close();
+
+   CarbonDisableModels();
+
+   CarbonStopSim();
+
+   return 0;
+}
+
+void printHelpMessage()
+{
+   fprintf(stderr, "[Usage]: ./network_model_driver -p <arg1> -l <arg2> -s <arg3> -N <arg4> -t <arg5> -d <arg6> -w <arg7> -r <arg8>\n");
+   fprintf(stderr, "where <arg1> = Network Traffic Pattern Type (uniform_random, bit_complement, shuffle, transpose, tornado, nearest_neighbor) (default uniform_random)\n");
+   fprintf(stderr, " and  <arg2> = Comma-separated list of Number of Packets injected into the Network per Core per Cycle (default 0.1)\n");
+   fprintf(stderr, " and  <arg3> = Size of each Packet in Bytes (default 8)\n");
+   fprintf(stderr, " and  <arg4> = Total Number of Packets injected into the Network per Core at each load (default 10000)\n");
+   fprintf(stderr, " and  <arg5> = Output directory of a simulation run with [network/packet_trace] enabled = true,\n");
+   fprintf(stderr, "               whose packet traces are replayed instead of the synthetic traffic (default none)\n");
+   fprintf(stderr, " and  <arg6> = Dependency-aware throttling of the replayed memory packets, 0 or 1 (default 0)\n");
+   fprintf(stderr, " and  <arg7> = Records of each tile looked ahead to replay the traces in time order (default 1024)\n");
+   fprintf(stderr, " and  <arg8> = Random seed (default 1)\n");
+}
+
+void parseOfferedLoads(string offered_loads)
+{
+   std::istringstream is(offered_loads);
+   string offered_load;
+   while (getline(is, offered_load, ','))
+      _offered_loads.push_back(atof(offered_load.c_str()));
+}
+
+double getHostTime()
+{
+   timeval t;
+   gettimeofday(&t, NULL);
+   return t.tv_sec + (t.tv_usec / 1000000.0);
+}
+
+void runSyntheticTraffic(double offered_load, Time start_time, DriverStats& stats)
+{
+   vector<vector<tile_id_t> > send_vec(_num_tiles);
+   vector<UInt64> total_packets_sent(_num_tiles, 0);
+   for (tile_id_t i = 0; i < _num_tiles; i++)
+   {
+      vector<tile_id_t> receive_vec;
+      generateTraffic(_traffic_pattern_type, _num_tiles, i, send_vec[i], receive_vec);
+   }
+
+   Byte data[_packet_size];
+   Random<double> rand_num;
+   rand_num.seed(_seed);
+
+   UInt64 total_packets = _total_packets * _num_tiles;
+   Time time = start_time;
+   for (UInt64 total_packets_injected = 0; total_packets_injected < total_packets; time = time + _cycle_time)
+   {
+      for (tile_id_t i = 0; i < _num_tiles; i++)
+      {
+         if ((total_packets_sent[i] == _total_packets) || (rand_num.next(1) >= offered_load))
+            continue;
+
+         tile_id_t receiver = send_vec[i][total_packets_sent[i] % send_vec[i].size()];
+         total_packets_sent[i] ++;
+         total_packets_injected ++;
+         // Tiles do not send packets to themselves over the network
+         if (receiver == i)
+            continue;
+
+         NetPacket packet(time, _packet_type, i, receiver, _packet_size, data);
+         routePacket(packet, STATIC_NETWORK_USER, stats);
+      }
+   }
+}
+
+// Replay the packet traces of all the tiles, merged in recorded time order. The traces are read
+// through bounded buffers, and _reorder_window records of each tile are held in memory
+// (the packets of a tile are recorded in send order, which is nearly, but not exactly, time order)
+void runPacketTrace(string trace_directory, DriverStats& stats)
+{
+   vector<PacketTraceReader*> readers(_num_tiles, (PacketTraceReader*) NULL);
+   std::priority_queue<PendingRecord, vector<PendingRecord>, std::greater<PendingRecord> > pending_records;
+   PendingRecord pending_record;
+   pending_record._sequence_num = 0;
+
+   for (tile_id_t i = 0; i < _num_tiles; i++)
+   {
+      string filename = trace_directory + "/" + PacketTraceWriter::getFilename(i);
+      readers[i] = new PacketTraceReader(filename);
+      if (!readers[i]->isOpen())
+      {
+         LOG_PRINT_WARNING("No packet trace for tile(%i) (%s)", i, filename.c_str());
+         continue;
+      }
+      LOG_ASSERT_ERROR(readers[i]->getTileId() == i, "Packet trace(%s) is for tile(%i)", filename.c_str(), readers[i]->getTileId());
+
+      for (UInt32 j = 0; (j < _reorder_window) && readers[i]->next(pending_record._record); j++)
+      {
+         pending_records.push(pending_record);
+         pending_record._sequence_num ++;
+      }
+   }
+
+   ArrivalMap arrival_map;
+   // Delay of the replayed packets of each tile with respect to their recorded time
+   vector<Time> slip(_num_tiles, Time(0));
+
+   while (!pending_records.empty())
+   {
+      const PacketTraceRecord& record = pending_records.top()._record;
+      tile_id_t sender = record._sender;
+
+      Time injection_time = record._time + slip[sender];
+      if (_dependency_throttling && (record._network_id == STATIC_NETWORK_MEMORY))
+      {
+         ArrivalMap::iterator it = arrival_map.find(std::make_pair(sender, record._address));
+         if ((it != arrival_map.end()) && (it->second > injection_time))
+         {
+            slip[sender] += (it->second - injection_time);
+            injection_time = it->second;
+         }
+      }
+      replayRecord(record, injection_time, stats, _dependency_throttling ? &arrival_map : NULL);
+      pending_records.pop();
+
+      // Keep the look-ahead of the tile full
+      if (readers[sender]->next(pending_record._record))
+      {
+         pending_records.push(pending_record);
+         pending_record._sequence_num ++;
+      }
+   }
+
+   for (tile_id_t i = 0; i < _num_tiles; i++)
+      delete readers[i];
+}
+
+void replayRecord(const PacketTraceRecord& record, Time injection_time, DriverStats& stats, ArrivalMap* arrival_map)
+{
+   NetworkModel* network_model = _network_models[record._network_id][record._sender];
+   NetPacket packet(injection_time, NETWORK_REPLAY, record._sender, record._receiver, record._modeled_length, NULL);
+   if (!record._multicast_mask.empty())
+   {
+      packet.multicast_mask_length = record._multicast_mask.size();
+      packet.multicast_mask = &record._multicast_mask[0];
+   }
+
+   // Broadcasts are sent as unicasts to the other application tiles when the model cannot broadcast
+   if ((record._receiver == NetPacket::BROADCAST) && !network_model->hasBroadcastCapability())
+   {
+      for (tile_id_t i = 0; i < _num_tiles; i++)
+      {
+         if ((i == record._sender) || (packet.isMulticast() && !packet.isMulticastReceiver(i)))
+            continue;
+         NetPacket unicast_packet = packet;
+         unicast_packet.receiver = CORE_ID(i);
+         unicast_packet.multicast_mask_length = 0;
+         unicast_packet.multicast_mask = NULL;
+         routePacket(unicast_packet, record._network_id, stats, record._address, arrival_map);
+      }
+   }
+   else
+   {
+      routePacket(packet, record._network_id, stats, record._address, arrival_map);
+   }
+}
+
+// Route the packet through the network models of the tiles on its path (what the sim threads
+// of these tiles would do), then receive it at its destination(s)
+void routePacket(NetPacket& packet, SInt32 network_id, DriverStats& stats, IntPtr address, ArrivalMap* arrival_map)
+{
+   Time injection_time = packet.time;
+   std::queue<NetworkModel::Hop> hop_queue;
+
+   _network_models[network_id][TILE_ID(packet.sender)]->__routePacket(packet, hop_queue);
+   while (!hop_queue.empty())
+   {
+      NetworkModel::Hop hop = hop_queue.front();
+      hop_queue.pop();
+
+      packet.node_type = hop._next_node_type;
+      packet.time = hop._time;
+      packet.zero_load_delay = hop._zero_load_delay;
+      packet.contention_delay = hop._contention_delay;
+
+      NetworkModel* network_model = _network_models[network_id][hop._next_tile_id];
+      if (hop._next_node_type == NetworkModel::RECEIVE_TILE)
+      {
+         // Broadcast trees reach every tile, the tiles outside the multicast set drop the packet
+         if ((hop._next_tile_id == TILE_ID(packet.sender)) ||
+             (packet.isMulticast() && !packet.isMulticastReceiver(hop._next_tile_id)))
+            continue;
+
+         network_model->__processReceivedPacket(packet);
+
+         stats._num_packets ++;
+         stats._total_latency += (packet.time - injection_time);
+         stats._total_contention_delay += packet.contention_delay;
+         if (packet.time > stats._last_arrival_time)
+            stats._last_arrival_time = packet.time;
+
+         if (arrival_map && (address != INVALID_ADDRESS))
+            (*arrival_map)[std::make_pair(hop._next_tile_id, address)] = packet.time;
+      }
+      else
+      {
+         network_model->__routePacket(packet, hop_queue);
+      }
+   }
+}
+
+void outputStats(std::ostream& os, string offered_load, DriverStats& stats, Time start_time, double host_time)
+{
+   double elapsed_cycles = (stats._last_arrival_time > start_time) ?
+                           ((double) (stats._last_arrival_time - start_time).toPicosec()) / _cycle_time.toPicosec() : 0.0;
+   double accepted_load = (elapsed_cycles > 0) ? (stats._num_packets / (elapsed_cycles * _num_tiles)) : 0.0;
+   double average_latency = (stats._num_packets > 0) ? (((double) stats._total_latency.toPicosec()) / (stats._num_packets * 1000)) : 0.0;
+   double average_contention_delay = (stats._num_packets > 0) ?
+                                     (((double) stats._total_contention_delay.toPicosec()) / (stats._num_packets * 1000)) : 0.0;
+
+   os << offered_load << ", " << accepted_load << ", " << average_latency << ", " << average_contention_delay << ", "
+      << stats._num_packets << ", " << host_time << ", " << ((host_time > 0) ? (stats._num_packets / host_time) : 0.0) << endl;
+}
@@ -0,0 +1,190 @@
+// Replays address streams through a cache set array under each replacement policy
+// and reports the miss rate and the host time spent per access.
+// A recorded stream (one hex address per line) can be passed after '--', e.g.,
+//    ./replacement_policy_replay -c carbon_sim.cfg -- trace.txt
+// Otherwise, a few synthetic streams are generated.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "cache_set.h"
+#include "cache_line_info.h"
+#include "cache_replacement_policy.h"
+#include "pr_l1_pr_l2_dram_directory_msi/cache_level.h"
+
+#define NUM_SETS        64
+#define ASSOCIATIVITY   16
+#define LINE_SIZE       64
+#define NUM_LINES       (NUM_SETS * ASSOCIATIVITY)
+#define STREAM_LENGTH   (64 * NUM_LINES)
+
+const char* policy_list[] = {"round_robin", "lru", "tree_plru", "srrip", "brrip", "dip"};
+const UInt32 num_policies = sizeof(policy_list) / sizeof(policy_list[0]);
+
+struct Result
+{
+   UInt64 _misses;
+   double _ns_per_access;
+};
+
+static UInt64 getTimeInNs()
+{
+   struct timeval t;
+   gettimeofday(&t, NULL);
+   return ((UInt64) t.tv_sec) * 1000000000 + ((UInt64) t.tv_usec) * 1000;
+}
+
+Result replay(const char* policy_str, const vector<IntPtr>& stream)
+{
+   CacheReplacementPolicy* replacement_policy = CacheReplacementPolicy::create(policy_str,
+         NUM_LINES * LINE_SIZE / 1024, ASSOCIATIVITY, LINE_SIZE);
+
+   vector<CacheSet*> set_list(NUM_SETS);
+   for (UInt32 i = 0; i < NUM_SETS; i++)
+      set_list[i] = new CacheSet(i, CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI, PrL1PrL2DramDirectoryMSI::L1,
+                                 replacement_policy, ASSOCIATIVITY, LINE_SIZE);
+
+   CacheLineInfo* inserted_line_info = CacheLineInfo::create(CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI, PrL1PrL2DramDirectoryMSI::L1);
+   CacheLineInfo* evicted_line_info = CacheLineInfo::create(CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI, PrL1PrL2DramDirectoryMSI::L1);
+
+   Result result;
+   result._misses = 0;
+
+   UInt64 start_time = getTimeInNs();
+   for (vector<IntPtr>::const_iterator it = stream.begin(); it != stream.end(); it ++)
+   {
+      IntPtr line = (*it) / LINE_SIZE;
+      CacheSet* set = set_list[line % NUM_SETS];
+      IntPtr tag = line / NUM_SETS;
+
+      UInt32 line_index;
+      if (set->find(tag, &line_index))
+      {
+         set->read_line(line_index, 0, NULL, 0);
+      }
+      else
+      {
+         result._misses ++;
+         bool eviction;
+         inserted_line_info->setTag(tag);
+         inserted_line_info->setCState(CacheState::SHARED);
+         set->insert(inserted_line_info, NULL, &eviction, evicted_line_info, NULL);
+      }
+   }
+   UInt64 end_time = getTimeInNs();
+   result._ns_per_access = ((double) (end_time - start_time)) / stream.size();
+
+   delete inserted_line_info;
+   delete evicted_line_info;
+   for (UInt32 i = 0; i < NUM_SETS; i++)
+      delete set_list[i];
+   delete replacement_policy;
+
+   return result;
+}
+
+// Cyclic walk over a working set 1.5x the cache size (LRU thrashes)
+void generateLoopStream(vector<IntPtr>& stream)
+{
+   UInt32 working_set = (3 * NUM_LINES) / 2;
+   for (UInt32 i = 0; i < STREAM_LENGTH; i++)
+      stream.push_back(((IntPtr) (i % working_set)) * LINE_SIZE);
+}
+
+// Hot working set of half the cache interrupted by long one-time scans
+void generateScanStream(vector<IntPtr>& stream)
+{
+   UInt32 hot_set = NUM_LINES / 2;
+   IntPtr scan_address = ((IntPtr) NUM_LINES) * LINE_SIZE * 16;
+   while (stream.size() < STREAM_LENGTH)
+   {
+      for (UInt32 i = 0; i < 4 * hot_set; i++)
+         stream.push_back(((IntPtr) (i % hot_set)) * LINE_SIZE);
+      for (UInt32 i = 0; i < NUM_LINES; i++)
+      {
+         stream.push_back(scan_address);
+         scan_address += LINE_SIZE;
+      }
+   }
+}
+
+// Uniform random accesses over twice the cache size
+void generateRandomStream(vector<IntPtr>& stream)
+{
+   srand(1);
+   for (UInt32 i = 0; i < STREAM_LENGTH; i++)
+      stream.push_back(((IntPtr) (rand() % (2 * NUM_LINES))) * LINE_SIZE);
+}
+
+bool readTrace(const char* filename, vector<IntPtr>& stream)
+{
+   FILE* fp = fopen(filename, "r");
+   if (!fp)
+      return false;
+   unsigned long long address;
+   while (fscanf(fp, "%llx", &address) == 1)
+      stream.push_back((IntPtr) address);
+   fclose(fp);
+   return true;
+}
+
+void replayAll(const char* stream_name, const vector<IntPtr>& stream)
+{
+   printf("Stream(%s), Accesses(%u)\n", stream_name, (UInt32) stream.size());
+   for (UInt32 i = 0; i < num_policies; i++)
+   {
+      Result result = replay(policy_list[i], stream);
+      printf("   %-12s Miss Rate(%%): %6.2f, Time per Access(ns): %.2f\n", policy_list[i],
+             100.0 * result._misses / stream.size(), result._ns_per_access);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Replacement-Policy replay\n");
+
+   const char* trace_filename = NULL;
+   for (SInt32 i = 1; i < argc - 1; i++)
+   {
+      if (strcmp(argv[i], "--") == 0)
+         trace_filename = argv[i+1];
+   }
+
+   if (trace_filename)
+   {
+      vector<IntPtr> stream;
+      if (!readTrace(trace_filename, stream) || stream.empty())
+      {
+         fprintf(stderr, "*ERROR* Could not read trace(%s)\n", trace_filename);
+         fprintf(stderr, "Replacement-Policy replay: FAILED\n");
+         exit(EXIT_FAILURE);
+      }
+      replayAll(trace_filename, stream);
+   }
+   else
+   {
+      vector<IntPtr> loop_stream;
+      generateLoopStream(loop_stream);
+      replayAll("loop", loop_stream);
+
+      vector<IntPtr> scan_stream;
+      generateScanStream(scan_stream);
+      replayAll("scan", scan_stream);
+
+      vector<IntPtr> random_stream;
+      generateRandomStream(random_stream);
+      replayAll("random", random_stream);
+   }
+
+   printf("Replacement-Policy replay: SUCCESS\n");
+   CarbonStopSim();
+   return 0;
+}
@@ -12,30 +12,13 @@
 #include "utils.h"
 #include "random.h"
 #include "log.h"
-
-enum NetworkTrafficType
-{
-   UNIFORM_RANDOM = 0,
-   BIT_COMPLEMENT,
-   SHUFFLE,
-   TRANSPOSE,
-   TORNADO,
-   NEAREST_NEIGHBOR,
-   NUM_NETWORK_TRAFFIC_TYPES
-};
+#include "traffic_patterns.h"
 
 void* sendNetworkTraffic(void*);
-void uniformRandomTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
-void bitComplementTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
-void shuffleTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
-void transposeTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
-void tornadoTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
-void nearestNeighborTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
 
 bool canSendPacket(double offered_load, Random<double>& rand_num);
 void synchronize(Time time, Tile* tile);
 void printHelpMessage();
-NetworkTrafficType parseTrafficPattern(string traffic_pattern);
 
 NetworkTrafficType _traffic_pattern_type = UNIFORM_RANDOM;     // Network Traffic Pattern Type
 double _offered_load = 0.1;                                    // Number of packets injected per tile per cycle
@@ -111,28 +94,6 @@ void printHelpMessage()
    fprintf(stderr, " and  <arg4> = Total Number of Packets injected into the Network per Core (default 10000)\n");
 }
 
-NetworkTrafficType parseTrafficPattern(string traffic_pattern)
-{
-   if (traffic_pattern == "uniform_random")
-      return UNIFORM_RANDOM;
-   else if (traffic_pattern == "bit_complement")
-      return BIT_COMPLEMENT;
-   else if (traffic_pattern == "shuffle")
-      return SHUFFLE;
-   else if (traffic_pattern == "transpose")
-      return TRANSPOSE;
-   else if (traffic_pattern == "tornado")
-      return TORNADO;
-   else if (traffic_pattern == "nearest_neighbor")
-      return NEAREST_NEIGHBOR;
-   else
-   {
-      fprintf(stderr, "** ERROR **\n");
-      fprintf(stderr, "Unrecognized Network Traffic Pattern Type (Use uniform_random, bit_complement, shuffle, transpose, tornado, nearest_neighbor)\n");
-      exit(-1);
-   }
-}
-
 void* sendNetworkTraffic(void*)
 {
    // Wait for everyone to be spawned
@@ -144,30 +105,7 @@ void* sendNetworkTraffic(void*)
    vector<tile_id_t> receive_vec;
    
    // Generate the Network Traffic
-   switch (_traffic_pattern_type)
-   {
-   case UNIFORM_RANDOM:
-      uniformRandomTrafficGenerator(tile->getId(), send_vec, receive_vec);
-      break;
-   case BIT_COMPLEMENT:
-      bitComplementTrafficGenerator(tile->getId(), send_vec, receive_vec);
-      break;
-   case SHUFFLE:
-      shuffleTrafficGenerator(tile->getId(), send_vec, receive_vec);
-      break;
-   case TRANSPOSE:
-      transposeTrafficGenerator(tile->getId(), send_vec, receive_vec);
-      break;
-   case TORNADO:
-      tornadoTrafficGenerator(tile->getId(), send_vec, receive_vec);
-      break;
-   case NEAREST_NEIGHBOR:
-      nearestNeighborTrafficGenerator(tile->getId(), send_vec, receive_vec);
-      break;
-   default:
-      LOG_PRINT_ERROR("Unrecognized traffic pattern (%u)", _traffic_pattern_type);
-      break;
-   }
+   generateTraffic(_traffic_pattern_type, _num_tiles, tile->getId(), send_vec, receive_vec);
 
    Byte data[_packet_size];
    UInt64 outstanding_window_size = 1000;
@@ -203,7 +141,7 @@ void* sendNetworkTraffic(void*)
          total_packets_received ++;
       }
 
-      Time ONE_CYCLE = Latency(1, tile->getFrequency());
+      Time ONE_CYCLE = Latency(1, tile->getCore()->getFrequency());
       time = time + ONE_CYCLE;
    }
 
@@ -224,136 +162,3 @@ void synchronize(Time packet_injection_time, Tile* tile)
    if (clock_skew_client)
       clock_skew_client->synchronize(packet_injection_time);
 }
-
-void computeEMeshTopologyParams(int num_tiles, int& mesh_width, int& mesh_height);
-void computeEMeshPosition(tile_id_t tile_id, int& sx, int& sy, int mesh_width);
-tile_id_t computeTileID(int sx, int sy, int mesh_width);
-
-void uniformRandomTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
-{
-   // Generate Random Numbers using Linear Congruential Generator
-   tile_id_t send_matrix[_num_tiles][_num_tiles];
-   tile_id_t receive_matrix[_num_tiles][_num_tiles];
-
-   send_matrix[0][0] = _num_tiles / 2; // Initial seed
-   receive_matrix[0][send_matrix[0][0]] = 0;
-   for (tile_id_t i = 0; i < _num_tiles; i++) // Time Slot
-   {
-      if (i != 0)
-      {
-         send_matrix[i][0] = send_matrix[i-1][1];
-         receive_matrix[i][send_matrix[i][0]] = 0;
-      }
-      for (tile_id_t j = 1; j < _num_tiles; j++) // Sender
-      {
-         send_matrix[i][j] = (13 * send_matrix[i][j-1] + 5) % _num_tiles;
-         receive_matrix[i][send_matrix[i][j]] = j;
-      }
-   }
-
-   // Check the validity of the random numbers
-   for (tile_id_t i = 0; i < _num_tiles; i++) // Time Slot
-   {
-      vector<bool> bits(_num_tiles, false);
-      for (tile_id_t j = 0; j < _num_tiles; j++) // Sender
-      {
-         bits[send_matrix[i][j]] = true;
-      }
-      for (tile_id_t j = 0; j < _num_tiles; j++)
-      {
-         assert(bits[j]);
-      }
-   }
-
-   for (tile_id_t j = 0; j < _num_tiles; j++) // Sender
-   {
-      vector<bool> bits(_num_tiles, false);
-      for (tile_id_t i = 0; i < _num_tiles; i++) // Time Slot
-      {
-         bits[send_matrix[i][j]] = true;
-      }
-      for (tile_id_t i = 0; i < _num_tiles; i++)
-      {
-         assert(bits[i]);
-      }
-   }
-
-   for (SInt32 i = 0; i < _num_tiles; i++)
-   {
-      send_vec.push_back(send_matrix[i][tile_id]);
-      receive_vec.push_back(receive_matrix[i][tile_id]);
-   }
-}
-
-void bitComplementTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
-{
-   assert(isPower2(_num_tiles));
-   int mask = _num_tiles-1;
-   tile_id_t dst_tile = (~tile_id) & mask;
-   send_vec.push_back(dst_tile);
-   receive_vec.push_back(dst_tile);
-}
-
-void shuffleTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
-{
-   assert(isPower2(_num_tiles));
-   int mask = _num_tiles-1;
-   int nbits = floorLog2(_num_tiles);
-   tile_id_t dst_tile = ((tile_id >> (nbits-1)) & 1) | ((tile_id << 1) & mask);
-   send_vec.push_back(dst_tile); 
-   receive_vec.push_back(dst_tile); 
-}
-
-void transposeTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
-{
-   int mesh_width, mesh_height;
-   computeEMeshTopologyParams(_num_tiles, mesh_width, mesh_height);
-   int sx, sy;
-   computeEMeshPosition(tile_id, sx, sy, mesh_width);
-   tile_id_t dst_tile = computeTileID(sy, sx, mesh_width);
-   
-   send_vec.push_back(dst_tile);
-   receive_vec.push_back(dst_tile);
-}
-
-void tornadoTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
-{
-   int mesh_width, mesh_height;
-   computeEMeshTopologyParams(_num_tiles, mesh_width, mesh_height);
-   int sx, sy;
-   computeEMeshPosition(tile_id, sx, sy, mesh_width);
-   tile_id_t dst_tile = computeTileID((sx + mesh_width/2) % mesh_width, (sy + mesh_height/2) % mesh_height, mesh_width);
-
-   send_vec.push_back(dst_tile);
-   receive_vec.push_back(dst_tile);
-}
-
-void nearestNeighborTrafficGenerator(tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
-{
-   int mesh_width, mesh_height;
-   computeEMeshTopologyParams(_num_tiles, mesh_width, mesh_height);
-   int sx, sy;
-   computeEMeshPosition(tile_id, sx, sy, mesh_width);
-   tile_id_t dst_tile = computeTileID((sx+1) % mesh_width, (sy+1) % mesh_height, mesh_width);
-
-   send_vec.push_back(dst_tile);
-   receive_vec.push_back(dst_tile);
-}
-
-void computeEMeshTopologyParams(int num_tiles, int& mesh_width, int& mesh_height)
-{
-   mesh_width = (int) sqrt(1.0 * num_tiles);
-   mesh_height = (tile_id_t) ceil(1.0 * num_tiles / mesh_width);
-   assert(num_tiles == (mesh_width * mesh_height));
-}
-
-void computeEMeshPosition(tile_id_t tile_id, int& sx, int& sy, int mesh_width)
-{
-   sx = tile_id % mesh_width;
-   sy = tile_id / mesh_width;
-}
-
-tile_id_t computeTileID(int sx, int sy, int mesh_width)
-{
-   return ((sy * mesh_width) + sx);
-}
@@ -0,0 +1,191 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cassert>
+#include "traffic_patterns.h"
+#include "utils.h"
+#include "log.h"
+
+NetworkTrafficType parseTrafficPattern(string traffic_pattern)
+{
+   if (traffic_pattern == "uniform_random")
+      return UNIFORM_RANDOM;
+   else if (traffic_pattern == "bit_complement")
+      return BIT_COMPLEMENT;
+   else if (traffic_pattern == "shuffle")
+      return SHUFFLE;
+   else if (traffic_pattern == "transpose")
+      return TRANSPOSE;
+   else if (traffic_pattern == "tornado")
+      return TORNADO;
+   else if (traffic_pattern == "nearest_neighbor")
+      return NEAREST_NEIGHBOR;
+   else
+   {
+      fprintf(stderr, "** ERROR **\n");
+      fprintf(stderr, "Unrecognized Network Traffic Pattern Type (Use uniform_random, bit_complement, shuffle, transpose, tornado, nearest_neighbor)\n");
+      exit(-1);
+   }
+}
+
+void generateTraffic(NetworkTrafficType traffic_pattern_type, SInt32 num_tiles, tile_id_t tile_id,
+                     vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   switch (traffic_pattern_type)
+   {
+   case UNIFORM_RANDOM:
+      uniformRandomTrafficGenerator(num_tiles, tile_id, send_vec, receive_vec);
+      break;
+   case BIT_COMPLEMENT:
+      bitComplementTrafficGenerator(num_tiles, tile_id, send_vec, receive_vec);
+      break;
+   case SHUFFLE:
+      shuffleTrafficGenerator(num_tiles, tile_id, send_vec, receive_vec);
+      break;
+   case TRANSPOSE:
+      transposeTrafficGenerator(num_tiles, tile_id, send_vec, receive_vec);
+      break;
+   case TORNADO:
+      tornadoTrafficGenerator(num_tiles, tile_id, send_vec, receive_vec);
+      break;
+   case NEAREST_NEIGHBOR:
+      nearestNeighborTrafficGenerator(num_tiles, tile_id, send_vec, receive_vec);
+      break;
+   default:
+      LOG_PRINT_ERROR("Unrecognized traffic pattern (%u)", traffic_pattern_type);
+      break;
+   }
+}
+
+void computeEMeshTopologyParams(int num_tiles, int& mesh_width, int& mesh_height);
+void computeEMeshPosition(tile_id_t tile_id, int& sx, int& sy, int mesh_width);
+tile_id_t computeTileID(int sx, int sy, int mesh_width);
+
+void uniformRandomTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   // Generate Random Numbers using Linear Congruential Generator
+   tile_id_t send_matrix[num_tiles][num_tiles];
+   tile_id_t receive_matrix[num_tiles][num_tiles];
+
+   send_matrix[0][0] = num_tiles / 2; // Initial seed
+   receive_matrix[0][send_matrix[0][0]] = 0;
+   for (tile_id_t i = 0; i < num_tiles; i++) // Time Slot
+   {
+      if (i != 0)
+      {
+         send_matrix[i][0] = send_matrix[i-1][1];
+         receive_matrix[i][send_matrix[i][0]] = 0;
+      }
+      for (tile_id_t j = 1; j < num_tiles; j++) // Sender
+      {
+         send_matrix[i][j] = (13 * send_matrix[i][j-1] + 5) % num_tiles;
+         receive_matrix[i][send_matrix[i][j]] = j;
+      }
+   }
+
+   // Check the validity of the random numbers
+   for (tile_id_t i = 0; i < num_tiles; i++) // Time Slot
+   {
+      vector<bool> bits(num_tiles, false);
+      for (tile_id_t j = 0; j < num_tiles; j++) // Sender
+      {
+         bits[send_matrix[i][j]] = true;
+      }
+      for (tile_id_t j = 0; j < num_tiles; j++)
+      {
+         assert(bits[j]);
+      }
+   }
+
+   for (tile_id_t j = 0; j < num_tiles; j++) // Sender
+   {
+      vector<bool> bits(num_tiles, false);
+      for (tile_id_t i = 0; i < num_tiles; i++) // Time Slot
+      {
+         bits[send_matrix[i][j]] = true;
+      }
+      for (tile_id_t i = 0; i < num_tiles; i++)
+      {
+         assert(bits[i]);
+      }
+   }
+
+   for (SInt32 i = 0; i < num_tiles; i++)
+   {
+      send_vec.push_back(send_matrix[i][tile_id]);
+      receive_vec.push_back(receive_matrix[i][tile_id]);
+   }
+}
+
+void bitComplementTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   assert(isPower2(num_tiles));
+   int mask = num_tiles-1;
+   tile_id_t dst_tile = (~tile_id) & mask;
+   send_vec.push_back(dst_tile);
+   receive_vec.push_back(dst_tile);
+}
+
+void shuffleTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   assert(isPower2(num_tiles));
+   int mask = num_tiles-1;
+   int nbits = floorLog2(num_tiles);
+   tile_id_t dst_tile = ((tile_id >> (nbits-1)) & 1) | ((tile_id << 1) & mask);
+   send_vec.push_back(dst_tile); 
+   receive_vec.push_back(dst_tile); 
+}
+
+void transposeTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   int mesh_width, mesh_height;
+   computeEMeshTopologyParams(num_tiles, mesh_width, mesh_height);
+   int sx, sy;
+   computeEMeshPosition(tile_id, sx, sy, mesh_width);
+   tile_id_t dst_tile = computeTileID(sy, sx, mesh_width);
+   
+   send_vec.push_back(dst_tile);
+   receive_vec.push_back(dst_tile);
+}
+
+void tornadoTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   int mesh_width, mesh_height;
+   computeEMeshTopologyParams(num_tiles, mesh_width, mesh_height);
+   int sx, sy;
+   computeEMeshPosition(tile_id, sx, sy, mesh_width);
+   tile_id_t dst_tile = computeTileID((sx + mesh_width/2) % mesh_width, (sy + mesh_height/2) % mesh_height, mesh_width);
+
+   send_vec.push_back(dst_tile);
+   receive_vec.push_back(dst_tile);
+}
+
+void nearestNeighborTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec)
+{
+   int mesh_width, mesh_height;
+   computeEMeshTopologyParams(num_tiles, mesh_width, mesh_height);
+   int sx, sy;
+   computeEMeshPosition(tile_id, sx, sy, mesh_width);
+   tile_id_t dst_tile = computeTileID((sx+1) % mesh_width, (sy+1) % mesh_height, mesh_width);
+
+   send_vec.push_back(dst_tile);
+   receive_vec.push_back(dst_tile);
+}
+
+void computeEMeshTopologyParams(int num_tiles, int& mesh_width, int& mesh_height)
+{
+   mesh_width = (int) sqrt(1.0 * num_tiles);
+   mesh_height = (tile_id_t) ceil(1.0 * num_tiles / mesh_width);
+   assert(num_tiles == (mesh_width * mesh_height));
+}
+
+void computeEMeshPosition(tile_id_t tile_id, int& sx, int& sy, int mesh_width)
+{
+   sx = tile_id % mesh_width;
+   sy = tile_id / mesh_width;
+}
+
+tile_id_t computeTileID(int sx, int sy, int mesh_width)
+{
+   return ((sy * mesh_width) + sx);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+#include "fixed_types.h"
+
+// Synthetic network traffic patterns (shared by synthetic_network and network_model_driver)
+enum NetworkTrafficType
+{
+   UNIFORM_RANDOM = 0,
+   BIT_COMPLEMENT,
+   SHUFFLE,
+   TRANSPOSE,
+   TORNADO,
+   NEAREST_NEIGHBOR,
+   NUM_NETWORK_TRAFFIC_TYPES
+};
+
+NetworkTrafficType parseTrafficPattern(string traffic_pattern);
+
+// The destinations a tile sends to in turn (send_vec), and the tiles it receives from (receive_vec)
+void generateTraffic(NetworkTrafficType traffic_pattern_type, SInt32 num_tiles, tile_id_t tile_id,
+                     vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
+
+void uniformRandomTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
+void bitComplementTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
+void shuffleTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
+void transposeTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
+void tornadoTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
+void nearestNeighborTrafficGenerator(SInt32 num_tiles, tile_id_t tile_id, vector<tile_id_t>& send_vec, vector<tile_id_t>& receive_vec);
@@ -0,0 +1,115 @@
+// Checks BitVector::set/clear/at/find and the whole-vector operations on bits at the
+// 64-bit word boundaries and at the capacity() limit, for capacities around a word
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+using std::set;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "bit_vector.h"
+
+UInt32 capacity_list[] = {1, 63, 64, 65, 127, 128, 130};
+const UInt32 num_capacities = sizeof(capacity_list) / sizeof(capacity_list[0]);
+
+// Bits on both sides of every word boundary (and the last bit of the vector)
+UInt32 boundary_bit_list[] = {0, 1, 62, 63, 64, 65, 126, 127, 128, 129};
+const UInt32 num_boundary_bits = sizeof(boundary_bit_list) / sizeof(boundary_bit_list[0]);
+
+void check(bool condition, const char* what, UInt32 capacity, SInt32 bit)
+{
+   if (!condition)
+   {
+      fprintf(stderr, "*ERROR* %s: Capacity(%u), Bit(%i)\n", what, capacity, bit);
+      fprintf(stderr, "Bit-Vector test: FAILED\n");
+      exit(EXIT_FAILURE);
+   }
+}
+
+// 'vec' must hold exactly the bits in 'expected'
+void checkBits(BitVector& vec, const set<UInt32>& expected)
+{
+   UInt32 capacity = vec.capacity();
+   check(vec.size() == expected.size(), "size()", capacity, -1);
+   for (UInt32 bit = 0; bit < capacity; bit++)
+      check(vec.at(bit) == (expected.count(bit) > 0), "at()", capacity, bit);
+
+   // find() returns the set bits in increasing order, then -1, then starts over
+   vec.resetFind();
+   for (set<UInt32>::const_iterator it = expected.begin(); it != expected.end(); it++)
+      check(vec.find() == (SInt32) *it, "find()", capacity, *it);
+   check(vec.find() == -1, "find() past the last set bit", capacity, -1);
+   if (!expected.empty())
+      check(vec.find() == (SInt32) *expected.begin(), "find() after wrapping around", capacity, *expected.begin());
+   vec.resetFind();
+}
+
+void testCapacity(UInt32 capacity)
+{
+   BitVector vec(capacity);
+   set<UInt32> expected;
+   check(vec.capacity() == capacity, "capacity()", capacity, -1);
+   checkBits(vec, expected);
+
+   // Set the boundary bits one at a time (setting a bit twice does not change the size)
+   for (UInt32 i = 0; i < num_boundary_bits; i++)
+   {
+      UInt32 bit = boundary_bit_list[i];
+      if (bit >= capacity)
+         continue;
+      vec.set(bit);
+      vec.set(bit);
+      expected.insert(bit);
+      checkBits(vec, expected);
+   }
+   vec.set(capacity - 1);
+   expected.insert(capacity - 1);
+   checkBits(vec, expected);
+
+   // Clear them again, lowest first (clearing a bit twice does not change the size)
+   while (!expected.empty())
+   {
+      UInt32 bit = *expected.begin();
+      vec.clear(bit);
+      vec.clear(bit);
+      expected.erase(bit);
+      checkBits(vec, expected);
+   }
+
+   // Whole-vector set, test and clear with a vector holding only the last bit
+   BitVector last_bit_vec(capacity);
+   last_bit_vec.set(capacity - 1);
+   check(!vec.test(last_bit_vec), "test() on disjoint vectors", capacity, capacity - 1);
+   if (capacity > 1)
+      vec.set(0);
+   vec.set(last_bit_vec);
+   check(vec.test(last_bit_vec), "test() on overlapping vectors", capacity, capacity - 1);
+   if (capacity > 1)
+      expected.insert(0);
+   expected.insert(capacity - 1);
+   checkBits(vec, expected);
+
+   vec.clear(last_bit_vec);
+   expected.erase(capacity - 1);
+   checkBits(vec, expected);
+
+   vec.reset();
+   expected.clear();
+   checkBits(vec, expected);
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Bit-Vector test\n");
+
+   for (UInt32 i = 0; i < num_capacities; i++)
+   {
+      testCapacity(capacity_list[i]);
+      printf("Capacity(%u): OK\n", capacity_list[i]);
+   }
+
+   printf("Bit-Vector test: SUCCESS\n");
+   CarbonStopSim();
+   return 0;
+}
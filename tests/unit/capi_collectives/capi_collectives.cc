@@ -0,0 +1,100 @@
+/****************************************************
+ * This is a test for the non-blocking and          *
+ * collective operations of the CAPI                *
+ ****************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "carbon_user.h"
+#include "capi.h"
+#include "sync_api.h"
+
+#define NUM_ITERATIONS     10
+
+int g_num_threads = 4;
+carbon_barrier_t g_rank_barrier;
+
+void* test_collectives(void* threadid);
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   carbon_thread_t threads[g_num_threads];
+
+   CarbonBarrierInit(&g_rank_barrier, g_num_threads);
+
+   for (int i = 1; i < g_num_threads; i++)
+      threads[i] = CarbonSpawnThread(test_collectives, (void*) (long) i);
+   test_collectives((void*) 0);
+
+   for (int i = 1; i < g_num_threads; i++)
+      CarbonJoinThread(threads[i]);
+
+   fprintf(stderr, "Finished running capi collectives test!.\n");
+
+   CarbonStopSim();
+   return 0;
+}
+
+void check(bool condition, const char* what, int rank, int iteration)
+{
+   if (!condition)
+   {
+      fprintf(stderr, "*ERROR* %s: rank(%i), iteration(%i)\n", what, rank, iteration);
+      exit(EXIT_FAILURE);
+   }
+}
+
+void* test_collectives(void* threadid)
+{
+   int rank = (int) (long) threadid;
+   int num_ranks = g_num_threads;
+
+   CAPI_Initialize(rank);
+   // All ranks must be initialized before anyone sends
+   CarbonBarrierWait(&g_rank_barrier);
+
+   for (int i = 0; i < NUM_ITERATIONS; i++)
+   {
+      // Ring exchange with non-blocking send/receive
+      int left = (rank + num_ranks - 1) % num_ranks;
+      int right = (rank + 1) % num_ranks;
+      int send_value = rank * 100 + i;
+      int recv_value = -1;
+      CAPI_request_t send_request, recv_request;
+      CAPI_message_irecv(left, rank, (char*) &recv_value, sizeof(recv_value), &recv_request);
+      CAPI_message_isend(rank, right, (char*) &send_value, sizeof(send_value), &send_request);
+
+      int completed = 0;
+      CAPI_message_test(&send_request, &completed);
+      check(completed, "isend not completed", rank, i);
+      CAPI_message_wait(&recv_request);
+      CAPI_message_test(&recv_request, &completed);
+      check(completed && (recv_value == left * 100 + i), "irecv", rank, i);
+
+      // Broadcast from a rotating root
+      int root = i % num_ranks;
+      long bcast_value[2] = {(rank == root) ? 42 + i : 0, (rank == root) ? -i : 0};
+      CAPI_broadcast(root, rank, num_ranks, (char*) bcast_value, sizeof(bcast_value));
+      check((bcast_value[0] == 42 + i) && (bcast_value[1] == -i), "broadcast", rank, i);
+
+      // Reduce to the root
+      int contribution[2] = {rank + i, rank};
+      int sum[2] = {0, 0};
+      CAPI_reduce(root, rank, num_ranks, (char*) contribution, (char*) sum, 2, CAPI_INT, CAPI_SUM);
+      if (rank == root)
+      {
+         int expected = num_ranks * (num_ranks - 1) / 2;
+         check((sum[0] == expected + num_ranks * i) && (sum[1] == expected), "reduce", rank, i);
+      }
+
+      // Allreduce
+      double max_value = 0.0;
+      double my_value = (double) ((rank * 7 + i) % num_ranks);
+      CAPI_allreduce(rank, num_ranks, (char*) &my_value, (char*) &max_value, 1, CAPI_DOUBLE, CAPI_MAX);
+      check(max_value == (double) (num_ranks - 1), "allreduce", rank, i);
+   }
+
+   return NULL;
+}
@@ -0,0 +1,125 @@
+// Condition variable and mutex homed on different tiles of the distributed sync server.
+// In every round, the waiters wait on the condition variable till the main thread moves to the
+// next generation. The main thread wakes them up with a broadcast or with signals, while holding
+// the mutex (the waiters queue on the mutex) or after releasing it (they get it right away).
+#include <cstdio>
+#include <cstdlib>
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "sync_home_lookup.h"
+
+#define NUM_WAITERS     3
+#define NUM_ROUNDS      12
+
+enum WakeupMode
+{
+   BROADCAST_HOLDING_MUTEX = 0,
+   SIGNAL_HOLDING_MUTEX,
+   SIGNAL_AFTER_UNLOCK,
+   NUM_WAKEUP_MODES
+};
+
+// Neighbouring handles are homed on different tiles
+struct SyncObjects
+{
+   carbon_mutex_t mux;
+   carbon_cond_t cond;
+} g_sync;
+
+volatile SInt32 g_generation = 0;
+volatile SInt32 g_num_waiting = 0;
+volatile SInt32 g_num_woken = 0;
+
+void check(bool condition, const char* what)
+{
+   if (!condition)
+   {
+      fprintf(stderr, "*ERROR* %s\n", what);
+      fprintf(stderr, "Cond-Remote-Mutex test: FAILED\n");
+      exit(EXIT_FAILURE);
+   }
+}
+
+void* waiter(void*)
+{
+   for (SInt32 round = 0; round < NUM_ROUNDS; round++)
+   {
+      CarbonMutexLock(&g_sync.mux);
+      g_num_waiting ++;
+      while (g_generation == round)
+         CarbonCondWait(&g_sync.cond, &g_sync.mux);
+      check(g_generation == (round + 1), "Woken up in the wrong generation");
+      g_num_woken ++;
+      CarbonMutexUnlock(&g_sync.mux);
+   }
+   return NULL;
+}
+
+// Returns holding the mutex once 'count' reaches 'value'
+void lockWhenReached(volatile SInt32* count, SInt32 value)
+{
+   while (1)
+   {
+      CarbonMutexLock(&g_sync.mux);
+      if (*count == value)
+         return;
+      CarbonMutexUnlock(&g_sync.mux);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Cond-Remote-Mutex test\n");
+
+   SyncHomeLookup home_lookup;
+   check(home_lookup.isDistributed(), "Needs the distributed sync server (--sync_server/scheme=distributed)");
+
+   CarbonMutexInit(&g_sync.mux);
+   CarbonCondInit(&g_sync.cond);
+   check(home_lookup.getHomeCore(g_sync.mux).tile_id != home_lookup.getHomeCore(g_sync.cond).tile_id,
+         "Mutex and condition variable homed on the same tile");
+
+   carbon_thread_t threads[NUM_WAITERS];
+   for (SInt32 i = 0; i < NUM_WAITERS; i++)
+      threads[i] = CarbonSpawnThread(waiter, NULL);
+
+   for (SInt32 round = 0; round < NUM_ROUNDS; round++)
+   {
+      // All the waiters of this round are waiting on the condition variable once they
+      // have released the mutex
+      lockWhenReached(&g_num_waiting, NUM_WAITERS * (round + 1));
+      g_generation ++;
+
+      switch (round % NUM_WAKEUP_MODES)
+      {
+      case BROADCAST_HOLDING_MUTEX:
+         CarbonCondBroadcast(&g_sync.cond);
+         CarbonMutexUnlock(&g_sync.mux);
+         break;
+
+      case SIGNAL_HOLDING_MUTEX:
+         for (SInt32 i = 0; i < NUM_WAITERS; i++)
+            CarbonCondSignal(&g_sync.cond);
+         CarbonMutexUnlock(&g_sync.mux);
+         break;
+
+      case SIGNAL_AFTER_UNLOCK:
+         CarbonMutexUnlock(&g_sync.mux);
+         for (SInt32 i = 0; i < NUM_WAITERS; i++)
+            CarbonCondSignal(&g_sync.cond);
+         break;
+      }
+
+      lockWhenReached(&g_num_woken, NUM_WAITERS * (round + 1));
+      CarbonMutexUnlock(&g_sync.mux);
+      printf("Round(%i): OK\n", round);
+   }
+
+   for (SInt32 i = 0; i < NUM_WAITERS; i++)
+      CarbonJoinThread(threads[i]);
+
+   printf("Cond-Remote-Mutex test: SUCCESS\n");
+   CarbonStopSim();
+   return 0;
+}
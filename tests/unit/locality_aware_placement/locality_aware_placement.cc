@@ -0,0 +1,92 @@
+// Checks the placement search of the locality aware thread scheduler on a fixed traffic matrix
+// of a 3x3 mesh: the swap delta must match the recomputed weighted hop distance for every pair
+// and the greedy search must end on a known placement.
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "locality_aware_thread_scheduler.h"
+
+#define NUM_TILES    9
+#define MESH_WIDTH   3
+
+// {sender, receiver, bytes}
+UInt64 traffic_cfg[][3] = {
+   {1, 8, 50},
+   {8, 1, 30},
+   {2, 6, 40},
+   {6, 2, 10},
+   {0, 4, 20},
+   {3, 5, 5},
+   {7, 0, 15}
+};
+
+tile_id_t expected_placement[NUM_TILES] = {0, 5, 7, 4, 1, 2, 6, 3, 8};
+double expected_weighted_hops_before = 535;
+double expected_weighted_hops_after = 175;
+
+void fail(const char* msg)
+{
+   fprintf(stderr, "*ERROR* %s\n", msg);
+   fprintf(stderr, "Locality-Aware Placement test: FAILED\n");
+   exit(EXIT_FAILURE);
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Locality-Aware Placement test\n");
+
+   vector<UInt64> traffic(NUM_TILES * NUM_TILES, 0);
+   for (UInt32 i = 0; i < sizeof(traffic_cfg) / sizeof(traffic_cfg[0]); i++)
+      traffic[traffic_cfg[i][0] * NUM_TILES + traffic_cfg[i][1]] = traffic_cfg[i][2];
+
+   vector<tile_id_t> placement(NUM_TILES);
+   for (UInt32 i = 0; i < NUM_TILES; i++)
+      placement[i] = (tile_id_t) i;
+
+   double weighted_hops_before = LocalityAwareThreadScheduler::computeWeightedHops(traffic, placement, MESH_WIDTH);
+   printf("Weighted Hops Before: %.0f\n", weighted_hops_before);
+   if (weighted_hops_before != expected_weighted_hops_before)
+      fail("Weighted hops before the search");
+
+   // The swap delta is the exact change of the weighted hop distance
+   for (UInt32 a = 1; a < NUM_TILES; a++)
+   {
+      for (UInt32 b = a + 1; b < NUM_TILES; b++)
+      {
+         double delta = LocalityAwareThreadScheduler::computeSwapDelta(traffic, placement, a, b, MESH_WIDTH);
+         vector<tile_id_t> swapped_placement = placement;
+         std::swap(swapped_placement[a], swapped_placement[b]);
+         double weighted_hops_swapped = LocalityAwareThreadScheduler::computeWeightedHops(traffic, swapped_placement, MESH_WIDTH);
+         if (delta != weighted_hops_swapped - weighted_hops_before)
+         {
+            fprintf(stderr, "*ERROR* Swap(%u,%u): Delta(%.0f), Recomputed(%.0f)\n",
+                    a, b, delta, weighted_hops_swapped - weighted_hops_before);
+            fail("Swap delta");
+         }
+      }
+   }
+
+   LocalityAwareThreadScheduler::computePlacement(traffic, placement, MESH_WIDTH);
+
+   for (UInt32 i = 0; i < NUM_TILES; i++)
+   {
+      printf("Placement: Thread on Tile(%u) -> Tile(%i)\n", i, placement[i]);
+      if (placement[i] != expected_placement[i])
+         fail("Placement");
+   }
+
+   double weighted_hops_after = LocalityAwareThreadScheduler::computeWeightedHops(traffic, placement, MESH_WIDTH);
+   printf("Weighted Hops After: %.0f\n", weighted_hops_after);
+   if (weighted_hops_after != expected_weighted_hops_after)
+      fail("Weighted hops after the search");
+
+   printf("Locality-Aware Placement test: SUCCESS\n");
+   CarbonStopSim();
+
+   return 0;
+}
@@ -0,0 +1,200 @@
+// Checks Network::netMulticast on the user network of a 4x4 mesh.
+// Tile 0 multicasts to a set of tiles that includes itself (one packet per receiver expected, with
+// the receiver set to BROADCAST when the model has a broadcast tree and to the tile otherwise),
+// then to a single remote tile (always a unicast). Tiles outside the receiver sets must not
+// receive anything. On emesh_hop_by_hop, the branches taken by the broadcast tree at tile 0 are
+// also checked against the receiver set.
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+using std::vector;
+using std::sort;
+
+#include "carbon_user.h"
+#include "simulator.h"
+#include "config.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "core.h"
+#include "core_model.h"
+#include "network.h"
+#include "network_model.h"
+#include "bit_vector.h"
+
+#define MESH_WIDTH      4
+#define NUM_TILES       (MESH_WIDTH * MESH_WIDTH)
+#define NUM_ROUNDS      2
+
+// Receivers of each round (-1 terminated)
+tile_id_t receiver_list[NUM_ROUNDS][NUM_TILES+1] = {
+   {0, 5, 6, 11, 15, -1},
+   {9, -1}
+};
+
+carbon_barrier_t g_barrier;
+
+void check(bool condition, const char* what, tile_id_t tile_id)
+{
+   if (!condition)
+   {
+      fprintf(stderr, "*ERROR* %s: Tile(%i)\n", what, tile_id);
+      fprintf(stderr, "Multicast test: FAILED\n");
+      exit(EXIT_FAILURE);
+   }
+}
+
+bool isReceiver(UInt32 round, tile_id_t tile_id)
+{
+   for (SInt32 i = 0; receiver_list[round][i] != -1; i++)
+   {
+      if (receiver_list[round][i] == tile_id)
+         return true;
+   }
+   return false;
+}
+
+UInt32 getNumRemoteReceivers(UInt32 round)
+{
+   UInt32 num_remote_receivers = 0;
+   for (SInt32 i = 0; receiver_list[round][i] != -1; i++)
+   {
+      if (receiver_list[round][i] != 0)
+         num_remote_receivers ++;
+   }
+   return num_remote_receivers;
+}
+
+// Next tiles of a multicast packet routed at the root of the broadcast tree (tile 0)
+vector<tile_id_t> routeAtRoot(Core* core, const vector<tile_id_t>& receivers)
+{
+   NetworkModel* model = core->getTile()->getNetwork()->getNetworkModelFromPacketType(USER);
+
+   UInt64 multicast_mask[(NUM_TILES + 63) / 64] = {0};
+   for (UInt32 i = 0; i < receivers.size(); i++)
+      multicast_mask[receivers[i] >> 6] |= ((UInt64) 1) << (receivers[i] & 63);
+
+   UInt32 payload = 0;
+   NetPacket packet(core->getModel()->getCurrTime(), USER, core->getTile()->getId(), NetPacket::BROADCAST,
+                    sizeof(payload), &payload);
+   packet.multicast_mask_length = (NUM_TILES + 63) / 64;
+   packet.multicast_mask = multicast_mask;
+
+   // Injection router first, then the mesh router of tile 0
+   queue<NetworkModel::Hop> injection_hops;
+   model->__routePacket(packet, injection_hops);
+   check(injection_hops.size() == 1, "Broadcast tree: injection hops", 0);
+   packet.node_type = injection_hops.front()._next_node_type;
+
+   queue<NetworkModel::Hop> next_hops;
+   model->__routePacket(packet, next_hops);
+
+   vector<tile_id_t> next_tiles;
+   for ( ; !next_hops.empty(); next_hops.pop())
+      next_tiles.push_back(next_hops.front()._next_tile_id);
+   sort(next_tiles.begin(), next_tiles.end());
+   return next_tiles;
+}
+
+void checkBroadcastTreePruning(Core* core)
+{
+   // Tile (x,y) is (y * MESH_WIDTH + x), tile 0 is in the corner, so the root only goes UP (tile 4),
+   // RIGHT (tile 1) or to itself
+   tile_id_t right_only[] = {5, 6};
+   tile_id_t up_only[] = {8};
+   tile_id_t all_branches[] = {0, 2, 12};
+   tile_id_t next_right_only[] = {1};
+   tile_id_t next_up_only[] = {4};
+   tile_id_t next_all_branches[] = {0, 1, 4};
+
+   check(routeAtRoot(core, vector<tile_id_t>(right_only, right_only + 2)) ==
+         vector<tile_id_t>(next_right_only, next_right_only + 1), "Broadcast tree: receivers to the right only", 0);
+   check(routeAtRoot(core, vector<tile_id_t>(up_only, up_only + 1)) ==
+         vector<tile_id_t>(next_up_only, next_up_only + 1), "Broadcast tree: receivers above only", 0);
+   check(routeAtRoot(core, vector<tile_id_t>(all_branches, all_branches + 3)) ==
+         vector<tile_id_t>(next_all_branches, next_all_branches + 3), "Broadcast tree: receivers on all branches", 0);
+}
+
+void sendMulticasts(Core* core)
+{
+   Network* network = core->getTile()->getNetwork();
+
+   for (UInt32 round = 0; round < NUM_ROUNDS; round++)
+   {
+      BitVector receivers(NUM_TILES);
+      for (SInt32 i = 0; receiver_list[round][i] != -1; i++)
+         receivers.set(receiver_list[round][i]);
+
+      UInt32 payload = round;
+      NetPacket packet(core->getModel()->getCurrTime(), USER, core->getTile()->getId(), NetPacket::BROADCAST,
+                       sizeof(payload), &payload);
+      network->netMulticast(NETWORK_USER, packet, receivers);
+   }
+}
+
+void* receiveMulticasts(void*)
+{
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   Network* network = core->getTile()->getNetwork();
+   tile_id_t tile_id = core->getTile()->getId();
+   bool broadcast_capable = network->getNetworkModelFromPacketType(USER)->hasBroadcastCapability();
+
+   for (UInt32 round = 0; round < NUM_ROUNDS; round++)
+   {
+      if (!isReceiver(round, tile_id))
+         continue;
+
+      NetPacket packet = network->netRecv(Tile::getMainCoreId(0), core->getId(), USER);
+      check((packet.length == sizeof(UInt32)) && (*((UInt32*) packet.data) == round), "Payload", tile_id);
+
+      // The sender gets its own copy as a unicast, so does a lone remote receiver
+      bool multicast = broadcast_capable && (tile_id != 0) && (getNumRemoteReceivers(round) > 1);
+      tile_id_t expected_receiver = multicast ? NetPacket::BROADCAST : tile_id;
+      check(packet.receiver.tile_id == expected_receiver, multicast ? "Expected a multicast packet" : "Expected a unicast packet", tile_id);
+
+      delete [] (Byte*) packet.data;
+   }
+
+   // Every receiver has its packets by now, nothing else may be waiting at any tile
+   CarbonBarrierWait(&g_barrier);
+
+   NetMatch match;
+   match.senders.push_back(Tile::getMainCoreId(0));
+   match.types.push_back(USER);
+   check(!network->netQuery(match, Time(~((UInt64) 0))), "Packet delivered outside the receiver set", tile_id);
+
+   return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Multicast test\n");
+
+   check(Config::getSingleton()->getApplicationTiles() == NUM_TILES, "Needs a 4x4 mesh (CORES=16)", 0);
+
+   Core* core = Sim()->getTileManager()->getCurrentCore();
+   NetworkModel* model = core->getTile()->getNetwork()->getNetworkModelFromPacketType(USER);
+   printf("User Network(%s), Broadcast Capability(%s)\n",
+          Config::getSingleton()->getNetworkType(STATIC_NETWORK_USER).c_str(),
+          model->hasBroadcastCapability() ? "true" : "false");
+
+   if ((Config::getSingleton()->getNetworkType(STATIC_NETWORK_USER) == "emesh_hop_by_hop") && model->hasBroadcastCapability())
+      checkBroadcastTreePruning(core);
+
+   CarbonBarrierInit(&g_barrier, NUM_TILES);
+
+   carbon_thread_t threads[NUM_TILES];
+   for (tile_id_t i = 1; i < NUM_TILES; i++)
+      threads[i] = CarbonSpawnThreadOnTile(i, receiveMulticasts, NULL);
+
+   sendMulticasts(core);
+   receiveMulticasts(NULL);
+
+   for (tile_id_t i = 1; i < NUM_TILES; i++)
+      CarbonJoinThread(threads[i]);
+
+   printf("Multicast test: SUCCESS\n");
+   CarbonStopSim();
+   return 0;
+}
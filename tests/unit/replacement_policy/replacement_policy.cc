@@ -0,0 +1,108 @@
+// Drives fixed tag sequences through one 4-way cache set under each replacement policy
+// and checks every access against the expected hit / victim.
+// The set is set 1 of the cache, which is a BIP leader set under DIP.
+#include <cstdio>
+#include <cstdlib>
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "cache_set.h"
+#include "cache_line_info.h"
+#include "cache_replacement_policy.h"
+#include "pr_l1_pr_l2_dram_directory_msi/cache_level.h"
+
+#define ASSOCIATIVITY   4
+#define LINE_SIZE       64
+#define CACHE_SIZE      1     // KB (4 sets)
+#define SET_NUM         1
+#define NUM_POLICIES    6
+#define NUM_ACCESSES    12
+
+// Expected outcome of an access: HIT, FILL (miss into an empty way) or the tag of the evicted line
+#define HIT             -1
+#define FILL            0
+
+const char* policy_list[NUM_POLICIES] = {"round_robin", "lru", "tree_plru", "srrip", "brrip", "dip"};
+
+// Two hot lines re-referenced between conflicting misses
+SInt32 reuse_sequence[NUM_ACCESSES] = {1, 2, 3, 4, 1, 5, 2, 6, 1, 7, 3, 8};
+SInt32 reuse_expected[NUM_POLICIES][NUM_ACCESSES] = {
+   {FILL, FILL, FILL, FILL, HIT, 1, HIT, 2, 3,   4, 5,   6},   // round_robin
+   {FILL, FILL, FILL, FILL, HIT, 2, 3,   4, HIT, 5, 2,   6},   // lru
+   {FILL, FILL, FILL, FILL, HIT, 3, HIT, 4, HIT, 5, 2,   6},   // tree_plru
+   {FILL, FILL, FILL, FILL, HIT, 2, 3,   4, HIT, 5, 2,   6},   // srrip
+   {FILL, FILL, FILL, FILL, HIT, 2, 5,   2, HIT, 6, HIT, 7},   // brrip
+   {FILL, FILL, FILL, FILL, HIT, 4, HIT, 5, HIT, 6, HIT, 7}    // dip
+};
+
+// Two hot lines, then a scan of five lines that are never reused, then the hot lines again
+SInt32 scan_sequence[NUM_ACCESSES] = {1, 2, 1, 2, 3, 4, 5, 6, 7, 1, 2, 8};
+SInt32 scan_expected[NUM_POLICIES][NUM_ACCESSES] = {
+   {FILL, FILL, HIT, HIT, FILL, FILL, 1, 2, 3, 4,   5,   6},   // round_robin
+   {FILL, FILL, HIT, HIT, FILL, FILL, 1, 2, 3, 4,   5,   6},   // lru
+   {FILL, FILL, HIT, HIT, FILL, FILL, 1, 3, 2, 4,   5,   6},   // tree_plru
+   {FILL, FILL, HIT, HIT, FILL, FILL, 3, 4, 5, HIT, HIT, 6},   // srrip
+   {FILL, FILL, HIT, HIT, FILL, FILL, 3, 5, 6, HIT, HIT, 7},   // brrip
+   {FILL, FILL, HIT, HIT, FILL, FILL, 4, 5, 6, HIT, HIT, 7}    // dip
+};
+
+void replay(const char* sequence_name, SInt32 sequence[NUM_ACCESSES],
+            SInt32 expected[NUM_POLICIES][NUM_ACCESSES])
+{
+   for (UInt32 p = 0; p < NUM_POLICIES; p++)
+   {
+      CacheReplacementPolicy* replacement_policy = CacheReplacementPolicy::create(policy_list[p],
+            CACHE_SIZE, ASSOCIATIVITY, LINE_SIZE);
+      CacheSet* set = new CacheSet(SET_NUM, CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI, PrL1PrL2DramDirectoryMSI::L1,
+                                   replacement_policy, ASSOCIATIVITY, LINE_SIZE);
+      CacheLineInfo* inserted_line_info = CacheLineInfo::create(CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI, PrL1PrL2DramDirectoryMSI::L1);
+      CacheLineInfo* evicted_line_info = CacheLineInfo::create(CachingProtocol::PR_L1_PR_L2_DRAM_DIRECTORY_MSI, PrL1PrL2DramDirectoryMSI::L1);
+
+      for (UInt32 i = 0; i < NUM_ACCESSES; i++)
+      {
+         IntPtr tag = (IntPtr) sequence[i];
+         SInt32 outcome;
+
+         UInt32 line_index;
+         if (set->find(tag, &line_index))
+         {
+            set->read_line(line_index, 0, NULL, 0);
+            outcome = HIT;
+         }
+         else
+         {
+            bool eviction;
+            inserted_line_info->setTag(tag);
+            inserted_line_info->setCState(CacheState::SHARED);
+            set->insert(inserted_line_info, NULL, &eviction, evicted_line_info, NULL);
+            outcome = eviction ? ((SInt32) evicted_line_info->getTag()) : FILL;
+         }
+
+         if (outcome != expected[p][i])
+         {
+            fprintf(stderr, "*ERROR* Sequence(%s), Policy(%s), Access(%u), Tag(%i): Expected(%i), Got(%i) [HIT(%i), FILL(%i)]\n",
+                    sequence_name, policy_list[p], i, sequence[i], expected[p][i], outcome, HIT, FILL);
+            fprintf(stderr, "Replacement-Policy test: FAILED\n");
+            exit(EXIT_FAILURE);
+         }
+      }
+      printf("Sequence(%s), Policy(%s): OK\n", sequence_name, policy_list[p]);
+
+      delete inserted_line_info;
+      delete evicted_line_info;
+      delete set;
+      delete replacement_policy;
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Replacement-Policy test\n");
+
+   replay("reuse", reuse_sequence, reuse_expected);
+   replay("scan", scan_sequence, scan_expected);
+
+   printf("Replacement-Policy test: SUCCESS\n");
+   CarbonStopSim();
+   return 0;
+}
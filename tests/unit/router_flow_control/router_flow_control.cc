@@ -0,0 +1,107 @@
+// Drives a fixed packet sequence through a RouterModel with credit-based flow control
+// (2 output ports, 2 VC classes of 2 VCs, 4-flit VC buffers, 6-cycle credit round trip)
+// and checks the contention delay of every packet, the VC and credit stall counters
+// and the output port backlog.
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+using std::string;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "core.h"
+#include "network.h"
+#include "network_model.h"
+#include "router_model.h"
+
+#define NUM_PORTS                   2
+#define NUM_VC_CLASSES              2
+#define NUM_VCS_PER_CLASS           2
+#define NUM_FLITS_PER_VC_BUFFER     4
+#define ROUTER_DELAY                1
+#define CREDIT_ROUND_TRIP_DELAY     6
+#define FLIT_WIDTH                  64
+#define NUM_PACKETS                 7
+
+// Time (in cycles), output port, VC class, length (in flits), expected contention delay (in cycles)
+UInt64 pkt_cfg[NUM_PACKETS][5] = {
+   {0, 0, 0, 2,  0},    // VC 0
+   {1, 0, 0, 2,  1},    // VC 1, waits for the link
+   {2, 0, 0, 1,  6},    // Waits for the credits of VC 0 (back at 8)
+   {3, 1, 0, 10, 4},    // Longer than the VC buffer: 2 credit waits of (6 - 4) cycles
+   {4, 1, 0, 1,  9},    // VC 1, waits for the link (busy till 13)
+   {5, 1, 0, 1,  15},   // Waits for the credits of VC 1 (back at 20)
+   {6, 0, 1, 1,  3}     // Other VC class (no VC stall), waits for the link (busy till 9)
+};
+
+#define EXPECTED_VC_STALLS          2
+#define EXPECTED_VC_STALL_CYCLES    21
+#define EXPECTED_CREDIT_STALLS      1
+#define EXPECTED_CREDIT_STALL_CYCLES 4
+
+void check(bool condition, const char* what, SInt32 pkt_num, UInt64 expected, UInt64 got)
+{
+   if (!condition)
+   {
+      fprintf(stderr, "*ERROR* %s: Pkt(%i), Expected(%llu), Got(%llu)\n", what, pkt_num,
+              (long long unsigned int) expected, (long long unsigned int) got);
+      fprintf(stderr, "Router-Flow-Control test: FAILED\n");
+      exit(EXIT_FAILURE);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Router-Flow-Control test\n");
+
+   NetworkModel* network_model = Sim()->getTileManager()->getCurrentCore()->getTile()->getNetwork()->
+                                 getNetworkModel(STATIC_NETWORK_USER);
+   double frequency = network_model->getFrequency();
+   // Replayed packets carry their modeled length (in bits)
+   check(network_model->computeNumFlits(FLIT_WIDTH) == 1, "Flits of a 64-bit packet on the user network", -1, 1,
+         network_model->computeNumFlits(FLIT_WIDTH));
+
+   string contention_model_type = "history_tree";
+   RouterModel router_model(network_model, frequency, network_model->getVoltage(),
+                            NUM_PORTS, NUM_PORTS, NUM_FLITS_PER_VC_BUFFER, ROUTER_DELAY, FLIT_WIDTH,
+                            true, contention_model_type,
+                            NUM_VC_CLASSES, NUM_VCS_PER_CLASS, CREDIT_ROUND_TRIP_DELAY);
+   check(router_model.isCreditFlowControlEnabled(), "Credit flow control enabled", -1, 1, 0);
+
+   for (SInt32 i = 0; i < NUM_PACKETS; i++)
+   {
+      NetPacket packet(Time(Latency(pkt_cfg[i][0], frequency)), NETWORK_REPLAY, 0, 0,
+                       pkt_cfg[i][3] * FLIT_WIDTH, NULL);
+      UInt64 zero_load_delay = 0;
+      UInt64 contention_delay = 0;
+      router_model.processPacket(packet, (SInt32) pkt_cfg[i][1], zero_load_delay, contention_delay, (SInt32) pkt_cfg[i][2]);
+
+      check(zero_load_delay == ROUTER_DELAY, "Zero Load Delay", i, ROUTER_DELAY, zero_load_delay);
+      check(contention_delay == pkt_cfg[i][4], "Contention Delay", i, pkt_cfg[i][4], contention_delay);
+      printf("Pkt(%i): Time(%llu), Output Port(%llu), VC Class(%llu), Flits(%llu), Contention Delay(%llu)\n", i,
+             (long long unsigned int) pkt_cfg[i][0], (long long unsigned int) pkt_cfg[i][1],
+             (long long unsigned int) pkt_cfg[i][2], (long long unsigned int) pkt_cfg[i][3],
+             (long long unsigned int) contention_delay);
+   }
+
+   check(router_model.getTotalVCStalls() == EXPECTED_VC_STALLS, "VC Stalls", -1,
+         EXPECTED_VC_STALLS, router_model.getTotalVCStalls());
+   check(router_model.getTotalVCStallCycles() == EXPECTED_VC_STALL_CYCLES, "VC Stall Cycles", -1,
+         EXPECTED_VC_STALL_CYCLES, router_model.getTotalVCStallCycles());
+   check(router_model.getTotalCreditStalls() == EXPECTED_CREDIT_STALLS, "Credit Stalls", -1,
+         EXPECTED_CREDIT_STALLS, router_model.getTotalCreditStalls());
+   check(router_model.getTotalCreditStallCycles() == EXPECTED_CREDIT_STALL_CYCLES, "Credit Stall Cycles", -1,
+         EXPECTED_CREDIT_STALL_CYCLES, router_model.getTotalCreditStallCycles());
+
+   // Port 0 is busy till cycle 10, port 1 till cycle 21
+   check(router_model.getOutputPortBacklog(0, 6) == 4, "Backlog of Port 0 at cycle 6", -1, 4, router_model.getOutputPortBacklog(0, 6));
+   check(router_model.getOutputPortBacklog(1, 6) == 15, "Backlog of Port 1 at cycle 6", -1, 15, router_model.getOutputPortBacklog(1, 6));
+
+   printf("Router-Flow-Control test: SUCCESS\n");
+   CarbonStopSim();
+   return 0;
+}
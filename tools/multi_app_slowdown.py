@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+
+# Slowdown of each target of a multi-application run relative to running alone,
+# along with the interference each target saw in the shared resources
+#
+# Usage:
+#   tools/multi_app_slowdown.py --shared-dir <results dir of the multi-application run>
+#                               --alone-dirs <results dir of target 0 alone>,<results dir of target 1 alone>,...
+
+import re
+import sys
+from optparse import OptionParser
+
+def readOutputFile(results_dir):
+   try:
+      return open("%s/sim.out" % (results_dir), 'r').readlines()
+   except IOError:
+      print("ERROR: Could not open file (%s/sim.out)" % (results_dir))
+      sys.exit(3)
+
+def parseRow(line):
+   values = line.split('|')[1:-1]
+   return [float(value) if (len(value.split()) > 0) else 0.0 for value in values]
+
+# First row matching 'key' after the line matching 'heading'
+def rowSearch(output_file_contents, heading, key):
+   heading_found = False
+   for line in output_file_contents:
+      if heading_found:
+         if re.search(key, line):
+            return parseRow(line)
+      else:
+         heading_found = (re.search(heading, line) != None)
+   print("ERROR: Could not find key [%s,%s]" % (heading, key))
+   sys.exit(1)
+
+# Element-wise sum of all rows matching 'key' (one per network, for instance)
+def rowSum(output_file_contents, key):
+   total = None
+   for line in output_file_contents:
+      if re.search(key, line):
+         row = parseRow(line)
+         total = row if (total == None) else [x + y for x, y in zip(total, row)]
+   return total
+
+def getTargetTiles(output_file_contents):
+   target_tiles = {}
+   for line in output_file_contents:
+      match_key = re.search("Target ([0-9]+) Application Tiles:(.*)", line)
+      if match_key:
+         target_tiles[int(match_key.group(1))] = [int(tile) for tile in match_key.group(2).split()]
+   if len(target_tiles) == 0:
+      print("ERROR: No Multi-Application Summary found, was more than one target simulated?")
+      sys.exit(1)
+   return target_tiles
+
+parser = OptionParser()
+parser.add_option("--shared-dir", dest="shared_dir", help="Results directory of the multi-application run")
+parser.add_option("--alone-dirs", dest="alone_dirs", help="Comma separated results directories of the targets run alone")
+(options,args) = parser.parse_args()
+
+if (options.shared_dir == None) or (options.alone_dirs == None):
+   parser.print_help()
+   sys.exit(1)
+
+shared_output = readOutputFile(options.shared_dir)
+alone_dirs = options.alone_dirs.split(',')
+
+target_tiles = getTargetTiles(shared_output)
+if len(alone_dirs) != len(target_tiles):
+   print("ERROR: %i targets in the multi-application run, %i alone runs given" % (len(target_tiles), len(alone_dirs)))
+   sys.exit(1)
+
+shared_completion_time = rowSearch(shared_output, "Core Summary", "Completion Time \(in nanoseconds\)")
+
+stats_file = open("%s/multi_app_stats.out" % (options.shared_dir), 'w')
+weighted_speedup = 0.0
+
+for target_num in sorted(target_tiles.keys()):
+   tiles = target_tiles[target_num]
+   target_time = max([shared_completion_time[tile] for tile in tiles])
+   alone_time = max(rowSearch(readOutputFile(alone_dirs[target_num]), "Core Summary", "Completion Time \(in nanoseconds\)"))
+   slowdown = target_time / alone_time
+   weighted_speedup += 1.0 / slowdown
+
+   stats_file.write("Target-%i-Time = %f\n" % (target_num, target_time))
+   stats_file.write("Target-%i-Alone-Time = %f\n" % (target_num, alone_time))
+   stats_file.write("Target-%i-Slowdown = %f\n" % (target_num, slowdown))
+
+   # Occupancy and queueing delay in the shared resources, summed over all tiles
+   for resource in ["Dram", "Network", "Directory"]:
+      for counter in ["Occupancy", "Queueing Delay"]:
+         row = rowSum(shared_output, "Target %i Total %s %s \(in nanoseconds\)" % (target_num, resource, counter))
+         if row != None:
+            stats_file.write("Target-%i-%s-%s = %f\n" % (target_num, resource, counter.replace(' ', '-'), sum(row)))
+
+stats_file.write("Weighted-Speedup = %f\n" % (weighted_speedup))
+stats_file.close()
+
+print("Written stats file: %s/multi_app_stats.out" % (options.shared_dir))
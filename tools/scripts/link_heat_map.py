@@ -0,0 +1,49 @@
+#!/usr/bin/env python
+
+# Prints the link utilization heat maps of an emesh_hop_by_hop network from sim.out:
+# one grid per link direction, laid out like the mesh (row 0 at the bottom)
+#   Usage: link_heat_map.py <sim.out> [User|Memory]
+
+import math
+import sys
+
+def read_heat_map(lines, network):
+   heat_map = {}
+   in_network = False
+   in_heat_map = False
+   for line in lines:
+      columns = [column.strip() for column in line.split('|')]
+      heading = columns[0]
+      if heading.startswith("Network ("):
+         in_network = (heading == "Network (%s)" % network)
+         in_heat_map = False
+      elif in_network and heading == "Link Utilization Heat Map (%)":
+         in_heat_map = True
+      elif in_heat_map and heading.endswith(" Link"):
+         heat_map[heading] = [float(value) if value else 0.0 for value in columns[1:-1]]
+      elif in_heat_map:
+         in_heat_map = False
+   return heat_map
+
+def print_heat_map(direction, values):
+   num_tiles = len(values)
+   mesh_width = int(math.floor(math.sqrt(num_tiles)))
+   mesh_height = (num_tiles + mesh_width - 1) // mesh_width
+   print("%s (%%):" % direction)
+   for y in reversed(range(mesh_height)):
+      row = values[y * mesh_width : (y+1) * mesh_width]
+      print("  " + " ".join("%6.2f" % value for value in row))
+   print("")
+
+if __name__ == "__main__":
+   if len(sys.argv) < 2:
+      print("Usage: %s <sim.out> [User|Memory]" % sys.argv[0])
+      sys.exit(1)
+   network = sys.argv[2] if len(sys.argv) > 2 else "User"
+
+   heat_map = read_heat_map(open(sys.argv[1]).readlines(), network)
+   if not heat_map:
+      print("ERROR: No link utilization heat map for network (%s) in %s" % (network, sys.argv[1]))
+      sys.exit(2)
+   for direction in ["Left Link", "Right Link", "Down Link", "Up Link"]:
+      print_heat_map(direction, heat_map[direction])
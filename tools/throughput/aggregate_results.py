@@ -0,0 +1,180 @@
+#!/usr/bin/env python
+
+# Collects the simulator throughput of every configuration of the benchmark matrix (see config.py),
+# appends it to the history file and flags the configurations that regressed against their baseline
+# (computed from the earlier runs on the same host only).
+#   Usage: aggregate_results.py [--no-history]   (--no-history: compare without recording the run)
+# Exits with 1 if any configuration failed or regressed.
+
+import sys
+import os
+import re
+import json
+import time
+import subprocess
+
+from config import *
+
+# Values of a row of the per-tile summary tables of sim.out, after 'heading' has been seen
+def searchRow(sim_out_lines, heading, key, num_tiles):
+   heading_found = False
+   for line in sim_out_lines:
+      columns = [column.strip() for column in line.split('|')]
+      if heading_found and (columns[0] == key):
+         return [float(value) if value else 0.0 for value in columns[1:num_tiles+1]]
+      elif re.search(heading, columns[0]):
+         heading_found = True
+   return None
+
+# Value of one of the 'Simulation (Host) Timers' of sim.out
+def searchHostTimer(sim_out_lines, key):
+   for line in sim_out_lines:
+      match = re.match(r"\s*" + re.escape(key) + r"\s+([0-9]+)\s*$", line)
+      if match:
+         return float(match.group(1))
+   return None
+
+def parseResults(configuration):
+   (benchmark, num_tiles, core_type, caching_protocol, network) = configuration
+   try:
+      sim_out_lines = open("%s/%s/sim.out" % (results_dir, getConfigurationName(configuration)), 'r').readlines()
+   except IOError:
+      return None
+
+   instructions = searchRow(sim_out_lines, "Core Summary", "Total Instructions", num_tiles)
+   completion_time = searchRow(sim_out_lines, "Core Summary", "Completion Time (in nanoseconds)", num_tiles)
+   start_time = searchHostTimer(sim_out_lines, "Start Time (in microseconds)")
+   stop_time = searchHostTimer(sim_out_lines, "Stop Time (in microseconds)")
+   peak_rss = searchHostTimer(sim_out_lines, "Peak Resident Set Size (in KB)")
+   if (instructions == None) or (completion_time == None) or (start_time == None) or (stop_time == None):
+      return None
+
+   target_instructions = sum(instructions)
+   target_time = max(completion_time)            # In nanoseconds
+   host_working_time = stop_time - start_time    # In microseconds
+   if (target_time == 0) or (host_working_time == 0):
+      return None
+
+   return {
+      "target_instructions"               : target_instructions,
+      "target_time_ns"                    : target_time,
+      "host_working_time_us"              : host_working_time,
+      "simulated_mips"                    : target_instructions / host_working_time,
+      "host_seconds_per_simulated_ms"     : (host_working_time / 1.0e6) / (target_time / 1.0e6),
+      "peak_rss_kb"                       : peak_rss,
+      }
+
+def readHistory():
+   history = []
+   if os.path.exists(history_file):
+      for line in open(history_file, 'r'):
+         if line.strip():
+            history.append(json.loads(line))
+   return history
+
+def median(value_list):
+   value_list = sorted(value_list)
+   n = len(value_list)
+   if (n % 2) == 1:
+      return value_list[n // 2]
+   return 0.5 * (value_list[n // 2 - 1] + value_list[n // 2])
+
+def readHostInfo():
+   try:
+      return json.load(open(host_info_file, 'r'))
+   except (IOError, ValueError):
+      return {"hostname": "unknown", "cpu_model": "unknown"}
+
+# Median of each metric over the last 'baseline_window' passing runs of the configuration on the host
+def computeBaseline(history, name, hostname):
+   runs = [record["metrics"] for record in history
+           if (record["configuration"] == name) and (record["status"] == "PASS") and (record.get("hostname") == hostname)]
+   runs = runs[-baseline_window:]
+   if not runs:
+      return None
+   baseline = {}
+   for metric in ["simulated_mips", "host_seconds_per_simulated_ms", "peak_rss_kb"]:
+      values = [run[metric] for run in runs if run.get(metric) != None]
+      if values:
+         baseline[metric] = median(values)
+   return baseline
+
+# Change (in %) of each metric in the direction that is worse
+def computeRegressions(metrics, baseline):
+   regressions = []
+   if baseline == None:
+      return regressions
+   if baseline.get("simulated_mips"):
+      change = 100.0 * (baseline["simulated_mips"] - metrics["simulated_mips"]) / baseline["simulated_mips"]
+      if change > regression_threshold:
+         regressions.append("Simulated MIPS -%.1f%%" % (change))
+   for (metric, label) in [("host_seconds_per_simulated_ms", "Host Seconds per Simulated ms"), ("peak_rss_kb", "Peak RSS")]:
+      if baseline.get(metric) and (metrics.get(metric) != None):
+         change = 100.0 * (metrics[metric] - baseline[metric]) / baseline[metric]
+         if change > regression_threshold:
+            regressions.append("%s +%.1f%%" % (label, change))
+   return regressions
+
+def getCommit():
+   try:
+      return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"], stderr=open(os.devnull, 'w')).decode().strip()
+   except (OSError, subprocess.CalledProcessError):
+      return "unknown"
+
+if __name__ == "__main__":
+   record_history = ("--no-history" not in sys.argv[1:])
+
+   history = readHistory()
+   host_info = readHostInfo()
+   commit = getCommit()
+   date = time.strftime("%Y-%m-%d %H:%M:%S")
+
+   summary_file = open("./tools/throughput/summary.log", 'w')
+   summary_file.write("Simulator Throughput (commit %s, %s, regression threshold %.1f%%)\n" % (commit, date, regression_threshold))
+   summary_file.write("Host %s (%s)\n\n" % (host_info["hostname"], host_info["cpu_model"]))
+   summary_file.write("%s | %s | %s | %s | %s | %s\n" % \
+                      ('Configuration'.ljust(62), 'Status'.center(10), 'Sim. MIPS'.center(10),
+                       'Host s/Sim. ms'.center(14), 'Peak RSS (MB)'.center(13), 'Regressions'))
+   summary_file.write("_" * 145 + "\n\n")
+
+   new_records = []
+   num_failures = 0
+   num_regressions = 0
+   for configuration in getConfigurationList():
+      name = getConfigurationName(configuration)
+      metrics = parseResults(configuration)
+
+      if metrics == None:
+         num_failures += 1
+         new_records.append({"commit": commit, "date": date, "hostname": host_info["hostname"], "cpu_model": host_info["cpu_model"],
+                             "configuration": name, "status": "FAIL", "metrics": {}})
+         summary_file.write("%s | %s | %s | %s | %s |\n" % \
+                            (name.ljust(62), 'FAIL'.center(10), ''.ljust(10), ''.ljust(14), ''.ljust(13)))
+         continue
+
+      regressions = computeRegressions(metrics, computeBaseline(history, name, host_info["hostname"]))
+      status = "REGRESSED" if regressions else "PASS"
+      if regressions:
+         num_regressions += 1
+      # Regressed runs are kept out of the baseline of the later runs
+      new_records.append({"commit": commit, "date": date, "hostname": host_info["hostname"], "cpu_model": host_info["cpu_model"],
+                          "configuration": name, "status": status, "metrics": metrics})
+
+      peak_rss = ("%.1f" % (metrics["peak_rss_kb"] / 1024.0)) if metrics["peak_rss_kb"] != None else ""
+      summary_file.write("%s | %s | %s | %s | %s | %s\n" % \
+                         (name.ljust(62), status.center(10),
+                          ("%.2f" % (metrics["simulated_mips"])).ljust(10),
+                          ("%.2f" % (metrics["host_seconds_per_simulated_ms"])).ljust(14),
+                          peak_rss.ljust(13), ", ".join(regressions)))
+
+   summary_file.write("_" * 145 + "\n\n")
+   summary_file.write("%i configurations: %i failed, %i regressed\n" % (len(new_records), num_failures, num_regressions))
+   summary_file.close()
+
+   if record_history:
+      history_out = open(history_file, 'a')
+      for record in new_records:
+         history_out.write(json.dumps(record, sort_keys=True) + "\n")
+      history_out.close()
+
+   sys.exit(1 if (num_failures > 0) or (num_regressions > 0) else 0)
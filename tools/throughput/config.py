@@ -0,0 +1,67 @@
+#!/usr/bin/env python
+
+import sys
+
+sys.path.append("./tools/")
+from benchmark_config import *
+
+# scheduler: Use 'condor' for the condor scheduling system or 'basic' for using Graphite's scheduling system
+scheduler = "basic"
+
+# results_dir: Directory where the simulation results are placed
+results_dir = "./tools/throughput/simulation_results"
+# config_filename: Config file to use for the simulation
+config_filename = "carbon_sim.cfg"
+
+# host: The one machine the whole matrix runs on, one simulation at a time, so that host times
+# are comparable across configurations and runs. Do not use 'localhost' or '127.0.0.1', use the machine name
+# Every simulation runs in one process. Baselines only use the runs made on the same host
+host = "draco1"
+machines = [host]
+
+# host_info_file: Hostname and CPU model of the host, written by run_tests.py
+host_info_file = results_dir + "/host_info.json"
+
+# history_file: One JSON record per configuration and run, appended by aggregate_results.py
+history_file = "./tools/throughput/history.jsonl"
+# regression_threshold: Change (in %) from the baseline flagged as a regression
+#   (lower simulated MIPS, higher host seconds per simulated ms or higher peak RSS)
+regression_threshold = 10.0
+# baseline_window: The baseline of a configuration is the median of its last 'baseline_window' passing runs
+baseline_window = 5
+
+# The benchmark matrix: every combination of the lists below
+benchmark_list = ["fft", "radix", "lu_contiguous", "cholesky"]
+num_tiles_list = [16, 64]
+core_type_list = ["in_order", "out_of_order"]
+caching_protocol_list = ["pr_l1_pr_l2_dram_directory_msi", "pr_l1_pr_l2_dram_directory_mosi"]
+network_list = ["emesh_hop_counter", "emesh_hop_by_hop"]
+
+# Inputs of the benchmarks (with one thread per tile)
+throughput_app_flags_table = {
+      "fft"                                        : "-p%(num_threads)d -m20",
+      "radix"                                      : "-p%(num_threads)d -n1048576",
+      "lu_contiguous"                              : "-p%(num_threads)d -n1024",
+      "cholesky"                                   : "-p%(num_threads)d inputs/tk29.O",
+      }
+
+caching_protocol_name_table = {
+      "pr_l1_pr_l2_dram_directory_msi"             : "msi",
+      "pr_l1_pr_l2_dram_directory_mosi"            : "mosi",
+      }
+
+def getConfigurationList():
+   configuration_list = []
+   for benchmark in benchmark_list:
+      for num_tiles in num_tiles_list:
+         for core_type in core_type_list:
+            for caching_protocol in caching_protocol_list:
+               for network in network_list:
+                  configuration_list.append((benchmark, num_tiles, core_type, caching_protocol, network))
+   return configuration_list
+
+# Name of the configuration, also the sub-directory of results_dir its results are placed in
+def getConfigurationName(configuration):
+   (benchmark, num_tiles, core_type, caching_protocol, network) = configuration
+   return "%s--tiles-%i--%s--%s--%s" % (benchmark, num_tiles, core_type,
+                                         caching_protocol_name_table[caching_protocol], network)
@@ -0,0 +1,14 @@
+#!/bin/sh
+echo "Starting: Simulator throughput benchmarks"
+date
+python -u tools/throughput/run_tests.py > tools/throughput/detailed.log 2>&1
+python -u tools/throughput/aggregate_results.py >> tools/throughput/detailed.log 2>&1
+status=$?
+cat tools/throughput/summary.log >> tools/throughput/detailed.log
+echo ""
+echo "Ending: Simulator throughput benchmarks"
+date
+echo ""
+cat tools/throughput/summary.log
+echo ""
+exit $status
@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+
+import sys
+import os
+import re
+import shutil
+import json
+import subprocess
+
+sys.path.append("./tools/")
+sys.path.append("./tools/scheduler")
+sys.path.append("./tools/job")
+
+from simulate import *
+from config import *
+from utils import *
+from sim_job import SimJob
+
+# The core type is set in [tile] model_list, which does not go through SIM_FLAGS
+# (because of the '<' and '>'), so every core type gets its own copy of the config file
+def createCoreTypeConfigFile(core_type):
+   core_type_config_filename = "%s/carbon_sim--%s.cfg" % (results_dir, core_type)
+   contents = open(config_filename, 'r').read()
+   contents = re.sub(r"\nmodel_list\s*=.*", "\nmodel_list = \"<default,%s,T1,T1,T1>\"" % (core_type), contents)
+   open(core_type_config_filename, 'w').write(contents)
+   return core_type_config_filename
+
+try:
+   # Remove the results directory
+   shutil.rmtree(results_dir)
+except OSError:
+   pass
+try:
+   # Create results directory
+   os.makedirs(results_dir)
+except OSError:
+   pass
+
+# Hostname and CPU model of the machine the simulations run on, recorded with the results
+def recordHostInfo():
+   command = "hostname; grep -m1 'model name' /proc/cpuinfo | cut -d: -f2"
+   try:
+      output = subprocess.check_output(["ssh", "-x", host, command]).decode().split("\n")
+      host_info = {"hostname": output[0].strip(), "cpu_model": output[1].strip()}
+   except (OSError, subprocess.CalledProcessError, IndexError):
+      print "*ERROR* Could not read the hostname and CPU model of %s" % (host)
+      sys.exit(4)
+   json.dump(host_info, open(host_info_file, 'w'), sort_keys=True)
+
+recordHostInfo()
+
+core_type_config_filename_table = {}
+for core_type in core_type_list:
+   core_type_config_filename_table[core_type] = createCoreTypeConfigFile(core_type)
+
+# Compile benchmarks
+compileBenchmarks(benchmark_list)
+
+# Generate jobs
+jobs = []
+
+for configuration in getConfigurationList():
+   (benchmark, num_tiles, core_type, caching_protocol, network) = configuration
+
+   # Generate command
+   command = getCommand(benchmark)
+
+   # Generate SIM_FLAGS
+   sim_flags = "--general/total_cores=%i " % (num_tiles) + \
+               "--general/mode=full " + \
+               "--general/trigger_models_within_application=true " + \
+               "--caching_protocol/type=%s " % (caching_protocol) + \
+               "--network/user=%s " % (network) + \
+               "--network/memory=%s " % (network)
+
+   # Generate APP_FLAGS
+   app_flags = throughput_app_flags_table[benchmark] % {"num_threads": num_tiles}
+
+   # Generate sub_dir where results are going to be placed
+   sub_dir = getConfigurationName(configuration)
+
+   jobs.append(SimJob(command, 1, core_type_config_filename_table[core_type], results_dir, sub_dir,
+                      sim_flags, app_flags, "pin", scheduler))
+
+# Go!
+simulate(scheduler, jobs, machines, results_dir, config_filename)